@@ -128,6 +128,25 @@ extern "C" {
 /** Maximum shared memory required for slave links. */
 #define BLE_CONTROLLER_MEM_SLAVE_LINKS_SHARED  40
 
+/** @brief Maximum memory required for a link configuration.
+ *
+ * This macro will return the memory required by all master and slave links,
+ * including the shared memory of each role in use. It can be used to size the
+ * memory given to @ref ble_controller_enable at compile time.
+ *
+ * @param[in] master_count Number of master links.
+ * @param[in] slave_count Number of slave links.
+ * @param[in] tx_size Link Layer TX packet size.
+ * @param[in] rx_size Link Layer RX packet size.
+ * @param[in] tx_count Link Layer TX packet count.
+ * @param[in] rx_count Link Layer RX packet count.
+ */
+#define BLE_CONTROLLER_MEM_LINKS(master_count, slave_count, tx_size, rx_size, tx_count, rx_count) \
+    ((master_count) * BLE_CONTROLLER_MEM_PER_MASTER_LINK(tx_size, rx_size, tx_count, rx_count) + \
+     ((master_count) > 0 ? BLE_CONTROLLER_MEM_MASTER_LINKS_SHARED : 0) + \
+     (slave_count) * BLE_CONTROLLER_MEM_PER_SLAVE_LINK(tx_size, rx_size, tx_count, rx_count) + \
+     ((slave_count) > 0 ? BLE_CONTROLLER_MEM_SLAVE_LINKS_SHARED : 0))
+
 /** @} end of ble_controller_mem_defines */
 
 /** @brief    Function prototype for the fault handler.
@@ -0,0 +1,65 @@
+/**
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+/**@file
+ * @defgroup nrf_cc310_bl_hash_sha256_flash nrf_cc310_bl Hash SHA-256 from flash
+ * @ingroup nrf_cc310_bl_hash_sha256
+ * @{
+ * @brief SHA-256 update for data in memory-mapped flash.
+ *
+ * @details The CC310 DMA can only read RAM, so data in flash has to be
+ *          copied before @ref nrf_cc310_bl_hash_sha256_update is called.
+ *          @ref nrf_cc310_bl_hash_sha256_update_flash does the copy through
+ *          a caller-provided RAM buffer, in chunks of the full buffer size,
+ *          so that an image is hashed with as few hardware operations as
+ *          the buffer allows. Data that is already in RAM is passed to the
+ *          hash engine directly.
+ */
+#ifndef NRF_CC310_BL_HASH_SHA256_FLASH_H__
+#define NRF_CC310_BL_HASH_SHA256_FLASH_H__
+
+#include <stdint.h>
+#include "nrf_cc310_bl_hash_sha256.h"
+#include "crys_error.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef CRYS_HASH_DATA_IN_POINTER_INVALID_ERROR
+/**@brief Error code of the CRYS hash module for an invalid data pointer. */
+#define CRYS_HASH_DATA_IN_POINTER_INVALID_ERROR (CRYS_HASH_MODULE_ERROR_BASE + 0x3UL)
+#endif
+
+/**@brief Function for running an update to the SHA-256 hash calculation
+ *        with data in any readable memory.
+ *
+ * @param[in,out]   p_hash_context  Structure holding context information
+ *                                  for the SHA-256 operation.
+ * @param[in]       p_src           Data to hash, in RAM or memory-mapped flash.
+ * @param[in]       len             Length of @p p_src.
+ * @param[in]       p_buf           RAM buffer used to copy data that is not in RAM.
+ *                                  Larger buffers need fewer hardware operations.
+ * @param[in]       buf_len         Length of @p p_buf. Must not be 0 if
+ *                                  @p p_src is not in RAM.
+ *
+ * @retval CRYS_OK If call was successful.
+ * @retval CRYS_HASH_DATA_IN_POINTER_INVALID_ERROR          No buffer was given for data in flash.
+ * @return Any other error code returned from @ref nrf_cc310_bl_hash_sha256_update.
+ */
+CRYSError_t nrf_cc310_bl_hash_sha256_update_flash(
+    nrf_cc310_bl_hash_context_sha256_t  * const p_hash_context,
+    uint8_t                             const * p_src,
+    uint32_t                                    len,
+    uint8_t                                   * p_buf,
+    uint32_t                                    buf_len);
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} */
+
+#endif // NRF_CC310_BL_HASH_SHA256_FLASH_H__
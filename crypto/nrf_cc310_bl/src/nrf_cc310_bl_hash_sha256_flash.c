@@ -0,0 +1,60 @@
+/**
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+#include <stdint.h>
+#include <string.h>
+
+#include "nrf_cc310_bl_hash_sha256_flash.h"
+
+#define SRAM_START ((uintptr_t)CONFIG_SRAM_BASE_ADDRESS)
+#define SRAM_END   (SRAM_START + (uintptr_t)CONFIG_SRAM_SIZE * 1024)
+
+/** @brief Static function to check if data can be read by the CC310 DMA
+ */
+static int is_in_sram(uint8_t const * p_src, uint32_t len)
+{
+    uintptr_t start = (uintptr_t)p_src;
+
+    return start >= SRAM_START && start <= SRAM_END &&
+           len <= SRAM_END - start;
+}
+
+CRYSError_t nrf_cc310_bl_hash_sha256_update_flash(
+    nrf_cc310_bl_hash_context_sha256_t  * const p_hash_context,
+    uint8_t                             const * p_src,
+    uint32_t                                    len,
+    uint8_t                                   * p_buf,
+    uint32_t                                    buf_len)
+{
+    CRYSError_t ret;
+    uint32_t chunk;
+
+    if (is_in_sram(p_src, len))
+    {
+        return nrf_cc310_bl_hash_sha256_update(p_hash_context, p_src, len);
+    }
+
+    if (len > 0 && (p_buf == NULL || buf_len == 0))
+    {
+        return CRYS_HASH_DATA_IN_POINTER_INVALID_ERROR;
+    }
+
+    while (len > 0)
+    {
+        chunk = len < buf_len ? len : buf_len;
+        memcpy(p_buf, p_src, chunk);
+
+        ret = nrf_cc310_bl_hash_sha256_update(p_hash_context, p_buf, chunk);
+        if (ret != CRYS_OK)
+        {
+            return ret;
+        }
+
+        p_src += chunk;
+        len -= chunk;
+    }
+
+    return CRYS_OK;
+}
@@ -0,0 +1,212 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+
+/**@file
+ * @defgroup cc_ecies_stream ECIES streaming encryption
+ * @ingroup cc_ecies
+ * @{
+ * @brief Streaming ECIES payload encryption on top of the CryptoCell ECIES-KEM.
+ *
+ * A session runs @c mbedtls_ecies_kem_encrypt once and keeps the
+ * encapsulated secret. Each payload of the session is then encrypted with
+ * AES-128-CTR and authenticated with AES-128-CMAC over the cyphertext. The
+ * payload keys are derived with HKDF from the session secret and a 32-bit
+ * payload sequence number, so several payloads can be sent to the same
+ * recipient with a single ephemeral key.
+ *
+ * The payload is processed in chunks of any size through the update
+ * functions, without intermediate copies.
+ *
+ * @note Decryption releases plaintext before the tag has been checked.
+ *       The plaintext must not be used before
+ *       @c mbedtls_ecies_stream_decrypt_finish has succeeded.
+ */
+
+#ifndef MBEDTLS_CC_ECIES_STREAM_H
+#define MBEDTLS_CC_ECIES_STREAM_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "mbedtls_cc_ecies.h"
+#include "mbedtls/aes.h"
+#include "mbedtls/cipher.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/** @brief Size of the encapsulated session secret in bytes. */
+#define MBEDTLS_ECIES_STREAM_SECRET_BYTES   (32)
+
+/** @brief Size of the payload authentication tag in bytes. */
+#define MBEDTLS_ECIES_STREAM_TAG_BYTES      (16)
+
+/** @brief ECIES streaming session, shared by all payloads to one recipient. */
+typedef struct
+{
+    uint8_t secret[MBEDTLS_ECIES_STREAM_SECRET_BYTES];  //!< Encapsulated secret.
+    mbedtls_hkdf_hashmode_t hash_mode;                  //!< Hash used by the KEM and for key derivation.
+    uint32_t next_seq;                                  //!< Sequence number of the next encrypted payload.
+} mbedtls_ecies_stream_session;
+
+/** @brief ECIES streaming context for one payload. */
+typedef struct
+{
+    mbedtls_aes_context aes;                            //!< AES-CTR encryption key.
+    mbedtls_cipher_context_t cmac;                      //!< AES-CMAC of the cyphertext.
+    uint8_t nonce_counter[16];                          //!< CTR counter block.
+    uint8_t stream_block[16];                           //!< CTR key stream block.
+    size_t nc_off;                                      //!< Used bytes of @c stream_block.
+} mbedtls_ecies_stream_context;
+
+
+/**@brief Create a sending session.
+ *
+ * A fresh ephemeral key is generated and the session secret is encapsulated
+ * for the recipient with ECIES-KEM (KDF2, not single hash mode).
+ *
+ * @param[out]    session          Session to create.
+ * @param[in]     grp              The ECP group to use.
+ * @param[in]     recip_pub        Public key of the recipient.
+ * @param[in]     hash_mode        Hash used by the KEM and for the payload key derivation.
+ * @param[out]    cipher_data      Encapsulated secret to send to the recipient.
+ * @param[in,out] cipher_data_size In: size of @p cipher_data, out: used size.
+ * @param[in]     buf              Temporary buffer of at least
+ *                                 @c MBEDTLS_ECIES_MIN_BUFF_LEN_BYTES bytes.
+ * @param[in]     buf_len          Size of @p buf.
+ * @param[in]     f_rng            RNG function.
+ * @param[in]     p_rng            RNG parameter.
+ *
+ * @retval 0 On success.
+ * @return The error of @c mbedtls_ecies_kem_encrypt otherwise.
+ */
+int mbedtls_ecies_stream_session_create(
+    mbedtls_ecies_stream_session *session,
+    mbedtls_ecp_group *grp, mbedtls_ecp_point *recip_pub,
+    mbedtls_hkdf_hashmode_t hash_mode,
+    uint8_t *cipher_data, size_t *cipher_data_size,
+    void *buf, size_t buf_len,
+    int (*f_rng)(void *, unsigned char *, size_t), void *p_rng);
+
+/**@brief Open a receiving session.
+ *
+ * @param[out] session          Session to open.
+ * @param[in]  grp              The ECP group to use.
+ * @param[in]  recip_priv       Private key of the recipient.
+ * @param[in]  hash_mode        Hash used by the sender.
+ * @param[in]  cipher_data      Encapsulated secret from the sender.
+ * @param[in]  cipher_data_size Size of @p cipher_data.
+ * @param[in]  buf              Temporary buffer of at least
+ *                              @c MBEDTLS_ECIES_MIN_BUFF_LEN_BYTES bytes.
+ * @param[in]  buf_len          Size of @p buf.
+ *
+ * @retval 0 On success.
+ * @return The error of @c mbedtls_ecies_kem_decrypt otherwise.
+ */
+int mbedtls_ecies_stream_session_open(
+    mbedtls_ecies_stream_session *session,
+    mbedtls_ecp_group *grp, mbedtls_mpi *recip_priv,
+    mbedtls_hkdf_hashmode_t hash_mode,
+    uint8_t *cipher_data, size_t cipher_data_size,
+    void *buf, size_t buf_len);
+
+/**@brief Clear a session.
+ *
+ * @param[in,out] session Session to clear.
+ */
+void mbedtls_ecies_stream_session_free(mbedtls_ecies_stream_session *session);
+
+/**@brief Start encryption of the next payload of a session.
+ *
+ * @param[out] ctx     Payload context.
+ * @param[in]  session Sending session.
+ * @param[out] seq     Sequence number of the payload, to send along with the payload.
+ *
+ * @retval 0 On success.
+ * @retval MBEDTLS_ERR_CIPHER_BAD_INPUT_DATA If all sequence numbers are used.
+ * @return An error of the key derivation or cipher setup otherwise.
+ */
+int mbedtls_ecies_stream_encrypt_start(
+    mbedtls_ecies_stream_context *ctx,
+    mbedtls_ecies_stream_session *session, uint32_t *seq);
+
+/**@brief Start decryption of a payload of a session.
+ *
+ * @param[out] ctx     Payload context.
+ * @param[in]  session Receiving session.
+ * @param[in]  seq     Sequence number of the payload.
+ *
+ * @retval 0 On success.
+ * @return An error of the key derivation or cipher setup otherwise.
+ */
+int mbedtls_ecies_stream_decrypt_start(
+    mbedtls_ecies_stream_context *ctx,
+    const mbedtls_ecies_stream_session *session, uint32_t seq);
+
+/**@brief Encrypt a chunk of a payload.
+ *
+ * @param[in,out] ctx    Payload context.
+ * @param[in]     input  Plaintext chunk.
+ * @param[out]    output Cyphertext chunk. May be equal to @p input.
+ * @param[in]     len    Length of the chunk.
+ *
+ * @retval 0 On success.
+ */
+int mbedtls_ecies_stream_encrypt_update(
+    mbedtls_ecies_stream_context *ctx,
+    const uint8_t *input, uint8_t *output, size_t len);
+
+/**@brief Decrypt a chunk of a payload.
+ *
+ * @param[in,out] ctx    Payload context.
+ * @param[in]     input  Cyphertext chunk.
+ * @param[out]    output Plaintext chunk. May be equal to @p input.
+ * @param[in]     len    Length of the chunk.
+ *
+ * @retval 0 On success.
+ */
+int mbedtls_ecies_stream_decrypt_update(
+    mbedtls_ecies_stream_context *ctx,
+    const uint8_t *input, uint8_t *output, size_t len);
+
+/**@brief Finish encryption of a payload.
+ *
+ * @param[in,out] ctx Payload context, freed by this function.
+ * @param[out]    tag Authentication tag of the payload.
+ *
+ * @retval 0 On success.
+ */
+int mbedtls_ecies_stream_encrypt_finish(
+    mbedtls_ecies_stream_context *ctx,
+    uint8_t tag[MBEDTLS_ECIES_STREAM_TAG_BYTES]);
+
+/**@brief Finish decryption of a payload.
+ *
+ * @param[in,out] ctx Payload context, freed by this function.
+ * @param[in]     tag Received authentication tag.
+ *
+ * @retval 0 If the payload is authentic.
+ * @retval MBEDTLS_ERR_CIPHER_AUTH_FAILED If the tag does not match.
+ */
+int mbedtls_ecies_stream_decrypt_finish(
+    mbedtls_ecies_stream_context *ctx,
+    const uint8_t tag[MBEDTLS_ECIES_STREAM_TAG_BYTES]);
+
+/**@brief Free a payload context without finishing it.
+ *
+ * @param[in,out] ctx Payload context.
+ */
+void mbedtls_ecies_stream_free(mbedtls_ecies_stream_context *ctx);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MBEDTLS_CC_ECIES_STREAM_H */
+
+/** @} */
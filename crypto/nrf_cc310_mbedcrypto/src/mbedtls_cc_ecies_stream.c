@@ -0,0 +1,236 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "mbedtls/aes.h"
+#include "mbedtls/cipher.h"
+#include "mbedtls/cmac.h"
+#include "mbedtls/platform_util.h"
+#include "mbedtls_extra/mbedtls_cc_ecies_stream.h"
+
+#define ECIES_STREAM_KEY_BYTES  (16)
+
+static const uint8_t ecies_stream_label[] = "ECIES stream";
+
+/** @brief Derive the CTR and CMAC keys of payload @p seq.
+ */
+static int ecies_stream_start(mbedtls_ecies_stream_context *ctx,
+                              const mbedtls_ecies_stream_session *session, uint32_t seq)
+{
+    uint8_t info[sizeof(ecies_stream_label) - 1 + 4];
+    uint8_t keys[2 * ECIES_STREAM_KEY_BYTES];
+    int ret;
+
+    memcpy(info, ecies_stream_label, sizeof(ecies_stream_label) - 1);
+    info[sizeof(info) - 4] = (uint8_t)(seq >> 24);
+    info[sizeof(info) - 3] = (uint8_t)(seq >> 16);
+    info[sizeof(info) - 2] = (uint8_t)(seq >> 8);
+    info[sizeof(info) - 1] = (uint8_t)seq;
+
+    mbedtls_aes_init(&ctx->aes);
+    mbedtls_cipher_init(&ctx->cmac);
+    memset(ctx->nonce_counter, 0, sizeof(ctx->nonce_counter));
+    ctx->nc_off = 0;
+
+    /* The session secret is KDF output, so only the expand step is needed. */
+    ret = (int)mbedtls_hkdf_key_derivation(session->hash_mode, NULL, 0,
+                                           (uint8_t *)session->secret, sizeof(session->secret),
+                                           info, sizeof(info), keys, sizeof(keys), CC_TRUE);
+    if (ret != 0)
+    {
+        goto exit;
+    }
+
+    ret = mbedtls_aes_setkey_enc(&ctx->aes, keys, 8 * ECIES_STREAM_KEY_BYTES);
+    if (ret != 0)
+    {
+        goto exit;
+    }
+
+    ret = mbedtls_cipher_setup(&ctx->cmac, mbedtls_cipher_info_from_type(MBEDTLS_CIPHER_AES_128_ECB));
+    if (ret != 0)
+    {
+        goto exit;
+    }
+
+    ret = mbedtls_cipher_cmac_starts(&ctx->cmac, keys + ECIES_STREAM_KEY_BYTES, 8 * ECIES_STREAM_KEY_BYTES);
+
+exit:
+    mbedtls_platform_zeroize(keys, sizeof(keys));
+    if (ret != 0)
+    {
+        mbedtls_ecies_stream_free(ctx);
+    }
+
+    return ret;
+}
+
+int mbedtls_ecies_stream_session_create(
+    mbedtls_ecies_stream_session *session,
+    mbedtls_ecp_group *grp, mbedtls_ecp_point *recip_pub,
+    mbedtls_hkdf_hashmode_t hash_mode,
+    uint8_t *cipher_data, size_t *cipher_data_size,
+    void *buf, size_t buf_len,
+    int (*f_rng)(void *, unsigned char *, size_t), void *p_rng)
+{
+    int ret;
+
+    ret = (int)mbedtls_ecies_kem_encrypt(grp, recip_pub, CC_KDF_ISO18033_KDF2_DerivMode,
+                                         hash_mode, 0, session->secret, sizeof(session->secret),
+                                         cipher_data, cipher_data_size, buf, buf_len,
+                                         f_rng, p_rng);
+    if (ret != 0)
+    {
+        mbedtls_ecies_stream_session_free(session);
+        return ret;
+    }
+
+    session->hash_mode = hash_mode;
+    session->next_seq = 0;
+
+    return 0;
+}
+
+int mbedtls_ecies_stream_session_open(
+    mbedtls_ecies_stream_session *session,
+    mbedtls_ecp_group *grp, mbedtls_mpi *recip_priv,
+    mbedtls_hkdf_hashmode_t hash_mode,
+    uint8_t *cipher_data, size_t cipher_data_size,
+    void *buf, size_t buf_len)
+{
+    int ret;
+
+    ret = (int)mbedtls_ecies_kem_decrypt(grp, recip_priv, CC_KDF_ISO18033_KDF2_DerivMode,
+                                         hash_mode, 0, cipher_data, cipher_data_size,
+                                         session->secret, sizeof(session->secret),
+                                         buf, buf_len);
+    if (ret != 0)
+    {
+        mbedtls_ecies_stream_session_free(session);
+        return ret;
+    }
+
+    session->hash_mode = hash_mode;
+    session->next_seq = 0;
+
+    return 0;
+}
+
+void mbedtls_ecies_stream_session_free(mbedtls_ecies_stream_session *session)
+{
+    mbedtls_platform_zeroize(session, sizeof(*session));
+}
+
+int mbedtls_ecies_stream_encrypt_start(
+    mbedtls_ecies_stream_context *ctx,
+    mbedtls_ecies_stream_session *session, uint32_t *seq)
+{
+    int ret;
+
+    /* Payload keys must never be reused. */
+    if (session->next_seq == UINT32_MAX)
+    {
+        return MBEDTLS_ERR_CIPHER_BAD_INPUT_DATA;
+    }
+
+    ret = ecies_stream_start(ctx, session, session->next_seq);
+    if (ret != 0)
+    {
+        return ret;
+    }
+
+    *seq = session->next_seq++;
+
+    return 0;
+}
+
+int mbedtls_ecies_stream_decrypt_start(
+    mbedtls_ecies_stream_context *ctx,
+    const mbedtls_ecies_stream_session *session, uint32_t seq)
+{
+    return ecies_stream_start(ctx, session, seq);
+}
+
+int mbedtls_ecies_stream_encrypt_update(
+    mbedtls_ecies_stream_context *ctx,
+    const uint8_t *input, uint8_t *output, size_t len)
+{
+    int ret;
+
+    ret = mbedtls_aes_crypt_ctr(&ctx->aes, len, &ctx->nc_off, ctx->nonce_counter,
+                                ctx->stream_block, input, output);
+    if (ret != 0)
+    {
+        return ret;
+    }
+
+    return mbedtls_cipher_cmac_update(&ctx->cmac, output, len);
+}
+
+int mbedtls_ecies_stream_decrypt_update(
+    mbedtls_ecies_stream_context *ctx,
+    const uint8_t *input, uint8_t *output, size_t len)
+{
+    int ret;
+
+    /* Authenticate before decrypting, as the output may overwrite the input. */
+    ret = mbedtls_cipher_cmac_update(&ctx->cmac, input, len);
+    if (ret != 0)
+    {
+        return ret;
+    }
+
+    return mbedtls_aes_crypt_ctr(&ctx->aes, len, &ctx->nc_off, ctx->nonce_counter,
+                                 ctx->stream_block, input, output);
+}
+
+int mbedtls_ecies_stream_encrypt_finish(
+    mbedtls_ecies_stream_context *ctx,
+    uint8_t tag[MBEDTLS_ECIES_STREAM_TAG_BYTES])
+{
+    int ret;
+
+    ret = mbedtls_cipher_cmac_finish(&ctx->cmac, tag);
+    mbedtls_ecies_stream_free(ctx);
+
+    return ret;
+}
+
+int mbedtls_ecies_stream_decrypt_finish(
+    mbedtls_ecies_stream_context *ctx,
+    const uint8_t tag[MBEDTLS_ECIES_STREAM_TAG_BYTES])
+{
+    uint8_t t[MBEDTLS_ECIES_STREAM_TAG_BYTES];
+    uint8_t diff = 0;
+    int ret;
+    int i;
+
+    ret = mbedtls_cipher_cmac_finish(&ctx->cmac, t);
+    mbedtls_ecies_stream_free(ctx);
+    if (ret != 0)
+    {
+        return ret;
+    }
+
+    for (i = 0; i < MBEDTLS_ECIES_STREAM_TAG_BYTES; i++)
+    {
+        diff |= t[i] ^ tag[i];
+    }
+    mbedtls_platform_zeroize(t, sizeof(t));
+
+    return diff == 0 ? 0 : MBEDTLS_ERR_CIPHER_AUTH_FAILED;
+}
+
+void mbedtls_ecies_stream_free(mbedtls_ecies_stream_context *ctx)
+{
+    mbedtls_aes_free(&ctx->aes);
+    mbedtls_cipher_free(&ctx->cmac);
+    mbedtls_platform_zeroize(ctx->nonce_counter, sizeof(ctx->nonce_counter));
+    mbedtls_platform_zeroize(ctx->stream_block, sizeof(ctx->stream_block));
+    ctx->nc_off = 0;
+}
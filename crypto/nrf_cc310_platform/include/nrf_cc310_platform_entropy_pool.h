@@ -0,0 +1,61 @@
+/**
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+/**@file
+ * @defgroup nrf_cc310_platform_entropy_pool nrf_cc310_platform entropy pool APIs
+ * @ingroup nrf_cc310_platform
+ * @{
+ * @brief The nrf_cc310_platform_entropy_pool APIs serves entropy from a pool
+ *        that is refilled ahead of time from the Arm CC310 TRNG.
+ *
+ * @details TRNG sampling is slow compared to the consumers of entropy, e.g.
+ *          a CTR_DRBG reseed during a TLS handshake. A low priority thread
+ *          provided by the RTOS companion source-file keeps the pool filled
+ *          using @ref nrf_cc310_platform_entropy_get, so that requests can
+ *          be served with a copy. The pool state is protected by the
+ *          rng_mutex of the platform.
+ */
+#ifndef NRF_CC310_PLATFORM_ENTROPY_POOL_H__
+#define NRF_CC310_PLATFORM_ENTROPY_POOL_H__
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "nrf_cc310_platform_defines.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**@brief Function to get entropy from the pre-fetched entropy pool
+ *
+ * This API has the same contract as @ref nrf_cc310_platform_entropy_get.
+ * If the pool holds less than the requested length, the remainder is
+ * gathered directly from the TRNG. Every call that leaves the pool below
+ * half full wakes up the refill thread.
+ *
+ * @note This API is only usable if @ref nrf_cc310_platform_init was run
+ *       prior to calling it.
+ *
+ * @param[out]	buffer  Pointer to buffer to hold the entropy data.
+ * @param[in]	length  Length of the buffer to fill with entropy data.
+ * @param[out]	olen    Pointer to variable that will hold the length of
+ *                      generated entropy.
+ *
+ * @retval 0 on success
+ * @return Any other error code returned from @ref nrf_cc310_platform_entropy_get
+ */
+int nrf_cc310_platform_entropy_pool_get(uint8_t *buffer,
+                                        size_t length,
+                                        size_t* olen);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NRF_CC310_PLATFORM_ENTROPY_POOL_H__ */
+
+/** @} */
@@ -0,0 +1,90 @@
+/**
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+/**@file
+ * @defgroup nrf_cc310_platform_job nrf_cc310_platform asynchronous job APIs
+ * @ingroup nrf_cc310_platform
+ * @{
+ * @brief The nrf_cc310_platform_job APIs provides a queue for running
+ *        long CC310 operations, like RSA private key operations, without
+ *        blocking the calling thread.
+ *
+ * @details Jobs are executed one at a time, in submission order, in a
+ *          dedicated thread provided by the RTOS companion source-file.
+ *          Once a job has finished, its completion callback is called from
+ *          the same thread.
+ */
+#ifndef NRF_CC310_PLATFORM_JOB_H__
+#define NRF_CC310_PLATFORM_JOB_H__
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/** @brief Type definition of function pointer running a job
+ *
+ * The function is called from the job thread and may call any nrf_cc310_mbedcrypto
+ * API, e.g. @c mbedtls_rsa_private.
+ *
+ * @param[in,out] p_context     User context given in the job.
+ *
+ * @return Result of the job, passed on to the completion callback.
+ */
+typedef int (*nrf_cc310_platform_job_fn_t)(void * p_context);
+
+
+/** @brief Type definition of function pointer called when a job has finished
+ *
+ * @note The job structure may be reused or freed from within this callback.
+ *
+ * @param[in]     result        Return value of the job function.
+ * @param[in,out] p_context     User context given in the job.
+ */
+typedef void (*nrf_cc310_platform_job_done_fn_t)(int result, void * p_context);
+
+
+/** @brief Type definition of structure holding a job
+ *
+ * @note The structure must stay valid until the completion callback is called.
+ */
+typedef struct nrf_cc310_platform_job
+{
+    /* Reserved for the RTOS queue implementation. Must not be modified. */
+    void *                              reserved;
+
+    /* Function performing the CC310 operation. */
+    nrf_cc310_platform_job_fn_t         job_fn;
+
+    /* Function called when the job has finished. May be NULL. */
+    nrf_cc310_platform_job_done_fn_t    done_fn;
+
+    /* User context passed to job_fn and done_fn. */
+    void *                              p_context;
+} nrf_cc310_platform_job_t;
+
+
+/** @brief Function to submit a job to the nrf_cc310_platform job queue
+ *
+ * This function does not block. The job is queued and executed after all
+ * previously submitted jobs have finished.
+ *
+ * @param[in] job               Pointer to the job to submit.
+ *
+ * @retval NRF_CC310_PLATFORM_SUCCESS           The job was queued.
+ * @retval NRF_CC310_PLATFORM_ERROR_PARAM_NULL  The job or its job function is NULL.
+ */
+int nrf_cc310_platform_job_submit(nrf_cc310_platform_job_t * job);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NRF_CC310_PLATFORM_JOB_H__ */
+
+/** @} */
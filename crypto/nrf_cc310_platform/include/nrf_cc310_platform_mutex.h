@@ -15,6 +15,7 @@
 
 #include <stdint.h>
 #include <stddef.h>
+#include <stdbool.h>
 
 #include "nrf_cc310_platform_abort.h"
 
@@ -26,6 +27,7 @@ extern "C"
 #define NRF_CC310_PLATFORM_MUTEX_MASK_INVALID        (0)         /*!< Mask indicating that the mutex is invalid (not initialized or allocated). */
 #define NRF_CC310_PLATFORM_MUTEX_MASK_IS_VALID       (1<<0)      /*!< Mask value indicating that the mutex is valid for use. */
 #define NRF_CC310_PLATFORM_MUTEX_MASK_IS_ALLOCATED   (1<<1)      /*!< Mask value indicating that the mutex is allocated and requires deallocation once freed. */
+#define NRF_CC310_PLATFORM_MUTEX_MASK_IS_DEFERRED    (1<<2)      /*!< Mask value indicating that the allocation failed and is retried when the mutex is locked. */
 
 /** @brief Type definition of architecture neutral mutex type */
 typedef struct nrf_cc310_platform_mutex
@@ -149,6 +151,54 @@ void nrf_cc310_platform_set_mutexes(
  */
 void nrf_cc310_platform_mutex_init(void);
 
+
+/** @brief Function to check if a platform mutex is held by another thread
+ *
+ * This function does not block and is intended for dispatch decisions, e.g.
+ * selecting a software implementation while the hardware is in use.
+ *
+ * @note The result is advisory. The mutex may be taken or released by
+ *       another thread right after this function returns.
+ *
+ * @param[in] mutex             Pointer to a platform mutex, e.g.
+ *                              platform_mutexes.sym_mutex.
+ *
+ * @return true if the mutex is held by another thread, otherwise false.
+ */
+bool nrf_cc310_platform_mutex_is_busy(void const * mutex);
+
+
+/** @brief Type definition of usage counters for the dynamic mutex pool */
+typedef struct nrf_cc310_platform_mutex_pool_stats
+{
+    uint32_t    size;       /*!< Number of mutexes in the pool. */
+    uint32_t    used;       /*!< Number of mutexes currently allocated. */
+    uint32_t    max_used;   /*!< Highest number of mutexes allocated at the same time. */
+} nrf_cc310_platform_mutex_pool_stats_t;
+
+
+/** @brief Function to read the usage counters of the dynamic mutex pool
+ *
+ * The pool holds the mutexes created through @ref nrf_cc310_platform_mutex_init_fn_t,
+ * e.g. by mbed TLS threading. The statically defined platform mutexes are not
+ * counted. Use max_used to size the pool for the application.
+ *
+ * @param[out] p_stats          Pointer to the structure to fill.
+ */
+void nrf_cc310_platform_mutex_pool_stats_get(nrf_cc310_platform_mutex_pool_stats_t * p_stats);
+
+
+/** @brief Function called after a lock has waited for a contended mutex
+ *
+ * Only called with CONFIG_NRF_CC310_PLATFORM_MUTEX_TRACE. An uncontended
+ * lock is not reported. The function is not provided by nrf_cc310_platform
+ * and must be implemented by the application or a tracing layer.
+ *
+ * @param[in] mutex             Pointer to the platform mutex that was locked.
+ * @param[in] cycles            Time spent waiting, in hardware clock cycles.
+ */
+void nrf_cc310_platform_mutex_trace_wait(void const * mutex, uint32_t cycles);
+
 #ifdef __cplusplus
 }
 #endif
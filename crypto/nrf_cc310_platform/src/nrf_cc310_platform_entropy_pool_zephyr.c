@@ -0,0 +1,197 @@
+/**
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#include <zephyr.h>
+#include <kernel.h>
+
+#include "nrf_cc310_platform.h"
+#include "nrf_cc310_platform_defines.h"
+#include "nrf_cc310_platform_mutex.h"
+#include "nrf_cc310_platform_entropy.h"
+#include "nrf_cc310_platform_entropy_pool.h"
+
+#define POOL_SIZE CONFIG_NRF_CC310_PLATFORM_ENTROPY_POOL_SIZE
+
+/** @brief Ring buffer holding the pre-fetched entropy
+ */
+static uint8_t pool[POOL_SIZE];
+
+/** @brief Index of the oldest byte in the pool
+ */
+static size_t pool_head;
+
+/** @brief Number of bytes available in the pool
+ */
+static size_t pool_count;
+
+/** @brief Semaphore waking up the refill thread
+ */
+K_SEM_DEFINE(pool_refill_sem, 1, 1);
+
+/** @brief Static function to lock the pool using the platform rng mutex
+ */
+static int pool_lock(void) {
+    return platform_mutex_apis.mutex_lock_fn(platform_mutexes.rng_mutex);
+}
+
+/** @brief Static function to unlock the pool
+ */
+static void pool_unlock(void) {
+    (void)platform_mutex_apis.mutex_unlock_fn(platform_mutexes.rng_mutex);
+}
+
+/** @brief Static function to add entropy to the pool
+ *
+ * @note Must be called with the pool locked.
+ *
+ * @return Number of bytes added.
+ */
+static size_t pool_put(uint8_t const * data, size_t length) {
+    size_t tail;
+    size_t i;
+
+    if (length > POOL_SIZE - pool_count) {
+        length = POOL_SIZE - pool_count;
+    }
+
+    tail = (pool_head + pool_count) % POOL_SIZE;
+
+    for (i = 0; i < length; i++) {
+        pool[tail] = data[i];
+        tail = (tail + 1) % POOL_SIZE;
+    }
+
+    pool_count += length;
+
+    return length;
+}
+
+/** @brief Static function to take entropy out of the pool
+ *
+ * The bytes are cleared from the pool once copied.
+ *
+ * @note Must be called with the pool locked.
+ *
+ * @return Number of bytes copied.
+ */
+static size_t pool_take(uint8_t * buffer, size_t length) {
+    size_t i;
+
+    if (length > pool_count) {
+        length = pool_count;
+    }
+
+    for (i = 0; i < length; i++) {
+        buffer[i] = pool[pool_head];
+        pool[pool_head] = 0;
+        pool_head = (pool_head + 1) % POOL_SIZE;
+    }
+
+    pool_count -= length;
+
+    return length;
+}
+
+/** @brief Thread refilling the pool
+ *
+ * The TRNG is sampled without holding the pool lock, so that consumers are
+ * only blocked while bytes are copied in or out of the pool.
+ */
+static void pool_refill_thread(void *p1, void *p2, void *p3) {
+    uint8_t chunk[NRF_CC310_PLATFORM_ENTROPY_MAX_GATHER];
+    size_t olen;
+    size_t added;
+    int ret;
+
+    ARG_UNUSED(p1);
+    ARG_UNUSED(p2);
+    ARG_UNUSED(p3);
+
+    while (1) {
+        k_sem_take(&pool_refill_sem, K_FOREVER);
+
+        while (nrf_cc310_platform_rng_is_initialized()) {
+            olen = 0;
+            ret = nrf_cc310_platform_entropy_get(chunk, sizeof(chunk), &olen);
+            if (ret != 0 || olen == 0) {
+                break;
+            }
+
+            if (pool_lock() != NRF_CC310_PLATFORM_SUCCESS) {
+                break;
+            }
+            added = pool_put(chunk, olen);
+            pool_unlock();
+
+            if (added < olen) {
+                /* The pool is full */
+                break;
+            }
+        }
+
+        memset(chunk, 0, sizeof(chunk));
+    }
+}
+
+K_THREAD_DEFINE(nrf_cc310_platform_entropy_pool_thread,
+                CONFIG_NRF_CC310_PLATFORM_ENTROPY_POOL_STACK_SIZE,
+                pool_refill_thread, NULL, NULL, NULL,
+                CONFIG_NRF_CC310_PLATFORM_ENTROPY_POOL_THREAD_PRIORITY, 0,
+                K_NO_WAIT);
+
+/** @brief Function to get entropy from the pre-fetched entropy pool
+ */
+int nrf_cc310_platform_entropy_pool_get(uint8_t *buffer,
+                                        size_t length,
+                                        size_t* olen) {
+    size_t taken;
+    size_t remaining;
+    size_t direct_olen;
+    int ret;
+
+    if (buffer == NULL || olen == NULL) {
+        return NRF_CC310_PLATFORM_ERROR_PARAM_NULL;
+    }
+
+    *olen = 0;
+
+    ret = pool_lock();
+    if (ret != NRF_CC310_PLATFORM_SUCCESS) {
+        return ret;
+    }
+
+    taken = pool_take(buffer, length);
+    remaining = pool_count;
+    pool_unlock();
+
+    if (remaining < POOL_SIZE / 2) {
+        k_sem_give(&pool_refill_sem);
+    }
+
+    /* Gather the shortfall directly */
+    while (taken < length) {
+        direct_olen = 0;
+        ret = nrf_cc310_platform_entropy_get(&buffer[taken],
+                                             MIN(length - taken,
+                                                 NRF_CC310_PLATFORM_ENTROPY_MAX_GATHER),
+                                             &direct_olen);
+        if (ret != 0) {
+            return ret;
+        }
+
+        if (direct_olen == 0) {
+            break;
+        }
+        taken += direct_olen;
+    }
+
+    *olen = taken;
+
+    return NRF_CC310_PLATFORM_SUCCESS;
+}
@@ -0,0 +1,60 @@
+/**
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+#include <stdint.h>
+#include <stddef.h>
+
+#include <zephyr.h>
+#include <kernel.h>
+
+#include "nrf_cc310_platform_defines.h"
+#include "nrf_cc310_platform_job.h"
+
+/** @brief Queue of jobs waiting to be executed
+ */
+K_FIFO_DEFINE(job_fifo);
+
+/** @brief Thread executing the queued jobs one at a time
+ */
+static void job_thread(void *p1, void *p2, void *p3)
+{
+    nrf_cc310_platform_job_t * job;
+    int result;
+
+    ARG_UNUSED(p1);
+    ARG_UNUSED(p2);
+    ARG_UNUSED(p3);
+
+    while (1) {
+        job = k_fifo_get(&job_fifo, K_FOREVER);
+        if (job == NULL) {
+            continue;
+        }
+
+        result = job->job_fn(job->p_context);
+
+        if (job->done_fn != NULL) {
+            job->done_fn(result, job->p_context);
+        }
+    }
+}
+
+K_THREAD_DEFINE(nrf_cc310_platform_job_thread,
+                CONFIG_NRF_CC310_PLATFORM_JOB_STACK_SIZE,
+                job_thread, NULL, NULL, NULL,
+                CONFIG_NRF_CC310_PLATFORM_JOB_THREAD_PRIORITY, 0, K_NO_WAIT);
+
+/** @brief Function to submit a job to the nrf_cc310_platform job queue
+ */
+int nrf_cc310_platform_job_submit(nrf_cc310_platform_job_t * job)
+{
+    if (job == NULL || job->job_fn == NULL) {
+        return NRF_CC310_PLATFORM_ERROR_PARAM_NULL;
+    }
+
+    k_fifo_put(&job_fifo, job);
+
+    return NRF_CC310_PLATFORM_SUCCESS;
+}
@@ -0,0 +1,417 @@
+/**
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <errno.h>
+
+#include <zephyr.h>
+#include <kernel.h>
+
+#include "nrf_cc310_platform_defines.h"
+#include "nrf_cc310_platform_mutex.h"
+#include "nrf_cc310_platform_abort.h"
+
+/** @brief External reference to the platforms abort APIs
+ *  	   This is used in case the mutex functions don't
+ * 		   provide return values in their APIs.
+ */
+extern nrf_cc310_platform_abort_apis_t platform_abort_apis;
+
+/** @brief Type definition of a lightweight recursive mutex
+ *
+ * The owner is the thread holding the mutex, or 0 if the mutex is free.
+ * The count is only accessed by the owner.
+ */
+typedef struct atomic_mutex
+{
+    atomic_t owner;
+    uint32_t count;
+} atomic_mutex_t;
+
+/** @brief Definition of mutex for symmetric cryptography
+ */
+static atomic_mutex_t sym_mutex_int;
+
+/** @brief Definition of mutex for asymmetric cryptography
+ */
+static atomic_mutex_t asym_mutex_int;
+
+/** @brief Definition of mutex for random number generation
+*/
+static atomic_mutex_t rng_mutex_int;
+
+/** @brief Definition of mutex for power mode changes
+*/
+static atomic_mutex_t power_mutex_int;
+
+/** @brief Number of dynamically allocated mutexes the system supports
+ */
+#define NUM_MUTEXES CONFIG_NRF_CC310_PLATFORM_MUTEX_POOL_SIZE
+
+#if NUM_MUTEXES > 0
+/** @brief Definition of the mutex slab and its buffer
+ */
+K_MEM_SLAB_DEFINE(mutex_slab, sizeof(atomic_mutex_t), NUM_MUTEXES, 4);
+#endif
+
+/** @brief Highest number of mutexes allocated from the slab at one time
+ */
+static uint32_t mutex_pool_max_used;
+
+/**@brief Definition of RTOS-independent symmetric cryptography mutex
+ * with NRF_CC310_PLATFORM_MUTEX_MASK_IS_VALID set to indicate that
+ * allocation is unneccesary
+*/
+nrf_cc310_platform_mutex_t sym_mutex =
+{
+    .mutex = &sym_mutex_int,
+    .flags = NRF_CC310_PLATFORM_MUTEX_MASK_IS_VALID
+};
+
+
+/**@brief Definition of RTOS-independent asymmetric cryptography mutex
+ * with NRF_CC310_PLATFORM_MUTEX_MASK_IS_VALID set to indicate that
+ * allocation is unneccesary
+*/
+nrf_cc310_platform_mutex_t asym_mutex =
+{
+    .mutex = &asym_mutex_int,
+    .flags = NRF_CC310_PLATFORM_MUTEX_MASK_IS_VALID
+};
+
+
+/**@brief Definition of RTOS-independent random number generation mutex
+ * with NRF_CC310_PLATFORM_MUTEX_MASK_IS_VALID set to indicate that
+ * allocation is unneccesary
+*/
+nrf_cc310_platform_mutex_t rng_mutex =
+{
+    .mutex = &rng_mutex_int,
+    .flags = NRF_CC310_PLATFORM_MUTEX_MASK_IS_VALID
+};
+
+
+/**@brief Definition of RTOS-independent power management mutex
+ * with NRF_CC310_PLATFORM_MUTEX_MASK_IS_VALID set to indicate that
+ * allocation is unneccesary
+*/
+nrf_cc310_platform_mutex_t power_mutex =
+{
+    .mutex = &power_mutex_int,
+    .flags = NRF_CC310_PLATFORM_MUTEX_MASK_IS_VALID
+};
+
+
+/** @brief Static function to allocate a mutex from the slab
+ *
+ * The slab is not waited on during mutex_init. An exhausted pool is a
+ * configuration error there and waiting could block the calling thread
+ * forever. A deferred allocation waits for at most
+ * CONFIG_NRF_CC310_PLATFORM_MUTEX_POOL_RETRY_TIMEOUT ms.
+ */
+static int mutex_pool_alloc(void ** pp_mutex, bool wait) {
+#if NUM_MUTEXES > 0
+    int ret;
+    uint32_t used;
+    unsigned int key;
+
+#if defined(CONFIG_NRF_CC310_PLATFORM_MUTEX_POOL_RECOVERABLE)
+    ret = k_mem_slab_alloc(&mutex_slab, pp_mutex,
+        wait ? K_MSEC(CONFIG_NRF_CC310_PLATFORM_MUTEX_POOL_RETRY_TIMEOUT) : K_NO_WAIT);
+#else
+    ARG_UNUSED(wait);
+    ret = k_mem_slab_alloc(&mutex_slab, pp_mutex, K_NO_WAIT);
+#endif
+    if (ret != 0) {
+        return ret;
+    }
+
+    key = irq_lock();
+    used = k_mem_slab_num_used_get(&mutex_slab);
+    if (used > mutex_pool_max_used) {
+        mutex_pool_max_used = used;
+    }
+    irq_unlock(key);
+
+    return 0;
+#else
+    ARG_UNUSED(wait);
+    *pp_mutex = NULL;
+    return -ENOMEM;
+#endif
+}
+
+
+/** @brief Static function to return a mutex to the slab
+ */
+static void mutex_pool_free(void ** pp_mutex) {
+#if NUM_MUTEXES > 0
+    k_mem_slab_free(&mutex_slab, pp_mutex);
+#endif
+    *pp_mutex = NULL;
+}
+
+
+#if defined(CONFIG_NRF_CC310_PLATFORM_MUTEX_POOL_RECOVERABLE)
+/** @brief Definition of mutex serializing deferred allocations
+ */
+K_MUTEX_DEFINE(mutex_pool_lock);
+
+/** @brief Static function to retry the allocation of a deferred mutex
+ */
+static int mutex_alloc_deferred(nrf_cc310_platform_mutex_t *mutex) {
+    int ret = 0;
+
+    k_mutex_lock(&mutex_pool_lock, K_FOREVER);
+
+    /* Another thread may have completed the allocation */
+    if (mutex->flags == NRF_CC310_PLATFORM_MUTEX_MASK_IS_DEFERRED) {
+        ret = mutex_pool_alloc(&mutex->mutex, true);
+        if (ret == 0) {
+            memset(mutex->mutex, 0, sizeof(atomic_mutex_t));
+            mutex->flags = NRF_CC310_PLATFORM_MUTEX_MASK_IS_ALLOCATED |
+                           NRF_CC310_PLATFORM_MUTEX_MASK_IS_VALID;
+        }
+    }
+
+    k_mutex_unlock(&mutex_pool_lock);
+
+    return ret;
+}
+#endif
+
+
+/**@brief static function to initialize a mutex
+ */
+static void mutex_init(nrf_cc310_platform_mutex_t *mutex) {
+    int ret;
+
+    /* Ensure that the mutex is valid (not NULL) */
+    if (mutex == NULL) {
+        platform_abort_apis.abort_fn(
+            "mutex_init called with NULL parameter");
+    }
+
+    /* Allocate if this has not been initialized statically */
+    if ((mutex->flags & NRF_CC310_PLATFORM_MUTEX_MASK_IS_VALID) == 0 &&
+        mutex->mutex == NULL) {
+        ret = mutex_pool_alloc(&mutex->mutex, false);
+        if(ret != 0 || mutex->mutex == NULL)
+        {
+#if defined(CONFIG_NRF_CC310_PLATFORM_MUTEX_POOL_RECOVERABLE)
+            /* Retry the allocation when the mutex is locked */
+            mutex->mutex = NULL;
+            mutex->flags = NRF_CC310_PLATFORM_MUTEX_MASK_IS_DEFERRED;
+            return;
+#else
+            /* Allocation failed. Abort all operations */
+            platform_abort_apis.abort_fn(
+                "Could not allocate mutex before initializing, "
+                "increase CONFIG_NRF_CC310_PLATFORM_MUTEX_POOL_SIZE");
+#endif
+        }
+
+        /** Set a flag to ensure that mutex is deallocated by the freeing
+         * operation
+         */
+        mutex->flags |= NRF_CC310_PLATFORM_MUTEX_MASK_IS_ALLOCATED;
+    }
+
+    memset(mutex->mutex, 0, sizeof(atomic_mutex_t));
+
+    /* Set the mask to indicate that the mutex is valid */
+    mutex->flags |= NRF_CC310_PLATFORM_MUTEX_MASK_IS_VALID;
+}
+
+
+/** @brief Static function to free a mutex
+ */
+static void mutex_free(nrf_cc310_platform_mutex_t *mutex) {
+    /* Ensure that the mutex is valid (not NULL) */
+    if (mutex == NULL) {
+        platform_abort_apis.abort_fn(
+            "mutex_free called with NULL parameter");
+    }
+
+    /* Check if we are freeing a mutex that isn't initialized or allocated */
+    if ((mutex->flags & NRF_CC310_PLATFORM_MUTEX_MASK_IS_VALID) == 0) {
+        /*Nothing to free*/
+        mutex->flags = NRF_CC310_PLATFORM_MUTEX_MASK_INVALID;
+        return;
+    }
+
+    /* Check if the mutex was allocated or being statically defined */
+    if ((mutex->flags & NRF_CC310_PLATFORM_MUTEX_MASK_IS_ALLOCATED) != 0) {
+        mutex_pool_free(&mutex->mutex);
+    }
+    else {
+        memset(mutex->mutex, 0, sizeof(atomic_mutex_t));
+    }
+
+    /* Reset the mutex to invalid state */
+    mutex->flags = NRF_CC310_PLATFORM_MUTEX_MASK_INVALID;
+}
+
+
+/** @brief Static function to lock a mutex
+ *
+ * The uncontended case is a single compare-and-swap. On contention the
+ * calling thread spins for a number of attempts before sleeping, so that
+ * a lower priority owner gets to run and release the mutex.
+ */
+static int32_t mutex_lock(nrf_cc310_platform_mutex_t *mutex) {
+    atomic_mutex_t * p_mutex;
+    atomic_val_t self;
+    uint32_t spins = 0;
+
+    /* Ensure that the mutex param is valid (not NULL) */
+    if(mutex == NULL) {
+        return NRF_CC310_PLATFORM_ERROR_PARAM_NULL;
+    }
+
+    /* Ensure that the mutex has been initialized */
+    if (mutex->flags == NRF_CC310_PLATFORM_MUTEX_MASK_INVALID) {
+        return NRF_CC310_PLATFORM_ERROR_MUTEX_NOT_INITIALIZED;
+    }
+
+#if defined(CONFIG_NRF_CC310_PLATFORM_MUTEX_POOL_RECOVERABLE)
+    /* Report an exhausted pool as a lock failure instead of aborting */
+    if (mutex->flags == NRF_CC310_PLATFORM_MUTEX_MASK_IS_DEFERRED &&
+        mutex_alloc_deferred(mutex) != 0) {
+        return NRF_CC310_PLATFORM_ERROR_MUTEX_FAILED;
+    }
+#endif
+
+    p_mutex = (atomic_mutex_t *)mutex->mutex;
+    self = (atomic_val_t)k_current_get();
+
+    if (atomic_get(&p_mutex->owner) == self) {
+        p_mutex->count++;
+        return NRF_CC310_PLATFORM_SUCCESS;
+    }
+
+#if defined(CONFIG_NRF_CC310_PLATFORM_MUTEX_TRACE)
+    /* Only a contended lock is timed and reported */
+    if (!atomic_cas(&p_mutex->owner, 0, self)) {
+        uint32_t start = k_cycle_get_32();
+
+        while (!atomic_cas(&p_mutex->owner, 0, self)) {
+            if (++spins >= CONFIG_NRF_CC310_PLATFORM_MUTEX_ATOMIC_SPIN_COUNT) {
+                k_sleep(K_MSEC(1));
+                spins = 0;
+            }
+        }
+
+        nrf_cc310_platform_mutex_trace_wait(mutex, k_cycle_get_32() - start);
+    }
+#else
+    while (!atomic_cas(&p_mutex->owner, 0, self)) {
+        if (++spins >= CONFIG_NRF_CC310_PLATFORM_MUTEX_ATOMIC_SPIN_COUNT) {
+            k_sleep(K_MSEC(1));
+            spins = 0;
+        }
+    }
+#endif
+
+    p_mutex->count = 1;
+    return NRF_CC310_PLATFORM_SUCCESS;
+}
+
+
+/** @brief Static function to unlock a mutex
+ */
+static int32_t mutex_unlock(nrf_cc310_platform_mutex_t *mutex) {
+    atomic_mutex_t * p_mutex;
+
+    /* Ensure that the mutex param is valid (not NULL) */
+    if(mutex == NULL) {
+        return NRF_CC310_PLATFORM_ERROR_PARAM_NULL;
+    }
+
+    /* Ensure that the mutex has been initialized */
+    if ((mutex->flags & NRF_CC310_PLATFORM_MUTEX_MASK_IS_VALID) == 0) {
+        return NRF_CC310_PLATFORM_ERROR_MUTEX_NOT_INITIALIZED;
+    }
+
+    p_mutex = (atomic_mutex_t *)mutex->mutex;
+
+    if (atomic_get(&p_mutex->owner) != (atomic_val_t)k_current_get()) {
+        return NRF_CC310_PLATFORM_ERROR_MUTEX_FAILED;
+    }
+
+    if (--p_mutex->count == 0) {
+        atomic_clear(&p_mutex->owner);
+    }
+
+    return NRF_CC310_PLATFORM_SUCCESS;
+}
+
+
+/**@brief Constant definition of mutex APIs to set in nrf_cc310_platform
+ */
+static const nrf_cc310_platform_mutex_apis_t mutex_apis =
+{
+    .mutex_init_fn = mutex_init,
+    .mutex_free_fn = mutex_free,
+    .mutex_lock_fn = mutex_lock,
+    .mutex_unlock_fn = mutex_unlock
+};
+
+
+/** @brief Constant definition of mutexes to set in nrf_cc310_platform
+ */
+static const nrf_cc310_platform_mutexes_t mutexes =
+{
+    .sym_mutex = &sym_mutex,
+    .asym_mutex = &asym_mutex,
+    .rng_mutex = &rng_mutex,
+    .reserved  = NULL,
+    .power_mutex = &power_mutex,
+};
+
+/** @brief Function to check if a mutex is held by another thread
+ */
+bool nrf_cc310_platform_mutex_is_busy(void const * mutex)
+{
+    nrf_cc310_platform_mutex_t const * p_platform_mutex = mutex;
+    atomic_mutex_t * p_mutex;
+    atomic_val_t owner;
+
+    if (p_platform_mutex == NULL ||
+        (p_platform_mutex->flags & NRF_CC310_PLATFORM_MUTEX_MASK_IS_VALID) == 0) {
+        return false;
+    }
+
+    p_mutex = (atomic_mutex_t *)p_platform_mutex->mutex;
+    owner = atomic_get(&p_mutex->owner);
+
+    return (owner != 0 && owner != (atomic_val_t)k_current_get());
+}
+
+/** @brief Function to read the usage counters of the dynamic mutex pool
+ */
+void nrf_cc310_platform_mutex_pool_stats_get(nrf_cc310_platform_mutex_pool_stats_t * p_stats)
+{
+    if (p_stats == NULL) {
+        return;
+    }
+
+    p_stats->size = NUM_MUTEXES;
+#if NUM_MUTEXES > 0
+    p_stats->used = k_mem_slab_num_used_get(&mutex_slab);
+#else
+    p_stats->used = 0;
+#endif
+    p_stats->max_used = mutex_pool_max_used;
+}
+
+/** @brief Function to initialize the nrf_cc310_platform mutex APIs
+ */
+void nrf_cc310_platform_mutex_init(void)
+{
+    nrf_cc310_platform_set_mutexes(&mutex_apis, &mutexes);
+}
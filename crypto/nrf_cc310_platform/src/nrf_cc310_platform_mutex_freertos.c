@@ -5,80 +5,181 @@
  */
 #include <stdint.h>
 #include <stddef.h>
+#include <stdbool.h>
 
 #include "FreeRTOS.h"
 #include "semphr.h"
+#include "task.h"
 
 #include "nrf_cc310_platform_defines.h"
 #include "nrf_cc310_platform_mutex.h"
+#include "nrf_cc310_platform_abort.h"
 
+#if configSUPPORT_STATIC_ALLOCATION != 1
+#error "nrf_cc310_platform mutexes require configSUPPORT_STATIC_ALLOCATION"
+#endif
 
-/** @brief external reference to the cc310 platform mutex APIs*/
-extern nrf_cc310_platform_mutex_apis_t  platform_mutex_apis;
+/** @brief Number of dynamically allocated mutexes the system supports
+ *
+ * Define NRF_CC310_PLATFORM_MUTEX_POOL_SIZE to change the size of the pool,
+ * or set it to 0 when no mutexes other than the platform mutexes are used.
+ */
+#ifndef NRF_CC310_PLATFORM_MUTEX_POOL_SIZE
+#define NRF_CC310_PLATFORM_MUTEX_POOL_SIZE 64
+#endif
+
+#define NUM_MUTEXES NRF_CC310_PLATFORM_MUTEX_POOL_SIZE
+
+/** @brief Type definition of a statically allocated FreeRTOS mutex
+ *
+ * The handle is kept next to its storage so that locking does not depend on
+ * how FreeRTOS maps the handle to the StaticSemaphore_t.
+ */
+typedef struct freertos_mutex
+{
+    SemaphoreHandle_t   handle;
+    StaticSemaphore_t   buffer;
+} freertos_mutex_t;
 
 /** @brief Definition of mutex for symmetric cryptography
  */
-static SemaphoreHandle_t sym_mutex_int;
+static freertos_mutex_t sym_mutex_int;
 
 /** @brief Definition of mutex for asymmetric cryptography
  */
-static SemaphoreHandle_t asym_mutex_int;
+static freertos_mutex_t asym_mutex_int;
 
 /** @brief Definition of mutex for random number generation
  */
-static SemaphoreHandle_t rng_mutex_int;
+static freertos_mutex_t rng_mutex_int;
 
 /** @brief Definition of mutex for power management changes
  */
-static SemaphoreHandle_t power_mutex_int;
+static freertos_mutex_t power_mutex_int;
+
+#if NUM_MUTEXES > 0
+/** @brief Definition of the mutex pool and its usage flags
+ */
+static freertos_mutex_t mutex_pool[NUM_MUTEXES];
+static bool mutex_pool_in_use[NUM_MUTEXES];
+#endif
+
+/** @brief Number of mutexes currently allocated from the pool
+ */
+static uint32_t mutex_pool_used;
+
+/** @brief Highest number of mutexes allocated from the pool at one time
+ */
+static uint32_t mutex_pool_max_used;
 
 
 /**@brief Definition of RTOS-independent symmetric cryptography mutex
- * with NRF_CC310_PLATFORM_MUTEX_MASK_IS_VALID set to indicate that
- * allocation is unneccesary
+ *
+ * The mutex is created by nrf_cc310_platform_mutex_init, which sets
+ * NRF_CC310_PLATFORM_MUTEX_MASK_IS_VALID to indicate that allocation is
+ * unneccesary.
 */
 nrf_cc310_platform_mutex_t sym_mutex =
 {
     .mutex = &sym_mutex_int,
-    .flags = NRF_CC310_PLATFORM_MUTEX_MASK_IS_VALID
+    .flags = NRF_CC310_PLATFORM_MUTEX_MASK_INVALID
 };
 
 
 /**@brief Definition of RTOS-independent asymmetric cryptography mutex
- * with NRF_CC310_PLATFORM_MUTEX_MASK_IS_VALID set to indicate that
- * allocation is unneccesary
+ *
+ * The mutex is created by nrf_cc310_platform_mutex_init.
 */
 nrf_cc310_platform_mutex_t asym_mutex =
 {
     .mutex = &asym_mutex_int,
-    .flags = NRF_CC310_PLATFORM_MUTEX_MASK_IS_VALID
+    .flags = NRF_CC310_PLATFORM_MUTEX_MASK_INVALID
 };
 
 
 /**@brief Definition of RTOS-independent random number generation mutex
- * with NRF_CC310_PLATFORM_MUTEX_MASK_IS_VALID set to indicate that
- * allocation is unneccesary
+ *
+ * The mutex is created by nrf_cc310_platform_mutex_init.
 */
 nrf_cc310_platform_mutex_t rng_mutex =
 {
     .mutex = &rng_mutex_int,
-    .flags = NRF_CC310_PLATFORM_MUTEX_MASK_IS_VALID
+    .flags = NRF_CC310_PLATFORM_MUTEX_MASK_INVALID
 };
 
 
 /**@brief Definition of RTOS-independent power management mutex
- * with NRF_CC310_PLATFORM_MUTEX_MASK_IS_VALID set to indicate that
- * allocation is unneccesary
+ *
+ * The mutex is created by nrf_cc310_platform_mutex_init.
 */
 nrf_cc310_platform_mutex_t power_mutex =
 {
     .mutex = &power_mutex_int,
-    .flags = NRF_CC310_PLATFORM_MUTEX_MASK_IS_VALID
+    .flags = NRF_CC310_PLATFORM_MUTEX_MASK_INVALID
 };
 
 
+/** @brief Static function to allocate a mutex from the pool
+ */
+static freertos_mutex_t * mutex_pool_alloc(void)
+{
+#if NUM_MUTEXES > 0
+    freertos_mutex_t * p_mutex = NULL;
+    uint32_t i;
+
+    taskENTER_CRITICAL();
+    for (i = 0; i < NUM_MUTEXES; i++) {
+        if (!mutex_pool_in_use[i]) {
+            mutex_pool_in_use[i] = true;
+            p_mutex = &mutex_pool[i];
+
+            mutex_pool_used++;
+            if (mutex_pool_used > mutex_pool_max_used) {
+                mutex_pool_max_used = mutex_pool_used;
+            }
+            break;
+        }
+    }
+    taskEXIT_CRITICAL();
 
-/** @brief Static function to unlock a mutex
+    return p_mutex;
+#else
+    return NULL;
+#endif
+}
+
+
+/** @brief Static function to return a mutex to the pool
+ */
+static void mutex_pool_free(freertos_mutex_t * p_mutex)
+{
+#if NUM_MUTEXES > 0
+    uint32_t i = (uint32_t)(p_mutex - mutex_pool);
+
+    taskENTER_CRITICAL();
+    if (i < NUM_MUTEXES && mutex_pool_in_use[i]) {
+        mutex_pool_in_use[i] = false;
+        mutex_pool_used--;
+    }
+    taskEXIT_CRITICAL();
+#else
+    (void)p_mutex;
+#endif
+}
+
+
+/** @brief Static function to create a mutex in its static storage
+ */
+static void mutex_create(freertos_mutex_t * p_mutex)
+{
+    p_mutex->handle = xSemaphoreCreateMutexStatic(&p_mutex->buffer);
+    if (p_mutex->handle == NULL) {
+        platform_abort_apis.abort_fn("Could not create mutex!");
+    }
+}
+
+
+/** @brief Static function to initialize a mutex
  */
 static void mutex_init(nrf_cc310_platform_mutex_t *mutex)
 {
@@ -87,11 +188,29 @@ static void mutex_init(nrf_cc310_platform_mutex_t *mutex)
         platform_abort_apis.abort_fn("mutex_init called with NULL parameter");
     }
 
-    mutex->mutex = (void*)xSemaphoreCreateMutex();
+    /* Nothing to do if the mutex is already initialized */
+    if ((mutex->flags & NRF_CC310_PLATFORM_MUTEX_MASK_IS_VALID) != 0) {
+        return;
+    }
+
+    /* Allocate if this has not been defined statically */
     if (mutex->mutex == NULL) {
-        platform_abort_apis.abort_fn("Could not create mutex!");
+        mutex->mutex = mutex_pool_alloc();
+        if (mutex->mutex == NULL) {
+            /* Allocation failed. Abort all operations */
+            platform_abort_apis.abort_fn(
+                "Could not allocate mutex before initializing, "
+                "increase NRF_CC310_PLATFORM_MUTEX_POOL_SIZE");
+        }
+
+        /** Set a flag to ensure that mutex is deallocated by the freeing
+         * operation
+         */
+        mutex->flags |= NRF_CC310_PLATFORM_MUTEX_MASK_IS_ALLOCATED;
     }
 
+    mutex_create((freertos_mutex_t *)mutex->mutex);
+
     /* Set the mask to indicate that the mutex is valid */
     mutex->flags |= NRF_CC310_PLATFORM_MUTEX_MASK_IS_VALID;
 }
@@ -101,21 +220,31 @@ static void mutex_init(nrf_cc310_platform_mutex_t *mutex)
  */
 static void mutex_free(nrf_cc310_platform_mutex_t *mutex)
 {
-    SemaphoreHandle_t *p_mutex;
+    freertos_mutex_t * p_mutex;
 
     /* Ensure that the mutex is valid (not NULL) */
     if (mutex == NULL) {
         platform_abort_apis.abort_fn("mutex_free called with NULL parameter");
     }
 
-    if (mutex->flags == NRF_CC310_PLATFORM_MUTEX_MASK_INVALID) {
+    /* Check if we are freeing a mutex that isn't initialized or allocated */
+    if ((mutex->flags & NRF_CC310_PLATFORM_MUTEX_MASK_IS_VALID) == 0) {
         /*Nothing to free*/
+        mutex->flags = NRF_CC310_PLATFORM_MUTEX_MASK_INVALID;
         return;
     }
 
-    p_mutex = (SemaphoreHandle_t*) mutex->mutex;
+    p_mutex = (freertos_mutex_t *)mutex->mutex;
 
-    vSemaphoreDelete(*p_mutex);
+    /* Static storage is not released by vSemaphoreDelete */
+    vSemaphoreDelete(p_mutex->handle);
+    p_mutex->handle = NULL;
+
+    /* Check if the mutex was allocated or being statically defined */
+    if ((mutex->flags & NRF_CC310_PLATFORM_MUTEX_MASK_IS_ALLOCATED) != 0) {
+        mutex_pool_free(p_mutex);
+        mutex->mutex = NULL;
+    }
 
     /* Reset the mutex to invalid state */
     mutex->flags = NRF_CC310_PLATFORM_MUTEX_MASK_INVALID;
@@ -126,23 +255,21 @@ static void mutex_free(nrf_cc310_platform_mutex_t *mutex)
  */
 static int mutex_lock(nrf_cc310_platform_mutex_t *mutex)
 {
-    int ret;
-    SemaphoreHandle_t *p_mutex;
+    freertos_mutex_t * p_mutex;
 
-    /* Ensure that the mutex is valid (not NULL) */
+    /* Ensure that the mutex param is valid (not NULL) */
     if (mutex == NULL) {
-        platform_abort_apis.abort_fn("mutex_lock called with NULL parameter");
+        return NRF_CC310_PLATFORM_ERROR_PARAM_NULL;
     }
 
     /* Ensure that the mutex has been initialized */
-    if (mutex->flags == NRF_CC310_PLATFORM_MUTEX_MASK_INVALID) {
+    if ((mutex->flags & NRF_CC310_PLATFORM_MUTEX_MASK_IS_VALID) == 0) {
         return NRF_CC310_PLATFORM_ERROR_MUTEX_NOT_INITIALIZED;
     }
 
-    p_mutex = (SemaphoreHandle_t*) mutex->mutex;
+    p_mutex = (freertos_mutex_t *)mutex->mutex;
 
-    ret = xSemaphoreTake(p_mutex, portMAX_DELAY);
-    if (ret == pdTRUE) {
+    if (xSemaphoreTake(p_mutex->handle, portMAX_DELAY) == pdTRUE) {
         return NRF_CC310_PLATFORM_SUCCESS;
     }
     else {
@@ -153,25 +280,23 @@ static int mutex_lock(nrf_cc310_platform_mutex_t *mutex)
 
 /** @brief Static function to unlock a mutex
  */
-static int mutex_unlock(nrf_cc310_platform_mutex_t * mutex)
+static int mutex_unlock(nrf_cc310_platform_mutex_t *mutex)
 {
-    int ret;
-    SemaphoreHandle_t *p_mutex;
+    freertos_mutex_t * p_mutex;
 
-    /* Ensure that the mutex is valid (not NULL) */
+    /* Ensure that the mutex param is valid (not NULL) */
     if (mutex == NULL) {
-        platform_abort_apis.abort_fn("mutex_unlock called with NULL parameter");
+        return NRF_CC310_PLATFORM_ERROR_PARAM_NULL;
     }
 
     /* Ensure that the mutex has been initialized */
-    if (mutex->flags == NRF_CC310_PLATFORM_MUTEX_MASK_INVALID) {
+    if ((mutex->flags & NRF_CC310_PLATFORM_MUTEX_MASK_IS_VALID) == 0) {
         return NRF_CC310_PLATFORM_ERROR_MUTEX_NOT_INITIALIZED;
     }
 
-    p_mutex = (SemaphoreHandle_t*);
+    p_mutex = (freertos_mutex_t *)mutex->mutex;
 
-    ret = xSemaphoreGive(p_mutex);
-    if (ret != pdTRUE) {
+    if (xSemaphoreGive(p_mutex->handle) != pdTRUE) {
         platform_abort_apis.abort_fn("Could not unlock mutex!");
     }
 
@@ -181,7 +306,7 @@ static int mutex_unlock(nrf_cc310_platform_mutex_t * mutex)
 
 /**@brief Constant definition of mutex APIs to set in nrf_cc310_platform
  */
-const nrf_cc310_platform_mutex_apis_t mutex_apis =
+static const nrf_cc310_platform_mutex_apis_t mutex_apis =
 {
     .mutex_init_fn = mutex_init,
     .mutex_free_fn = mutex_free,
@@ -192,7 +317,7 @@ const nrf_cc310_platform_mutex_apis_t mutex_apis =
 
 /** @brief Constant definition of mutexes to set in nrf_cc310_platform
  */
-const nrf_cc310_platform_mutexes_t mutexes =
+static const nrf_cc310_platform_mutexes_t mutexes =
 {
     .sym_mutex = &sym_mutex,
     .asym_mutex = &asym_mutex,
@@ -201,10 +326,50 @@ const nrf_cc310_platform_mutexes_t mutexes =
     .power_mutex = &power_mutex
 };
 
-/** @brief Function to initiialize the nrf_cc310_platform mutex APIs.
+/** @brief Function to check if a mutex is held by another task
+ */
+bool nrf_cc310_platform_mutex_is_busy(void const * mutex)
+{
+    nrf_cc310_platform_mutex_t const * p_platform_mutex = mutex;
+    freertos_mutex_t const * p_mutex;
+    TaskHandle_t holder;
+
+    if (p_platform_mutex == NULL ||
+        (p_platform_mutex->flags & NRF_CC310_PLATFORM_MUTEX_MASK_IS_VALID) == 0) {
+        return false;
+    }
+
+    p_mutex = (freertos_mutex_t const *)p_platform_mutex->mutex;
+    holder = xSemaphoreGetMutexHolder(p_mutex->handle);
+
+    return (holder != NULL && holder != xTaskGetCurrentTaskHandle());
+}
+
+/** @brief Function to read the usage counters of the dynamic mutex pool
+ */
+void nrf_cc310_platform_mutex_pool_stats_get(nrf_cc310_platform_mutex_pool_stats_t * p_stats)
+{
+    if (p_stats == NULL) {
+        return;
+    }
+
+    taskENTER_CRITICAL();
+    p_stats->size = NUM_MUTEXES;
+    p_stats->used = mutex_pool_used;
+    p_stats->max_used = mutex_pool_max_used;
+    taskEXIT_CRITICAL();
+}
+
+/** @brief Function to initialize the nrf_cc310_platform mutex APIs.
+ *
+ * The platform mutexes are created here, in static storage.
  */
-int nrf_cc310_platform_mutex_init(void)
+void nrf_cc310_platform_mutex_init(void)
 {
+    mutex_init(&sym_mutex);
+    mutex_init(&asym_mutex);
+    mutex_init(&rng_mutex);
+    mutex_init(&power_mutex);
+
     nrf_cc310_platform_set_mutexes(&mutex_apis, &mutexes);
-    return NRF_CC310_PLATFORM_SUCCESS;
 }
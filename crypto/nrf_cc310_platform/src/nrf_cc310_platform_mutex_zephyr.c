@@ -6,6 +6,7 @@
 #include <stdint.h>
 #include <stddef.h>
 #include <string.h>
+#include <errno.h>
 
 #include <zephyr.h>
 #include <kernel.h>
@@ -36,17 +37,19 @@ K_MUTEX_DEFINE(rng_mutex_int);
 */
 K_MUTEX_DEFINE(power_mutex_int);
 
-/** @brief Arbritary number of mutexes the system suppors
+/** @brief Number of dynamically allocated mutexes the system supports
  */
-#define NUM_MUTEXES 64
+#define NUM_MUTEXES CONFIG_NRF_CC310_PLATFORM_MUTEX_POOL_SIZE
 
-/** @brief Structure definition of the mutex slab
+#if NUM_MUTEXES > 0
+/** @brief Definition of the mutex slab and its buffer
  */
-struct k_mem_slab mutex_slab;
+K_MEM_SLAB_DEFINE(mutex_slab, sizeof(struct k_mutex), NUM_MUTEXES, 4);
+#endif
 
-/** @brief Definition of buffer used for the mutex slabs
+/** @brief Highest number of mutexes allocated from the slab at one time
  */
-char __aligned(4) mutex_slab_buffer[NUM_MUTEXES * sizeof(struct k_mutex)];
+static uint32_t mutex_pool_max_used;
 
 /**@brief Definition of RTOS-independent symmetric cryptography mutex
  * with NRF_CC310_PLATFORM_MUTEX_MASK_IS_VALID set to indicate that
@@ -92,6 +95,86 @@ nrf_cc310_platform_mutex_t power_mutex =
 };
 
 
+/** @brief Static function to allocate a mutex from the slab
+ *
+ * The slab is not waited on during mutex_init. An exhausted pool is a
+ * configuration error there and waiting could block the calling thread
+ * forever. A deferred allocation waits for at most
+ * CONFIG_NRF_CC310_PLATFORM_MUTEX_POOL_RETRY_TIMEOUT ms.
+ */
+static int mutex_pool_alloc(void ** pp_mutex, bool wait) {
+#if NUM_MUTEXES > 0
+    int ret;
+    uint32_t used;
+    unsigned int key;
+
+#if defined(CONFIG_NRF_CC310_PLATFORM_MUTEX_POOL_RECOVERABLE)
+    ret = k_mem_slab_alloc(&mutex_slab, pp_mutex,
+        wait ? K_MSEC(CONFIG_NRF_CC310_PLATFORM_MUTEX_POOL_RETRY_TIMEOUT) : K_NO_WAIT);
+#else
+    ARG_UNUSED(wait);
+    ret = k_mem_slab_alloc(&mutex_slab, pp_mutex, K_NO_WAIT);
+#endif
+    if (ret != 0) {
+        return ret;
+    }
+
+    key = irq_lock();
+    used = k_mem_slab_num_used_get(&mutex_slab);
+    if (used > mutex_pool_max_used) {
+        mutex_pool_max_used = used;
+    }
+    irq_unlock(key);
+
+    return 0;
+#else
+    ARG_UNUSED(wait);
+    *pp_mutex = NULL;
+    return -ENOMEM;
+#endif
+}
+
+
+/** @brief Static function to return a mutex to the slab
+ */
+static void mutex_pool_free(void ** pp_mutex) {
+#if NUM_MUTEXES > 0
+    k_mem_slab_free(&mutex_slab, pp_mutex);
+#endif
+    *pp_mutex = NULL;
+}
+
+
+#if defined(CONFIG_NRF_CC310_PLATFORM_MUTEX_POOL_RECOVERABLE)
+/** @brief Definition of mutex serializing deferred allocations
+ */
+K_MUTEX_DEFINE(mutex_pool_lock);
+
+/** @brief Static function to retry the allocation of a deferred mutex
+ */
+static int mutex_alloc_deferred(nrf_cc310_platform_mutex_t *mutex) {
+    int ret = 0;
+
+    k_mutex_lock(&mutex_pool_lock, K_FOREVER);
+
+    /* Another thread may have completed the allocation */
+    if (mutex->flags == NRF_CC310_PLATFORM_MUTEX_MASK_IS_DEFERRED) {
+        ret = mutex_pool_alloc(&mutex->mutex, true);
+        if (ret == 0) {
+            memset(mutex->mutex, 0, sizeof(struct k_mutex));
+            k_mutex_init((struct k_mutex *)mutex->mutex);
+            mutex->flags = NRF_CC310_PLATFORM_MUTEX_MASK_IS_ALLOCATED |
+                           NRF_CC310_PLATFORM_MUTEX_MASK_IS_VALID;
+        }
+    }
+
+    k_mutex_unlock(&mutex_pool_lock);
+
+    return ret;
+}
+#endif
+
+
 /**@brief static function to initialize a mutex
  */
 static void mutex_init(nrf_cc310_platform_mutex_t *mutex) {
@@ -105,15 +188,22 @@ static void mutex_init(nrf_cc310_platform_mutex_t *mutex) {
     }
 
     /* Allocate if this has not been initialized statically */
-    if (mutex->flags == NRF_CC310_PLATFORM_MUTEX_MASK_INVALID &&
+    if ((mutex->flags & NRF_CC310_PLATFORM_MUTEX_MASK_IS_VALID) == 0 &&
         mutex->mutex == NULL) {
-        /* allocate some memory for the mute*/
-        ret = k_mem_slab_alloc(&mutex_slab, &mutex->mutex, K_FOREVER);
+        ret = mutex_pool_alloc(&mutex->mutex, false);
         if(ret != 0 || mutex->mutex == NULL)
         {
+#if defined(CONFIG_NRF_CC310_PLATFORM_MUTEX_POOL_RECOVERABLE)
+            /* Retry the allocation when the mutex is locked */
+            mutex->mutex = NULL;
+            mutex->flags = NRF_CC310_PLATFORM_MUTEX_MASK_IS_DEFERRED;
+            return;
+#else
             /* Allocation failed. Abort all operations */
             platform_abort_apis.abort_fn(
-                "Could not allocate mutex before initializing");
+                "Could not allocate mutex before initializing, "
+                "increase CONFIG_NRF_CC310_PLATFORM_MUTEX_POOL_SIZE");
+#endif
         }
 
         memset(mutex->mutex, 0, sizeof(struct k_mutex));
@@ -138,19 +228,19 @@ static void mutex_free(nrf_cc310_platform_mutex_t *mutex) {
     /* Ensure that the mutex is valid (not NULL) */
     if (mutex == NULL) {
         platform_abort_apis.abort_fn(
-            "mutex_init called with NULL parameter");
+            "mutex_free called with NULL parameter");
     }
 
-    /* Check if we are freeing a mutex that isn't initialized */
-    if (mutex->flags == NRF_CC310_PLATFORM_MUTEX_MASK_INVALID) {
+    /* Check if we are freeing a mutex that isn't initialized or allocated */
+    if ((mutex->flags & NRF_CC310_PLATFORM_MUTEX_MASK_IS_VALID) == 0) {
         /*Nothing to free*/
+        mutex->flags = NRF_CC310_PLATFORM_MUTEX_MASK_INVALID;
         return;
     }
 
     /* Check if the mutex was allocated or being statically defined */
-    if ((mutex->flags & NRF_CC310_PLATFORM_MUTEX_MASK_IS_ALLOCATED) == 0) {
-        k_mem_slab_free(&mutex_slab, mutex->mutex);
-        mutex->mutex = NULL;
+    if ((mutex->flags & NRF_CC310_PLATFORM_MUTEX_MASK_IS_ALLOCATED) != 0) {
+        mutex_pool_free(&mutex->mutex);
     }
     else {
         memset(mutex->mutex, 0, sizeof(struct k_mutex));
@@ -177,9 +267,28 @@ static int32_t mutex_lock(nrf_cc310_platform_mutex_t *mutex) {
         return NRF_CC310_PLATFORM_ERROR_MUTEX_NOT_INITIALIZED;
     }
 
+#if defined(CONFIG_NRF_CC310_PLATFORM_MUTEX_POOL_RECOVERABLE)
+    /* Report an exhausted pool as a lock failure instead of aborting */
+    if (mutex->flags == NRF_CC310_PLATFORM_MUTEX_MASK_IS_DEFERRED &&
+        mutex_alloc_deferred(mutex) != 0) {
+        return NRF_CC310_PLATFORM_ERROR_MUTEX_FAILED;
+    }
+#endif
+
     p_mutex = (struct k_mutex *)mutex->mutex;
 
+#if defined(CONFIG_NRF_CC310_PLATFORM_MUTEX_TRACE)
+    /* Only a contended lock is timed and reported */
+    ret = k_mutex_lock(p_mutex, K_NO_WAIT);
+    if (ret == -EBUSY) {
+        uint32_t start = k_cycle_get_32();
+
+        ret = k_mutex_lock(p_mutex, K_FOREVER);
+        nrf_cc310_platform_mutex_trace_wait(mutex, k_cycle_get_32() - start);
+    }
+#else
     ret = k_mutex_lock(p_mutex, K_FOREVER);
+#endif
     if (ret == 0) {
         return NRF_CC310_PLATFORM_SUCCESS;
     }
@@ -200,7 +309,7 @@ static int32_t mutex_unlock(nrf_cc310_platform_mutex_t *mutex) {
     }
 
     /* Ensure that the mutex has been initialized */
-    if (mutex->flags == NRF_CC310_PLATFORM_MUTEX_MASK_INVALID) {
+    if ((mutex->flags & NRF_CC310_PLATFORM_MUTEX_MASK_IS_VALID) == 0) {
         return NRF_CC310_PLATFORM_ERROR_MUTEX_NOT_INITIALIZED;
     }
 
@@ -233,14 +342,43 @@ static const nrf_cc310_platform_mutexes_t mutexes =
     .power_mutex = &power_mutex,
 };
 
+/** @brief Function to check if a mutex is held by another thread
+ */
+bool nrf_cc310_platform_mutex_is_busy(void const * mutex)
+{
+    nrf_cc310_platform_mutex_t const * p_platform_mutex = mutex;
+    struct k_mutex * p_mutex;
+
+    if (p_platform_mutex == NULL ||
+        (p_platform_mutex->flags & NRF_CC310_PLATFORM_MUTEX_MASK_IS_VALID) == 0) {
+        return false;
+    }
+
+    p_mutex = (struct k_mutex *)p_platform_mutex->mutex;
+
+    return (p_mutex->owner != NULL && p_mutex->owner != k_current_get());
+}
+
+/** @brief Function to read the usage counters of the dynamic mutex pool
+ */
+void nrf_cc310_platform_mutex_pool_stats_get(nrf_cc310_platform_mutex_pool_stats_t * p_stats)
+{
+    if (p_stats == NULL) {
+        return;
+    }
+
+    p_stats->size = NUM_MUTEXES;
+#if NUM_MUTEXES > 0
+    p_stats->used = k_mem_slab_num_used_get(&mutex_slab);
+#else
+    p_stats->used = 0;
+#endif
+    p_stats->max_used = mutex_pool_max_used;
+}
+
 /** @brief Function to initialize the nrf_cc310_platform mutex APIs
  */
 void nrf_cc310_platform_mutex_init(void)
 {
-    k_mem_slab_init(&mutex_slab,
-            mutex_slab_buffer,
-            sizeof(struct k_mutex),
-            NUM_MUTEXES);
-
     nrf_cc310_platform_set_mutexes(&mutex_apis, &mutexes);
 }
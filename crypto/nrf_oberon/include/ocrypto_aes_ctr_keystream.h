@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+
+/**@file
+ * @defgroup nrf_oberon_aes_ctr_keystream AES-CTR with a precomputed keystream
+ * @ingroup nrf_oberon_aes
+ * @{
+ * @brief Type declarations and APIs to precompute an AES-CTR keystream.
+ *
+ * The keystream of an AES-CTR stream does not depend on the data. It can be
+ * generated in bulk ahead of time, e.g. while the radio is idle, into a
+ * buffer provided by the user. Encrypting or decrypting a packet then only
+ * takes an XOR with the buffered keystream. When the buffer runs out, the
+ * remaining data is processed with @c ocrypto_aes_ctr_encrypt.
+ *
+ * The output is identical to that of @c ocrypto_aes_ctr_encrypt on the same
+ * stream.
+ */
+
+#ifndef OCRYPTO_AES_CTR_KEYSTREAM_H
+#define OCRYPTO_AES_CTR_KEYSTREAM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "ocrypto_aes_ctr.h"
+
+
+/**@cond */
+typedef struct {
+    ocrypto_aes_ctr_ctx ctr;
+    uint8_t *buf;
+    size_t size;
+    size_t pos;
+    size_t fill;
+} ocrypto_aes_ctr_keystream_ctx;
+/**@endcond */
+
+
+/**
+ * AES-CTR keystream initialization.
+ *
+ * The state @p ctx is initialized by this function. No keystream is
+ * generated until @c ocrypto_aes_ctr_keystream_refill is called.
+ *
+ * @param[out] ctx      State.
+ * @param      buf      Buffer to hold the precomputed keystream. Must be
+ *                      kept while @p ctx is in use.
+ * @param      buf_size Size of @p buf.
+ * @param      key      AES key.
+ * @param      size     Key size (16, 24, or 32 bytes).
+ * @param      iv       Initial vector.
+ */
+void ocrypto_aes_ctr_keystream_init(ocrypto_aes_ctr_keystream_ctx *ctx,
+                                    uint8_t *buf, size_t buf_size,
+                                    const uint8_t *key, size_t size,
+                                    const uint8_t iv[16]);
+
+/**
+ * AES-CTR keystream generation.
+ *
+ * Fills the unused part of the keystream buffer in a single bulk call.
+ *
+ * @param[in,out] ctx State.
+ */
+void ocrypto_aes_ctr_keystream_refill(ocrypto_aes_ctr_keystream_ctx *ctx);
+
+/**
+ * Number of precomputed keystream bytes available.
+ *
+ * @param ctx State.
+ *
+ * @returns Number of bytes that can be processed without generating keystream.
+ */
+size_t ocrypto_aes_ctr_keystream_available(const ocrypto_aes_ctr_keystream_ctx *ctx);
+
+/**
+ * AES-CTR encryption or decryption with the precomputed keystream.
+ *
+ * @param[in,out] ctx    State.
+ * @param[out]    out    Output data. May be the same as @p in.
+ * @param         in     Input data.
+ * @param         in_len Length of @p in and @p out.
+ */
+void ocrypto_aes_ctr_keystream_xor(ocrypto_aes_ctr_keystream_ctx *ctx,
+                                   uint8_t *out, const uint8_t *in, size_t in_len);
+
+/**
+ * AES-CTR keystream clearing.
+ *
+ * The key schedule and the buffered keystream are cleared.
+ *
+ * @param[out] ctx State.
+ */
+void ocrypto_aes_ctr_keystream_clear(ocrypto_aes_ctr_keystream_ctx *ctx);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* #ifndef OCRYPTO_AES_CTR_KEYSTREAM_H */
+
+/** @} */
@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+
+/**@file
+ * @defgroup nrf_oberon_aes_ctr_reset AES-CTR counter reset
+ * @ingroup nrf_oberon_aes_ctr
+ * @{
+ * @brief Restart an AES-CTR context at a new counter without expanding the key again.
+ *
+ * @c ocrypto_aes_ctr_init called with a NULL key only loads the counter and
+ * keeps the expanded key in the context. This is not part of the documented
+ * API. It has been verified with nrf_oberon 3.0.3, and the build fails for
+ * any other nrf_oberon version while a user of this header is enabled, see
+ * crypto/CMakeLists.txt.
+ */
+
+#ifndef OCRYPTO_AES_CTR_RESET_H
+#define OCRYPTO_AES_CTR_RESET_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "ocrypto_aes_ctr.h"
+
+
+/**
+ * AES-CTR counter reset.
+ *
+ * The counter of @p ctx is set to @p iv. The key is kept.
+ *
+ * @param ctx Context, initialized with @c ocrypto_aes_ctr_init.
+ * @param iv  Initial vector.
+ */
+static inline void ocrypto_aes_ctr_reset(ocrypto_aes_ctr_ctx *ctx, const uint8_t iv[16])
+{
+    ocrypto_aes_ctr_init(ctx, NULL, ctx->size, iv);
+}
+
+/**
+ * AES block encryption with the key of an AES-CTR context.
+ *
+ * @p out is the keystream of the counter @p in, that is the AES encryption
+ * of @p in. The counter of @p ctx is changed.
+ *
+ * @param      ctx Context, initialized with @c ocrypto_aes_ctr_init.
+ * @param      in  Input block.
+ * @param[out] out Output block.
+ *
+ * @remark @p in and @p out can point to the same address.
+ */
+static inline void ocrypto_aes_ctr_block(ocrypto_aes_ctr_ctx *ctx, const uint8_t in[16], uint8_t out[16])
+{
+    ocrypto_aes_ctr_reset(ctx, in);
+    memset(out, 0, 16);
+    ocrypto_aes_ctr_encrypt(ctx, out, out, 16);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* #ifndef OCRYPTO_AES_CTR_RESET_H */
+
+/** @} */
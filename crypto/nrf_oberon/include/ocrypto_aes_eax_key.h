@@ -0,0 +1,226 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+
+/**@file
+ * @defgroup nrf_oberon_aes_eax_key AES-EAX APIs using a precomputed key
+ * @ingroup nrf_oberon_aes
+ * @{
+ * @brief Type declarations and APIs for AES-EAX with a reusable key schedule.
+ *
+ * @c ocrypto_aes_eax_encrypt and @c ocrypto_aes_eax_decrypt expand the AES
+ * key and derive the OMAC subkeys for every message. When many messages are
+ * protected with the same key, the expanded AES key, the OMAC subkeys, and
+ * the OMAC states after the three tweak blocks can be computed once and
+ * stored in an @c ocrypto_aes_eax_key. This saves the key expansion and four
+ * AES blocks per message.
+ *
+ * Messages can also be processed incrementally, in chunks of any size, with
+ * a context of bounded size.
+ *
+ * The output is identical to that of @c ocrypto_aes_eax_encrypt.
+ */
+
+#ifndef OCRYPTO_AES_EAX_KEY_H
+#define OCRYPTO_AES_EAX_KEY_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "ocrypto_aes_ctr.h"
+
+
+/**
+ * Precomputed AES-EAX key schedule.
+ *
+ * The key schedule holds secret material and should be cleared after use.
+ * It is not modified by the encryption and decryption functions, and can be
+ * shared between concurrent users.
+ */
+typedef struct
+{
+    ocrypto_aes_ctr_ctx ctr;    //!< Expanded AES key.
+    uint8_t b[16];              //!< OMAC subkey for complete final blocks.
+    uint8_t p[16];              //!< OMAC subkey for padded final blocks.
+    uint8_t omac[3][16];        //!< OMAC states after the tweak blocks 0, 1, and 2.
+} ocrypto_aes_eax_key;
+
+/**@cond */
+typedef struct
+{
+    ocrypto_aes_ctr_ctx ctr;
+    ocrypto_aes_ctr_ctx mac;
+    const ocrypto_aes_eax_key *key;
+    uint8_t tag[16];
+    uint8_t x[16];
+    uint8_t pos;
+    uint8_t t;
+} ocrypto_aes_eax_keyed_ctx;
+/**@endcond */
+
+
+/**
+ * AES-EAX key schedule setup.
+ *
+ * @param[out] key  Key schedule.
+ * @param      k    AES key.
+ * @param      size Key size (16, 24, or 32 bytes).
+ */
+void ocrypto_aes_eax_key_init(ocrypto_aes_eax_key *key, const uint8_t *k, size_t size);
+
+/**
+ * AES-EAX key schedule clearing.
+ *
+ * @param[out] key Key schedule.
+ */
+void ocrypto_aes_eax_key_clear(ocrypto_aes_eax_key *key);
+
+/**
+ * AES-EAX encryption using a precomputed key schedule.
+ *
+ * @param[out] ct     Cyphertext.
+ * @param[out] tag    Authentication tag.
+ * @param      pt     Plaintext.
+ * @param      pt_len Plaintext length.
+ * @param      key    Key schedule.
+ * @param      iv     Initial vector.
+ * @param      iv_len Initial vector length.
+ * @param      aa     Additional authentication data.
+ * @param      aa_len Additional authentication data length.
+ *
+ * @remark @p ct and @p pt can point to the same address.
+ * @remark Initialization of the key schedule @p key through
+ *         @c ocrypto_aes_eax_key_init is required before this function can be called.
+ */
+void ocrypto_aes_eax_keyed_encrypt(
+    uint8_t *ct, uint8_t tag[16], const uint8_t *pt, size_t pt_len,
+    const ocrypto_aes_eax_key *key,
+    const uint8_t *iv, size_t iv_len, const uint8_t *aa, size_t aa_len);
+
+/**
+ * AES-EAX decryption using a precomputed key schedule.
+ *
+ * @param[out] pt     Plaintext.
+ * @param      tag    Authentication tag.
+ * @param      ct     Cyphertext.
+ * @param      ct_len Cyphertext length.
+ * @param      key    Key schedule.
+ * @param      iv     Initial vector.
+ * @param      iv_len Initial vector length.
+ * @param      aa     Additional authentication data.
+ * @param      aa_len Additional authentication data length.
+ *
+ * @remark @p ct and @p pt can point to the same address.
+ * @remark @p pt is not written if @p tag is invalid.
+ * @remark Initialization of the key schedule @p key through
+ *         @c ocrypto_aes_eax_key_init is required before this function can be called.
+ *
+ * @retval 0  If @p tag is valid.
+ * @retval -1 Otherwise.
+ */
+int ocrypto_aes_eax_keyed_decrypt(
+    uint8_t *pt, const uint8_t tag[16], const uint8_t *ct, size_t ct_len,
+    const ocrypto_aes_eax_key *key,
+    const uint8_t *iv, size_t iv_len, const uint8_t *aa, size_t aa_len);
+
+/**@name Incremental AES-EAX encryption/decryption.
+ *
+ * This group of functions can be used to incrementally compute the
+ * AES-EAX encryption/decryption for a given message.
+ */
+/**@{*/
+/**
+ * AES-EAX initialization using a precomputed key schedule.
+ *
+ * The state @p ctx is initialized by this function.
+ *
+ * @param[out] ctx    State.
+ * @param      key    Key schedule. Must be kept while @p ctx is in use.
+ * @param      iv     Initial vector.
+ * @param      iv_len Initial vector length.
+ */
+void ocrypto_aes_eax_keyed_init(
+    ocrypto_aes_eax_keyed_ctx *ctx, const ocrypto_aes_eax_key *key,
+    const uint8_t *iv, size_t iv_len);
+
+/**
+ * AES-EAX incremental additional authentication data input.
+ *
+ * This function can be called repeatedly until the whole data is processed.
+ *
+ * @param      ctx    State.
+ * @param      aa     Additional authentication data.
+ * @param      aa_len Length of @p aa.
+ *
+ * @remark @c ocrypto_aes_eax_keyed_update_aad must be called before any call to
+ *         @c ocrypto_aes_eax_keyed_update_enc or @c ocrypto_aes_eax_keyed_update_dec.
+ */
+void ocrypto_aes_eax_keyed_update_aad(
+    ocrypto_aes_eax_keyed_ctx *ctx, const uint8_t *aa, size_t aa_len);
+
+/**
+ * AES-EAX incremental encryption.
+ *
+ * This function can be called repeatedly until the whole message is processed.
+ *
+ * @param      ctx    State.
+ * @param[out] ct     Cyphertext.
+ * @param      pt     Plaintext.
+ * @param      pt_len Length of @p pt and @p ct.
+ *
+ * @remark @p ct and @p pt can point to the same address.
+ */
+void ocrypto_aes_eax_keyed_update_enc(
+    ocrypto_aes_eax_keyed_ctx *ctx, uint8_t *ct, const uint8_t *pt, size_t pt_len);
+
+/**
+ * AES-EAX incremental decryption.
+ *
+ * This function can be called repeatedly until the whole cyphertext is processed.
+ *
+ * @param      ctx    State.
+ * @param[out] pt     Plaintext.
+ * @param      ct     Cyphertext.
+ * @param      ct_len Length of @p ct and @p pt.
+ *
+ * @remark @p ct and @p pt can point to the same address.
+ * @remark The plaintext is not authenticated until
+ *         @c ocrypto_aes_eax_keyed_final_dec has returned 0. It must not be
+ *         used, e.g. an image must not be activated, before that.
+ */
+void ocrypto_aes_eax_keyed_update_dec(
+    ocrypto_aes_eax_keyed_ctx *ctx, uint8_t *pt, const uint8_t *ct, size_t ct_len);
+
+/**
+ * AES-EAX final encoder step.
+ *
+ * @param      ctx State. Cleared by this function.
+ * @param[out] tag Generated authentication tag.
+ */
+void ocrypto_aes_eax_keyed_final_enc(ocrypto_aes_eax_keyed_ctx *ctx, uint8_t tag[16]);
+
+/**
+ * AES-EAX final decoder step.
+ *
+ * @param      ctx State. Cleared by this function.
+ * @param      tag Received authentication tag.
+ *
+ * @retval 0  If @p tag is valid.
+ * @retval -1 Otherwise.
+ */
+int ocrypto_aes_eax_keyed_final_dec(ocrypto_aes_eax_keyed_ctx *ctx, const uint8_t tag[16]);
+/**@}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* #ifndef OCRYPTO_AES_EAX_KEY_H */
+
+/** @} */
@@ -0,0 +1,220 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+
+/**@file
+ * @defgroup nrf_oberon_aes_gcm_key AES-GCM APIs using a precomputed key
+ * @ingroup nrf_oberon_aes
+ * @{
+ * @brief Type declarations and APIs for AES-GCM with a reusable key schedule.
+ *
+ * @c ocrypto_aes_gcm_encrypt and @c ocrypto_aes_gcm_decrypt expand the AES
+ * key and compute the GHASH key for every message. When many messages are
+ * protected with the same key, the expanded AES key and a GHASH
+ * multiplication table can be computed once and stored in an
+ * @c ocrypto_aes_gcm_key. Each message then only needs the AES blocks of the
+ * message itself.
+ *
+ * Messages can also be processed incrementally, in chunks of any size, with
+ * a context of bounded size.
+ *
+ * The output is identical to that of @c ocrypto_aes_gcm_encrypt.
+ */
+
+#ifndef OCRYPTO_AES_GCM_KEY_H
+#define OCRYPTO_AES_GCM_KEY_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "ocrypto_aes_ctr.h"
+
+
+/**
+ * Precomputed AES-GCM key schedule.
+ *
+ * The key schedule holds secret material and should be cleared after use.
+ * It is not modified by the encryption and decryption functions, and can be
+ * shared between concurrent users.
+ */
+typedef struct
+{
+    ocrypto_aes_ctr_ctx ctr;    //!< Expanded AES key.
+    uint64_t hl[16];            //!< GHASH table, low halves of the multiples of H.
+    uint64_t hh[16];            //!< GHASH table, high halves of the multiples of H.
+} ocrypto_aes_gcm_key;
+
+/**@cond */
+typedef struct
+{
+    ocrypto_aes_ctr_ctx ctr;
+    const ocrypto_aes_gcm_key *key;
+    uint8_t y[16];
+    uint8_t ek0[16];
+    size_t aa_len;
+    size_t ct_len;
+    uint8_t pos;
+    uint8_t data;
+} ocrypto_aes_gcm_keyed_ctx;
+/**@endcond */
+
+
+/**
+ * AES-GCM key schedule setup.
+ *
+ * @param[out] key  Key schedule.
+ * @param      k    AES key.
+ * @param      size Key size (16, 24, or 32 bytes).
+ */
+void ocrypto_aes_gcm_key_init(ocrypto_aes_gcm_key *key, const uint8_t *k, size_t size);
+
+/**
+ * AES-GCM key schedule clearing.
+ *
+ * @param[out] key Key schedule.
+ */
+void ocrypto_aes_gcm_key_clear(ocrypto_aes_gcm_key *key);
+
+/**
+ * AES-GCM encryption using a precomputed key schedule.
+ *
+ * @param[out] ct     Cyphertext.
+ * @param[out] tag    Authentication tag.
+ * @param      pt     Plaintext.
+ * @param      pt_len Plaintext length.
+ * @param      key    Key schedule.
+ * @param      iv     Initial vector.
+ * @param      aa     Additional authentication data.
+ * @param      aa_len Additional authentication data length.
+ *
+ * @remark @p ct and @p pt can point to the same address.
+ * @remark Initialization of the key schedule @p key through
+ *         @c ocrypto_aes_gcm_key_init is required before this function can be called.
+ */
+void ocrypto_aes_gcm_keyed_encrypt(
+    uint8_t *ct, uint8_t tag[16], const uint8_t *pt, size_t pt_len,
+    const ocrypto_aes_gcm_key *key, const uint8_t iv[12], const uint8_t *aa, size_t aa_len);
+
+/**
+ * AES-GCM decryption using a precomputed key schedule.
+ *
+ * @param[out] pt     Plaintext.
+ * @param      tag    Authentication tag.
+ * @param      ct     Cyphertext.
+ * @param      ct_len Cyphertext length.
+ * @param      key    Key schedule.
+ * @param      iv     Initial vector.
+ * @param      aa     Additional authentication data.
+ * @param      aa_len Additional authentication data length.
+ *
+ * @remark @p ct and @p pt can point to the same address.
+ * @remark @p pt is not written if @p tag is invalid.
+ * @remark Initialization of the key schedule @p key through
+ *         @c ocrypto_aes_gcm_key_init is required before this function can be called.
+ *
+ * @retval 0  If @p tag is valid.
+ * @retval -1 Otherwise.
+ */
+int ocrypto_aes_gcm_keyed_decrypt(
+    uint8_t *pt, const uint8_t tag[16], const uint8_t *ct, size_t ct_len,
+    const ocrypto_aes_gcm_key *key, const uint8_t iv[12], const uint8_t *aa, size_t aa_len);
+
+/**@name Incremental AES-GCM encryption/decryption.
+ *
+ * This group of functions can be used to incrementally compute the
+ * AES-GCM encryption/decryption for a given message.
+ */
+/**@{*/
+/**
+ * AES-GCM initialization using a precomputed key schedule.
+ *
+ * The state @p ctx is initialized by this function.
+ *
+ * @param[out] ctx State.
+ * @param      key Key schedule. Must be kept while @p ctx is in use.
+ * @param      iv  Initial vector.
+ */
+void ocrypto_aes_gcm_keyed_init(
+    ocrypto_aes_gcm_keyed_ctx *ctx, const ocrypto_aes_gcm_key *key, const uint8_t iv[12]);
+
+/**
+ * AES-GCM incremental additional authentication data input.
+ *
+ * This function can be called repeatedly until the whole data is processed.
+ *
+ * @param      ctx    State.
+ * @param      aa     Additional authentication data.
+ * @param      aa_len Length of @p aa.
+ *
+ * @remark @c ocrypto_aes_gcm_keyed_update_aad must be called before any call to
+ *         @c ocrypto_aes_gcm_keyed_update_enc or @c ocrypto_aes_gcm_keyed_update_dec.
+ */
+void ocrypto_aes_gcm_keyed_update_aad(
+    ocrypto_aes_gcm_keyed_ctx *ctx, const uint8_t *aa, size_t aa_len);
+
+/**
+ * AES-GCM incremental encryption.
+ *
+ * This function can be called repeatedly until the whole message is processed.
+ *
+ * @param      ctx    State.
+ * @param[out] ct     Cyphertext.
+ * @param      pt     Plaintext.
+ * @param      pt_len Length of @p pt and @p ct.
+ *
+ * @remark @p ct and @p pt can point to the same address.
+ */
+void ocrypto_aes_gcm_keyed_update_enc(
+    ocrypto_aes_gcm_keyed_ctx *ctx, uint8_t *ct, const uint8_t *pt, size_t pt_len);
+
+/**
+ * AES-GCM incremental decryption.
+ *
+ * This function can be called repeatedly until the whole cyphertext is processed.
+ *
+ * @param      ctx    State.
+ * @param[out] pt     Plaintext.
+ * @param      ct     Cyphertext.
+ * @param      ct_len Length of @p ct and @p pt.
+ *
+ * @remark @p ct and @p pt can point to the same address.
+ * @remark The plaintext is not authenticated until
+ *         @c ocrypto_aes_gcm_keyed_final_dec has returned 0. It must not be
+ *         used, e.g. an image must not be activated, before that.
+ */
+void ocrypto_aes_gcm_keyed_update_dec(
+    ocrypto_aes_gcm_keyed_ctx *ctx, uint8_t *pt, const uint8_t *ct, size_t ct_len);
+
+/**
+ * AES-GCM final encoder step.
+ *
+ * @param      ctx State. Cleared by this function.
+ * @param[out] tag Generated authentication tag.
+ */
+void ocrypto_aes_gcm_keyed_final_enc(ocrypto_aes_gcm_keyed_ctx *ctx, uint8_t tag[16]);
+
+/**
+ * AES-GCM final decoder step.
+ *
+ * @param      ctx State. Cleared by this function.
+ * @param      tag Received authentication tag.
+ *
+ * @retval 0  If @p tag is valid.
+ * @retval -1 Otherwise.
+ */
+int ocrypto_aes_gcm_keyed_final_dec(ocrypto_aes_gcm_keyed_ctx *ctx, const uint8_t tag[16]);
+/**@}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* #ifndef OCRYPTO_AES_GCM_KEY_H */
+
+/** @} */
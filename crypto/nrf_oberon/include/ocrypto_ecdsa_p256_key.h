@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+
+/**@file
+ * @defgroup nrf_oberon_ecdsa_key ECDSA APIs using a precomputed public key
+ * @ingroup nrf_oberon_ecdsa
+ * @{
+ * @brief Type declarations and APIs for ECDSA P-256 verification with a reusable public key.
+ *
+ * @c ocrypto_ecdsa_p256_verify decodes and validates the public key for every
+ * signature. When many signatures are checked against the same few keys,
+ * e.g. firmware signing keys, each key can be decoded and validated once into
+ * an @c ocrypto_ecdsa_p256_key. The key object also holds a table of small
+ * odd multiples of the public key, so that each verification is an
+ * interleaved sliding window double-scalar multiplication with shared
+ * doublings.
+ *
+ * Only public data is processed, so the verification does not run in
+ * constant time.
+ *
+ * The result is identical to that of @c ocrypto_ecdsa_p256_verify_hash.
+ */
+
+#ifndef OCRYPTO_ECDSA_P256_KEY_H
+#define OCRYPTO_ECDSA_P256_KEY_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+
+/**
+ * Precomputed ECDSA P-256 public key.
+ */
+typedef struct
+{
+    uint32_t q[8][2][8];    //!< Affine points Q, 3Q, ..., 15Q of the public key Q.
+} ocrypto_ecdsa_p256_key;
+
+
+/**
+ * ECDSA P-256 public key setup.
+ *
+ * The public key @p pk is decoded, validated, and its multiples are
+ * computed into @p key.
+ *
+ * @param[out] key Precomputed public key.
+ * @param      pk  Public key.
+ *
+ * @retval 0  If @p pk is a valid public key.
+ * @retval -1 Otherwise.
+ */
+int ocrypto_ecdsa_p256_key_init(ocrypto_ecdsa_p256_key *key, const uint8_t pk[64]);
+
+/**
+ * ECDSA P-256 signature verification using a precomputed public key.
+ *
+ * @param sig  Input signature.
+ * @param m    Input message.
+ * @param mlen Input length.
+ * @param key  Precomputed public key.
+ *
+ * @retval 0  If signature is valid.
+ * @retval -1 Otherwise.
+ *
+ * @remark Initialization of @p key through @c ocrypto_ecdsa_p256_key_init
+ *         is required before this function can be called.
+ */
+int ocrypto_ecdsa_p256_keyed_verify(
+    const uint8_t sig[64],
+    const uint8_t *m, size_t mlen,
+    const ocrypto_ecdsa_p256_key *key);
+
+/**
+ * ECDSA P-256 signature verification from hash using a precomputed public key.
+ *
+ * @param sig  Input signature.
+ * @param hash SHA-256 hash of the input message.
+ * @param key  Precomputed public key.
+ *
+ * @retval 0  If signature is valid.
+ * @retval -1 Otherwise.
+ *
+ * @remark Initialization of @p key through @c ocrypto_ecdsa_p256_key_init
+ *         is required before this function can be called.
+ */
+int ocrypto_ecdsa_p256_keyed_verify_hash(
+    const uint8_t sig[64],
+    const uint8_t hash[32],
+    const ocrypto_ecdsa_p256_key *key);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* #ifndef OCRYPTO_ECDSA_P256_KEY_H */
+
+/** @} */
@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+
+/**@file
+ * @defgroup nrf_oberon_ecdsa_presig ECDSA APIs using precomputed session keys
+ * @ingroup nrf_oberon_ecdsa
+ * @{
+ * @brief Type declarations and APIs for ECDSA P-256 signing with the session key part done ahead of time.
+ *
+ * Most of the time of @c ocrypto_ecdsa_p256_sign_hash is spent on the
+ * session key: the point multiplication k * G and the inversion of k. Neither
+ * depends on the message or the secret key, so they can be computed in idle
+ * time into an @c ocrypto_ecdsa_p256_presig. Signing a hash with it is then
+ * two modular multiplications and an addition.
+ *
+ * A precomputed session key must only be used for one signature, otherwise
+ * the secret key can be computed from two signatures. Signing therefore
+ * clears the @c ocrypto_ecdsa_p256_presig, also when it fails, and a cleared
+ * one is rejected. An @c ocrypto_ecdsa_p256_presig must not be copied, nor
+ * stored in memory that can be restored, e.g. retained RAM or flash, as that
+ * would allow it to be used again.
+ *
+ * To keep a pool, fill an array of @c ocrypto_ecdsa_p256_presig in idle time
+ * and sign with the next filled entry.
+ *
+ * The secret values are processed in constant time. The signature verifies
+ * like one of @c ocrypto_ecdsa_p256_sign_hash with the same session key.
+ */
+
+#ifndef OCRYPTO_ECDSA_P256_PRESIG_H
+#define OCRYPTO_ECDSA_P256_PRESIG_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+
+/**
+ * Precomputed ECDSA P-256 session key.
+ */
+typedef struct
+{
+    uint32_t r[8];          //!< r = x(k * G) mod n.
+    uint32_t r_mont[8];     //!< r in Montgomery form.
+    uint32_t k_inv[8];      //!< k^-1 mod n in Montgomery form.
+    uint32_t valid;         //!< Nonzero until the session key is used.
+} ocrypto_ecdsa_p256_presig;
+
+
+/**
+ * ECDSA P-256 session key precomputation.
+ *
+ * @param[out] presig Precomputed session key.
+ * @param      ek     Session key, from a random number generator.
+ *
+ * @retval 0  If @p ek is a valid session key.
+ * @retval -1 Otherwise. A new @p ek must then be used.
+ */
+int ocrypto_ecdsa_p256_presign(ocrypto_ecdsa_p256_presig *presig, const uint8_t ek[32]);
+
+/**
+ * ECDSA P-256 signature generation from hash using a precomputed session key.
+ *
+ * @param[out]    sig    Generated signature.
+ * @param         hash   SHA-256 hash of the input message.
+ * @param         sk     Secret key.
+ * @param[in,out] presig Precomputed session key, cleared by this function.
+ *
+ * @retval 0  If the signature was generated.
+ * @retval -1 If @p presig has already been used, @p sk is not a valid
+ *            secret key, or s = 0. Signing can be retried with a new
+ *            @p presig.
+ *
+ * @remark Initialization of @p presig through @c ocrypto_ecdsa_p256_presign
+ *         is required before this function can be called.
+ */
+int ocrypto_ecdsa_p256_presig_sign_hash(
+    uint8_t sig[64],
+    const uint8_t hash[32],
+    const uint8_t sk[32],
+    ocrypto_ecdsa_p256_presig *presig);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* #ifndef OCRYPTO_ECDSA_P256_PRESIG_H */
+
+/** @} */
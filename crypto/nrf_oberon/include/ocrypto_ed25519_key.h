@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+
+/**@file
+ * @defgroup nrf_oberon_ed25519_key Ed25519 APIs using a precomputed public key
+ * @ingroup nrf_oberon_ed25519
+ * @{
+ * @brief Type declarations and APIs for Ed25519 verification with reusable public keys.
+ *
+ * @c ocrypto_ed25519_verify decompresses the public key for every signature.
+ * When many signatures are checked against a small set of keys, each key can
+ * be decompressed once into an @c ocrypto_ed25519_key, together with a table
+ * of small odd multiples of the key. Each verification is then an
+ * interleaved sliding window double-scalar multiplication.
+ *
+ * Several signatures can also be checked together with
+ * @c ocrypto_ed25519_verify_batch, which shares the point doublings between
+ * all signatures of a batch.
+ *
+ * Only public data is processed, so the verification does not run in
+ * constant time.
+ */
+
+#ifndef OCRYPTO_ED25519_KEY_H
+#define OCRYPTO_ED25519_KEY_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "ocrypto_ed25519.h"
+
+
+/**
+ * Precomputed Ed25519 public key.
+ */
+typedef struct
+{
+    uint8_t pk[ocrypto_ed25519_PUBLIC_KEY_BYTES];   //!< Public key.
+    uint32_t a[8][3][8];                            //!< Points A, 3A, ..., 15A of the public key A.
+} ocrypto_ed25519_key;
+
+
+/**
+ * Ed25519 public key setup.
+ *
+ * The public key @p pk is decompressed and its multiples are computed into
+ * @p key.
+ *
+ * @param[out] key Precomputed public key.
+ * @param      pk  Public key.
+ *
+ * @retval 0  If @p pk is a valid public key.
+ * @retval -1 Otherwise.
+ */
+int ocrypto_ed25519_key_init(ocrypto_ed25519_key *key,
+                             const uint8_t pk[ocrypto_ed25519_PUBLIC_KEY_BYTES]);
+
+/**
+ * Ed25519 signature verification using a precomputed public key.
+ *
+ * @param sig   Signature.
+ * @param m     Message.
+ * @param m_len Length of @p m.
+ * @param key   Precomputed public key.
+ *
+ * @retval 0  If the signature is valid.
+ * @retval -1 Otherwise.
+ *
+ * @remark Initialization of @p key through @c ocrypto_ed25519_key_init
+ *         is required before this function can be called.
+ */
+int ocrypto_ed25519_keyed_verify(const uint8_t sig[ocrypto_ed25519_BYTES],
+                                 const uint8_t *m, size_t m_len,
+                                 const ocrypto_ed25519_key *key);
+
+/**
+ * Ed25519 batch signature verification.
+ *
+ * Signature @p sig[i] of message @p m[i] with length @p m_len[i] is checked
+ * against the public key @p key[i], for all @p count signatures. The
+ * signatures are checked in groups of four with a random linear combination
+ * of the verification equations. The combination coefficients are derived
+ * from the signatures and messages.
+ *
+ * @param sig   Array of @p count signatures.
+ * @param m     Array of @p count messages.
+ * @param m_len Array of @p count message lengths.
+ * @param key   Array of @p count precomputed public keys.
+ * @param count Number of signatures.
+ *
+ * @retval 0  If all signatures are valid.
+ * @retval -1 If at least one signature is invalid.
+ *
+ * @remark The batch check multiplies the combined equation by the cofactor.
+ *         A signature with a deliberately crafted small order component can
+ *         pass the batch check and fail @c ocrypto_ed25519_keyed_verify.
+ *         If a batch fails, the signatures can be checked one by one to find
+ *         the invalid ones.
+ * @remark About 4 kB of stack is used.
+ */
+int ocrypto_ed25519_verify_batch(const uint8_t * const sig[],
+                                 const uint8_t * const m[], const size_t m_len[],
+                                 const ocrypto_ed25519_key * const key[],
+                                 size_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* #ifndef OCRYPTO_ED25519_KEY_H */
+
+/** @} */
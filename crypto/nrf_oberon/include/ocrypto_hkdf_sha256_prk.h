@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+
+/**@file
+ * @defgroup nrf_oberon_hkdf_256_prk HKDF-SHA256 APIs with separate Extract and Expand
+ * @ingroup nrf_oberon_hkdf
+ * @{
+ * @brief Type declarations and APIs for HKDF-SHA256 with a reusable pseudorandom key.
+ *
+ * @c ocrypto_hkdf_sha256 runs both HKDF steps for every derived key. Key
+ * schedules such as the one of TLS 1.3 derive many keys from the same
+ * pseudorandom key (PRK) with different labels. Here the Extract step
+ * produces an @c ocrypto_hkdf_sha256_prk, which holds the PRK as an
+ * HMAC-SHA256 key schedule, and any number of Expand steps can then be run
+ * from it without repeating the Extract step or the HMAC key setup.
+ *
+ * The output is identical to @c ocrypto_hkdf_sha256.
+ */
+
+#ifndef OCRYPTO_HKDF_SHA256_PRK_H
+#define OCRYPTO_HKDF_SHA256_PRK_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "ocrypto_hmac_sha256_key.h"
+
+
+/**
+ * Maximum length of a key derived with @c ocrypto_hkdf_sha256_expand.
+ */
+#define ocrypto_hkdf_sha256_prk_LENGTH_MAX (255 * ocrypto_sha256_BYTES)
+
+
+/**
+ * HKDF-SHA256 pseudorandom key.
+ *
+ * The key holds secret material and should be cleared after use.
+ */
+typedef struct
+{
+    ocrypto_hmac_sha256_key key;    //!< HMAC-SHA256 key schedule of the PRK.
+} ocrypto_hkdf_sha256_prk;
+
+
+/**
+ * HKDF-SHA256 Extract step.
+ *
+ * The pseudorandom key @p prk is extracted from an input key @p key and a
+ * salt @p salt.
+ *
+ * @param[out] prk      Pseudorandom key.
+ * @param      key      Input key.
+ * @param      key_len  Length of @p key.
+ * @param      salt     Salt.
+ * @param      salt_len Length of salt @p salt.
+ */
+void ocrypto_hkdf_sha256_extract(ocrypto_hkdf_sha256_prk *prk,
+                                 const uint8_t *key, size_t key_len,
+                                 const uint8_t *salt, size_t salt_len);
+
+/**
+ * HKDF-SHA256 pseudorandom key setup from an existing PRK.
+ *
+ * For keys that are already uniformly random, e.g. the traffic secrets of
+ * TLS 1.3, the Extract step is skipped.
+ *
+ * @param[out] prk     Pseudorandom key.
+ * @param      key     Existing PRK.
+ * @param      key_len Length of @p key, at least @c ocrypto_sha256_BYTES.
+ */
+void ocrypto_hkdf_sha256_prk_init(ocrypto_hkdf_sha256_prk *prk,
+                                  const uint8_t *key, size_t key_len);
+
+/**
+ * HKDF-SHA256 pseudorandom key clearing.
+ *
+ * @param[out] prk Pseudorandom key to clear.
+ */
+void ocrypto_hkdf_sha256_prk_clear(ocrypto_hkdf_sha256_prk *prk);
+
+/**
+ * HKDF-SHA256 Expand step.
+ *
+ * A new key of length @p r_len is derived from the pseudorandom key @p prk
+ * and additional information @p info.
+ *
+ * @param[out] r        Output key.
+ * @param      r_len    Length of @p r, 0 < @p r_len <= @c ocrypto_hkdf_sha256_prk_LENGTH_MAX.
+ * @param      prk      Pseudorandom key.
+ * @param      info     Additional information.
+ * @param      info_len Length of @p info.
+ */
+void ocrypto_hkdf_sha256_expand(uint8_t *r, size_t r_len,
+                                const ocrypto_hkdf_sha256_prk *prk,
+                                const uint8_t *info, size_t info_len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* #ifndef OCRYPTO_HKDF_SHA256_PRK_H */
+
+/** @} */
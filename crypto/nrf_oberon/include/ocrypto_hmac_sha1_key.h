@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+
+/**@file
+ * @defgroup nrf_oberon_hmac_1_key HMAC-SHA1 APIs using a precomputed key
+ * @ingroup nrf_oberon_hmac
+ * @{
+ * @brief Type declarations and APIs for HMAC-SHA1 with a reusable key schedule.
+ *
+ * HMAC-SHA1 hashes an inner and an outer key block for every message. When
+ * many messages are authenticated with the same key, e.g. the packets of an
+ * SRTP stream, the SHA-1 states after those two blocks can be computed once
+ * and stored in an @c ocrypto_hmac_sha1_key. Each message then starts from a
+ * copy of the stored states, which saves two SHA-1 compressions per message.
+ *
+ * For SRTP (RFC 3711, section 4.2), the message is the authenticated portion
+ * of the packet followed by the 32-bit rollover counter in big endian, and
+ * the tag is the first bytes of the output. The packet and the counter can
+ * be passed in two calls to @c ocrypto_hmac_sha1_keyed_update.
+ */
+
+#ifndef OCRYPTO_HMAC_SHA1_KEY_H
+#define OCRYPTO_HMAC_SHA1_KEY_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "ocrypto_sha1.h"
+
+
+/**
+ * Precomputed HMAC-SHA1 key schedule.
+ *
+ * The key schedule holds secret material and should be cleared after use.
+ */
+typedef struct
+{
+    ocrypto_sha1_ctx inner;     //!< SHA-1 state after the inner key block.
+    ocrypto_sha1_ctx outer;     //!< SHA-1 state after the outer key block.
+} ocrypto_hmac_sha1_key;
+
+/**@cond */
+typedef struct
+{
+    ocrypto_sha1_ctx hash_ctx;
+    const ocrypto_hmac_sha1_key *key;
+} ocrypto_hmac_sha1_keyed_ctx;
+/**@endcond */
+
+
+/**
+ * HMAC-SHA1 key schedule setup.
+ *
+ * The key schedule @p key is computed from the HMAC key @p k.
+ * Keys longer than the SHA-1 block size are hashed first, as specified in
+ * RFC 2104.
+ *
+ * @param[out] key   Key schedule.
+ * @param      k     HMAC key.
+ * @param      k_len Length of @p k.
+ */
+void ocrypto_hmac_sha1_key_init(ocrypto_hmac_sha1_key *key,
+                                const uint8_t *k, size_t k_len);
+
+/**
+ * HMAC-SHA1 key schedule clearing.
+ *
+ * @param[out] key Key schedule to clear.
+ */
+void ocrypto_hmac_sha1_key_clear(ocrypto_hmac_sha1_key *key);
+
+/**@name Incremental HMAC-SHA1 generator using a key schedule.
+ *
+ * This group of functions can be used to incrementally compute HMAC-SHA1
+ * for a given message with a precomputed key schedule.
+ */
+/**@{*/
+/**
+ * HMAC-SHA1 initialization from a key schedule.
+ *
+ * The generator state @p ctx is initialized by this function.
+ *
+ * @param[out] ctx Generator state.
+ * @param      key Key schedule. Must be kept until
+ *                 @c ocrypto_hmac_sha1_keyed_final returns.
+ */
+void ocrypto_hmac_sha1_keyed_init(ocrypto_hmac_sha1_keyed_ctx *ctx,
+                                  const ocrypto_hmac_sha1_key *key);
+
+/**
+ * HMAC-SHA1 incremental data input.
+ *
+ * @param[in,out] ctx    Generator state.
+ * @param         in     Input data.
+ * @param         in_len Length of @p in.
+ *
+ * @remark Initialization of the generator state @p ctx through
+ *         @c ocrypto_hmac_sha1_keyed_init is required before this function can be called.
+ */
+void ocrypto_hmac_sha1_keyed_update(ocrypto_hmac_sha1_keyed_ctx *ctx,
+                                    const uint8_t *in, size_t in_len);
+
+/**
+ * HMAC-SHA1 output.
+ *
+ * @param[in,out] ctx Generator state.
+ * @param[out]    r   Generated HMAC digest.
+ *
+ * @remark After return, the generator state @p ctx must be reinitialized
+ *         using @c ocrypto_hmac_sha1_keyed_init before it is used again.
+ */
+void ocrypto_hmac_sha1_keyed_final(ocrypto_hmac_sha1_keyed_ctx *ctx,
+                                   uint8_t r[ocrypto_sha1_BYTES]);
+/**@}*/
+
+/**
+ * HMAC-SHA1 algorithm using a key schedule.
+ *
+ * @param[out] r      HMAC output.
+ * @param      key    Key schedule.
+ * @param      in     Input data.
+ * @param      in_len Length of @p in.
+ */
+void ocrypto_hmac_sha1_keyed(uint8_t r[ocrypto_sha1_BYTES],
+                             const ocrypto_hmac_sha1_key *key,
+                             const uint8_t *in, size_t in_len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* #ifndef OCRYPTO_HMAC_SHA1_KEY_H */
+
+/** @} */
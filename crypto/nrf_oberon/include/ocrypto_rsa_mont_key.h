@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+
+/**@file
+ * @defgroup nrf_oberon_rsa_mont_key RSA verification with precomputed public keys
+ * @ingroup nrf_oberon_rsa
+ * @{
+ * @brief Type declarations and APIs for RSA-2048 verification with reusable public keys.
+ *
+ * An @c ocrypto_rsa2048_mont_pub_key holds the modulus together with its
+ * Montgomery constants R^2 mod n and -1/n mod 2^32. The constants are
+ * computed once in @c ocrypto_rsa2048_init_mont_pub_key, so that keys which
+ * are used for many verifications, e.g. certificate authority keys, can be
+ * kept and reused without any further setup.
+ *
+ * Only public data is processed, so the verification does not run in
+ * constant time.
+ */
+
+#ifndef OCRYPTO_RSA_MONT_KEY_H
+#define OCRYPTO_RSA_MONT_KEY_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+
+/**
+ * 2048-bit RSA public key with Montgomery constants.
+ */
+typedef struct {
+    uint32_t n[64];     //!< Modulus, least significant word first.
+    uint32_t rr[64];    //!< 2^4096 mod n.
+    uint32_t ninv;      //!< -1/n mod 2^32.
+    // e = 65537
+} ocrypto_rsa2048_mont_pub_key;
+
+
+/**
+ * 2048-bit RSA public key setup with Montgomery constants.
+ *
+ * @param[out] k       The initialized public key.
+ * @param      n       The RSA modulus. Must be exactly 2048 bits.
+ * @param      nlen    Length of @p n.
+ *
+ * @retval -1 If the input length is not correct or @p n is even.
+ * @retval 0  Otherwise.
+ *
+ * @remark The public exponent is fixed at 65537.
+ */
+int ocrypto_rsa2048_init_mont_pub_key(
+    ocrypto_rsa2048_mont_pub_key *k,
+    const uint8_t *n, size_t nlen);
+
+/**
+ * 2048-bit RSA PKCS1 V1.5 SHA-256 signature verify using a precomputed key.
+ *
+ * The signature @p s is verified for a correct signature of message @p m.
+ *
+ * @param s      The 256-byte signature.
+ * @param m      The signed message.
+ * @param mlen   Length of @p m.
+ * @param pk     A valid 2048-bit RSA public key with Montgomery constants.
+ *
+ * @retval 0  If the signature is successfully verified.
+ * @retval -1 If verification failed.
+ *
+ * @remark The key @p pk should be initialized with @c ocrypto_rsa2048_init_mont_pub_key.
+ */
+int ocrypto_rsa2048_mont_pkcs1_v15_sha256_verify(
+    const uint8_t s[256],
+    const uint8_t *m, size_t mlen,
+    const ocrypto_rsa2048_mont_pub_key *pk);
+
+/**
+ * 2048-bit RSA PSS SHA-256 signature verify using a precomputed key.
+ *
+ * The signature @p s is verified for a correct signature of message @p m.
+ *
+ * @param s      The 256-byte signature.
+ * @param m      The signed message.
+ * @param mlen   Length of @p m.
+ * @param slen   The length of the salt.
+ * @param pk     A valid 2048-bit RSA public key with Montgomery constants.
+ *
+ * @retval 0   If the signature is successfully verified.
+ * @retval -1  If verification failed.
+ * @retval -2  If the salt is too long.
+ *
+ * @remark The key @p pk should be initialized with @c ocrypto_rsa2048_init_mont_pub_key.
+ */
+int ocrypto_rsa2048_mont_pss_sha256_verify(
+    const uint8_t s[256],
+    const uint8_t *m, size_t mlen,
+    size_t slen, // salt length
+    const ocrypto_rsa2048_mont_pub_key *pk);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* #ifndef OCRYPTO_RSA_MONT_KEY_H */
+
+/** @} */
@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+
+/**@file
+ * @defgroup nrf_oberon_sha_256_multi SHA-256 APIs for multiple messages
+ * @ingroup nrf_oberon_sha_256
+ * @{
+ * @brief API to compute SHA-256 of many independent messages in one call.
+ *
+ * Messages are hashed two at a time, with the compression rounds of both
+ * messages interleaved. The rounds of one message do not depend on the
+ * other, so the CPU pipeline is kept busy while one message waits for the
+ * result of the previous instruction. This gives a higher throughput than
+ * calling @c ocrypto_sha256 for each message, in particular for many short
+ * messages of similar length, like Merkle tree nodes.
+ *
+ * The digests are identical to those of @c ocrypto_sha256.
+ */
+
+#ifndef OCRYPTO_SHA256_MULTI_H
+#define OCRYPTO_SHA256_MULTI_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "ocrypto_sha256.h"
+
+
+/**
+ * SHA-256 hash of multiple messages.
+ *
+ * The SHA-256 digest of each message @p in[i] of length @p in_len[i] is
+ * put into @p r[i].
+ *
+ * @param[out] r      Array of @p count generated hash values.
+ * @param      in     Array of @p count pointers to input data.
+ * @param      in_len Array of @p count input lengths.
+ * @param      count  Number of messages.
+ */
+void ocrypto_sha256_multi(
+    uint8_t r[][ocrypto_sha256_BYTES],
+    const uint8_t * const in[], const size_t in_len[],
+    size_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* #ifndef OCRYPTO_SHA256_MULTI_H */
+
+/** @} */
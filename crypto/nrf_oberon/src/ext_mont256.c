@@ -0,0 +1,285 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "ext_mont256.h"
+#include "ext_wipe.h"
+
+void ext_mont256_load_be(uint32_t r[8], const uint8_t a[32])
+{
+    int i;
+
+    for (i = 0; i < 8; i++) {
+        r[i] = ((uint32_t)a[31 - 4 * i - 3] << 24) | ((uint32_t)a[31 - 4 * i - 2] << 16) |
+               ((uint32_t)a[31 - 4 * i - 1] << 8) | (uint32_t)a[31 - 4 * i];
+    }
+}
+
+void ext_mont256_load_le(uint32_t r[8], const uint8_t a[32])
+{
+    int i;
+
+    for (i = 0; i < 8; i++) {
+        r[i] = ((uint32_t)a[4 * i + 3] << 24) | ((uint32_t)a[4 * i + 2] << 16) |
+               ((uint32_t)a[4 * i + 1] << 8) | (uint32_t)a[4 * i];
+    }
+}
+
+void ext_mont256_store_le(uint8_t r[32], const uint32_t a[8])
+{
+    int i;
+
+    for (i = 0; i < 8; i++) {
+        r[4 * i] = (uint8_t)a[i];
+        r[4 * i + 1] = (uint8_t)(a[i] >> 8);
+        r[4 * i + 2] = (uint8_t)(a[i] >> 16);
+        r[4 * i + 3] = (uint8_t)(a[i] >> 24);
+    }
+}
+
+int ext_mont256_is_zero(const uint32_t a[8])
+{
+    uint32_t x = 0;
+    int i;
+
+    for (i = 0; i < 8; i++) {
+        x |= a[i];
+    }
+    return x == 0;
+}
+
+int ext_mont256_lt(const uint32_t a[8], const uint32_t b[8])
+{
+    int i;
+
+    for (i = 7; i >= 0; i--) {
+        if (a[i] != b[i]) {
+            return a[i] < b[i];
+        }
+    }
+    return 0;
+}
+
+uint32_t ext_mont256_add_raw(uint32_t r[8], const uint32_t a[8], const uint32_t b[8])
+{
+    uint64_t c = 0;
+    int i;
+
+    for (i = 0; i < 8; i++) {
+        c += (uint64_t)a[i] + b[i];
+        r[i] = (uint32_t)c;
+        c >>= 32;
+    }
+    return (uint32_t)c;
+}
+
+uint32_t ext_mont256_sub_raw(uint32_t r[8], const uint32_t a[8], const uint32_t b[8])
+{
+    uint64_t c;
+    uint32_t borrow = 0;
+    int i;
+
+    for (i = 0; i < 8; i++) {
+        c = (uint64_t)a[i] - b[i] - borrow;
+        r[i] = (uint32_t)c;
+        borrow = (uint32_t)(c >> 32) & 1;
+    }
+    return borrow;
+}
+
+void ext_mont256_add(uint32_t r[8], const uint32_t a[8], const uint32_t b[8],
+                     const ext_mont256_mod *mod)
+{
+    if (ext_mont256_add_raw(r, a, b) || !ext_mont256_lt(r, mod->m)) {
+        ext_mont256_sub_raw(r, r, mod->m);
+    }
+}
+
+void ext_mont256_sub(uint32_t r[8], const uint32_t a[8], const uint32_t b[8],
+                     const ext_mont256_mod *mod)
+{
+    if (ext_mont256_sub_raw(r, a, b)) {
+        ext_mont256_add_raw(r, r, mod->m);
+    }
+}
+
+/* t = a * b / 2^256, less than 2 * m, with the carry in t[8]. */
+static void ext_mont256_mul_raw(uint32_t t[10], const uint32_t a[8], const uint32_t b[8],
+                                const ext_mont256_mod *mod)
+{
+    uint64_t c;
+    uint32_t u;
+    int i, j;
+
+    memset(t, 0, 10 * sizeof(uint32_t));
+
+    for (i = 0; i < 8; i++) {
+        c = 0;
+        for (j = 0; j < 8; j++) {
+            c += (uint64_t)t[j] + (uint64_t)a[j] * b[i];
+            t[j] = (uint32_t)c;
+            c >>= 32;
+        }
+        c += t[8];
+        t[8] = (uint32_t)c;
+        t[9] = (uint32_t)(c >> 32);
+
+        u = t[0] * mod->ninv;
+        c = ((uint64_t)t[0] + (uint64_t)u * mod->m[0]) >> 32;
+        for (j = 1; j < 8; j++) {
+            c += (uint64_t)t[j] + (uint64_t)u * mod->m[j];
+            t[j - 1] = (uint32_t)c;
+            c >>= 32;
+        }
+        c += t[8];
+        t[7] = (uint32_t)c;
+        t[8] = t[9] + (uint32_t)(c >> 32);
+    }
+}
+
+/* r = a - m if a >= m, for a less than 2 * m with the carry in @p hi, without branches. */
+static void ext_mont256_reduce_once_ct(uint32_t r[8], const uint32_t a[8], uint32_t hi,
+                                       const ext_mont256_mod *mod)
+{
+    uint32_t d[8];
+    uint32_t mask;
+    int i;
+
+    mask = 0 - (hi | (ext_mont256_sub_raw(d, a, mod->m) ^ 1));
+    for (i = 0; i < 8; i++) {
+        r[i] = (d[i] & mask) | (a[i] & ~mask);
+    }
+}
+
+void ext_mont256_mul(uint32_t r[8], const uint32_t a[8], const uint32_t b[8],
+                     const ext_mont256_mod *mod)
+{
+    uint32_t t[10];
+
+    ext_mont256_mul_raw(t, a, b, mod);
+
+    if (t[8] || !ext_mont256_lt(t, mod->m)) {
+        ext_mont256_sub_raw(t, t, mod->m);
+    }
+    memcpy(r, t, 32);
+}
+
+void ext_mont256_pow(uint32_t r[8], const uint32_t a[8], const uint32_t e[8],
+                     const ext_mont256_mod *mod)
+{
+    uint32_t x[8];
+    int i;
+
+    memcpy(x, mod->one, sizeof(x));
+    for (i = 255; i >= 0; i--) {
+        ext_mont256_mul(x, x, x, mod);
+        if ((e[i >> 5] >> (i & 31)) & 1) {
+            ext_mont256_mul(x, x, a, mod);
+        }
+    }
+    memcpy(r, x, sizeof(x));
+}
+
+void ext_mont256_inv(uint32_t r[8], const uint32_t a[8], const ext_mont256_mod *mod)
+{
+    uint32_t e[8];
+
+    /* Fermat, a^(m - 2). The low word of every supported modulus is >= 2. */
+    memcpy(e, mod->m, sizeof(e));
+    e[0] -= 2;
+    ext_mont256_pow(r, a, e, mod);
+}
+
+void ext_mont256_reduce_ct(uint32_t r[8], const uint32_t a[8], const ext_mont256_mod *mod)
+{
+    ext_mont256_reduce_once_ct(r, a, 0, mod);
+}
+
+void ext_mont256_add_ct(uint32_t r[8], const uint32_t a[8], const uint32_t b[8],
+                        const ext_mont256_mod *mod)
+{
+    uint32_t t[8];
+    uint32_t carry;
+
+    carry = ext_mont256_add_raw(t, a, b);
+    ext_mont256_reduce_once_ct(r, t, carry, mod);
+    ext_wipe(t, sizeof(t));
+}
+
+void ext_mont256_mul_ct(uint32_t r[8], const uint32_t a[8], const uint32_t b[8],
+                        const ext_mont256_mod *mod)
+{
+    uint32_t t[10];
+
+    ext_mont256_mul_raw(t, a, b, mod);
+    ext_mont256_reduce_once_ct(r, t, t[8], mod);
+    ext_wipe(t, sizeof(t));
+}
+
+void ext_mont256_inv_ct(uint32_t r[8], const uint32_t a[8], const ext_mont256_mod *mod)
+{
+    uint32_t x[8];
+    uint32_t e[8];
+    int i;
+
+    /* Fermat, a^(m - 2). The exponent is public, only the multiplications need to be constant time. */
+    memcpy(e, mod->m, sizeof(e));
+    e[0] -= 2;
+
+    memcpy(x, mod->one, sizeof(x));
+    for (i = 255; i >= 0; i--) {
+        ext_mont256_mul_ct(x, x, x, mod);
+        if ((e[i >> 5] >> (i & 31)) & 1) {
+            ext_mont256_mul_ct(x, x, a, mod);
+        }
+    }
+    memcpy(r, x, sizeof(x));
+    ext_wipe(x, sizeof(x));
+}
+
+int ext_mont256_wnaf(int8_t naf[257], const uint32_t s[8], int w)
+{
+    const uint32_t mask = (1U << w) - 1;
+    const int half = 1 << (w - 1);
+    uint32_t k[9];
+    uint64_t c;
+    int d, i, j;
+
+    memcpy(k, s, 32);
+    k[8] = 0;
+    memset(naf, 0, 257);
+
+    for (i = 0; !ext_mont256_is_zero(k) || k[8]; i++) {
+        if (k[0] & 1) {
+            d = (int)(k[0] & mask);
+            if (d >= half) {
+                d -= 2 * half;
+            }
+            naf[i] = (int8_t)d;
+
+            /* k -= d, which clears the low w bits. */
+            if (d > 0) {
+                k[0] -= (uint32_t)d;
+            } else {
+                c = (uint64_t)k[0] + (uint32_t)-d;
+                k[0] = (uint32_t)c;
+                for (j = 1; j < 9 && (c >> 32); j++) {
+                    c = (uint64_t)k[j] + 1;
+                    k[j] = (uint32_t)c;
+                }
+            }
+        }
+
+        for (j = 0; j < 8; j++) {
+            k[j] = (k[j] >> 1) | (k[j + 1] << 31);
+        }
+        k[8] >>= 1;
+    }
+
+    return i;
+}
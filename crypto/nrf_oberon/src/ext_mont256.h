@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+
+/**@file
+ * @brief Internal 256-bit Montgomery arithmetic for the nrf_oberon companion sources.
+ *
+ * Numbers are 8 little endian 32-bit words. Residues are kept fully reduced.
+ * The functions run in variable time and must only be used on public data,
+ * except for the ones with a _ct suffix.
+ */
+
+#ifndef EXT_MONT256_H
+#define EXT_MONT256_H
+
+#include <stdint.h>
+
+/** @brief Odd modulus with its Montgomery constants.
+ */
+typedef struct {
+    uint32_t m[8];          //!< Modulus.
+    uint32_t ninv;          //!< -m^-1 mod 2^32.
+    uint32_t rr[8];         //!< 2^512 mod m.
+    uint32_t one[8];        //!< 2^256 mod m, 1 in Montgomery form.
+} ext_mont256_mod;
+
+/** @brief Load a 32 byte big endian number. */
+void ext_mont256_load_be(uint32_t r[8], const uint8_t a[32]);
+
+/** @brief Load a 32 byte little endian number. */
+void ext_mont256_load_le(uint32_t r[8], const uint8_t a[32]);
+
+/** @brief Store a number as 32 bytes little endian. */
+void ext_mont256_store_le(uint8_t r[32], const uint32_t a[8]);
+
+/** @brief a == 0. */
+int ext_mont256_is_zero(const uint32_t a[8]);
+
+/** @brief a < b. */
+int ext_mont256_lt(const uint32_t a[8], const uint32_t b[8]);
+
+/** @brief r = a + b, returns the carry. */
+uint32_t ext_mont256_add_raw(uint32_t r[8], const uint32_t a[8], const uint32_t b[8]);
+
+/** @brief r = a - b, returns the borrow. */
+uint32_t ext_mont256_sub_raw(uint32_t r[8], const uint32_t a[8], const uint32_t b[8]);
+
+/** @brief r = a + b mod m. */
+void ext_mont256_add(uint32_t r[8], const uint32_t a[8], const uint32_t b[8],
+                     const ext_mont256_mod *mod);
+
+/** @brief r = a - b mod m. */
+void ext_mont256_sub(uint32_t r[8], const uint32_t a[8], const uint32_t b[8],
+                     const ext_mont256_mod *mod);
+
+/** @brief r = a * b / 2^256 mod m. a * b must be less than m * 2^256. */
+void ext_mont256_mul(uint32_t r[8], const uint32_t a[8], const uint32_t b[8],
+                     const ext_mont256_mod *mod);
+
+/** @brief r = a^e, with a and r in Montgomery form. */
+void ext_mont256_pow(uint32_t r[8], const uint32_t a[8], const uint32_t e[8],
+                     const ext_mont256_mod *mod);
+
+/** @brief r = a^-1 for prime m, with a and r in Montgomery form. */
+void ext_mont256_inv(uint32_t r[8], const uint32_t a[8], const ext_mont256_mod *mod);
+
+/** @brief r = a mod m for a < 2 * m, in constant time. */
+void ext_mont256_reduce_ct(uint32_t r[8], const uint32_t a[8], const ext_mont256_mod *mod);
+
+/** @brief r = a + b mod m, in constant time. */
+void ext_mont256_add_ct(uint32_t r[8], const uint32_t a[8], const uint32_t b[8],
+                        const ext_mont256_mod *mod);
+
+/** @brief r = a * b / 2^256 mod m, in constant time. a * b must be less than m * 2^256. */
+void ext_mont256_mul_ct(uint32_t r[8], const uint32_t a[8], const uint32_t b[8],
+                        const ext_mont256_mod *mod);
+
+/** @brief r = a^-1 for prime m, with a and r in Montgomery form, in constant time. */
+void ext_mont256_inv_ct(uint32_t r[8], const uint32_t a[8], const ext_mont256_mod *mod);
+
+/** @brief Width-w NAF of @p s, returns the number of digits.
+ *
+ * The digits are odd and less than 2^(w - 1) in absolute value.
+ */
+int ext_mont256_wnaf(int8_t naf[257], const uint32_t s[8], int w);
+
+#endif /* #ifndef EXT_MONT256_H */
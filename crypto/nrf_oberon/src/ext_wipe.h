@@ -0,0 +1,28 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+
+/**@file
+ * @brief Internal memory wipe for the nrf_oberon companion sources.
+ */
+
+#ifndef EXT_WIPE_H
+#define EXT_WIPE_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/** @brief Clear memory in a way that is not removed by the compiler
+ */
+static inline void ext_wipe(void *p, size_t len)
+{
+    volatile uint8_t *v = p;
+
+    while (len--) {
+        *v++ = 0;
+    }
+}
+
+#endif /* #ifndef EXT_WIPE_H */
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "ocrypto_aes_ctr.h"
+#include "ocrypto_aes_ctr_keystream.h"
+#include "ext_wipe.h"
+
+void ocrypto_aes_ctr_keystream_init(ocrypto_aes_ctr_keystream_ctx *ctx,
+                                    uint8_t *buf, size_t buf_size,
+                                    const uint8_t *key, size_t size,
+                                    const uint8_t iv[16])
+{
+    ocrypto_aes_ctr_init(&ctx->ctr, key, size, iv);
+    ctx->buf = buf;
+    ctx->size = buf_size;
+    ctx->pos = 0;
+    ctx->fill = 0;
+}
+
+void ocrypto_aes_ctr_keystream_refill(ocrypto_aes_ctr_keystream_ctx *ctx)
+{
+    size_t left = ctx->fill - ctx->pos;
+
+    /* Keep the unused keystream, in order, at the start of the buffer. */
+    if (ctx->pos != 0) {
+        memmove(ctx->buf, ctx->buf + ctx->pos, left);
+        ctx->pos = 0;
+        ctx->fill = left;
+    }
+
+    if (ctx->fill < ctx->size) {
+        /* The keystream is the encryption of zeros. */
+        memset(ctx->buf + ctx->fill, 0, ctx->size - ctx->fill);
+        ocrypto_aes_ctr_encrypt(&ctx->ctr, ctx->buf + ctx->fill,
+                                ctx->buf + ctx->fill, ctx->size - ctx->fill);
+        ctx->fill = ctx->size;
+    }
+}
+
+size_t ocrypto_aes_ctr_keystream_available(const ocrypto_aes_ctr_keystream_ctx *ctx)
+{
+    return ctx->fill - ctx->pos;
+}
+
+void ocrypto_aes_ctr_keystream_xor(ocrypto_aes_ctr_keystream_ctx *ctx,
+                                   uint8_t *out, const uint8_t *in, size_t in_len)
+{
+    size_t n = ctx->fill - ctx->pos;
+    const uint8_t *ks;
+    size_t i;
+
+    if (n > in_len) {
+        n = in_len;
+    }
+
+    ks = ctx->buf + ctx->pos;
+    for (i = 0; i < n; i++) {
+        out[i] = in[i] ^ ks[i];
+    }
+    ext_wipe(ctx->buf + ctx->pos, n);
+    ctx->pos += n;
+
+    if (ctx->pos == ctx->fill) {
+        ctx->pos = 0;
+        ctx->fill = 0;
+    }
+
+    /* The counter is positioned right after the buffered keystream. */
+    if (in_len > n) {
+        ocrypto_aes_ctr_encrypt(&ctx->ctr, out + n, in + n, in_len - n);
+    }
+}
+
+void ocrypto_aes_ctr_keystream_clear(ocrypto_aes_ctr_keystream_ctx *ctx)
+{
+    if (ctx->buf != NULL) {
+        ext_wipe(ctx->buf, ctx->size);
+    }
+    ext_wipe(ctx, sizeof(*ctx));
+}
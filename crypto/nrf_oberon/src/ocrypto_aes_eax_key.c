@@ -0,0 +1,242 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "ocrypto_aes_ctr.h"
+#include "ocrypto_aes_ctr_reset.h"
+#include "ocrypto_constant_time.h"
+#include "ocrypto_aes_eax_key.h"
+#include "ext_wipe.h"
+
+/** @brief r = 2 * x in GF(2^128).
+ */
+static void aes_eax_double(uint8_t r[16], const uint8_t x[16])
+{
+    uint8_t carry = x[0] >> 7;
+    int i;
+
+    for (i = 0; i < 15; i++) {
+        r[i] = (uint8_t)((x[i] << 1) | (x[i + 1] >> 7));
+    }
+    r[15] = (uint8_t)((x[15] << 1) ^ (0x87 & (0 - carry)));
+}
+
+/** @brief Start OMAC(K, [t] || ...).
+ */
+static void aes_eax_omac_start(ocrypto_aes_eax_keyed_ctx *ctx, int t)
+{
+    memcpy(ctx->x, ctx->key->omac[t], 16);
+    ctx->pos = 0;
+    ctx->t = (uint8_t)t;
+}
+
+/** @brief Add @p m to the OMAC state.
+ *
+ * The encryption of a completed block is deferred until more input arrives,
+ * as the final block is treated differently.
+ */
+static void aes_eax_omac_update(ocrypto_aes_eax_keyed_ctx *ctx, const uint8_t *m, size_t m_len)
+{
+    size_t i, n;
+
+    while (m_len > 0) {
+        if (ctx->pos == 16) {
+            ocrypto_aes_ctr_block(&ctx->mac, ctx->x, ctx->x);
+            ctx->pos = 0;
+        }
+        n = 16 - ctx->pos;
+        if (n > m_len) {
+            n = m_len;
+        }
+        for (i = 0; i < n; i++) {
+            ctx->x[ctx->pos + i] ^= m[i];
+        }
+        ctx->pos += (uint8_t)n;
+        m += n;
+        m_len -= n;
+    }
+}
+
+/** @brief r = OMAC(K, [t] || m).
+ */
+static void aes_eax_omac_finish(ocrypto_aes_eax_keyed_ctx *ctx, uint8_t r[16])
+{
+    const ocrypto_aes_eax_key *key = ctx->key;
+    size_t i;
+
+    if (ctx->pos == 0) {
+        /* The tweak block is the final, complete block. */
+        memcpy(r, key->b, 16);
+        r[15] ^= ctx->t;
+    } else if (ctx->pos == 16) {
+        for (i = 0; i < 16; i++) {
+            r[i] = ctx->x[i] ^ key->b[i];
+        }
+    } else {
+        ctx->x[ctx->pos] ^= 0x80;
+        for (i = 0; i < 16; i++) {
+            r[i] = ctx->x[i] ^ key->p[i];
+        }
+    }
+    ocrypto_aes_ctr_block(&ctx->mac, r, r);
+}
+
+/** @brief Switch from additional authentication data to cyphertext.
+ */
+static void aes_eax_start_data(ocrypto_aes_eax_keyed_ctx *ctx)
+{
+    uint8_t h[16];
+    int i;
+
+    if (ctx->t == 1) {
+        aes_eax_omac_finish(ctx, h);
+        for (i = 0; i < 16; i++) {
+            ctx->tag[i] ^= h[i];
+        }
+        aes_eax_omac_start(ctx, 2);
+        ext_wipe(h, sizeof(h));
+    }
+}
+
+/** @brief Compute the authentication tag of the message.
+ */
+static void aes_eax_tag(ocrypto_aes_eax_keyed_ctx *ctx, uint8_t tag[16])
+{
+    int i;
+
+    aes_eax_start_data(ctx);
+    aes_eax_omac_finish(ctx, tag);
+    for (i = 0; i < 16; i++) {
+        tag[i] ^= ctx->tag[i];
+    }
+}
+
+void ocrypto_aes_eax_key_init(ocrypto_aes_eax_key *key, const uint8_t *k, size_t size)
+{
+    uint8_t l[16];
+    int t;
+
+    memset(l, 0, sizeof(l));
+    ocrypto_aes_ctr_init(&key->ctr, k, size, l);
+    ocrypto_aes_ctr_block(&key->ctr, l, l);
+
+    aes_eax_double(key->b, l);
+    aes_eax_double(key->p, key->b);
+
+    for (t = 0; t < 3; t++) {
+        memset(key->omac[t], 0, 16);
+        key->omac[t][15] = (uint8_t)t;
+        ocrypto_aes_ctr_block(&key->ctr, key->omac[t], key->omac[t]);
+    }
+
+    ext_wipe(l, sizeof(l));
+}
+
+void ocrypto_aes_eax_key_clear(ocrypto_aes_eax_key *key)
+{
+    ext_wipe(key, sizeof(*key));
+}
+
+void ocrypto_aes_eax_keyed_init(
+    ocrypto_aes_eax_keyed_ctx *ctx, const ocrypto_aes_eax_key *key,
+    const uint8_t *iv, size_t iv_len)
+{
+    ctx->ctr = key->ctr;
+    ctx->mac = key->ctr;
+    ctx->key = key;
+
+    /* The nonce OMAC is both the initial counter and part of the tag. */
+    aes_eax_omac_start(ctx, 0);
+    aes_eax_omac_update(ctx, iv, iv_len);
+    aes_eax_omac_finish(ctx, ctx->tag);
+    ocrypto_aes_ctr_reset(&ctx->ctr, ctx->tag);
+
+    aes_eax_omac_start(ctx, 1);
+}
+
+void ocrypto_aes_eax_keyed_update_aad(
+    ocrypto_aes_eax_keyed_ctx *ctx, const uint8_t *aa, size_t aa_len)
+{
+    aes_eax_omac_update(ctx, aa, aa_len);
+}
+
+void ocrypto_aes_eax_keyed_update_enc(
+    ocrypto_aes_eax_keyed_ctx *ctx, uint8_t *ct, const uint8_t *pt, size_t pt_len)
+{
+    aes_eax_start_data(ctx);
+    ocrypto_aes_ctr_encrypt(&ctx->ctr, ct, pt, pt_len);
+    aes_eax_omac_update(ctx, ct, pt_len);
+}
+
+void ocrypto_aes_eax_keyed_update_dec(
+    ocrypto_aes_eax_keyed_ctx *ctx, uint8_t *pt, const uint8_t *ct, size_t ct_len)
+{
+    aes_eax_start_data(ctx);
+    aes_eax_omac_update(ctx, ct, ct_len);
+    ocrypto_aes_ctr_decrypt(&ctx->ctr, pt, ct, ct_len);
+}
+
+void ocrypto_aes_eax_keyed_final_enc(ocrypto_aes_eax_keyed_ctx *ctx, uint8_t tag[16])
+{
+    aes_eax_tag(ctx, tag);
+    ext_wipe(ctx, sizeof(*ctx));
+}
+
+int ocrypto_aes_eax_keyed_final_dec(ocrypto_aes_eax_keyed_ctx *ctx, const uint8_t tag[16])
+{
+    uint8_t t[16];
+    int res;
+
+    aes_eax_tag(ctx, t);
+    res = ocrypto_constant_time_equal(t, tag, sizeof(t)) ? 0 : -1;
+
+    ext_wipe(t, sizeof(t));
+    ext_wipe(ctx, sizeof(*ctx));
+
+    return res;
+}
+
+void ocrypto_aes_eax_keyed_encrypt(
+    uint8_t *ct, uint8_t tag[16], const uint8_t *pt, size_t pt_len,
+    const ocrypto_aes_eax_key *key,
+    const uint8_t *iv, size_t iv_len, const uint8_t *aa, size_t aa_len)
+{
+    ocrypto_aes_eax_keyed_ctx ctx;
+
+    ocrypto_aes_eax_keyed_init(&ctx, key, iv, iv_len);
+    ocrypto_aes_eax_keyed_update_aad(&ctx, aa, aa_len);
+    ocrypto_aes_eax_keyed_update_enc(&ctx, ct, pt, pt_len);
+    ocrypto_aes_eax_keyed_final_enc(&ctx, tag);
+}
+
+int ocrypto_aes_eax_keyed_decrypt(
+    uint8_t *pt, const uint8_t tag[16], const uint8_t *ct, size_t ct_len,
+    const ocrypto_aes_eax_key *key,
+    const uint8_t *iv, size_t iv_len, const uint8_t *aa, size_t aa_len)
+{
+    ocrypto_aes_eax_keyed_ctx ctx;
+    uint8_t t[16];
+    int res = -1;
+
+    ocrypto_aes_eax_keyed_init(&ctx, key, iv, iv_len);
+    ocrypto_aes_eax_keyed_update_aad(&ctx, aa, aa_len);
+    aes_eax_start_data(&ctx);
+    aes_eax_omac_update(&ctx, ct, ct_len);
+    aes_eax_tag(&ctx, t);
+
+    /* Only release the plaintext of an authentic message. */
+    if (ocrypto_constant_time_equal(t, tag, sizeof(t))) {
+        ocrypto_aes_ctr_decrypt(&ctx.ctr, pt, ct, ct_len);
+        res = 0;
+    }
+
+    ext_wipe(&ctx, sizeof(ctx));
+    ext_wipe(t, sizeof(t));
+
+    return res;
+}
@@ -0,0 +1,294 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "ocrypto_aes_ctr.h"
+#include "ocrypto_aes_ctr_reset.h"
+#include "ocrypto_constant_time.h"
+#include "ocrypto_aes_gcm_key.h"
+#include "ext_wipe.h"
+
+static uint64_t aes_gcm_load64(const uint8_t *p)
+{
+    return ((uint64_t)p[0] << 56) | ((uint64_t)p[1] << 48) |
+           ((uint64_t)p[2] << 40) | ((uint64_t)p[3] << 32) |
+           ((uint64_t)p[4] << 24) | ((uint64_t)p[5] << 16) |
+           ((uint64_t)p[6] << 8) | (uint64_t)p[7];
+}
+
+static void aes_gcm_store64(uint8_t *p, uint64_t x)
+{
+    int i;
+
+    for (i = 7; i >= 0; i--) {
+        p[i] = (uint8_t)x;
+        x >>= 8;
+    }
+}
+
+/** @brief Reduction constants for the 4-bit GHASH table method.
+ */
+static const uint64_t aes_gcm_last4[16] = {
+    0x0000, 0x1c20, 0x3840, 0x2460, 0x7080, 0x6ca0, 0x48c0, 0x54e0,
+    0xe100, 0xfd20, 0xd940, 0xc560, 0x9180, 0x8da0, 0xa9c0, 0xb5e0
+};
+
+/** @brief y = y * H in GF(2^128).
+ */
+static void aes_gcm_mult(const ocrypto_aes_gcm_key *key, uint8_t y[16])
+{
+    uint64_t zh, zl;
+    unsigned lo, hi, rem;
+    int i;
+
+    lo = y[15] & 0x0f;
+    zh = key->hh[lo];
+    zl = key->hl[lo];
+
+    for (i = 15; i >= 0; i--) {
+        lo = y[i] & 0x0f;
+        hi = y[i] >> 4;
+
+        if (i != 15) {
+            rem = (unsigned)zl & 0x0f;
+            zl = (zh << 60) | (zl >> 4);
+            zh = (zh >> 4) ^ (aes_gcm_last4[rem] << 48);
+            zh ^= key->hh[lo];
+            zl ^= key->hl[lo];
+        }
+
+        rem = (unsigned)zl & 0x0f;
+        zl = (zh << 60) | (zl >> 4);
+        zh = (zh >> 4) ^ (aes_gcm_last4[rem] << 48);
+        zh ^= key->hh[hi];
+        zl ^= key->hl[hi];
+    }
+
+    aes_gcm_store64(y, zh);
+    aes_gcm_store64(y + 8, zl);
+}
+
+/** @brief Add @p in to the GHASH state.
+ *
+ * The multiplication of a completed block is deferred until more input
+ * arrives or the block is flushed, so that chunks of any size can be added.
+ */
+static void aes_gcm_absorb(ocrypto_aes_gcm_keyed_ctx *ctx, const uint8_t *in, size_t in_len)
+{
+    size_t i, n;
+
+    while (in_len > 0) {
+        if (ctx->pos == 16) {
+            aes_gcm_mult(ctx->key, ctx->y);
+            ctx->pos = 0;
+        }
+        n = 16 - ctx->pos;
+        if (n > in_len) {
+            n = in_len;
+        }
+        for (i = 0; i < n; i++) {
+            ctx->y[ctx->pos + i] ^= in[i];
+        }
+        ctx->pos += (uint8_t)n;
+        in += n;
+        in_len -= n;
+    }
+}
+
+/** @brief Complete the current GHASH block, zero padded.
+ */
+static void aes_gcm_flush(ocrypto_aes_gcm_keyed_ctx *ctx)
+{
+    if (ctx->pos > 0) {
+        aes_gcm_mult(ctx->key, ctx->y);
+        ctx->pos = 0;
+    }
+}
+
+/** @brief Switch from additional authentication data to cyphertext.
+ */
+static void aes_gcm_start_data(ocrypto_aes_gcm_keyed_ctx *ctx)
+{
+    if (!ctx->data) {
+        aes_gcm_flush(ctx);
+        ctx->data = 1;
+    }
+}
+
+/** @brief Compute the authentication tag of the message.
+ */
+static void aes_gcm_tag(ocrypto_aes_gcm_keyed_ctx *ctx, uint8_t tag[16])
+{
+    uint8_t len_block[16];
+    int i;
+
+    aes_gcm_flush(ctx);
+    aes_gcm_store64(len_block, (uint64_t)ctx->aa_len << 3);
+    aes_gcm_store64(len_block + 8, (uint64_t)ctx->ct_len << 3);
+    aes_gcm_absorb(ctx, len_block, sizeof(len_block));
+    aes_gcm_flush(ctx);
+
+    for (i = 0; i < 16; i++) {
+        tag[i] = ctx->ek0[i] ^ ctx->y[i];
+    }
+}
+
+void ocrypto_aes_gcm_key_init(ocrypto_aes_gcm_key *key, const uint8_t *k, size_t size)
+{
+    uint8_t h[16];
+    uint64_t vh, vl, t;
+    int i, j;
+
+    memset(h, 0, sizeof(h));
+    ocrypto_aes_ctr_init(&key->ctr, k, size, h);
+    ocrypto_aes_ctr_encrypt(&key->ctr, h, h, sizeof(h));
+
+    /* Multiples of H by all 4-bit polynomials. */
+    vh = aes_gcm_load64(h);
+    vl = aes_gcm_load64(h + 8);
+
+    key->hl[8] = vl;
+    key->hh[8] = vh;
+    key->hl[0] = 0;
+    key->hh[0] = 0;
+
+    for (i = 4; i > 0; i >>= 1) {
+        t = (vl & 1) * 0xe1000000U;
+        vl = (vh << 63) | (vl >> 1);
+        vh = (vh >> 1) ^ (t << 32);
+        key->hl[i] = vl;
+        key->hh[i] = vh;
+    }
+
+    for (i = 2; i <= 8; i *= 2) {
+        vh = key->hh[i];
+        vl = key->hl[i];
+        for (j = 1; j < i; j++) {
+            key->hh[i + j] = vh ^ key->hh[j];
+            key->hl[i + j] = vl ^ key->hl[j];
+        }
+    }
+
+    ext_wipe(h, sizeof(h));
+}
+
+void ocrypto_aes_gcm_key_clear(ocrypto_aes_gcm_key *key)
+{
+    ext_wipe(key, sizeof(*key));
+}
+
+void ocrypto_aes_gcm_keyed_init(
+    ocrypto_aes_gcm_keyed_ctx *ctx, const ocrypto_aes_gcm_key *key, const uint8_t iv[12])
+{
+    uint8_t j0[16];
+
+    memcpy(j0, iv, 12);
+    j0[12] = 0;
+    j0[13] = 0;
+    j0[14] = 0;
+    j0[15] = 1;
+
+    /* Only the counter is reset, the expanded key is copied from the key schedule. */
+    ctx->ctr = key->ctr;
+    ocrypto_aes_ctr_reset(&ctx->ctr, j0);
+
+    /* The first counter block gives the tag mask; the data starts at J0 + 1. */
+    memset(ctx->ek0, 0, sizeof(ctx->ek0));
+    ocrypto_aes_ctr_encrypt(&ctx->ctr, ctx->ek0, ctx->ek0, sizeof(ctx->ek0));
+
+    ctx->key = key;
+    memset(ctx->y, 0, sizeof(ctx->y));
+    ctx->aa_len = 0;
+    ctx->ct_len = 0;
+    ctx->pos = 0;
+    ctx->data = 0;
+}
+
+void ocrypto_aes_gcm_keyed_update_aad(
+    ocrypto_aes_gcm_keyed_ctx *ctx, const uint8_t *aa, size_t aa_len)
+{
+    aes_gcm_absorb(ctx, aa, aa_len);
+    ctx->aa_len += aa_len;
+}
+
+void ocrypto_aes_gcm_keyed_update_enc(
+    ocrypto_aes_gcm_keyed_ctx *ctx, uint8_t *ct, const uint8_t *pt, size_t pt_len)
+{
+    aes_gcm_start_data(ctx);
+    ocrypto_aes_ctr_encrypt(&ctx->ctr, ct, pt, pt_len);
+    aes_gcm_absorb(ctx, ct, pt_len);
+    ctx->ct_len += pt_len;
+}
+
+void ocrypto_aes_gcm_keyed_update_dec(
+    ocrypto_aes_gcm_keyed_ctx *ctx, uint8_t *pt, const uint8_t *ct, size_t ct_len)
+{
+    aes_gcm_start_data(ctx);
+    aes_gcm_absorb(ctx, ct, ct_len);
+    ctx->ct_len += ct_len;
+    ocrypto_aes_ctr_decrypt(&ctx->ctr, pt, ct, ct_len);
+}
+
+void ocrypto_aes_gcm_keyed_final_enc(ocrypto_aes_gcm_keyed_ctx *ctx, uint8_t tag[16])
+{
+    aes_gcm_tag(ctx, tag);
+    ext_wipe(ctx, sizeof(*ctx));
+}
+
+int ocrypto_aes_gcm_keyed_final_dec(ocrypto_aes_gcm_keyed_ctx *ctx, const uint8_t tag[16])
+{
+    uint8_t t[16];
+    int res;
+
+    aes_gcm_tag(ctx, t);
+    res = ocrypto_constant_time_equal(t, tag, sizeof(t)) ? 0 : -1;
+
+    ext_wipe(t, sizeof(t));
+    ext_wipe(ctx, sizeof(*ctx));
+
+    return res;
+}
+
+void ocrypto_aes_gcm_keyed_encrypt(
+    uint8_t *ct, uint8_t tag[16], const uint8_t *pt, size_t pt_len,
+    const ocrypto_aes_gcm_key *key, const uint8_t iv[12], const uint8_t *aa, size_t aa_len)
+{
+    ocrypto_aes_gcm_keyed_ctx ctx;
+
+    ocrypto_aes_gcm_keyed_init(&ctx, key, iv);
+    ocrypto_aes_gcm_keyed_update_aad(&ctx, aa, aa_len);
+    ocrypto_aes_gcm_keyed_update_enc(&ctx, ct, pt, pt_len);
+    ocrypto_aes_gcm_keyed_final_enc(&ctx, tag);
+}
+
+int ocrypto_aes_gcm_keyed_decrypt(
+    uint8_t *pt, const uint8_t tag[16], const uint8_t *ct, size_t ct_len,
+    const ocrypto_aes_gcm_key *key, const uint8_t iv[12], const uint8_t *aa, size_t aa_len)
+{
+    ocrypto_aes_gcm_keyed_ctx ctx;
+    uint8_t t[16];
+    int res = -1;
+
+    ocrypto_aes_gcm_keyed_init(&ctx, key, iv);
+    ocrypto_aes_gcm_keyed_update_aad(&ctx, aa, aa_len);
+    aes_gcm_start_data(&ctx);
+    aes_gcm_absorb(&ctx, ct, ct_len);
+    ctx.ct_len = ct_len;
+    aes_gcm_tag(&ctx, t);
+
+    /* Only release the plaintext of an authentic message. */
+    if (ocrypto_constant_time_equal(t, tag, sizeof(t))) {
+        ocrypto_aes_ctr_decrypt(&ctx.ctr, pt, ct, ct_len);
+        res = 0;
+    }
+
+    ext_wipe(&ctx, sizeof(ctx));
+    ext_wipe(t, sizeof(t));
+
+    return res;
+}
@@ -0,0 +1,326 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "ocrypto_sha256.h"
+#include "ocrypto_ecdsa_p256_key.h"
+#include "ext_mont256.h"
+
+/** @brief Jacobian point.
+ */
+typedef struct {
+    uint32_t x[8];
+    uint32_t y[8];
+    uint32_t z[8];
+    int inf;
+} ecdsa_p256_point;
+
+static const ext_mont256_mod ecdsa_p256_p = {
+    { 0xffffffff, 0xffffffff, 0xffffffff, 0x00000000, 0x00000000, 0x00000000, 0x00000001, 0xffffffff },
+    0x00000001,
+    { 0x00000003, 0x00000000, 0xffffffff, 0xfffffffb, 0xfffffffe, 0xffffffff, 0xfffffffd, 0x00000004 },
+    { 0x00000001, 0x00000000, 0x00000000, 0xffffffff, 0xffffffff, 0xffffffff, 0xfffffffe, 0x00000000 },
+};
+
+static const ext_mont256_mod ecdsa_p256_n = {
+    { 0xfc632551, 0xf3b9cac2, 0xa7179e84, 0xbce6faad, 0xffffffff, 0xffffffff, 0x00000000, 0xffffffff },
+    0xee00bc4f,
+    { 0xbe79eea2, 0x83244c95, 0x49bd6fa6, 0x4699799c, 0x2b6bec59, 0x2845b239, 0xf3d95620, 0x66e12d94 },
+    { 0x039cdaaf, 0x0c46353d, 0x58e8617b, 0x43190552, 0x00000000, 0x00000000, 0xffffffff, 0x00000000 },
+};
+
+/** @brief Curve constant b in Montgomery form.
+ */
+static const uint32_t ecdsa_p256_b[8] = {
+    0x29c4bddf, 0xd89cdf62, 0x78843090, 0xacf005cd, 0xf7212ed6, 0xe5a220ab, 0x04874834, 0xdc30061d
+};
+
+/** @brief Affine points G, 3G, ..., 15G in Montgomery form.
+ */
+static const uint32_t ecdsa_p256_g[8][2][8] = {
+    { { 0x18a9143c, 0x79e730d4, 0x5fedb601, 0x75ba95fc, 0x77622510, 0x79fb732b, 0xa53755c6, 0x18905f76 },
+      { 0xce95560a, 0xddf25357, 0xba19e45c, 0x8b4ab8e4, 0xdd21f325, 0xd2e88688, 0x25885d85, 0x8571ff18 } },
+    { { 0x4eebc127, 0xffac3f90, 0x087d81fb, 0xb027f84a, 0x87cbbc98, 0x66ad77dd, 0xb6ff747e, 0x26936a3f },
+      { 0xc983a7eb, 0xb04c5c1f, 0x0861fe1a, 0x583e47ad, 0x1a2ee98e, 0x78820831, 0xe587cc07, 0xd5f06a29 } },
+    { { 0xc45c61f5, 0xbe1b8aae, 0x94b9537d, 0x90ec649a, 0xd076c20c, 0x941cb5aa, 0x890523c8, 0xc9079605 },
+      { 0xe7ba4f10, 0xeb309b4a, 0xe5eb882b, 0x73c568ef, 0x7e7a1f68, 0x3540a987, 0x2dd1e916, 0x73a076bb } },
+    { { 0xa0173b4f, 0x0746354e, 0xd23c00f7, 0x2bd20213, 0x0c23bb08, 0xf43eaab5, 0xc3123e03, 0x13ba5119 },
+      { 0x3f5b9d4d, 0x2847d030, 0x5da67bdd, 0x6742f2f2, 0x77c94195, 0xef933bdc, 0x6e240867, 0xeaedd915 } },
+    { { 0x264e20e8, 0x75c96e8f, 0x59a7a841, 0xabe6bfed, 0x44c8eb00, 0x2cc09c04, 0xf0c4e16b, 0xe05b3080 },
+      { 0xa45f3314, 0x1eb7777a, 0xce5d45e3, 0x56af7bed, 0x88b12f1a, 0x2b6e019a, 0xfd835f9b, 0x086659cd } },
+    { { 0x6245e404, 0xea7d260a, 0x6e7fdfe0, 0x9de40795, 0x8dac1ab5, 0x1ff3a415, 0x649c9073, 0x3e7090f1 },
+      { 0x2b944e88, 0x1a768561, 0xe57f61c8, 0x250f939e, 0x1ead643d, 0x0c0daa89, 0xe125b88e, 0x68930023 } },
+    { { 0x4b2ed709, 0xccc42563, 0x856fd30d, 0x0e356769, 0x559e9811, 0xbcbcd43f, 0x5395b759, 0x738477ac },
+      { 0xc00ee17f, 0x35752b90, 0x742ed2e3, 0x68748390, 0xbd1f5bc1, 0x7cd06422, 0xc9e7b797, 0xfbc08769 } },
+    { { 0xbc60055b, 0x72bcd8b7, 0x56e27e4b, 0x03cc23ee, 0xe4819370, 0xee337424, 0x0ad3da09, 0xe2aa0e43 },
+      { 0x6383c45d, 0x40b8524f, 0x42a41b25, 0xd7663554, 0x778a4797, 0x64efa6de, 0x7079adf4, 0x2042170a } },
+};
+
+/** @brief r = 2 * a.
+ */
+static void ecdsa_p256_point_double(ecdsa_p256_point *r, const ecdsa_p256_point *a)
+{
+    const ext_mont256_mod *p = &ecdsa_p256_p;
+    uint32_t delta[8], gamma[8], beta[8], alpha[8], t[8];
+    uint32_t x3[8], y3[8], z3[8];
+
+    if (a->inf) {
+        *r = *a;
+        return;
+    }
+
+    ext_mont256_mul(delta, a->z, a->z, p);
+    ext_mont256_mul(gamma, a->y, a->y, p);
+    ext_mont256_mul(beta, a->x, gamma, p);
+
+    /* alpha = 3 * (x - delta) * (x + delta) */
+    ext_mont256_sub(t, a->x, delta, p);
+    ext_mont256_add(alpha, a->x, delta, p);
+    ext_mont256_mul(t, t, alpha, p);
+    ext_mont256_add(alpha, t, t, p);
+    ext_mont256_add(alpha, alpha, t, p);
+
+    /* x3 = alpha^2 - 8 * beta */
+    ext_mont256_add(beta, beta, beta, p);
+    ext_mont256_add(beta, beta, beta, p);
+    ext_mont256_mul(x3, alpha, alpha, p);
+    ext_mont256_sub(x3, x3, beta, p);
+    ext_mont256_sub(x3, x3, beta, p);
+
+    /* z3 = (y + z)^2 - gamma - delta */
+    ext_mont256_add(z3, a->y, a->z, p);
+    ext_mont256_mul(z3, z3, z3, p);
+    ext_mont256_sub(z3, z3, gamma, p);
+    ext_mont256_sub(z3, z3, delta, p);
+
+    /* y3 = alpha * (4 * beta - x3) - 8 * gamma^2 */
+    ext_mont256_sub(y3, beta, x3, p);
+    ext_mont256_mul(y3, y3, alpha, p);
+    ext_mont256_mul(t, gamma, gamma, p);
+    ext_mont256_add(t, t, t, p);
+    ext_mont256_add(t, t, t, p);
+    ext_mont256_add(t, t, t, p);
+    ext_mont256_sub(y3, y3, t, p);
+
+    memcpy(r->x, x3, 32);
+    memcpy(r->y, y3, 32);
+    memcpy(r->z, z3, 32);
+    r->inf = 0;
+}
+
+/** @brief r = a + (x2, y2), or a - (x2, y2) if @p neg is set.
+ */
+static void ecdsa_p256_point_add_affine(ecdsa_p256_point *r, const ecdsa_p256_point *a,
+                                        const uint32_t x2[8], const uint32_t y2[8], int neg)
+{
+    const ext_mont256_mod *p = &ecdsa_p256_p;
+    uint32_t y[8], z1z1[8], u2[8], s2[8], h[8], hh[8], i[8], j[8], rr[8], v[8];
+    uint32_t x3[8], y3[8], z3[8];
+
+    if (neg) {
+        memset(y, 0, 32);
+        ext_mont256_sub(y, y, y2, p);
+    } else {
+        memcpy(y, y2, 32);
+    }
+
+    if (a->inf) {
+        memcpy(r->x, x2, 32);
+        memcpy(r->y, y, 32);
+        memcpy(r->z, p->one, 32);
+        r->inf = 0;
+        return;
+    }
+
+    ext_mont256_mul(z1z1, a->z, a->z, p);
+    ext_mont256_mul(u2, x2, z1z1, p);
+    ext_mont256_mul(s2, y, a->z, p);
+    ext_mont256_mul(s2, s2, z1z1, p);
+    ext_mont256_sub(h, u2, a->x, p);
+    ext_mont256_sub(rr, s2, a->y, p);
+
+    if (ext_mont256_is_zero(h)) {
+        if (ext_mont256_is_zero(rr)) {
+            ecdsa_p256_point_double(r, a);
+        } else {
+            r->inf = 1;
+        }
+        return;
+    }
+
+    ext_mont256_mul(hh, h, h, p);
+    ext_mont256_add(i, hh, hh, p);
+    ext_mont256_add(i, i, i, p);
+    ext_mont256_mul(j, h, i, p);
+    ext_mont256_add(rr, rr, rr, p);
+    ext_mont256_mul(v, a->x, i, p);
+
+    /* x3 = rr^2 - j - 2 * v */
+    ext_mont256_mul(x3, rr, rr, p);
+    ext_mont256_sub(x3, x3, j, p);
+    ext_mont256_sub(x3, x3, v, p);
+    ext_mont256_sub(x3, x3, v, p);
+
+    /* y3 = rr * (v - x3) - 2 * y1 * j */
+    ext_mont256_sub(y3, v, x3, p);
+    ext_mont256_mul(y3, y3, rr, p);
+    ext_mont256_mul(j, j, a->y, p);
+    ext_mont256_sub(y3, y3, j, p);
+    ext_mont256_sub(y3, y3, j, p);
+
+    /* z3 = (z1 + h)^2 - z1z1 - hh */
+    ext_mont256_add(z3, a->z, h, p);
+    ext_mont256_mul(z3, z3, z3, p);
+    ext_mont256_sub(z3, z3, z1z1, p);
+    ext_mont256_sub(z3, z3, hh, p);
+
+    memcpy(r->x, x3, 32);
+    memcpy(r->y, y3, 32);
+    memcpy(r->z, z3, 32);
+    r->inf = 0;
+}
+
+static void ecdsa_p256_point_to_affine(uint32_t x[8], uint32_t y[8], const ecdsa_p256_point *a)
+{
+    const ext_mont256_mod *p = &ecdsa_p256_p;
+    uint32_t zi[8], zi2[8];
+
+    ext_mont256_inv(zi, a->z, p);
+    ext_mont256_mul(zi2, zi, zi, p);
+    ext_mont256_mul(x, a->x, zi2, p);
+    ext_mont256_mul(zi2, zi2, zi, p);
+    ext_mont256_mul(y, a->y, zi2, p);
+}
+
+int ocrypto_ecdsa_p256_key_init(ocrypto_ecdsa_p256_key *key, const uint8_t pk[64])
+{
+    const ext_mont256_mod *p = &ecdsa_p256_p;
+    uint32_t x[8], y[8], t[8], lhs[8];
+    uint32_t q2x[8], q2y[8];
+    ecdsa_p256_point a;
+    int i;
+
+    ext_mont256_load_be(x, pk);
+    ext_mont256_load_be(y, pk + 32);
+    if (!ext_mont256_lt(x, p->m) || !ext_mont256_lt(y, p->m)) {
+        return -1;
+    }
+    ext_mont256_mul(x, x, p->rr, p);
+    ext_mont256_mul(y, y, p->rr, p);
+
+    /* y^2 = x^3 - 3 * x + b */
+    ext_mont256_mul(lhs, y, y, p);
+    ext_mont256_mul(t, x, x, p);
+    ext_mont256_mul(t, t, x, p);
+    ext_mont256_sub(t, t, x, p);
+    ext_mont256_sub(t, t, x, p);
+    ext_mont256_sub(t, t, x, p);
+    ext_mont256_add(t, t, ecdsa_p256_b, p);
+    if (memcmp(lhs, t, sizeof(t)) != 0) {
+        return -1;
+    }
+
+    memcpy(key->q[0][0], x, 32);
+    memcpy(key->q[0][1], y, 32);
+
+    memcpy(a.x, x, 32);
+    memcpy(a.y, y, 32);
+    memcpy(a.z, p->one, 32);
+    a.inf = 0;
+    ecdsa_p256_point_double(&a, &a);
+    ecdsa_p256_point_to_affine(q2x, q2y, &a);
+
+    for (i = 1; i < 8; i++) {
+        memcpy(a.x, key->q[i - 1][0], 32);
+        memcpy(a.y, key->q[i - 1][1], 32);
+        memcpy(a.z, p->one, 32);
+        a.inf = 0;
+        ecdsa_p256_point_add_affine(&a, &a, q2x, q2y, 0);
+        ecdsa_p256_point_to_affine(key->q[i][0], key->q[i][1], &a);
+    }
+
+    return 0;
+}
+
+int ocrypto_ecdsa_p256_keyed_verify_hash(
+    const uint8_t sig[64],
+    const uint8_t hash[32],
+    const ocrypto_ecdsa_p256_key *key)
+{
+    const ext_mont256_mod *n = &ecdsa_p256_n;
+    static const uint32_t one[8] = { 1 };
+    uint32_t r[8], s[8], e[8], w[8], u1[8], u2[8], x[8];
+    int8_t naf1[257], naf2[257];
+    ecdsa_p256_point a;
+    int len, len2, i, d;
+
+    ext_mont256_load_be(r, sig);
+    ext_mont256_load_be(s, sig + 32);
+    if (ext_mont256_is_zero(r) || !ext_mont256_lt(r, n->m) ||
+        ext_mont256_is_zero(s) || !ext_mont256_lt(s, n->m)) {
+        return -1;
+    }
+
+    ext_mont256_load_be(e, hash);
+    if (!ext_mont256_lt(e, n->m)) {
+        ext_mont256_sub_raw(e, e, n->m);
+    }
+
+    /* u1 = e / s, u2 = r / s. w is 1 / s in Montgomery form. */
+    ext_mont256_mul(w, s, n->rr, n);
+    ext_mont256_inv(w, w, n);
+    ext_mont256_mul(u1, e, w, n);
+    ext_mont256_mul(u2, r, w, n);
+
+    /* u1 * G + u2 * Q, with shared doublings. */
+    len = ext_mont256_wnaf(naf1, u1, 5);
+    len2 = ext_mont256_wnaf(naf2, u2, 5);
+    if (len2 > len) {
+        len = len2;
+    }
+
+    a.inf = 1;
+    for (i = len - 1; i >= 0; i--) {
+        ecdsa_p256_point_double(&a, &a);
+        d = naf1[i];
+        if (d != 0) {
+            ecdsa_p256_point_add_affine(&a, &a, ecdsa_p256_g[(d < 0 ? -d : d) >> 1][0],
+                                        ecdsa_p256_g[(d < 0 ? -d : d) >> 1][1], d < 0);
+        }
+        d = naf2[i];
+        if (d != 0) {
+            ecdsa_p256_point_add_affine(&a, &a, key->q[(d < 0 ? -d : d) >> 1][0],
+                                        key->q[(d < 0 ? -d : d) >> 1][1], d < 0);
+        }
+    }
+
+    if (a.inf) {
+        return -1;
+    }
+
+    /* x(R) mod n == r */
+    ecdsa_p256_point_to_affine(x, s, &a);
+    ext_mont256_mul(x, x, one, &ecdsa_p256_p);
+    if (!ext_mont256_lt(x, n->m)) {
+        ext_mont256_sub_raw(x, x, n->m);
+    }
+
+    return memcmp(x, r, sizeof(x)) == 0 ? 0 : -1;
+}
+
+int ocrypto_ecdsa_p256_keyed_verify(
+    const uint8_t sig[64],
+    const uint8_t *m, size_t mlen,
+    const ocrypto_ecdsa_p256_key *key)
+{
+    uint8_t hash[ocrypto_sha256_BYTES];
+
+    ocrypto_sha256(hash, m, mlen);
+
+    return ocrypto_ecdsa_p256_keyed_verify_hash(sig, hash, key);
+}
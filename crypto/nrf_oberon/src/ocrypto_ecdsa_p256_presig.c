@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "ocrypto_ecdsa_p256.h"
+#include "ocrypto_ecdsa_p256_presig.h"
+#include "ext_mont256.h"
+#include "ext_wipe.h"
+
+static const ext_mont256_mod ecdsa_p256_n = {
+    { 0xfc632551, 0xf3b9cac2, 0xa7179e84, 0xbce6faad, 0xffffffff, 0xffffffff, 0x00000000, 0xffffffff },
+    0xee00bc4f,
+    { 0xbe79eea2, 0x83244c95, 0x49bd6fa6, 0x4699799c, 0x2b6bec59, 0x2845b239, 0xf3d95620, 0x66e12d94 },
+    { 0x039cdaaf, 0x0c46353d, 0x58e8617b, 0x43190552, 0x00000000, 0x00000000, 0xffffffff, 0x00000000 },
+};
+
+static void ecdsa_p256_store_be(uint8_t r[32], const uint32_t a[8])
+{
+    int i;
+
+    for (i = 0; i < 8; i++) {
+        r[31 - 4 * i] = (uint8_t)a[i];
+        r[31 - 4 * i - 1] = (uint8_t)(a[i] >> 8);
+        r[31 - 4 * i - 2] = (uint8_t)(a[i] >> 16);
+        r[31 - 4 * i - 3] = (uint8_t)(a[i] >> 24);
+    }
+}
+
+/* 0 < a < n, in constant time. */
+static int ecdsa_p256_is_scalar(const uint32_t a[8])
+{
+    uint32_t t[8];
+    uint32_t lt;
+
+    lt = ext_mont256_sub_raw(t, a, ecdsa_p256_n.m);
+    ext_wipe(t, sizeof(t));
+    return (int)(lt & (uint32_t)(ext_mont256_is_zero(a) ^ 1));
+}
+
+int ocrypto_ecdsa_p256_presign(ocrypto_ecdsa_p256_presig *presig, const uint8_t ek[32])
+{
+    const ext_mont256_mod *n = &ecdsa_p256_n;
+    uint8_t kg[64];
+    uint32_t k[8];
+    int ret = -1;
+
+    memset(presig, 0, sizeof(*presig));
+
+    ext_mont256_load_be(k, ek);
+    if (!ecdsa_p256_is_scalar(k)) {
+        goto exit;
+    }
+
+    /* r = x(k * G) mod n, where x < p < 2 * n. r is public. */
+    if (ocrypto_ecdsa_p256_public_key(kg, ek) != 0) {
+        goto exit;
+    }
+    ext_mont256_load_be(presig->r, kg);
+    if (!ext_mont256_lt(presig->r, n->m)) {
+        ext_mont256_sub_raw(presig->r, presig->r, n->m);
+    }
+    if (ext_mont256_is_zero(presig->r)) {
+        goto exit;
+    }
+    ext_mont256_mul(presig->r_mont, presig->r, n->rr, n);
+
+    /* k^-1 in Montgomery form. */
+    ext_mont256_mul_ct(k, k, n->rr, n);
+    ext_mont256_inv_ct(presig->k_inv, k, n);
+
+    presig->valid = 1;
+    ret = 0;
+
+exit:
+    if (ret != 0) {
+        ext_wipe(presig, sizeof(*presig));
+    }
+    ext_wipe(k, sizeof(k));
+    ext_wipe(kg, sizeof(kg));
+    return ret;
+}
+
+int ocrypto_ecdsa_p256_presig_sign_hash(
+    uint8_t sig[64],
+    const uint8_t hash[32],
+    const uint8_t sk[32],
+    ocrypto_ecdsa_p256_presig *presig)
+{
+    const ext_mont256_mod *n = &ecdsa_p256_n;
+    uint32_t d[8], e[8], s[8];
+    int ret = -1;
+
+    if (!presig->valid) {
+        return -1;
+    }
+
+    /* The session key is used at most once, whatever the outcome. */
+    presig->valid = 0;
+
+    ext_mont256_load_be(d, sk);
+    if (!ecdsa_p256_is_scalar(d)) {
+        goto exit;
+    }
+
+    /* e < 2^256 < 2 * n */
+    ext_mont256_load_be(e, hash);
+    ext_mont256_reduce_ct(e, e, n);
+
+    /* s = (e + r * d) / k */
+    ext_mont256_mul_ct(d, d, presig->r_mont, n);
+    ext_mont256_add_ct(s, e, d, n);
+    ext_mont256_mul_ct(s, s, presig->k_inv, n);
+
+    if (ext_mont256_is_zero(s)) {
+        goto exit;
+    }
+
+    ecdsa_p256_store_be(sig, presig->r);
+    ecdsa_p256_store_be(sig + 32, s);
+    ret = 0;
+
+exit:
+    ext_wipe(presig, sizeof(*presig));
+    ext_wipe(d, sizeof(d));
+    ext_wipe(e, sizeof(e));
+    ext_wipe(s, sizeof(s));
+    return ret;
+}
@@ -0,0 +1,517 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "ocrypto_sha512.h"
+#include "ocrypto_ed25519_key.h"
+#include "ext_mont256.h"
+
+/* Signatures combined into one batch equation. */
+#define ED25519_BATCH 4
+
+/** @brief Extended point (X : Y : Z : T) with x = X / Z, y = Y / Z, x * y = T / Z.
+ */
+typedef struct {
+    uint32_t x[8];
+    uint32_t y[8];
+    uint32_t z[8];
+    uint32_t t[8];
+} ed25519_point;
+
+/** @brief Point (Y + X, Y - X, 2 * d * T, 2 * Z), ready for addition.
+ */
+typedef struct {
+    uint32_t yp[8];
+    uint32_t ym[8];
+    uint32_t t2d[8];
+    uint32_t z2[8];
+} ed25519_cached;
+
+static const ext_mont256_mod ed25519_p = {
+    { 0xffffffed, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0x7fffffff },
+    0x286bca1b,
+    { 0x000005a4, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000 },
+    { 0x00000026, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000 },
+};
+
+static const ext_mont256_mod ed25519_l = {
+    { 0x5cf5d3ed, 0x5812631a, 0xa2f79cd6, 0x14def9de, 0x00000000, 0x00000000, 0x00000000, 0x10000000 },
+    0x12547e1b,
+    { 0x449c0f01, 0xa40611e3, 0x68859347, 0xd00e1ba7, 0x17f5be65, 0xceec73d2, 0x7c309a3d, 0x0399411b },
+    { 0x8d98951d, 0xd6ec3174, 0x737dcf70, 0xc6ef5bf4, 0xfffffffe, 0xffffffff, 0xffffffff, 0x0fffffff },
+};
+
+/** @brief 2^768 mod l, for the reduction of 512-bit hashes.
+ */
+static const uint32_t ed25519_l_rrr[8] = {
+    0x7b83a2db, 0x2a9e4968, 0xaef7f3ec, 0x278324e6, 0x04ec5b65, 0x8065dc6c, 0x3599cec7, 0x0e530b77
+};
+
+/** @brief Curve constants d and 2 * d in Montgomery form.
+ */
+static const uint32_t ed25519_d[8] = {
+    0xdf47e9fa, 0x80ed8bfe, 0xafc62973, 0x10a18777, 0xbc188690, 0xe5939207, 0x729fc526, 0x2c822b5a
+};
+static const uint32_t ed25519_d2[8] = {
+    0xbe8fd3f4, 0x01db17fd, 0x5f8c52e7, 0x21430eef, 0x78310d20, 0xcb27240f, 0xe53f8a4d, 0x590456b4
+};
+
+/** @brief sqrt(-1) in Montgomery form.
+ */
+static const uint32_t ed25519_sqrtm1[8] = {
+    0xfe2bdb04, 0x3b5807d4, 0xb51be9ed, 0x03f590fd, 0x336202d1, 0x6d6e16bf, 0xd6c71ba8, 0x75776b0b
+};
+
+/** @brief (p - 5) / 8.
+ */
+static const uint32_t ed25519_p58[8] = {
+    0xfffffffd, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0x0fffffff
+};
+
+/** @brief Affine points B, 3B, ..., 15B as (y + x, y - x, 2 * d * x * y) in Montgomery form.
+ */
+static const uint32_t ed25519_b[8][3][8] = {
+    { { 0x72d0d5e4, 0x15fdef88, 0x56ca17bd, 0xcfd8cb89, 0xe117e8ea, 0xcbacc69e, 0xb193ab03, 0x28d156a3 },
+      { 0xf39590b0, 0x506876dd, 0x0f9c4ea9, 0x968d9add, 0x854e7d7b, 0x9ab99fc7, 0xb4d2bb62, 0x3d950fc2 },
+      { 0x1c354dd0, 0x7fd8acd2, 0x61592f8d, 0xc4587550, 0xd7ff4acd, 0x6014ac42, 0x9bd716fd, 0x7c985187 } },
+    { { 0x6b6a73cc, 0xff9838fb, 0x83ef3695, 0x596f9f42, 0x9a35516c, 0xaa0de063, 0xef24f454, 0x1f4f9818 },
+      { 0x7d873be2, 0xd26abc88, 0x1ac1ae9a, 0xe15e77b0, 0xf141e016, 0x2d6a15e0, 0xaba26a9f, 0x57793216 },
+      { 0x0d002644, 0x11e9db5c, 0x2ffe6a8f, 0x25fd3710, 0xec0c8d55, 0x16c20852, 0xc790d583, 0x61f5bdfc } },
+    { { 0x4899ca76, 0x0ec7f219, 0x98172e64, 0xf9eacd0f, 0x787d122c, 0xd224e3d5, 0x858d0702, 0x205c6bd0 },
+      { 0x62a9e00e, 0xef99690a, 0x27d0313c, 0x9e031711, 0x5eefd429, 0xbb0bca43, 0xe60ec233, 0x290ec534 },
+      { 0x2c4f613a, 0x03e2a5d9, 0xfc2d2b84, 0xcc153128, 0x1e26d0b3, 0xbc114ba6, 0xeadd1af6, 0x0b5843a5 } },
+    { { 0x03ac4fd6, 0xe5e9c6f6, 0xa96a9f3b, 0x48a7e6b6, 0xfc7edee7, 0xe0783f51, 0xf8fdbec4, 0x6824cb9b },
+      { 0x437100de, 0xac809ef5, 0xdda14ae5, 0x1fc4f25a, 0xafbc90ac, 0x70cd8fcf, 0xe0558b57, 0x5e74dbd4 },
+      { 0x416aacb8, 0xd9824bb0, 0xc74c6eff, 0x9280248a, 0x21c3d22c, 0x4331c1a9, 0xbe4f78d6, 0x33b5c637 } },
+    { { 0xbcfeba17, 0x08e35e94, 0x21f28155, 0xaff78486, 0x780878f6, 0xae73aff3, 0x9ce0e754, 0x539935a6 },
+      { 0x89611067, 0x2258f8b4, 0x62c9bd26, 0xa7d34128, 0x580e2a2e, 0x623f6552, 0x3cbf3d50, 0x728d682b },
+      { 0x6a580088, 0xfeda8c6f, 0xcdd532fa, 0xb1ed9488, 0xf196bd65, 0x60a96e2b, 0x0214a2fd, 0x2eb6ec50 } },
+    { { 0x8f065e5d, 0x165a13ac, 0x5326d9d1, 0x1e5bd2ba, 0x7aa7b906, 0x8f47a8c9, 0x884353fc, 0x5d775d98 },
+      { 0xe9edfd35, 0x54278256, 0xab43852d, 0x53dea1a7, 0xd110f827, 0x49d16aad, 0x35bb9cf2, 0x296f4906 },
+      { 0x9c5479ec, 0x1668a563, 0x7f6df078, 0x768ecfed, 0xe1efe90c, 0x1f489cd0, 0xe73300ba, 0x2b70a326 } },
+    { { 0x0c12eaec, 0x6abcd124, 0xfa09149e, 0x6db2a8f6, 0x43259d26, 0x641e16d1, 0xfc87f5b2, 0x3dda0d70 },
+      { 0x7ef66fd2, 0xf07a2ec9, 0x13ba89ed, 0xf98affed, 0x55bb4589, 0x50c67385, 0x784570e1, 0x5b5e36b1 },
+      { 0x18ec455f, 0x6057e9c7, 0x2f0d88d2, 0x604c3e67, 0x9eec0597, 0x2f824ee5, 0x3d67deca, 0x685ac9a7 } },
+    { { 0xf0dcd5e7, 0x76b24874, 0xa72d6833, 0xeecce0f1, 0xca0b96f3, 0xca2a3338, 0xccd05068, 0x0792198d },
+      { 0x78e6bd1e, 0x99c081ee, 0x52b87fc4, 0x65631a5e, 0x24781bcb, 0x5f372131, 0xaeee106b, 0x0cfc77cf },
+      { 0x20fae30c, 0xe4ed8b11, 0x337b1761, 0xea6a059c, 0xf1cddcc2, 0x78e16ea3, 0x9df819cc, 0x0a5c6ae7 } },
+};
+
+static void ed25519_point_identity(ed25519_point *r)
+{
+    memset(r->x, 0, 32);
+    memcpy(r->y, ed25519_p.one, 32);
+    memcpy(r->z, ed25519_p.one, 32);
+    memset(r->t, 0, 32);
+}
+
+/** @brief r = 2 * a.
+ */
+static void ed25519_point_double(ed25519_point *r, const ed25519_point *a)
+{
+    const ext_mont256_mod *p = &ed25519_p;
+    uint32_t aa[8], bb[8], c[8], e[8], f[8], g[8], h[8];
+
+    ext_mont256_mul(aa, a->x, a->x, p);
+    ext_mont256_mul(bb, a->y, a->y, p);
+    ext_mont256_mul(c, a->z, a->z, p);
+    ext_mont256_add(c, c, c, p);
+
+    /* e = (x + y)^2 - x^2 - y^2, h = -x^2 - y^2 */
+    ext_mont256_add(e, a->x, a->y, p);
+    ext_mont256_mul(e, e, e, p);
+    ext_mont256_add(h, aa, bb, p);
+    ext_mont256_sub(e, e, h, p);
+    memset(f, 0, 32);
+    ext_mont256_sub(h, f, h, p);
+
+    ext_mont256_sub(g, bb, aa, p);
+    ext_mont256_sub(f, g, c, p);
+
+    ext_mont256_mul(r->x, e, f, p);
+    ext_mont256_mul(r->y, g, h, p);
+    ext_mont256_mul(r->t, e, h, p);
+    ext_mont256_mul(r->z, f, g, p);
+}
+
+/** @brief r = a + b, or a - b if @p neg is set.
+ *
+ * @p z2 is 2 * Z of b, or NULL for an affine b.
+ */
+static void ed25519_point_add(ed25519_point *r, const ed25519_point *a,
+                              const uint32_t yp[8], const uint32_t ym[8],
+                              const uint32_t t2d[8], const uint32_t *z2, int neg)
+{
+    const ext_mont256_mod *p = &ed25519_p;
+    uint32_t aa[8], bb[8], c[8], d[8], e[8], f[8], g[8], h[8];
+
+    /* -(x, y) = (-x, y) swaps y + x with y - x and negates t. */
+    ext_mont256_sub(aa, a->y, a->x, p);
+    ext_mont256_mul(aa, aa, neg ? yp : ym, p);
+    ext_mont256_add(bb, a->y, a->x, p);
+    ext_mont256_mul(bb, bb, neg ? ym : yp, p);
+    ext_mont256_mul(c, a->t, t2d, p);
+    if (neg) {
+        memset(d, 0, 32);
+        ext_mont256_sub(c, d, c, p);
+    }
+    if (z2 != NULL) {
+        ext_mont256_mul(d, a->z, z2, p);
+    } else {
+        ext_mont256_add(d, a->z, a->z, p);
+    }
+
+    ext_mont256_sub(e, bb, aa, p);
+    ext_mont256_sub(f, d, c, p);
+    ext_mont256_add(g, d, c, p);
+    ext_mont256_add(h, bb, aa, p);
+
+    ext_mont256_mul(r->x, e, f, p);
+    ext_mont256_mul(r->y, g, h, p);
+    ext_mont256_mul(r->t, e, h, p);
+    ext_mont256_mul(r->z, f, g, p);
+}
+
+/** @brief Cached form of @p a.
+ */
+static void ed25519_point_cache(ed25519_cached *r, const ed25519_point *a)
+{
+    const ext_mont256_mod *p = &ed25519_p;
+
+    ext_mont256_add(r->yp, a->y, a->x, p);
+    ext_mont256_sub(r->ym, a->y, a->x, p);
+    ext_mont256_mul(r->t2d, a->t, ed25519_d2, p);
+    ext_mont256_add(r->z2, a->z, a->z, p);
+}
+
+/** @brief Affine x and y of @p a, in Montgomery form.
+ */
+static void ed25519_point_to_affine(uint32_t x[8], uint32_t y[8], const ed25519_point *a)
+{
+    const ext_mont256_mod *p = &ed25519_p;
+    uint32_t zi[8];
+
+    ext_mont256_inv(zi, a->z, p);
+    ext_mont256_mul(x, a->x, zi, p);
+    ext_mont256_mul(y, a->y, zi, p);
+}
+
+/** @brief Decode a point as specified in RFC 8032, section 5.1.3.
+ */
+static int ed25519_point_decode(ed25519_point *r, const uint8_t s[32])
+{
+    const ext_mont256_mod *p = &ed25519_p;
+    static const uint32_t one[8] = { 1 };
+    uint32_t u[8], v[8], v3[8], t[8], x[8];
+    int sign = s[31] >> 7;
+
+    ext_mont256_load_le(r->y, s);
+    r->y[7] &= 0x7fffffff;
+    if (!ext_mont256_lt(r->y, p->m)) {
+        return -1;
+    }
+    ext_mont256_mul(r->y, r->y, p->rr, p);
+
+    /* u = y^2 - 1, v = d * y^2 + 1 */
+    ext_mont256_mul(u, r->y, r->y, p);
+    ext_mont256_mul(v, u, ed25519_d, p);
+    ext_mont256_sub(u, u, p->one, p);
+    ext_mont256_add(v, v, p->one, p);
+
+    /* x = u * v^3 * (u * v^7)^((p - 5) / 8) */
+    ext_mont256_mul(v3, v, v, p);
+    ext_mont256_mul(v3, v3, v, p);
+    ext_mont256_mul(t, v3, v3, p);
+    ext_mont256_mul(t, t, v, p);
+    ext_mont256_mul(t, t, u, p);
+    ext_mont256_pow(t, t, ed25519_p58, p);
+    ext_mont256_mul(x, t, v3, p);
+    ext_mont256_mul(x, x, u, p);
+
+    /* v * x^2 is u or -u, otherwise u / v is not a square. */
+    ext_mont256_mul(t, x, x, p);
+    ext_mont256_mul(t, t, v, p);
+    if (memcmp(t, u, 32) != 0) {
+        ext_mont256_add(t, t, u, p);
+        if (!ext_mont256_is_zero(t)) {
+            return -1;
+        }
+        ext_mont256_mul(x, x, ed25519_sqrtm1, p);
+    }
+
+    ext_mont256_mul(t, x, one, p);
+    if (ext_mont256_is_zero(t) && sign) {
+        return -1;
+    }
+    if ((int)(t[0] & 1) != sign) {
+        memset(t, 0, 32);
+        ext_mont256_sub(x, t, x, p);
+    }
+
+    memcpy(r->x, x, 32);
+    memcpy(r->z, p->one, 32);
+    ext_mont256_mul(r->t, x, r->y, p);
+
+    return 0;
+}
+
+/** @brief Encode a point as specified in RFC 8032, section 5.1.2.
+ */
+static void ed25519_point_encode(uint8_t s[32], const ed25519_point *a)
+{
+    const ext_mont256_mod *p = &ed25519_p;
+    static const uint32_t one[8] = { 1 };
+    uint32_t x[8], y[8];
+
+    ed25519_point_to_affine(x, y, a);
+    ext_mont256_mul(x, x, one, p);
+    ext_mont256_mul(y, y, one, p);
+    ext_mont256_store_le(s, y);
+    s[31] |= (uint8_t)((x[0] & 1) << 7);
+}
+
+/** @brief h = SHA512(R || A || M) mod l, in Montgomery form.
+ */
+static void ed25519_hram(uint32_t h[8], const uint8_t r[32], const uint8_t pk[32],
+                         const uint8_t *m, size_t m_len)
+{
+    const ext_mont256_mod *l = &ed25519_l;
+    ocrypto_sha512_ctx ctx;
+    uint8_t hash[ocrypto_sha512_BYTES];
+    uint32_t lo[8], hi[8];
+
+    ocrypto_sha512_init(&ctx);
+    ocrypto_sha512_update(&ctx, r, 32);
+    ocrypto_sha512_update(&ctx, pk, 32);
+    ocrypto_sha512_update(&ctx, m, m_len);
+    ocrypto_sha512_final(&ctx, hash);
+
+    /* lo * 2^256 + hi * 2^512 = (lo + hi * 2^256) * 2^256 mod l */
+    ext_mont256_load_le(lo, hash);
+    ext_mont256_load_le(hi, hash + 32);
+    ext_mont256_mul(lo, lo, l->rr, l);
+    ext_mont256_mul(hi, hi, ed25519_l_rrr, l);
+    ext_mont256_add(h, lo, hi, l);
+}
+
+/** @brief Load S from @p sig, in Montgomery form mod l.
+ */
+static int ed25519_load_s(uint32_t s[8], const uint8_t sig[64])
+{
+    const ext_mont256_mod *l = &ed25519_l;
+
+    ext_mont256_load_le(s, sig + 32);
+    if (!ext_mont256_lt(s, l->m)) {
+        return -1;
+    }
+    ext_mont256_mul(s, s, l->rr, l);
+    return 0;
+}
+
+int ocrypto_ed25519_key_init(ocrypto_ed25519_key *key,
+                             const uint8_t pk[ocrypto_ed25519_PUBLIC_KEY_BYTES])
+{
+    const ext_mont256_mod *p = &ed25519_p;
+    ed25519_point a, a2;
+    ed25519_cached c;
+    uint32_t x[8], y[8];
+    int i;
+
+    if (ed25519_point_decode(&a, pk)) {
+        return -1;
+    }
+    memcpy(key->pk, pk, sizeof(key->pk));
+
+    ed25519_point_double(&a2, &a);
+    ed25519_point_cache(&c, &a2);
+
+    for (i = 0; i < 8; i++) {
+        if (i > 0) {
+            ed25519_point_add(&a, &a, c.yp, c.ym, c.t2d, c.z2, 0);
+        }
+        ed25519_point_to_affine(x, y, &a);
+        ext_mont256_add(key->a[i][0], y, x, p);
+        ext_mont256_sub(key->a[i][1], y, x, p);
+        ext_mont256_mul(key->a[i][2], x, y, p);
+        ext_mont256_mul(key->a[i][2], key->a[i][2], ed25519_d2, p);
+    }
+
+    return 0;
+}
+
+int ocrypto_ed25519_keyed_verify(const uint8_t sig[ocrypto_ed25519_BYTES],
+                                 const uint8_t *m, size_t m_len,
+                                 const ocrypto_ed25519_key *key)
+{
+    static const uint32_t one[8] = { 1 };
+    uint32_t s[8], h[8];
+    int8_t naf1[257], naf2[257];
+    uint8_t r[32];
+    ed25519_point a;
+    int len, len2, i, d;
+
+    if (ed25519_load_s(s, sig)) {
+        return -1;
+    }
+    ed25519_hram(h, sig, key->pk, m, m_len);
+    ext_mont256_mul(s, s, one, &ed25519_l);
+    ext_mont256_mul(h, h, one, &ed25519_l);
+
+    /* [S]B - [h]A, with shared doublings. */
+    len = ext_mont256_wnaf(naf1, s, 5);
+    len2 = ext_mont256_wnaf(naf2, h, 5);
+    if (len2 > len) {
+        len = len2;
+    }
+
+    ed25519_point_identity(&a);
+    for (i = len - 1; i >= 0; i--) {
+        ed25519_point_double(&a, &a);
+        d = naf1[i];
+        if (d != 0) {
+            const uint32_t (*b)[8] = ed25519_b[(d < 0 ? -d : d) >> 1];
+            ed25519_point_add(&a, &a, b[0], b[1], b[2], NULL, d < 0);
+        }
+        d = naf2[i];
+        if (d != 0) {
+            const uint32_t (*b)[8] = key->a[(d < 0 ? -d : d) >> 1];
+            ed25519_point_add(&a, &a, b[0], b[1], b[2], NULL, d > 0);
+        }
+    }
+
+    ed25519_point_encode(r, &a);
+
+    return memcmp(r, sig, sizeof(r)) == 0 ? 0 : -1;
+}
+
+/** @brief Check up to ED25519_BATCH signatures with one combined equation.
+ *
+ * [sum(z_i * S_i)]B - sum([z_i]R_i) - sum([z_i * h_i]A_i) = 0, multiplied by
+ * the cofactor 8. The 128-bit coefficients z_i are derived from a hash of all
+ * signatures and h_i of the batch.
+ */
+static int ed25519_verify_batch_part(const uint8_t * const sig[],
+                                     const uint8_t * const m[], const size_t m_len[],
+                                     const ocrypto_ed25519_key * const key[],
+                                     size_t count)
+{
+    const ext_mont256_mod *l = &ed25519_l;
+    ed25519_cached rt[ED25519_BATCH][2];
+    int8_t naf_r[ED25519_BATCH][257], naf_a[ED25519_BATCH][257], naf_b[257];
+    uint32_t h[ED25519_BATCH][8], s[8], z[8], b[8];
+    uint8_t seed[ocrypto_sha512_BYTES], hash[ocrypto_sha512_BYTES];
+    ocrypto_sha512_ctx ctx;
+    ed25519_point a, r2;
+    int len, n, i, d;
+    size_t j;
+
+    ocrypto_sha512_init(&ctx);
+    for (j = 0; j < count; j++) {
+        if (ed25519_load_s(s, sig[j])) {
+            return -1;
+        }
+
+        /* Table R, 3R. */
+        if (ed25519_point_decode(&a, sig[j])) {
+            return -1;
+        }
+        ed25519_point_cache(&rt[j][0], &a);
+        ed25519_point_double(&r2, &a);
+        ed25519_point_add(&a, &r2, rt[j][0].yp, rt[j][0].ym, rt[j][0].t2d, rt[j][0].z2, 0);
+        ed25519_point_cache(&rt[j][1], &a);
+
+        ed25519_hram(h[j], sig[j], key[j]->pk, m[j], m_len[j]);
+        ext_mont256_store_le(hash, h[j]);
+        ocrypto_sha512_update(&ctx, sig[j], ocrypto_ed25519_BYTES);
+        ocrypto_sha512_update(&ctx, hash, 32);
+    }
+    ocrypto_sha512_final(&ctx, seed);
+
+    memset(b, 0, sizeof(b));
+    len = 0;
+    for (j = 0; j < count; j++) {
+        /* z = SHA512(seed || j) mod 2^128 */
+        ocrypto_sha512_init(&ctx);
+        ocrypto_sha512_update(&ctx, seed, sizeof(seed));
+        hash[0] = (uint8_t)j;
+        ocrypto_sha512_update(&ctx, hash, 1);
+        ocrypto_sha512_final(&ctx, hash);
+        memset(hash + 16, 0, 16);
+        ext_mont256_load_le(z, hash);
+
+        /* b += z * S, h = z * h */
+        ed25519_load_s(s, sig[j]);
+        ext_mont256_mul(s, s, z, l);
+        ext_mont256_add(b, b, s, l);
+        ext_mont256_mul(h[j], h[j], z, l);
+
+        n = ext_mont256_wnaf(naf_r[j], z, 3);
+        if (n > len) {
+            len = n;
+        }
+        n = ext_mont256_wnaf(naf_a[j], h[j], 5);
+        if (n > len) {
+            len = n;
+        }
+    }
+    n = ext_mont256_wnaf(naf_b, b, 5);
+    if (n > len) {
+        len = n;
+    }
+
+    ed25519_point_identity(&a);
+    for (i = len - 1; i >= 0; i--) {
+        ed25519_point_double(&a, &a);
+        d = naf_b[i];
+        if (d != 0) {
+            const uint32_t (*t)[8] = ed25519_b[(d < 0 ? -d : d) >> 1];
+            ed25519_point_add(&a, &a, t[0], t[1], t[2], NULL, d < 0);
+        }
+        for (j = 0; j < count; j++) {
+            d = naf_r[j][i];
+            if (d != 0) {
+                const ed25519_cached *t = &rt[j][(d < 0 ? -d : d) >> 1];
+                ed25519_point_add(&a, &a, t->yp, t->ym, t->t2d, t->z2, d > 0);
+            }
+            d = naf_a[j][i];
+            if (d != 0) {
+                const uint32_t (*t)[8] = key[j]->a[(d < 0 ? -d : d) >> 1];
+                ed25519_point_add(&a, &a, t[0], t[1], t[2], NULL, d > 0);
+            }
+        }
+    }
+
+    for (i = 0; i < 3; i++) {
+        ed25519_point_double(&a, &a);
+    }
+
+    /* The identity is (0 : Z : Z). */
+    return (ext_mont256_is_zero(a.x) && memcmp(a.y, a.z, 32) == 0) ? 0 : -1;
+}
+
+int ocrypto_ed25519_verify_batch(const uint8_t * const sig[],
+                                 const uint8_t * const m[], const size_t m_len[],
+                                 const ocrypto_ed25519_key * const key[],
+                                 size_t count)
+{
+    size_t n;
+
+    while (count > 0) {
+        n = count < ED25519_BATCH ? count : ED25519_BATCH;
+        if (ed25519_verify_batch_part(sig, m, m_len, key, n)) {
+            return -1;
+        }
+        sig += n;
+        m += n;
+        m_len += n;
+        key += n;
+        count -= n;
+    }
+
+    return 0;
+}
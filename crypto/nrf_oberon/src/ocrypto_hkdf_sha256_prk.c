@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "ocrypto_sha256.h"
+#include "ocrypto_hmac_sha256_key.h"
+#include "ocrypto_hkdf_sha256_prk.h"
+#include "ext_wipe.h"
+
+void ocrypto_hkdf_sha256_extract(ocrypto_hkdf_sha256_prk *prk,
+                                 const uint8_t *key, size_t key_len,
+                                 const uint8_t *salt, size_t salt_len)
+{
+    uint8_t t[ocrypto_sha256_BYTES];
+
+    /* PRK = HMAC(salt, IKM). An empty salt is the same HMAC key as HashLen zeros. */
+    ocrypto_hmac_sha256_key_init(&prk->key, salt, salt_len);
+    ocrypto_hmac_sha256_keyed(t, &prk->key, key, key_len);
+
+    ocrypto_hmac_sha256_key_init(&prk->key, t, sizeof(t));
+
+    ext_wipe(t, sizeof(t));
+}
+
+void ocrypto_hkdf_sha256_prk_init(ocrypto_hkdf_sha256_prk *prk,
+                                  const uint8_t *key, size_t key_len)
+{
+    ocrypto_hmac_sha256_key_init(&prk->key, key, key_len);
+}
+
+void ocrypto_hkdf_sha256_prk_clear(ocrypto_hkdf_sha256_prk *prk)
+{
+    ocrypto_hmac_sha256_key_clear(&prk->key);
+}
+
+void ocrypto_hkdf_sha256_expand(uint8_t *r, size_t r_len,
+                                const ocrypto_hkdf_sha256_prk *prk,
+                                const uint8_t *info, size_t info_len)
+{
+    ocrypto_hmac_sha256_keyed_ctx ctx;
+    uint8_t t[ocrypto_sha256_BYTES];
+    uint8_t cnt = 0;
+    size_t n;
+
+    /* T(i) = HMAC(PRK, T(i-1) || info || i), with T(0) empty. */
+    while (r_len > 0) {
+        ocrypto_hmac_sha256_keyed_init(&ctx, &prk->key);
+        if (cnt > 0) {
+            ocrypto_hmac_sha256_keyed_update(&ctx, t, sizeof(t));
+        }
+        ocrypto_hmac_sha256_keyed_update(&ctx, info, info_len);
+        cnt++;
+        ocrypto_hmac_sha256_keyed_update(&ctx, &cnt, 1);
+        ocrypto_hmac_sha256_keyed_final(&ctx, t);
+
+        n = r_len < sizeof(t) ? r_len : sizeof(t);
+        memcpy(r, t, n);
+        r += n;
+        r_len -= n;
+    }
+
+    ext_wipe(t, sizeof(t));
+}
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "ocrypto_sha1.h"
+#include "ocrypto_hmac_sha1_key.h"
+#include "ext_wipe.h"
+
+#define HMAC_SHA1_BLOCK_BYTES (64)
+
+void ocrypto_hmac_sha1_key_init(ocrypto_hmac_sha1_key *key,
+                                const uint8_t *k, size_t k_len)
+{
+    uint8_t block[HMAC_SHA1_BLOCK_BYTES];
+    size_t i;
+
+    memset(block, 0, sizeof(block));
+    if (k_len > HMAC_SHA1_BLOCK_BYTES) {
+        ocrypto_sha1(block, k, k_len);
+    } else {
+        memcpy(block, k, k_len);
+    }
+
+    for (i = 0; i < sizeof(block); i++) {
+        block[i] ^= 0x36;
+    }
+    ocrypto_sha1_init(&key->inner);
+    ocrypto_sha1_update(&key->inner, block, sizeof(block));
+
+    /* 0x36 ^ 0x5c turns the inner pad into the outer pad. */
+    for (i = 0; i < sizeof(block); i++) {
+        block[i] ^= 0x36 ^ 0x5c;
+    }
+    ocrypto_sha1_init(&key->outer);
+    ocrypto_sha1_update(&key->outer, block, sizeof(block));
+
+    ext_wipe(block, sizeof(block));
+}
+
+void ocrypto_hmac_sha1_key_clear(ocrypto_hmac_sha1_key *key)
+{
+    ext_wipe(key, sizeof(*key));
+}
+
+void ocrypto_hmac_sha1_keyed_init(ocrypto_hmac_sha1_keyed_ctx *ctx,
+                                  const ocrypto_hmac_sha1_key *key)
+{
+    ctx->hash_ctx = key->inner;
+    ctx->key = key;
+}
+
+void ocrypto_hmac_sha1_keyed_update(ocrypto_hmac_sha1_keyed_ctx *ctx,
+                                    const uint8_t *in, size_t in_len)
+{
+    ocrypto_sha1_update(&ctx->hash_ctx, in, in_len);
+}
+
+void ocrypto_hmac_sha1_keyed_final(ocrypto_hmac_sha1_keyed_ctx *ctx,
+                                   uint8_t r[ocrypto_sha1_BYTES])
+{
+    uint8_t inner[ocrypto_sha1_BYTES];
+
+    ocrypto_sha1_final(&ctx->hash_ctx, inner);
+
+    ctx->hash_ctx = ctx->key->outer;
+    ocrypto_sha1_update(&ctx->hash_ctx, inner, sizeof(inner));
+    ocrypto_sha1_final(&ctx->hash_ctx, r);
+
+    ext_wipe(inner, sizeof(inner));
+    ext_wipe(ctx, sizeof(*ctx));
+}
+
+void ocrypto_hmac_sha1_keyed(uint8_t r[ocrypto_sha1_BYTES],
+                             const ocrypto_hmac_sha1_key *key,
+                             const uint8_t *in, size_t in_len)
+{
+    ocrypto_hmac_sha1_keyed_ctx ctx;
+
+    ocrypto_hmac_sha1_keyed_init(&ctx, key);
+    ocrypto_hmac_sha1_keyed_update(&ctx, in, in_len);
+    ocrypto_hmac_sha1_keyed_final(&ctx, r);
+}
@@ -0,0 +1,277 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "ocrypto_sha256.h"
+#include "ocrypto_rsa_mont_key.h"
+
+#define RSA_WORDS 64
+#define RSA_BYTES (4 * RSA_WORDS)
+
+/** @brief DER encoded DigestInfo prefix of a SHA-256 hash.
+ */
+static const uint8_t rsa_sha256_prefix[19] = {
+    0x30, 0x31, 0x30, 0x0d, 0x06, 0x09, 0x60, 0x86, 0x48, 0x01,
+    0x65, 0x03, 0x04, 0x02, 0x01, 0x05, 0x00, 0x04, 0x20
+};
+
+/** @brief a < n.
+ */
+static int rsa_mont_lt(const uint32_t a[RSA_WORDS], const uint32_t n[RSA_WORDS])
+{
+    int i;
+
+    for (i = RSA_WORDS - 1; i >= 0; i--) {
+        if (a[i] != n[i]) {
+            return a[i] < n[i];
+        }
+    }
+    return 0;
+}
+
+/** @brief r = a - n.
+ */
+static void rsa_mont_sub_n(uint32_t r[RSA_WORDS], const uint32_t a[RSA_WORDS],
+                           const uint32_t n[RSA_WORDS])
+{
+    uint64_t c;
+    uint32_t borrow = 0;
+    int i;
+
+    for (i = 0; i < RSA_WORDS; i++) {
+        c = (uint64_t)a[i] - n[i] - borrow;
+        r[i] = (uint32_t)c;
+        borrow = (uint32_t)(c >> 32) & 1;
+    }
+}
+
+/** @brief r = a * b / 2^2048 mod n.
+ */
+static void rsa_mont_mul(uint32_t r[RSA_WORDS], const uint32_t a[RSA_WORDS],
+                         const uint32_t b[RSA_WORDS], const ocrypto_rsa2048_mont_pub_key *k)
+{
+    uint32_t t[RSA_WORDS + 2];
+    uint64_t c;
+    uint32_t u;
+    int i, j;
+
+    memset(t, 0, sizeof(t));
+
+    for (i = 0; i < RSA_WORDS; i++) {
+        c = 0;
+        for (j = 0; j < RSA_WORDS; j++) {
+            c += (uint64_t)t[j] + (uint64_t)a[j] * b[i];
+            t[j] = (uint32_t)c;
+            c >>= 32;
+        }
+        c += t[RSA_WORDS];
+        t[RSA_WORDS] = (uint32_t)c;
+        t[RSA_WORDS + 1] = (uint32_t)(c >> 32);
+
+        u = t[0] * k->ninv;
+        c = ((uint64_t)t[0] + (uint64_t)u * k->n[0]) >> 32;
+        for (j = 1; j < RSA_WORDS; j++) {
+            c += (uint64_t)t[j] + (uint64_t)u * k->n[j];
+            t[j - 1] = (uint32_t)c;
+            c >>= 32;
+        }
+        c += t[RSA_WORDS];
+        t[RSA_WORDS - 1] = (uint32_t)c;
+        t[RSA_WORDS] = t[RSA_WORDS + 1] + (uint32_t)(c >> 32);
+    }
+
+    if (t[RSA_WORDS] || !rsa_mont_lt(t, k->n)) {
+        rsa_mont_sub_n(t, t, k->n);
+    }
+    memcpy(r, t, RSA_BYTES);
+}
+
+/** @brief em = s^65537 mod n, as 256 bytes big endian.
+ */
+static int rsa_mont_public(uint8_t em[RSA_BYTES], const uint8_t s[RSA_BYTES],
+                           const ocrypto_rsa2048_mont_pub_key *k)
+{
+    uint32_t x[RSA_WORDS], y[RSA_WORDS];
+    int i;
+
+    for (i = 0; i < RSA_WORDS; i++) {
+        x[i] = ((uint32_t)s[RSA_BYTES - 4 * i - 4] << 24) |
+               ((uint32_t)s[RSA_BYTES - 4 * i - 3] << 16) |
+               ((uint32_t)s[RSA_BYTES - 4 * i - 2] << 8) |
+               (uint32_t)s[RSA_BYTES - 4 * i - 1];
+    }
+    if (!rsa_mont_lt(x, k->n)) {
+        return -1;
+    }
+
+    /* x^(2^16 + 1), with x in Montgomery form. */
+    rsa_mont_mul(x, x, k->rr, k);
+    memcpy(y, x, sizeof(y));
+    for (i = 0; i < 16; i++) {
+        rsa_mont_mul(y, y, y, k);
+    }
+    rsa_mont_mul(y, y, x, k);
+
+    memset(x, 0, sizeof(x));
+    x[0] = 1;
+    rsa_mont_mul(y, y, x, k);
+
+    for (i = 0; i < RSA_WORDS; i++) {
+        em[RSA_BYTES - 4 * i - 4] = (uint8_t)(y[i] >> 24);
+        em[RSA_BYTES - 4 * i - 3] = (uint8_t)(y[i] >> 16);
+        em[RSA_BYTES - 4 * i - 2] = (uint8_t)(y[i] >> 8);
+        em[RSA_BYTES - 4 * i - 1] = (uint8_t)y[i];
+    }
+
+    return 0;
+}
+
+int ocrypto_rsa2048_init_mont_pub_key(
+    ocrypto_rsa2048_mont_pub_key *k,
+    const uint8_t *n, size_t nlen)
+{
+    uint32_t x[RSA_WORDS];
+    uint32_t inv, carry, top;
+    int i, j;
+
+    if (nlen != RSA_BYTES || (n[0] & 0x80) == 0 || (n[RSA_BYTES - 1] & 1) == 0) {
+        return -1;
+    }
+
+    for (i = 0; i < RSA_WORDS; i++) {
+        k->n[i] = ((uint32_t)n[RSA_BYTES - 4 * i - 4] << 24) |
+                  ((uint32_t)n[RSA_BYTES - 4 * i - 3] << 16) |
+                  ((uint32_t)n[RSA_BYTES - 4 * i - 2] << 8) |
+                  (uint32_t)n[RSA_BYTES - 4 * i - 1];
+    }
+
+    /* Newton iteration, each step doubles the number of correct bits. */
+    inv = k->n[0];
+    for (i = 0; i < 4; i++) {
+        inv *= 2 - k->n[0] * inv;
+    }
+    k->ninv = 0 - inv;
+
+    /* 2^2048 mod n = 2^2048 - n, as n >= 2^2047. */
+    memset(x, 0, sizeof(x));
+    rsa_mont_sub_n(x, x, k->n);
+
+    /* 2048 modular doublings give 2^4096 mod n. */
+    for (j = 0; j < 2048; j++) {
+        top = x[RSA_WORDS - 1] >> 31;
+        carry = 0;
+        for (i = 0; i < RSA_WORDS; i++) {
+            uint32_t w = x[i];
+            x[i] = (w << 1) | carry;
+            carry = w >> 31;
+        }
+        if (top || !rsa_mont_lt(x, k->n)) {
+            rsa_mont_sub_n(x, x, k->n);
+        }
+    }
+    memcpy(k->rr, x, sizeof(x));
+
+    return 0;
+}
+
+int ocrypto_rsa2048_mont_pkcs1_v15_sha256_verify(
+    const uint8_t s[256],
+    const uint8_t *m, size_t mlen,
+    const ocrypto_rsa2048_mont_pub_key *pk)
+{
+    uint8_t em[RSA_BYTES];
+    uint8_t hash[ocrypto_sha256_BYTES];
+    size_t i, ps;
+
+    if (rsa_mont_public(em, s, pk)) {
+        return -1;
+    }
+
+    /* EM = 0x00 || 0x01 || PS || 0x00 || DigestInfo || H */
+    ps = RSA_BYTES - 3 - sizeof(rsa_sha256_prefix) - sizeof(hash);
+    if (em[0] != 0x00 || em[1] != 0x01 || em[2 + ps] != 0x00) {
+        return -1;
+    }
+    for (i = 0; i < ps; i++) {
+        if (em[2 + i] != 0xff) {
+            return -1;
+        }
+    }
+    if (memcmp(em + 3 + ps, rsa_sha256_prefix, sizeof(rsa_sha256_prefix)) != 0) {
+        return -1;
+    }
+
+    ocrypto_sha256(hash, m, mlen);
+
+    return memcmp(em + RSA_BYTES - sizeof(hash), hash, sizeof(hash)) == 0 ? 0 : -1;
+}
+
+int ocrypto_rsa2048_mont_pss_sha256_verify(
+    const uint8_t s[256],
+    const uint8_t *m, size_t mlen,
+    size_t slen, // salt length
+    const ocrypto_rsa2048_mont_pub_key *pk)
+{
+    const size_t db_len = RSA_BYTES - ocrypto_sha256_BYTES - 1;
+    ocrypto_sha256_ctx ctx;
+    uint8_t em[RSA_BYTES];
+    uint8_t hash[ocrypto_sha256_BYTES];
+    uint8_t cnt[4] = { 0 };
+    const uint8_t *h;
+    size_t i, j, ps;
+
+    if (slen > db_len - 1) {
+        return -2;
+    }
+
+    if (rsa_mont_public(em, s, pk)) {
+        return -1;
+    }
+
+    /* EM = maskedDB || H || 0xbc, with the top bit of EM cleared. */
+    h = em + db_len;
+    if (em[RSA_BYTES - 1] != 0xbc || (em[0] & 0x80) != 0) {
+        return -1;
+    }
+
+    /* DB = maskedDB ^ MGF1(H) */
+    for (i = 0; i < db_len; i += ocrypto_sha256_BYTES) {
+        cnt[3] = (uint8_t)(i / ocrypto_sha256_BYTES);
+        ocrypto_sha256_init(&ctx);
+        ocrypto_sha256_update(&ctx, h, ocrypto_sha256_BYTES);
+        ocrypto_sha256_update(&ctx, cnt, sizeof(cnt));
+        ocrypto_sha256_final(&ctx, hash);
+        for (j = 0; j < ocrypto_sha256_BYTES && i + j < db_len; j++) {
+            em[i + j] ^= hash[j];
+        }
+    }
+    em[0] &= 0x7f;
+
+    /* DB = PS || 0x01 || salt */
+    ps = db_len - slen - 1;
+    for (i = 0; i < ps; i++) {
+        if (em[i] != 0x00) {
+            return -1;
+        }
+    }
+    if (em[ps] != 0x01) {
+        return -1;
+    }
+
+    /* H = SHA256(0^64 || SHA256(m) || salt) */
+    ocrypto_sha256(hash, m, mlen);
+    ocrypto_sha256_init(&ctx);
+    memset(cnt, 0, sizeof(cnt));
+    ocrypto_sha256_update(&ctx, cnt, sizeof(cnt));
+    ocrypto_sha256_update(&ctx, cnt, sizeof(cnt));
+    ocrypto_sha256_update(&ctx, hash, sizeof(hash));
+    ocrypto_sha256_update(&ctx, em + ps + 1, slen);
+    ocrypto_sha256_final(&ctx, hash);
+
+    return memcmp(h, hash, sizeof(hash)) == 0 ? 0 : -1;
+}
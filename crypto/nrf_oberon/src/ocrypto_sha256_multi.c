@@ -0,0 +1,240 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "ocrypto_sha256.h"
+#include "ocrypto_sha256_multi.h"
+
+#define SHA256_BLOCK_BYTES (64)
+
+static const uint32_t k256[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+static const uint32_t h256[8] = {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19,
+};
+
+#define ROR(x, n)   (((x) >> (n)) | ((x) << (32 - (n))))
+#define S0(x)       (ROR(x, 2) ^ ROR(x, 13) ^ ROR(x, 22))
+#define S1(x)       (ROR(x, 6) ^ ROR(x, 11) ^ ROR(x, 25))
+#define s0(x)       (ROR(x, 7) ^ ROR(x, 18) ^ ((x) >> 3))
+#define s1(x)       (ROR(x, 17) ^ ROR(x, 19) ^ ((x) >> 10))
+#define CH(x, y, z) (((x) & ((y) ^ (z))) ^ (z))
+#define MAJ(x, y, z) (((x) & (y)) | ((z) & ((x) | (y))))
+
+/** @brief Compression state and block source of one message
+ */
+typedef struct
+{
+    uint32_t h[8];
+    const uint8_t *in;
+    size_t blocks;          /* Number of full input blocks left. */
+    size_t tail_blocks;     /* Number of padded tail blocks left. */
+    const uint8_t *tail_p;
+    uint8_t tail[2 * SHA256_BLOCK_BYTES];
+} sha256_lane;
+
+static void lane_init(sha256_lane *lane, const uint8_t *in, size_t in_len)
+{
+    size_t rem = in_len % SHA256_BLOCK_BYTES;
+    uint64_t bits = (uint64_t)in_len * 8;
+    size_t tail_len;
+    int i;
+
+    memcpy(lane->h, h256, sizeof(lane->h));
+    lane->in = in;
+    lane->blocks = in_len / SHA256_BLOCK_BYTES;
+
+    /* The tail holds the last partial block, the padding and the length. */
+    tail_len = (rem + 9 > SHA256_BLOCK_BYTES) ? 2 * SHA256_BLOCK_BYTES : SHA256_BLOCK_BYTES;
+    memset(lane->tail, 0, tail_len);
+    memcpy(lane->tail, in + in_len - rem, rem);
+    lane->tail[rem] = 0x80;
+    for (i = 0; i < 8; i++) {
+        lane->tail[tail_len - 1 - i] = (uint8_t)(bits >> (8 * i));
+    }
+    lane->tail_blocks = tail_len / SHA256_BLOCK_BYTES;
+    lane->tail_p = lane->tail;
+}
+
+static size_t lane_left(const sha256_lane *lane)
+{
+    return lane->blocks + lane->tail_blocks;
+}
+
+static const uint8_t * lane_next(sha256_lane *lane)
+{
+    const uint8_t *p;
+
+    if (lane->blocks) {
+        p = lane->in;
+        lane->in += SHA256_BLOCK_BYTES;
+        lane->blocks--;
+    } else {
+        p = lane->tail_p;
+        lane->tail_p += SHA256_BLOCK_BYTES;
+        lane->tail_blocks--;
+    }
+    return p;
+}
+
+static void lane_final(sha256_lane *lane, uint8_t r[ocrypto_sha256_BYTES])
+{
+    int i;
+
+    for (i = 0; i < 8; i++) {
+        r[4 * i + 0] = (uint8_t)(lane->h[i] >> 24);
+        r[4 * i + 1] = (uint8_t)(lane->h[i] >> 16);
+        r[4 * i + 2] = (uint8_t)(lane->h[i] >> 8);
+        r[4 * i + 3] = (uint8_t)(lane->h[i]);
+    }
+}
+
+static uint32_t load_be32(const uint8_t *p)
+{
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) |
+           ((uint32_t)p[2] << 8) | (uint32_t)p[3];
+}
+
+/** @brief One SHA-256 round; the working variables rotate by renaming
+ */
+#define ROUND(a, b, c, d, e, f, g, h, k, w) do { \
+        uint32_t t1 = h + S1(e) + CH(e, f, g) + k + w; \
+        uint32_t t2 = S0(a) + MAJ(a, b, c); \
+        d += t1; \
+        h = t1 + t2; \
+    } while (0)
+
+#define W_NEXT(w, i) \
+    (w[(i) & 15] += s1(w[((i) - 2) & 15]) + w[((i) - 7) & 15] + s0(w[((i) - 15) & 15]))
+
+/** @brief Compress one block of each of two messages with interleaved rounds
+ */
+static void sha256_compress2(uint32_t ha[8], const uint8_t *pa,
+                             uint32_t hb[8], const uint8_t *pb)
+{
+    uint32_t wa[16], wb[16];
+    uint32_t a0 = ha[0], a1 = ha[1], a2 = ha[2], a3 = ha[3];
+    uint32_t a4 = ha[4], a5 = ha[5], a6 = ha[6], a7 = ha[7];
+    uint32_t b0 = hb[0], b1 = hb[1], b2 = hb[2], b3 = hb[3];
+    uint32_t b4 = hb[4], b5 = hb[5], b6 = hb[6], b7 = hb[7];
+    int i;
+
+    for (i = 0; i < 16; i++) {
+        wa[i] = load_be32(pa + 4 * i);
+        wb[i] = load_be32(pb + 4 * i);
+    }
+
+    for (i = 0; i < 64; i += 8) {
+        if (i >= 16) {
+            int j;
+            for (j = i; j < i + 8; j++) {
+                W_NEXT(wa, j);
+                W_NEXT(wb, j);
+            }
+        }
+        ROUND(a0, a1, a2, a3, a4, a5, a6, a7, k256[i + 0], wa[(i + 0) & 15]);
+        ROUND(b0, b1, b2, b3, b4, b5, b6, b7, k256[i + 0], wb[(i + 0) & 15]);
+        ROUND(a7, a0, a1, a2, a3, a4, a5, a6, k256[i + 1], wa[(i + 1) & 15]);
+        ROUND(b7, b0, b1, b2, b3, b4, b5, b6, k256[i + 1], wb[(i + 1) & 15]);
+        ROUND(a6, a7, a0, a1, a2, a3, a4, a5, k256[i + 2], wa[(i + 2) & 15]);
+        ROUND(b6, b7, b0, b1, b2, b3, b4, b5, k256[i + 2], wb[(i + 2) & 15]);
+        ROUND(a5, a6, a7, a0, a1, a2, a3, a4, k256[i + 3], wa[(i + 3) & 15]);
+        ROUND(b5, b6, b7, b0, b1, b2, b3, b4, k256[i + 3], wb[(i + 3) & 15]);
+        ROUND(a4, a5, a6, a7, a0, a1, a2, a3, k256[i + 4], wa[(i + 4) & 15]);
+        ROUND(b4, b5, b6, b7, b0, b1, b2, b3, k256[i + 4], wb[(i + 4) & 15]);
+        ROUND(a3, a4, a5, a6, a7, a0, a1, a2, k256[i + 5], wa[(i + 5) & 15]);
+        ROUND(b3, b4, b5, b6, b7, b0, b1, b2, k256[i + 5], wb[(i + 5) & 15]);
+        ROUND(a2, a3, a4, a5, a6, a7, a0, a1, k256[i + 6], wa[(i + 6) & 15]);
+        ROUND(b2, b3, b4, b5, b6, b7, b0, b1, k256[i + 6], wb[(i + 6) & 15]);
+        ROUND(a1, a2, a3, a4, a5, a6, a7, a0, k256[i + 7], wa[(i + 7) & 15]);
+        ROUND(b1, b2, b3, b4, b5, b6, b7, b0, k256[i + 7], wb[(i + 7) & 15]);
+    }
+
+    ha[0] += a0; ha[1] += a1; ha[2] += a2; ha[3] += a3;
+    ha[4] += a4; ha[5] += a5; ha[6] += a6; ha[7] += a7;
+    hb[0] += b0; hb[1] += b1; hb[2] += b2; hb[3] += b3;
+    hb[4] += b4; hb[5] += b5; hb[6] += b6; hb[7] += b7;
+}
+
+/** @brief Compress one block of a single message
+ */
+static void sha256_compress1(uint32_t ha[8], const uint8_t *pa)
+{
+    uint32_t wa[16];
+    uint32_t a0 = ha[0], a1 = ha[1], a2 = ha[2], a3 = ha[3];
+    uint32_t a4 = ha[4], a5 = ha[5], a6 = ha[6], a7 = ha[7];
+    int i;
+
+    for (i = 0; i < 16; i++) {
+        wa[i] = load_be32(pa + 4 * i);
+    }
+
+    for (i = 0; i < 64; i += 8) {
+        if (i >= 16) {
+            int j;
+            for (j = i; j < i + 8; j++) {
+                W_NEXT(wa, j);
+            }
+        }
+        ROUND(a0, a1, a2, a3, a4, a5, a6, a7, k256[i + 0], wa[(i + 0) & 15]);
+        ROUND(a7, a0, a1, a2, a3, a4, a5, a6, k256[i + 1], wa[(i + 1) & 15]);
+        ROUND(a6, a7, a0, a1, a2, a3, a4, a5, k256[i + 2], wa[(i + 2) & 15]);
+        ROUND(a5, a6, a7, a0, a1, a2, a3, a4, k256[i + 3], wa[(i + 3) & 15]);
+        ROUND(a4, a5, a6, a7, a0, a1, a2, a3, k256[i + 4], wa[(i + 4) & 15]);
+        ROUND(a3, a4, a5, a6, a7, a0, a1, a2, k256[i + 5], wa[(i + 5) & 15]);
+        ROUND(a2, a3, a4, a5, a6, a7, a0, a1, k256[i + 6], wa[(i + 6) & 15]);
+        ROUND(a1, a2, a3, a4, a5, a6, a7, a0, k256[i + 7], wa[(i + 7) & 15]);
+    }
+
+    ha[0] += a0; ha[1] += a1; ha[2] += a2; ha[3] += a3;
+    ha[4] += a4; ha[5] += a5; ha[6] += a6; ha[7] += a7;
+}
+
+void ocrypto_sha256_multi(
+    uint8_t r[][ocrypto_sha256_BYTES],
+    const uint8_t * const in[], const size_t in_len[],
+    size_t count)
+{
+    sha256_lane lanes[2];
+    size_t i;
+
+    for (i = 0; i + 1 < count; i += 2) {
+        lane_init(&lanes[0], in[i], in_len[i]);
+        lane_init(&lanes[1], in[i + 1], in_len[i + 1]);
+
+        while (lane_left(&lanes[0]) && lane_left(&lanes[1])) {
+            const uint8_t *pa = lane_next(&lanes[0]);
+            const uint8_t *pb = lane_next(&lanes[1]);
+            sha256_compress2(lanes[0].h, pa, lanes[1].h, pb);
+        }
+        while (lane_left(&lanes[0])) {
+            sha256_compress1(lanes[0].h, lane_next(&lanes[0]));
+        }
+        while (lane_left(&lanes[1])) {
+            sha256_compress1(lanes[1].h, lane_next(&lanes[1]));
+        }
+
+        lane_final(&lanes[0], r[i]);
+        lane_final(&lanes[1], r[i + 1]);
+    }
+
+    if (i < count) {
+        ocrypto_sha256(r[i], in[i], in_len[i]);
+    }
+
+    memset(lanes, 0, sizeof(lanes));
+}
@@ -137,6 +137,7 @@ kconfig_mbedtls_config("MBEDTLS_ECP_DP_BP384R1_ENABLED")
 kconfig_mbedtls_config("MBEDTLS_ECP_DP_BP512R1_ENABLED")
 kconfig_mbedtls_config("MBEDTLS_ECP_DP_CURVE25519_ENABLED")
 kconfig_mbedtls_config("MBEDTLS_ECP_DP_CURVE448_ENABLED")
+kconfig_mbedtls_config("MBEDTLS_ECP_RESTARTABLE")
 kconfig_mbedtls_config("MBEDTLS_CIPHER_PADDING_PKCS7")
 kconfig_mbedtls_config("MBEDTLS_CIPHER_PADDING_ONE_AND_ZEROS")
 kconfig_mbedtls_config("MBEDTLS_CIPHER_PADDING_ZEROS_AND_LEN")
@@ -213,6 +214,7 @@ kconfig_mbedtls_config_alt("MBEDTLS_DHM")
 kconfig_mbedtls_config_alt("MBEDTLS_ECDH")
 kconfig_mbedtls_config_alt("MBEDTLS_ECDSA")
 kconfig_mbedtls_config_alt("MBEDTLS_ECP")
+kconfig_mbedtls_config_alt("MBEDTLS_GCM")
 kconfig_mbedtls_config_alt("MBEDTLS_POLY1305")
 kconfig_mbedtls_config_alt("MBEDTLS_RSA")
 kconfig_mbedtls_config_alt("MBEDTLS_SHA1")
@@ -234,7 +236,7 @@ if (CONFIG_CC310_BACKEND)
   set(MBEDTLS_PLATFORM_SETUP_TEARDOWN_ALT TRUE)
 endif()
 
-if (CC310_MBEDTLS_ECDH_C)
+if (CC310_MBEDTLS_ECDH_C OR CONFIG_GLUE_MBEDTLS_ECDH_C)
   set(MBEDTLS_ECDH_GEN_PUBLIC_ALT TRUE)
   set(MBEDTLS_ECDH_COMPUTE_SHARED_ALT TRUE)
 endif()
@@ -426,6 +428,12 @@ configure_file_ifdef(CONFIG_GLUE_MBEDTLS_CCM_C
   COPYONLY
 )
 
+configure_file_ifdef(CONFIG_GLUE_MBEDTLS_CHACHAPOLY_C
+  ${mbedcrypto_glue_include_path}/chachapoly_alt.h
+  ${generated_include_path}/chachapoly_alt.h
+  COPYONLY
+)
+
 configure_file_ifdef(CONFIG_GLUE_MBEDTLS_CMAC_C
   ${mbedcrypto_glue_include_path}/cmac_alt.h
   ${generated_include_path}/cmac_alt.h
@@ -438,12 +446,30 @@ configure_file_ifdef(CONFIG_GLUE_MBEDTLS_DHM_C
   COPYONLY
 )
 
+configure_file_ifdef(CONFIG_GLUE_MBEDTLS_GCM_C
+  ${mbedcrypto_glue_include_path}/gcm_alt.h
+  ${generated_include_path}/gcm_alt.h
+  COPYONLY
+)
+
 configure_file_ifdef(CONFIG_GLUE_MBEDTLS_RSA_C
   ${mbedcrypto_glue_include_path}/rsa_alt.h
   ${generated_include_path}/rsa_alt.h
   COPYONLY
 )
 
+configure_file_ifdef(CONFIG_GLUE_MBEDTLS_SHA1_C
+  ${mbedcrypto_glue_include_path}/sha1_alt.h
+  ${generated_include_path}/sha1_alt.h
+  COPYONLY
+)
+
+configure_file_ifdef(CONFIG_GLUE_MBEDTLS_SHA256_C
+  ${mbedcrypto_glue_include_path}/sha256_alt.h
+  ${generated_include_path}/sha256_alt.h
+  COPYONLY
+)
+
 #
 # Include for generated mbed TLS config file
 #
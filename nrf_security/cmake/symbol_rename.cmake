@@ -59,6 +59,7 @@ function(symbol_rename_func backend rename_template is_stripped)
   #
   keep_config_test_glue("MBEDTLS_AES_C"           ${BACKEND_NAME})
   keep_config_test_glue("MBEDTLS_CCM_C"           ${BACKEND_NAME})
+  keep_config_test_glue("MBEDTLS_CHACHAPOLY_C"    ${BACKEND_NAME})
   keep_config_test_glue("MBEDTLS_DHM_C"           ${BACKEND_NAME})
 
   keep_config_test_glue("MBEDTLS_CMAC_C"          ${BACKEND_NAME})
@@ -67,6 +68,8 @@ function(symbol_rename_func backend rename_template is_stripped)
   keep_config_test_glue("MBEDTLS_RSA_C"           ${BACKEND_NAME})
   keep_config_test_glue("MBEDTLS_DHM_C"           ${BACKEND_NAME})
   keep_config_test_glue("MBEDTLS_GCM_C"           ${BACKEND_NAME})
+  keep_config_test_glue("MBEDTLS_SHA1_C"          ${BACKEND_NAME})
+  keep_config_test_glue("MBEDTLS_SHA256_C"        ${BACKEND_NAME})
 
 
   #
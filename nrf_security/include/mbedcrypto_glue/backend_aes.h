@@ -36,6 +36,8 @@
  *          dynamically checked. If the return value is 0, then the backend does not
  *          support the AES cipher (mode, key size etc). If the value is positive,
  *          then the backend with the highest value is selected (priority based).
+ *          The result is cached per key size, mode and XTS usage, so it must
+ *          not depend on anything else.
  *
  * @param[in]   keybits     Key size in bits for the AES functionality.
  * @param[in]   mode        AES mode.
@@ -164,6 +166,23 @@ typedef int (*mbedtls_internal_aes_encrypt_fn)(mbedtls_aes_context *ctx, const u
 typedef int (*mbedtls_internal_aes_decrypt_fn)(mbedtls_aes_context *ctx, const unsigned char input[16], unsigned char output[16]);
 
 
+/**@brief Function pointer to encrypt/decrypt multiple independent AES blocks.
+ *
+ * @details This function pointer has a signature equal to @c mbedtls_aes_crypt_ecb_blocks.
+ *          Optional, no current backend provides it. If set to NULL, the glue layer
+ *          calls the single block functions for each block.
+ *
+ * @param[in,out]       ctx         Pointer to the context for the encrypt/decrypt operation.
+ * @param[in]           mode        Mode of AES operation (encrypt/decrypt).
+ * @param[in]           length      Length of the input/output data, a multiple of 16 bytes.
+ * @param[in]           input       Pointer to the buffer holding the input blocks.
+ * @param[out]          output      Pointer to the buffer to hold the output blocks.
+ *
+ * @return 0 if operation was successful, otherwise a negative value corresponding to the error.
+ */
+typedef int (*mbedtls_aes_crypt_ecb_blocks_fn)(mbedtls_aes_context *ctx, int mode, size_t length, const unsigned char *input, unsigned char *output);
+
+
 /**@brief Function pointer to encrypt/decrypt using AES CBC.
  *
  * @details This function pointer has a signature equal to @c mbedtls_aes_crypt_cbc.
@@ -289,6 +308,7 @@ typedef struct
 #endif /* MBEDTLS_CIPHER_MODE_XTS */
     mbedtls_internal_aes_encrypt_fn internal_encrypt;   //!< Perform AES encrypt operation.
     mbedtls_internal_aes_decrypt_fn internal_decrypt;   //!< Perform AES decrypt operation.
+    mbedtls_aes_crypt_ecb_blocks_fn crypt_ecb_blocks;   //!< Perform AES encrypt/decrypt operation on multiple blocks (optional).
 #if defined(MBEDTLS_CIPHER_MODE_CBC)
     mbedtls_aes_crypt_cbc_fn crypt_cbc;                 //!< Perform AES CBC encrypt/decrypt operation.
 #endif /* MBEDTLS_CIPHER_MODE_CBC */
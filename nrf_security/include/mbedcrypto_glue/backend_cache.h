@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+
+/**@file
+ * @defgroup mbedcrypto_glue_backend_cache mbedcrypto glue backend cache
+ * @ingroup mbedcrypto_glue
+ * @{
+ * @brief Resolved-backend cache shared by the mbedcrypto glue layers.
+ *
+ * @details The glue layers select a backend by calling the @c check function of
+ *          every enabled backend and picking the one with the highest priority.
+ *          The result only depends on the parameters given to @c check, so it is
+ *          resolved once per parameter combination and stored in a table that is
+ *          indexed directly. Subsequent lookups are a single array read without any
+ *          indirect calls.
+ *
+ *          Each entry is a single pointer and the resolved value for an index never
+ *          changes, so concurrent lazy population is safe without locking.
+ */
+#ifndef BACKEND_CACHE_H
+#define BACKEND_CACHE_H
+
+/**@brief Index value used when a parameter combination can not be cached. */
+#define BACKEND_CACHE_NO_INDEX          (-1)
+
+/**@brief Number of cache rows used for the AES key sizes 128, 192 and 256 bits. */
+#define BACKEND_CACHE_KEYBITS_COUNT     (3)
+
+/**@brief Map an AES key size in bits to a cache row.
+ *
+ * @param[in]   keybits     Key size in bits.
+ *
+ * @return Row index for 128, 192 or 256 bits, otherwise @ref BACKEND_CACHE_NO_INDEX.
+ */
+static inline int backend_cache_keybits_index(unsigned int keybits)
+{
+    switch (keybits)
+    {
+        case 128:
+            return 0;
+        case 192:
+            return 1;
+        case 256:
+            return 2;
+        default:
+            return BACKEND_CACHE_NO_INDEX;
+    }
+}
+
+/**@brief Look up the backend for a cache index, resolving and storing it on a miss.
+ *
+ * @details If @p index is @ref BACKEND_CACHE_NO_INDEX, @p resolve is evaluated on
+ *          every call. Unsupported parameter combinations (@p resolve yielding NULL)
+ *          are not stored, which keeps the error path identical to an uncached lookup.
+ *
+ * @param[in]   cache       Array of resolved backend pointers, zero-initialized.
+ * @param[in]   index       Index into @p cache.
+ * @param[out]  funcs       Variable receiving the resolved backend.
+ * @param[in]   resolve     Expression that performs the full backend search.
+ */
+#define BACKEND_CACHE_GET(cache, index, funcs, resolve) do { \
+        int _cache_index = (index); \
+        if (_cache_index == BACKEND_CACHE_NO_INDEX) \
+        { \
+            funcs = (resolve); \
+            break; \
+        } \
+        funcs = cache[_cache_index]; \
+        if (funcs == NULL) \
+        { \
+            funcs = (resolve); \
+            cache[_cache_index] = funcs; \
+        } \
+    } while (0)
+
+#endif /* BACKEND_CACHE_H */
+
+/** @} */
@@ -30,6 +30,8 @@
  *          dynamically checked. If the return value is 0, then the backend does not
  *          support the AES CCM cipher (mode, keysize etc). If the value is positive,
  *          then the backend with the highest value is selected (priority based).
+ *          The result is cached per cipher and key size, so it must not depend
+ *          on anything else.
  *
  * @param[in]   mode        AES CCM mode.
  * @param[in]   keybits     Key size in bits for the AES functionality.
@@ -39,6 +41,22 @@
 typedef int (*mbedtls_ccm_check_fn)(mbedtls_cipher_id_t cipher, unsigned int keybits);
 
 
+/**@brief Function pointer to get the priority of the backend for an operation length.
+ *
+ * @details Used by the glue layer when CONFIG_GLUE_SIZE_AWARE_DISPATCH is enabled.
+ *          A context is then keyed in the two highest priority backends, and each
+ *          operation is handed to the one returning the highest value for its
+ *          input length. Ties go to the backend selected by @ref mbedtls_ccm_check_fn.
+ *          Backends with a cost independent of the length should set this to NULL,
+ *          which is equivalent to returning 1.
+ *
+ * @param[in]   length      Length of the input of the operation.
+ *
+ * @return Priority for the operation, where higher is better.
+ */
+typedef int (*mbedtls_ccm_check_length_fn)(size_t length);
+
+
 /**@brief Function pointer to initialize a glue AES CCM context.
  *
  * @details This function inits or resets the glue context for an AES CCM operation.
@@ -153,6 +171,56 @@ typedef int (*mbedtls_ccm_auth_decrypt_fn)(mbedtls_ccm_context *ctx, size_t leng
 typedef int (*mbedtls_ccm_star_auth_decrypt_fn)(mbedtls_ccm_context *ctx, size_t length, const unsigned char *iv, size_t iv_len, const unsigned char *add, size_t add_len, const unsigned char *input, unsigned char *output, const unsigned char *tag, size_t tag_len);
 
 
+/**@brief Function pointer to perform an AES CCM or CCM* encrypt-and-tag operation on fragmented buffers.
+ *
+ * @details This function pointer corresponds to @c mbedtls_ccm_encrypt_and_tag_iov and
+ *          @c mbedtls_ccm_star_encrypt_and_tag_iov. Backends that can not process
+ *          fragmented buffers directly should set this to NULL, in which case the glue
+ *          layer gathers the segments before calling @c encrypt_and_tag.
+ *
+ * @param[in,out]       ctx             Pointer to the context for the operation.
+ * @param[in]           star            If 1, CCM* is used. Otherwise CCM.
+ * @param[in]           iv              Pointer to the array holding the initialization vector.
+ * @param[in]           iv_len          Length of the initialization vector.
+ * @param[in]           add             Segments holding optional associated data.
+ * @param[in]           add_count       Number of associated data segments.
+ * @param[in]           input           Segments holding the input.
+ * @param[in]           input_count     Number of input segments.
+ * @param[out]          output          Segments to hold the output.
+ * @param[in]           output_count    Number of output segments.
+ * @param[out]          tag             Pointer to the array to hold the tag.
+ * @param[in]           tag_len         Length of the tag.
+ *
+ * @return 0 if operation was successful, otherwise a negative value corresponding to the error.
+ */
+typedef int (*mbedtls_ccm_encrypt_and_tag_iov_fn)(mbedtls_ccm_context *ctx, int star, const unsigned char *iv, size_t iv_len, const mbedtls_ccm_iovec *add, size_t add_count, const mbedtls_ccm_iovec *input, size_t input_count, const mbedtls_ccm_iovec *output, size_t output_count, unsigned char *tag, size_t tag_len);
+
+
+/**@brief Function pointer to perform an AES CCM or CCM* decrypt operation on fragmented buffers.
+ *
+ * @details This function pointer corresponds to @c mbedtls_ccm_auth_decrypt_iov and
+ *          @c mbedtls_ccm_star_auth_decrypt_iov. Backends that can not process
+ *          fragmented buffers directly should set this to NULL, in which case the glue
+ *          layer gathers the segments before calling @c auth_decrypt.
+ *
+ * @param[in,out]       ctx             Pointer to the context for the operation.
+ * @param[in]           star            If 1, CCM* is used. Otherwise CCM.
+ * @param[in]           iv              Pointer to the array holding the initialization vector.
+ * @param[in]           iv_len          Length of the initialization vector.
+ * @param[in]           add             Segments holding optional associated data.
+ * @param[in]           add_count       Number of associated data segments.
+ * @param[in]           input           Segments holding the input.
+ * @param[in]           input_count     Number of input segments.
+ * @param[out]          output          Segments to hold the output.
+ * @param[in]           output_count    Number of output segments.
+ * @param[in]           tag             Pointer to the array holding the tag.
+ * @param[in]           tag_len         Length of the tag.
+ *
+ * @return 0 if operation was successful, otherwise a negative value corresponding to the error.
+ */
+typedef int (*mbedtls_ccm_auth_decrypt_iov_fn)(mbedtls_ccm_context *ctx, int star, const unsigned char *iv, size_t iv_len, const mbedtls_ccm_iovec *add, size_t add_count, const mbedtls_ccm_iovec *input, size_t input_count, const mbedtls_ccm_iovec *output, size_t output_count, const unsigned char *tag, size_t tag_len);
+
+
 /**@brief Structure type holding the AES CCM calling interface for a backend.
  *
  * @details The backend must provide an instance of this structure to
@@ -169,6 +237,9 @@ typedef struct
     mbedtls_ccm_star_encrypt_and_tag_fn star_encrypt_and_tag;   //!< Perform an AES CCM* encrypt-and-tag operation.
     mbedtls_ccm_auth_decrypt_fn auth_decrypt;                   //!< Perform an AES CCM decrypt operation.
     mbedtls_ccm_star_auth_decrypt_fn star_auth_decrypt;         //!< Perform an AES CCM* decrypt operation.
+    mbedtls_ccm_encrypt_and_tag_iov_fn encrypt_and_tag_iov;     //!< Perform an AES CCM/CCM* encrypt-and-tag operation on fragmented buffers (optional).
+    mbedtls_ccm_auth_decrypt_iov_fn auth_decrypt_iov;           //!< Perform an AES CCM/CCM* decrypt operation on fragmented buffers (optional).
+    mbedtls_ccm_check_length_fn check_length;                   //!< Get the priority for an operation length (optional).
 } mbedtls_ccm_funcs;
 
 #endif /* MBEDTLS_CCM_ALT */
@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+
+/**@file
+ * @defgroup mbedcrypto_glue_chachapoly mbedcrypto CHACHA20-POLY1305 glue
+ * @ingroup mbedcrypto_glue
+ * @{
+ * @brief Glue layer for mbedcrypto CHACHA20-POLY1305 APIs, including typedefs for backend API abstraction.
+ */
+#ifndef BACKEND_CHACHAPOLY_H
+#define BACKEND_CHACHAPOLY_H
+
+#if !defined(MBEDTLS_CONFIG_FILE)
+#include "config.h"
+#else
+#include MBEDTLS_CONFIG_FILE
+#endif
+
+#if defined(MBEDTLS_CHACHAPOLY_ALT)
+
+#include "mbedtls/chachapoly.h"
+
+/**@brief Function pointer to get the priority of the backend for an operation.
+ *
+ * @details The value returned by the backend implementing this function pointer is
+ *          checked for every one-shot operation, and when a streaming operation is
+ *          started. If the return value is 0, then the backend is not used for the
+ *          operation. If the value is positive, then the backend with the highest
+ *          value is selected (priority based).
+ *
+ * @param[in]   length      Length of the input of a one-shot operation, or 0 for
+ *                          a streaming operation.
+ *
+ * @return 0 if the operation is not supported, otherwise a priority where higher is better.
+ */
+typedef int (*mbedtls_chachapoly_check_fn)(size_t length);
+
+
+/**@brief Function pointer to initialize a CHACHA20-POLY1305 context.
+ *
+ * @details This function pointer has a signature equal to @c mbedtls_chachapoly_init.
+ *
+ * @param[in,out]       ctx         Pointer to the context to initialize.
+ */
+typedef void (*mbedtls_chachapoly_init_fn)(mbedtls_chachapoly_context *ctx);
+
+
+/**@brief Function pointer to free a CHACHA20-POLY1305 context.
+ *
+ * @details This function pointer has a signature equal to @c mbedtls_chachapoly_free.
+ *
+ * @param[in,out]       ctx         Pointer to the context to free.
+ */
+typedef void (*mbedtls_chachapoly_free_fn)(mbedtls_chachapoly_context *ctx);
+
+
+/**@brief Function pointer to set the key of a CHACHA20-POLY1305 context.
+ *
+ * @details This function pointer has a signature equal to @c mbedtls_chachapoly_setkey.
+ *
+ * @param[in,out]       ctx         Pointer to the context to set the key in.
+ * @param[in]           key         Pointer to the array holding the 256-bit key.
+ *
+ * @return 0 if operation was successful, otherwise a negative value corresponding to the error.
+ */
+typedef int (*mbedtls_chachapoly_setkey_fn)(mbedtls_chachapoly_context *ctx, const unsigned char key[32]);
+
+
+/**@brief Function pointer to start a streaming CHACHA20-POLY1305 operation.
+ *
+ * @details This function pointer has a signature equal to @c mbedtls_chachapoly_starts.
+ *
+ * @param[in,out]       ctx         Pointer to the context.
+ * @param[in]           nonce       Pointer to the array holding the 96-bit nonce.
+ * @param[in]           mode        MBEDTLS_CHACHAPOLY_ENCRYPT or MBEDTLS_CHACHAPOLY_DECRYPT.
+ *
+ * @return 0 if operation was successful, otherwise a negative value corresponding to the error.
+ */
+typedef int (*mbedtls_chachapoly_starts_fn)(mbedtls_chachapoly_context *ctx, const unsigned char nonce[12], mbedtls_chachapoly_mode_t mode);
+
+
+/**@brief Function pointer to feed associated data to a streaming CHACHA20-POLY1305 operation.
+ *
+ * @details This function pointer has a signature equal to @c mbedtls_chachapoly_update_aad.
+ *
+ * @param[in,out]       ctx         Pointer to the context.
+ * @param[in]           aad         Pointer to the associated data.
+ * @param[in]           aad_len     Length of the associated data.
+ *
+ * @return 0 if operation was successful, otherwise a negative value corresponding to the error.
+ */
+typedef int (*mbedtls_chachapoly_update_aad_fn)(mbedtls_chachapoly_context *ctx, const unsigned char *aad, size_t aad_len);
+
+
+/**@brief Function pointer to encrypt or decrypt a part of a streaming CHACHA20-POLY1305 operation.
+ *
+ * @details This function pointer has a signature equal to @c mbedtls_chachapoly_update.
+ *
+ * @param[in,out]       ctx         Pointer to the context.
+ * @param[in]           len         Length of the input.
+ * @param[in]           input       Pointer to the input.
+ * @param[out]          output      Pointer to the output.
+ *
+ * @return 0 if operation was successful, otherwise a negative value corresponding to the error.
+ */
+typedef int (*mbedtls_chachapoly_update_fn)(mbedtls_chachapoly_context *ctx, size_t len, const unsigned char *input, unsigned char *output);
+
+
+/**@brief Function pointer to finish a streaming CHACHA20-POLY1305 operation.
+ *
+ * @details This function pointer has a signature equal to @c mbedtls_chachapoly_finish.
+ *
+ * @param[in,out]       ctx         Pointer to the context.
+ * @param[out]          mac         Pointer to the array to hold the 128-bit tag.
+ *
+ * @return 0 if operation was successful, otherwise a negative value corresponding to the error.
+ */
+typedef int (*mbedtls_chachapoly_finish_fn)(mbedtls_chachapoly_context *ctx, unsigned char mac[16]);
+
+
+/**@brief Function pointer to perform a CHACHA20-POLY1305 encrypt-and-tag operation.
+ *
+ * @details This function pointer has a signature equal to @c mbedtls_chachapoly_encrypt_and_tag.
+ *
+ * @param[in,out]       ctx         Pointer to the context.
+ * @param[in]           length      Length of the input.
+ * @param[in]           nonce       Pointer to the array holding the 96-bit nonce.
+ * @param[in]           aad         Pointer to the associated data.
+ * @param[in]           aad_len     Length of the associated data.
+ * @param[in]           input       Pointer to the input.
+ * @param[out]          output      Pointer to the output.
+ * @param[out]          tag         Pointer to the array to hold the 128-bit tag.
+ *
+ * @return 0 if operation was successful, otherwise a negative value corresponding to the error.
+ */
+typedef int (*mbedtls_chachapoly_encrypt_and_tag_fn)(mbedtls_chachapoly_context *ctx, size_t length, const unsigned char nonce[12], const unsigned char *aad, size_t aad_len, const unsigned char *input, unsigned char *output, unsigned char tag[16]);
+
+
+/**@brief Function pointer to perform a CHACHA20-POLY1305 decrypt operation.
+ *
+ * @details This function pointer has a signature equal to @c mbedtls_chachapoly_auth_decrypt.
+ *
+ * @param[in,out]       ctx         Pointer to the context.
+ * @param[in]           length      Length of the input.
+ * @param[in]           nonce       Pointer to the array holding the 96-bit nonce.
+ * @param[in]           aad         Pointer to the associated data.
+ * @param[in]           aad_len     Length of the associated data.
+ * @param[in]           tag         Pointer to the array holding the 128-bit tag.
+ * @param[in]           input       Pointer to the input.
+ * @param[out]          output      Pointer to the output.
+ *
+ * @return 0 if operation was successful, otherwise a negative value corresponding to the error.
+ */
+typedef int (*mbedtls_chachapoly_auth_decrypt_fn)(mbedtls_chachapoly_context *ctx, size_t length, const unsigned char nonce[12], const unsigned char *aad, size_t aad_len, const unsigned char tag[16], const unsigned char *input, unsigned char *output);
+
+
+/**@brief Structure type holding the CHACHA20-POLY1305 calling interface for a backend.
+ *
+ * @details The backend must provide an instance of this structure to
+ *          enable mbedcrypto glue functionality. Backends that only support
+ *          one-shot operations set the streaming function pointers to NULL.
+ */
+typedef struct
+{
+    size_t backend_context_size;                                //!< Size of the CHACHA20-POLY1305 context according to the backend.
+    mbedtls_chachapoly_check_fn check;                          //!< Get the priority for an operation.
+    mbedtls_chachapoly_init_fn init;                            //!< Initialize the CHACHA20-POLY1305 context.
+    mbedtls_chachapoly_free_fn free;                            //!< Free the CHACHA20-POLY1305 context.
+    mbedtls_chachapoly_setkey_fn setkey;                        //!< Set the CHACHA20-POLY1305 key.
+    mbedtls_chachapoly_starts_fn starts;                        //!< Start a streaming operation (optional).
+    mbedtls_chachapoly_update_aad_fn update_aad;                //!< Feed associated data to a streaming operation (optional).
+    mbedtls_chachapoly_update_fn update;                        //!< Process input in a streaming operation (optional).
+    mbedtls_chachapoly_finish_fn finish;                        //!< Finish a streaming operation (optional).
+    mbedtls_chachapoly_encrypt_and_tag_fn encrypt_and_tag;      //!< Perform a one-shot encrypt-and-tag operation.
+    mbedtls_chachapoly_auth_decrypt_fn auth_decrypt;            //!< Perform a one-shot decrypt operation.
+} mbedtls_chachapoly_funcs;
+
+#endif /* MBEDTLS_CHACHAPOLY_ALT */
+
+#endif /* BACKEND_CHACHAPOLY_H */
+
+/** @} */
@@ -30,6 +30,8 @@
  *          dynamically checked. If the return value is 0, then the backend does not
  *          support the CMAC mode. If the value is positive, then the backend with the
  *          highest value is selected (priority based).
+ *          The result is cached per key size, so it must not depend on the
+ *          cipher info or the key contents.
  *
  * @param[in]   cipher_info Cipher info for the CMAC operation.
  * @param[in]   key         Pointer to the array holding the key.
@@ -30,6 +30,7 @@
  *          dynamically checked. If the return value is 0, then the backend does not
  *          support the DHM mode. If the value is positive, then the backend with the
  *          highest value is selected (priority based).
+ *          The result is cached per prime size.
  *
  * @param[in]   pbits       Private key bit size.
  *
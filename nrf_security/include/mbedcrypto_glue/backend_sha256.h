@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+
+/**@file
+ * @defgroup mbedcrypto_glue_sha256 mbedcrypto SHA-256 glue
+ * @ingroup mbedcrypto_glue
+ * @{
+ * @brief Glue layer for mbedcrypto SHA-256 APIs, including typedefs for backend API abstraction.
+ */
+#ifndef BACKEND_SHA256_H
+#define BACKEND_SHA256_H
+
+#if !defined(MBEDTLS_CONFIG_FILE)
+#include "config.h"
+#else
+#include MBEDTLS_CONFIG_FILE
+#endif
+
+#if defined(MBEDTLS_SHA256_ALT)
+
+#include "mbedtls/sha256.h"
+
+/**@brief Function pointer to check if a SHA-256 or SHA-224 operation is supported by the backend.
+ *
+ * @details The value returned by the backend implementing this function pointer is
+ *          checked when an operation is started. If the return value is 0, then
+ *          the backend is not used for the operation. If the value is positive,
+ *          then the backend with the highest value is selected (priority based).
+ *
+ * @param[in]   is224       0 for SHA-256, 1 for SHA-224.
+ *
+ * @return 0 if the operation is not supported, otherwise a priority where higher is better.
+ */
+typedef int (*mbedtls_sha256_check_fn)(int is224);
+
+
+/**@brief Function pointer to initialize a SHA-256 context.
+ *
+ * @details This function pointer has a signature equal to @c mbedtls_sha256_init.
+ *
+ * @param[in,out]       ctx         Pointer to the context to initialize.
+ */
+typedef void (*mbedtls_sha256_init_fn)(mbedtls_sha256_context *ctx);
+
+
+/**@brief Function pointer to free a SHA-256 context.
+ *
+ * @details This function pointer has a signature equal to @c mbedtls_sha256_free.
+ *
+ * @param[in,out]       ctx         Pointer to the context to free.
+ */
+typedef void (*mbedtls_sha256_free_fn)(mbedtls_sha256_context *ctx);
+
+
+/**@brief Function pointer to start a SHA-256 or SHA-224 operation.
+ *
+ * @details This function pointer has a signature equal to @c mbedtls_sha256_starts_ret.
+ *
+ * @param[in,out]       ctx         Pointer to the context.
+ * @param[in]           is224       0 for SHA-256, 1 for SHA-224.
+ *
+ * @return 0 if operation was successful, otherwise a negative value corresponding to the error.
+ */
+typedef int (*mbedtls_sha256_starts_fn)(mbedtls_sha256_context *ctx, int is224);
+
+
+/**@brief Function pointer to feed input to a SHA-256 operation.
+ *
+ * @details This function pointer has a signature equal to @c mbedtls_sha256_update_ret.
+ *
+ * @param[in,out]       ctx         Pointer to the context.
+ * @param[in]           input       Pointer to the input.
+ * @param[in]           ilen        Length of the input.
+ *
+ * @return 0 if operation was successful, otherwise a negative value corresponding to the error.
+ */
+typedef int (*mbedtls_sha256_update_fn)(mbedtls_sha256_context *ctx, const unsigned char *input, size_t ilen);
+
+
+/**@brief Function pointer to finish a SHA-256 operation.
+ *
+ * @details This function pointer has a signature equal to @c mbedtls_sha256_finish_ret.
+ *
+ * @param[in,out]       ctx         Pointer to the context.
+ * @param[out]          output      Pointer to the array to hold the digest.
+ *
+ * @return 0 if operation was successful, otherwise a negative value corresponding to the error.
+ */
+typedef int (*mbedtls_sha256_finish_fn)(mbedtls_sha256_context *ctx, unsigned char output[32]);
+
+
+/**@brief Function pointer to process a single 64 byte block.
+ *
+ * @details This function pointer has a signature equal to @c mbedtls_internal_sha256_process.
+ *
+ * @param[in,out]       ctx         Pointer to the context.
+ * @param[in]           data        Pointer to the block.
+ *
+ * @return 0 if operation was successful, otherwise a negative value corresponding to the error.
+ */
+typedef int (*mbedtls_sha256_process_fn)(mbedtls_sha256_context *ctx, const unsigned char data[64]);
+
+
+/**@brief Structure type holding the SHA-256 calling interface for a backend.
+ *
+ * @details The backend must provide an instance of this structure to
+ *          enable mbedcrypto glue functionality. The backend context must
+ *          not contain pointers, as it is copied to clone and save contexts.
+ *          Backends without access to the compression function set
+ *          process to NULL.
+ */
+typedef struct
+{
+    size_t backend_context_size;            //!< Size of the SHA-256 context according to the backend.
+    mbedtls_sha256_check_fn check;          //!< Check if the operation is supported.
+    mbedtls_sha256_init_fn init;            //!< Initialize the SHA-256 context.
+    mbedtls_sha256_free_fn free;            //!< Free the SHA-256 context.
+    mbedtls_sha256_starts_fn starts;        //!< Start a SHA-256 or SHA-224 operation.
+    mbedtls_sha256_update_fn update;        //!< Feed input to the operation.
+    mbedtls_sha256_finish_fn finish;        //!< Finish the operation.
+    mbedtls_sha256_process_fn process;      //!< Process a single block (optional).
+} mbedtls_sha256_funcs;
+
+#endif /* MBEDTLS_SHA256_ALT */
+
+#endif /* BACKEND_SHA256_H */
+
+/** @} */
@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+
+/**@file
+ * @defgroup mbedcrypto_glue_backend_trace mbedcrypto glue backend trace
+ * @ingroup mbedcrypto_glue
+ * @{
+ * @brief Tracing hooks around the backend calls of the mbedcrypto glue layers.
+ *
+ * @details With CONFIG_GLUE_TRACE, the glue layers call @ref backend_trace_begin
+ *          before and @ref backend_trace_end after each data processing call to a
+ *          backend. The backend is identified by its function table, so the
+ *          selected backend, the number of bytes processed and the duration of the
+ *          operation can be recovered from the trace.
+ *
+ *          The default hooks record SystemView events when CONFIG_SEGGER_SYSTEMVIEW
+ *          is enabled and do nothing otherwise. The hooks are weak and can be
+ *          replaced by the application, e.g. to forward the events to another
+ *          trace recorder.
+ *
+ *          With CONFIG_GLUE_STATS, the same calls are counted in the statistics of
+ *          mbedcrypto_glue_stats.h.
+ *
+ *          Without CONFIG_GLUE_TRACE and CONFIG_GLUE_STATS the macro expands to the
+ *          backend call only.
+ */
+#ifndef BACKEND_TRACE_H
+#define BACKEND_TRACE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**@brief Traced glue operations. */
+enum backend_trace_op
+{
+    BACKEND_TRACE_AES_ECB,
+    BACKEND_TRACE_AES_CBC,
+    BACKEND_TRACE_AES_XTS,
+    BACKEND_TRACE_AES_CFB,
+    BACKEND_TRACE_AES_OFB,
+    BACKEND_TRACE_AES_CTR,
+    BACKEND_TRACE_CCM_ENCRYPT,
+    BACKEND_TRACE_CCM_DECRYPT,
+    BACKEND_TRACE_CHACHAPOLY_UPDATE,
+    BACKEND_TRACE_CHACHAPOLY_ENCRYPT,
+    BACKEND_TRACE_CHACHAPOLY_DECRYPT,
+    BACKEND_TRACE_CMAC_UPDATE,
+    BACKEND_TRACE_CMAC,
+    BACKEND_TRACE_SHA1_UPDATE,
+    BACKEND_TRACE_SHA256_UPDATE,
+    BACKEND_TRACE_DHM_MAKE_PUBLIC,
+    BACKEND_TRACE_DHM_CALC_SECRET,
+    BACKEND_TRACE_ECDH_GEN_PUBLIC,
+    BACKEND_TRACE_ECDH_COMPUTE_SHARED,
+    BACKEND_TRACE_ECDSA_SIGN,
+    BACKEND_TRACE_ECDSA_VERIFY,
+    BACKEND_TRACE_ECDSA_GENKEY,
+    BACKEND_TRACE_COUNT
+};
+
+#if defined(CONFIG_GLUE_TRACE)
+
+/**@brief Hook called before a backend call.
+ *
+ * @param[in]   op          Operation, one of @ref backend_trace_op.
+ * @param[in]   backend     Function table of the selected backend.
+ * @param[in]   bytes       Number of bytes processed, 0 for public key operations.
+ */
+void backend_trace_begin(uint32_t op, const void *backend, size_t bytes);
+
+/**@brief Hook called after a backend call.
+ *
+ * @param[in]   op          Operation, one of @ref backend_trace_op.
+ * @param[in]   ret         Return value of the backend call.
+ */
+void backend_trace_end(uint32_t op, int ret);
+
+#endif /* CONFIG_GLUE_TRACE */
+
+#if defined(CONFIG_GLUE_STATS)
+
+/**@brief Read the start time of a backend call for @ref backend_stats_record.
+ *
+ * @return Hardware clock cycle counter.
+ */
+uint32_t backend_stats_start(void);
+
+/**@brief Count a backend call in the statistics of mbedcrypto_glue_stats.h.
+ *
+ * @param[in]   op          Operation, one of @ref backend_trace_op.
+ * @param[in]   backend     Function table of the selected backend.
+ * @param[in]   bytes       Number of bytes processed.
+ * @param[in]   start       Value of @ref backend_stats_start before the call.
+ */
+void backend_stats_record(uint32_t op, const void *backend, size_t bytes, uint32_t start);
+
+#endif /* CONFIG_GLUE_STATS */
+
+#if defined(CONFIG_GLUE_TRACE) || defined(CONFIG_GLUE_STATS)
+
+/**@brief Hooks run before a backend call.
+ *
+ * @return Start time of the call if statistics are enabled, otherwise 0.
+ */
+static inline uint32_t backend_trace_enter(uint32_t op, const void *backend, size_t bytes)
+{
+#if defined(CONFIG_GLUE_TRACE)
+    backend_trace_begin(op, backend, bytes);
+#endif
+#if defined(CONFIG_GLUE_STATS)
+    return backend_stats_start();
+#else
+    return 0;
+#endif
+}
+
+/**@brief Hooks run after a backend call. */
+static inline void backend_trace_exit(uint32_t op, const void *backend, size_t bytes, uint32_t start, int ret)
+{
+#if defined(CONFIG_GLUE_STATS)
+    backend_stats_record(op, backend, bytes, start);
+#endif
+#if defined(CONFIG_GLUE_TRACE)
+    backend_trace_end(op, ret);
+#endif
+}
+
+/**@brief Call a backend function between the trace and statistics hooks.
+ *
+ * @param[in]   op          Operation, one of @ref backend_trace_op.
+ * @param[in]   backend     Function table of the selected backend.
+ * @param[in]   bytes       Number of bytes processed.
+ * @param[in]   call        Backend call returning int.
+ *
+ * @return The return value of @p call.
+ */
+#define BACKEND_TRACE(op, backend, bytes, call)                                     \
+    ({                                                                              \
+        size_t backend_trace_bytes = (bytes);                                       \
+        uint32_t backend_trace_start;                                               \
+        int backend_trace_ret;                                                      \
+        backend_trace_start = backend_trace_enter((op), (backend), backend_trace_bytes); \
+        backend_trace_ret = (call);                                                 \
+        backend_trace_exit((op), (backend), backend_trace_bytes,                    \
+                           backend_trace_start, backend_trace_ret);                 \
+        backend_trace_ret;                                                          \
+    })
+
+#else
+
+#define BACKEND_TRACE(op, backend, bytes, call) (call)
+
+#endif /* CONFIG_GLUE_TRACE || CONFIG_GLUE_STATS */
+
+#endif /* BACKEND_TRACE_H */
+
+/** @} */
@@ -20,6 +20,7 @@
 #define CC310_MBEDTLS_AES_CONTEXT_WORDS         (24)    //!< AES context size in words in nrf_cc310_mbedcrypto library.
 #define VANILLA_MBEDTLS_AES_CONTEXT_WORDS       (70)    //!< AES context size in words in standard mbed TLS.
 #define VANILLA_MBEDTLS_AES_XTS_CONTEXT_WORDS   (140)   //!< AES XTS context size in words in standard mbed TLS.
+#define OBERON_MBEDTLS_AES_CONTEXT_WORDS        (70)    //!< AES context size in words in the nrf_oberon backend.
 
 #if defined(MBEDTLS_AES_ALT)
 
@@ -30,7 +31,7 @@
  */
 typedef struct mbedtls_aes_context
 {
-    union
+    union _aes_buffer
     {
 #if defined(CONFIG_CC310_MBEDTLS_AES_C)
         uint32_t buffer_cc310[CC310_MBEDTLS_AES_CONTEXT_WORDS];                //!< Array the size of an AES context in the nrf_cc310_mbedcrypto library.
@@ -38,9 +39,16 @@ typedef struct mbedtls_aes_context
 #if defined(CONFIG_VANILLA_MBEDTLS_AES_C)
         uint32_t buffer_vanilla_mbedtls[VANILLA_MBEDTLS_AES_CONTEXT_WORDS];    //!< Array the size of an AES context in vanilla mbed TLS.
 #endif /* CONFIG_VANILLA_MBEDTLS_AES_C */
+#if defined(CONFIG_GLUE_MBEDTLS_AES_OBERON)
+        uint32_t buffer_oberon[OBERON_MBEDTLS_AES_CONTEXT_WORDS];              //!< Array the size of an AES context in the nrf_oberon backend.
+#endif /* CONFIG_GLUE_MBEDTLS_AES_OBERON */
         uint32_t dummy;                                                        //!< Dummy value in case no backend is enabled.
     } buffer;                                                                  //!< Union with size of the largest enabled backend context.
     void* handle;   //!< Pointer to the function table in an initialized glue context.
+#if defined(CONFIG_GLUE_MBEDTLS_AES_SECONDARY)
+    union _aes_buffer buffer_secondary;     //!< Context of the software backend used while cc310 is busy, keyed with the same key.
+    void* handle_secondary;                 //!< Pointer to the function table of the software backend, or NULL.
+#endif /* CONFIG_GLUE_MBEDTLS_AES_SECONDARY */
 } mbedtls_aes_context;
 
 
@@ -58,6 +66,37 @@ typedef struct mbedtls_aes_xts_context
     void* handle;   //!< Pointer to the function table in an initialized glue context.
 } mbedtls_aes_xts_context;
 
+#if defined(CONFIG_GLUE_MBEDTLS_AES_C)
+
+#include <stddef.h>
+
+/** @brief Encrypt or decrypt multiple independent blocks using AES-ECB.
+ *
+ * @details All blocks are processed using the key set in @p ctx, and the
+ *          backend is resolved only once for the whole call. This is
+ *          equivalent to calling @c mbedtls_aes_crypt_ecb for each block.
+ *
+ * @note Only the glue dispatch is shared between the blocks. Every block is
+ *       still a separate backend operation, on cc310 with its own lock and
+ *       key load. For a keystream of consecutive counter blocks, use
+ *       @c mbedtls_aes_crypt_ctr, which cc310 processes in one call.
+ *
+ * @param[in,out]       ctx         Pointer to an initialized AES context with a key set.
+ * @param[in]           mode        MBEDTLS_AES_ENCRYPT or MBEDTLS_AES_DECRYPT.
+ * @param[in]           length      Length of the input/output data, a multiple of 16 bytes.
+ * @param[in]           input       Pointer to the buffer holding the input blocks.
+ * @param[out]          output      Pointer to the buffer to hold the output blocks.
+ *
+ * @return 0 if operation was successful, otherwise a negative value corresponding to the error.
+ */
+int mbedtls_aes_crypt_ecb_blocks(mbedtls_aes_context *ctx,
+                                 int mode,
+                                 size_t length,
+                                 const unsigned char *input,
+                                 unsigned char *output);
+
+#endif /* CONFIG_GLUE_MBEDTLS_AES_C */
+
 #endif /* MBEDTLS_AES_ALT */
 
 #endif /* MBEDTLS_AES_ALT_H */
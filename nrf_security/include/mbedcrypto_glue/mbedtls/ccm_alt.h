@@ -25,6 +25,11 @@
 #define CC310_MBEDTLS_CCM_CONTEXT_WORDS     (96)
 #define VANILLA_MBEDTLS_CCM_CONTEXT_WORDS   ((sizeof(mbedtls_cipher_context_t) + 3) / 4)
 
+/**
+ * @brief Context size of AES CCM in words in the nrf_oberon backend.
+ */
+#define OBERON_MBEDTLS_CCM_CONTEXT_WORDS    (70)
+
 /**
  * @brief Context size of AES CCM in words in standard mbed TLS.
  */
@@ -49,11 +54,253 @@ typedef struct mbedtls_ccm_context
 #if defined(CONFIG_VANILLA_MBEDTLS_CCM_C)
         uint32_t buffer_vanilla_mbedtls[VANILLA_MBEDTLS_CCM_CONTEXT_WORDS];   //!< Array the size of an AES CCM context in standard mbed TLS.
 #endif /* CONFIG_VANILLA_MBEDTLS_CCM_C */
+#if defined(CONFIG_GLUE_MBEDTLS_CCM_OBERON)
+        uint32_t buffer_oberon[OBERON_MBEDTLS_CCM_CONTEXT_WORDS];             //!< Array the size of an AES CCM context in the nrf_oberon backend.
+#endif /* CONFIG_GLUE_MBEDTLS_CCM_OBERON */
         uint32_t dummy;                                                       //!< Dummy value in case no backend is enabled.
     } buffer;                                                                 //!< Union with size of the largest enabled backend context.
     void* handle;                                                             //!< Pointer to the function table in an initialized glue context.
+#if defined(CONFIG_GLUE_MBEDTLS_CCM_SECONDARY)
+    union _buffer buffer_secondary;                                           //!< Context of the secondary backend, keyed with the same key.
+    void* handle_secondary;                                                   //!< Pointer to the function table of the secondary backend, or NULL.
+#endif /* CONFIG_GLUE_MBEDTLS_CCM_SECONDARY */
 } mbedtls_ccm_context;
 
+#if defined(CONFIG_GLUE_MBEDTLS_CCM_C)
+
+#include <stddef.h>
+
+#include "mbedtls/aes.h"
+
+/**
+ * @brief Buffer segment used by the scatter-gather AES CCM APIs.
+ *
+ * @note Segments given as input are never written to.
+ */
+typedef struct mbedtls_ccm_iovec
+{
+    unsigned char *base;    //!< Pointer to the start of the segment.
+    size_t len;             //!< Length of the segment in bytes.
+} mbedtls_ccm_iovec;
+
+/**
+ * @brief Perform an AES CCM encrypt-and-tag operation on fragmented buffers.
+ *
+ * @details This is equivalent to @c mbedtls_ccm_encrypt_and_tag, but the
+ *          associated data, input and output are given as lists of segments.
+ *          The total length of the output segments must equal the total length
+ *          of the input segments. The segment boundaries may differ, and the
+ *          output may alias the input.
+ *
+ *          If the selected backend has no scatter-gather support, fragmented
+ *          buffers are copied into a stack buffer of
+ *          CONFIG_GLUE_MBEDTLS_CCM_IOV_BUFFER_SIZE bytes. Longer associated
+ *          data and input are copied into a heap buffer if
+ *          CONFIG_GLUE_MBEDTLS_CCM_IOV_HEAP is enabled, otherwise
+ *          MBEDTLS_ERR_CCM_BAD_INPUT is returned.
+ *
+ * @param[in,out]       ctx         Pointer to the context for the operation.
+ * @param[in]           iv          Pointer to the array holding the initialization vector.
+ * @param[in]           iv_len      Length of the initialization vector.
+ * @param[in]           add         Segments holding optional associated data.
+ * @param[in]           add_count   Number of associated data segments.
+ * @param[in]           input       Segments holding the input.
+ * @param[in]           input_count Number of input segments.
+ * @param[out]          output      Segments to hold the output.
+ * @param[in]           output_count Number of output segments.
+ * @param[out]          tag         Pointer to the array to hold the tag.
+ * @param[in]           tag_len     Length of the tag.
+ *
+ * @return 0 if operation was successful, otherwise a negative value corresponding to the error.
+ */
+int mbedtls_ccm_encrypt_and_tag_iov(mbedtls_ccm_context *ctx,
+                                    const unsigned char *iv, size_t iv_len,
+                                    const mbedtls_ccm_iovec *add, size_t add_count,
+                                    const mbedtls_ccm_iovec *input, size_t input_count,
+                                    const mbedtls_ccm_iovec *output, size_t output_count,
+                                    unsigned char *tag, size_t tag_len);
+
+/**
+ * @brief Perform an AES CCM* encrypt-and-tag operation on fragmented buffers.
+ *
+ * @details See @ref mbedtls_ccm_encrypt_and_tag_iov. A tag length of 0 is allowed.
+ */
+int mbedtls_ccm_star_encrypt_and_tag_iov(mbedtls_ccm_context *ctx,
+                                         const unsigned char *iv, size_t iv_len,
+                                         const mbedtls_ccm_iovec *add, size_t add_count,
+                                         const mbedtls_ccm_iovec *input, size_t input_count,
+                                         const mbedtls_ccm_iovec *output, size_t output_count,
+                                         unsigned char *tag, size_t tag_len);
+
+/**
+ * @brief Perform an AES CCM decrypt operation on fragmented buffers.
+ *
+ * @details This is equivalent to @c mbedtls_ccm_auth_decrypt, but the
+ *          associated data, input and output are given as lists of segments.
+ *          If the tag does not match, all output segments are cleared.
+ *
+ * @param[in,out]       ctx         Pointer to the context for the operation.
+ * @param[in]           iv          Pointer to the array holding the initialization vector.
+ * @param[in]           iv_len      Length of the initialization vector.
+ * @param[in]           add         Segments holding optional associated data.
+ * @param[in]           add_count   Number of associated data segments.
+ * @param[in]           input       Segments holding the input.
+ * @param[in]           input_count Number of input segments.
+ * @param[out]          output      Segments to hold the output.
+ * @param[in]           output_count Number of output segments.
+ * @param[in]           tag         Pointer to the array holding the tag.
+ * @param[in]           tag_len     Length of the tag.
+ *
+ * @return 0 if operation was successful, otherwise a negative value corresponding to the error.
+ */
+int mbedtls_ccm_auth_decrypt_iov(mbedtls_ccm_context *ctx,
+                                 const unsigned char *iv, size_t iv_len,
+                                 const mbedtls_ccm_iovec *add, size_t add_count,
+                                 const mbedtls_ccm_iovec *input, size_t input_count,
+                                 const mbedtls_ccm_iovec *output, size_t output_count,
+                                 const unsigned char *tag, size_t tag_len);
+
+/**
+ * @brief Perform an AES CCM* decrypt operation on fragmented buffers.
+ *
+ * @details See @ref mbedtls_ccm_auth_decrypt_iov. A tag length of 0 is allowed.
+ */
+int mbedtls_ccm_star_auth_decrypt_iov(mbedtls_ccm_context *ctx,
+                                      const unsigned char *iv, size_t iv_len,
+                                      const mbedtls_ccm_iovec *add, size_t add_count,
+                                      const mbedtls_ccm_iovec *input, size_t input_count,
+                                      const mbedtls_ccm_iovec *output, size_t output_count,
+                                      const unsigned char *tag, size_t tag_len);
+
+/**
+ * @brief Context for streaming AES CCM operations.
+ *
+ * @details The streaming operations are implemented in the glue on top of the
+ *          AES block cipher, so they are accelerated by whichever AES backend
+ *          is selected. Only the fields of the context needed for one block
+ *          of state are kept, so the memory use does not depend on the
+ *          length of the message.
+ */
+typedef struct mbedtls_ccm_stream_context
+{
+    mbedtls_aes_context aes;            //!< AES context, keyed for encryption.
+    unsigned char y[16];                //!< CBC-MAC state.
+    unsigned char ctr[16];              //!< Next counter block.
+    unsigned char mac_buf[16];          //!< Partial block waiting to be authenticated.
+    unsigned char ks[16];               //!< Key stream of the current counter block.
+    unsigned char s0[16];               //!< Key stream used to encrypt the tag.
+    size_t mac_len;                     //!< Number of bytes in mac_buf.
+    size_t ks_off;                      //!< Number of bytes of ks already used.
+    size_t ad_left;                     //!< Associated data bytes still expected.
+    size_t length_left;                 //!< Payload bytes still expected.
+    size_t tag_len;                     //!< Length of the tag.
+    int mode;                           //!< MBEDTLS_CCM_ENCRYPT or MBEDTLS_CCM_DECRYPT.
+    int state;                          //!< Internal state of the operation.
+} mbedtls_ccm_stream_context;
+
+#define MBEDTLS_CCM_ENCRYPT      0      //!< Streaming AES CCM encrypt-and-tag.
+#define MBEDTLS_CCM_DECRYPT      1      //!< Streaming AES CCM decrypt-and-verify.
+#define MBEDTLS_CCM_STAR_ENCRYPT 2      //!< Streaming AES CCM* encrypt-and-tag.
+#define MBEDTLS_CCM_STAR_DECRYPT 3      //!< Streaming AES CCM* decrypt-and-verify.
+
+/**
+ * @brief Initialize a streaming AES CCM context.
+ *
+ * @param[in,out]       ctx         Pointer to the context to initialize.
+ */
+void mbedtls_ccm_stream_init(mbedtls_ccm_stream_context *ctx);
+
+/**
+ * @brief Set the AES key of a streaming AES CCM context.
+ *
+ * @param[in,out]       ctx         Pointer to the context.
+ * @param[in]           key         Pointer to the array holding the key.
+ * @param[in]           keybits     Key size in bits: 128, 192 or 256.
+ *
+ * @return 0 if operation was successful, otherwise a negative value corresponding to the error.
+ */
+int mbedtls_ccm_stream_setkey(mbedtls_ccm_stream_context *ctx, const unsigned char *key, unsigned int keybits);
+
+/**
+ * @brief Release and clear a streaming AES CCM context.
+ *
+ * @param[in,out]       ctx         Pointer to the context to free.
+ */
+void mbedtls_ccm_stream_free(mbedtls_ccm_stream_context *ctx);
+
+/**
+ * @brief Start a streaming AES CCM operation.
+ *
+ * @details CCM authenticates the lengths before any data, so the total length
+ *          of the associated data and of the payload must be given up front.
+ *          A context can be reused for a new operation after
+ *          @ref mbedtls_ccm_stream_finish, without setting the key again.
+ *
+ * @param[in,out]       ctx         Pointer to the keyed context.
+ * @param[in]           mode        One of MBEDTLS_CCM_ENCRYPT, MBEDTLS_CCM_DECRYPT,
+ *                                  MBEDTLS_CCM_STAR_ENCRYPT or MBEDTLS_CCM_STAR_DECRYPT.
+ * @param[in]           iv          Pointer to the array holding the nonce.
+ * @param[in]           iv_len      Length of the nonce, 7 to 13 bytes.
+ * @param[in]           ad_len      Total length of the associated data, less than 0xFF00.
+ * @param[in]           length      Total length of the payload.
+ * @param[in]           tag_len     Length of the tag.
+ *
+ * @return 0 if operation was successful, otherwise a negative value corresponding to the error.
+ */
+int mbedtls_ccm_stream_starts(mbedtls_ccm_stream_context *ctx, int mode,
+                              const unsigned char *iv, size_t iv_len,
+                              size_t ad_len, size_t length, size_t tag_len);
+
+/**
+ * @brief Feed associated data to a streaming AES CCM operation.
+ *
+ * @details All associated data must be given before the first call to
+ *          @ref mbedtls_ccm_stream_update.
+ *
+ * @param[in,out]       ctx         Pointer to the context.
+ * @param[in]           add         Pointer to the associated data.
+ * @param[in]           add_len     Length of the associated data.
+ *
+ * @return 0 if operation was successful, otherwise a negative value corresponding to the error.
+ */
+int mbedtls_ccm_stream_update_ad(mbedtls_ccm_stream_context *ctx, const unsigned char *add, size_t add_len);
+
+/**
+ * @brief Encrypt or decrypt a part of the payload.
+ *
+ * @details The payload can be split at any byte boundary. The output may alias
+ *          the input.
+ *
+ * @warning When decrypting, the plaintext is released before the tag has been
+ *          verified. It must not be acted upon until
+ *          @ref mbedtls_ccm_stream_finish has returned 0.
+ *
+ * @param[in,out]       ctx         Pointer to the context.
+ * @param[in]           input       Pointer to the input.
+ * @param[in]           length      Length of the input.
+ * @param[out]          output      Pointer to the output, of the same length as the input.
+ *
+ * @return 0 if operation was successful, otherwise a negative value corresponding to the error.
+ */
+int mbedtls_ccm_stream_update(mbedtls_ccm_stream_context *ctx, const unsigned char *input, size_t length, unsigned char *output);
+
+/**
+ * @brief Finish a streaming AES CCM operation.
+ *
+ * @details When encrypting, the tag is written to @p tag. When decrypting,
+ *          @p tag holds the expected tag and is compared in constant time.
+ *
+ * @param[in,out]       ctx         Pointer to the context.
+ * @param[in,out]       tag         Pointer to the tag.
+ * @param[in]           tag_len     Length of the tag, as given to @ref mbedtls_ccm_stream_starts.
+ *
+ * @return 0 if operation was successful, MBEDTLS_ERR_CCM_AUTH_FAILED if the tag
+ *         does not match, otherwise a negative value corresponding to the error.
+ */
+int mbedtls_ccm_stream_finish(mbedtls_ccm_stream_context *ctx, unsigned char *tag, size_t tag_len);
+
+#endif /* CONFIG_GLUE_MBEDTLS_CCM_C */
+
 #endif /* MBEDTLS_CCM_ALT */
 
 #endif /* MBEDTLS_CCM_ALT_H */
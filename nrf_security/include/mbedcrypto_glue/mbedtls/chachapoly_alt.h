@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+
+/**@file
+ * @addtogroup mbedcrypto_glue_chachapoly
+ * @{
+ */
+#ifndef MBEDTLS_CHACHAPOLY_ALT_H
+#define MBEDTLS_CHACHAPOLY_ALT_H
+
+#if !defined(MBEDTLS_CONFIG_FILE)
+#include "config.h"
+#else
+#include MBEDTLS_CONFIG_FILE
+#endif
+
+/**
+ * @brief Context size of CHACHA20-POLY1305 in words in the mbed_cc310_mbedcrypto library.
+ */
+#define CC310_MBEDTLS_CHACHAPOLY_CONTEXT_WORDS      (8)
+
+/**
+ * @brief Context size of CHACHA20-POLY1305 in words in the nrf_oberon backend.
+ */
+#define OBERON_MBEDTLS_CHACHAPOLY_CONTEXT_WORDS     (52)
+
+#if defined(MBEDTLS_CHACHAPOLY_ALT)
+
+#include <stdint.h>
+
+/**
+ * @brief mbedcrypto CHACHA20-POLY1305 glue context.
+ *
+ * @details The key is kept in the glue context, so that every operation can be
+ *          handed to the backend best suited for it.
+ */
+typedef struct mbedtls_chachapoly_context
+{
+    union _buffer
+    {
+        uint32_t buffer_cc310[CC310_MBEDTLS_CHACHAPOLY_CONTEXT_WORDS];        //!< Array the size of a CHACHA20-POLY1305 context in the nrf_cc310_mbedcrypto library.
+        uint32_t buffer_oberon[OBERON_MBEDTLS_CHACHAPOLY_CONTEXT_WORDS];      //!< Array the size of a CHACHA20-POLY1305 context in the nrf_oberon backend.
+    } buffer;                                                                 //!< Union with size of the largest enabled backend context.
+    void* handle;                                                             //!< Pointer to the function table of the backend keyed in buffer, or NULL.
+    unsigned char key[32];                                                    //!< Copy of the key.
+    int key_set;                                                              //!< 1 if the key has been set.
+} mbedtls_chachapoly_context;
+
+#endif /* MBEDTLS_CHACHAPOLY_ALT */
+
+#endif /* MBEDTLS_CHACHAPOLY_ALT_H */
+
+/** @} */
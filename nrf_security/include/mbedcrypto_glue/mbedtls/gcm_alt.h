@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+
+/**@file
+ * @defgroup mbedcrypto_glue_aes_gcm mbedcrypto glue AES GCM
+ * @ingroup mbedcrypto_glue
+ * @{
+ * @brief AES GCM glue context.
+ *
+ * @details The counter blocks are encrypted through the AES API, so that they
+ *          are processed by the selected AES backend, and GHASH is computed
+ *          in software. One-shot operations may instead be processed by
+ *          nrf_oberon, see CONFIG_GLUE_MBEDTLS_GCM_OBERON.
+ */
+#ifndef MBEDTLS_GCM_ALT_H
+#define MBEDTLS_GCM_ALT_H
+
+#if !defined(MBEDTLS_CONFIG_FILE)
+#include "config.h"
+#else
+#include MBEDTLS_CONFIG_FILE
+#endif
+
+#if defined(MBEDTLS_GCM_ALT)
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "mbedtls/aes.h"
+
+/**
+ * @brief mbedcrypto AES GCM glue context.
+ */
+typedef struct mbedtls_gcm_context
+{
+    mbedtls_aes_context aes;             //!< AES context, keyed for encryption.
+    uint64_t HL[16];                     //!< Precalculated multiples of H, low halves.
+    uint64_t HH[16];                     //!< Precalculated multiples of H, high halves.
+    uint64_t len;                        //!< Length of the processed input.
+    uint64_t add_len;                    //!< Length of the associated data.
+    unsigned char base_ectr[16];         //!< Encrypted first counter block, used for the tag.
+    unsigned char y[16];                 //!< Next counter block.
+    unsigned char buf[16];               //!< GHASH state.
+    unsigned char stream_block[16];      //!< Key stream of the current counter block.
+    size_t nc_off;                       //!< Number of bytes of stream_block already used.
+    int mode;                            //!< MBEDTLS_GCM_ENCRYPT or MBEDTLS_GCM_DECRYPT.
+#if defined(CONFIG_GLUE_MBEDTLS_GCM_OBERON)
+    unsigned char key[32];               //!< Copy of the key, as nrf_oberon takes the key with every operation.
+    size_t key_len;                      //!< Length of the key in bytes.
+#endif /* CONFIG_GLUE_MBEDTLS_GCM_OBERON */
+} mbedtls_gcm_context;
+
+#endif /* MBEDTLS_GCM_ALT */
+
+#endif /* MBEDTLS_GCM_ALT_H */
+
+/** @} */
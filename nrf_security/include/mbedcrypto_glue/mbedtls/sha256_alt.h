@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+
+/**@file
+ * @addtogroup mbedcrypto_glue_sha256
+ * @{
+ */
+#ifndef MBEDTLS_SHA256_ALT_H
+#define MBEDTLS_SHA256_ALT_H
+
+#if !defined(MBEDTLS_CONFIG_FILE)
+#include "config.h"
+#else
+#include MBEDTLS_CONFIG_FILE
+#endif
+
+/**
+ * @brief Context size of SHA-256 in words in the nrf_cc310_mbedcrypto library.
+ */
+#define CC310_MBEDTLS_SHA256_CONTEXT_WORDS      (60)
+
+/**
+ * @brief Context size of SHA-256 in words in the nrf_oberon backend.
+ */
+#define OBERON_MBEDTLS_SHA256_CONTEXT_WORDS     (26)
+
+/**
+ * @brief Size of a SHA-256 state saved with @ref mbedtls_sha256_save_state.
+ */
+#define MBEDTLS_SHA256_STATE_SIZE               (4 + 4 * CC310_MBEDTLS_SHA256_CONTEXT_WORDS)
+
+#if defined(MBEDTLS_SHA256_ALT)
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief mbedcrypto SHA-256 glue context.
+ */
+typedef struct mbedtls_sha256_context
+{
+    union _buffer
+    {
+        uint32_t buffer_cc310[CC310_MBEDTLS_SHA256_CONTEXT_WORDS];      //!< Array the size of a SHA-256 context in the nrf_cc310_mbedcrypto library.
+        uint32_t buffer_oberon[OBERON_MBEDTLS_SHA256_CONTEXT_WORDS];    //!< Array the size of a SHA-256 context in the nrf_oberon backend.
+    } buffer;                                                           //!< Union with size of the largest enabled backend context.
+    void* handle;                                                       //!< Pointer to the function table in a started glue context.
+} mbedtls_sha256_context;
+
+/**@brief Save the intermediate state of a started SHA-256 operation.
+ *
+ * @details The saved state can be restored with @ref mbedtls_sha256_restore_state
+ *          into any context, which continues the operation on the same backend.
+ *          This allows many long-lived operations, e.g. HMAC streams, to be
+ *          parked in small buffers and resumed with a single context.
+ *
+ * @note The saved state is only valid for the firmware image that saved it.
+ *
+ * @param[in]           ctx         Pointer to a started context.
+ * @param[out]          state       Pointer to a buffer to hold the state.
+ * @param[in]           state_size  Size of the buffer.
+ * @param[out]          olen        Pointer to a variable to hold the size of the saved state.
+ *
+ * @return 0 if operation was successful, otherwise a negative value corresponding to the error.
+ */
+int mbedtls_sha256_save_state(const mbedtls_sha256_context *ctx, unsigned char *state, size_t state_size, size_t *olen);
+
+/**@brief Restore a SHA-256 state saved with @ref mbedtls_sha256_save_state.
+ *
+ * @param[in,out]       ctx         Pointer to an initialized context.
+ * @param[in]           state       Pointer to the saved state.
+ * @param[in]           state_len   Length of the saved state.
+ *
+ * @return 0 if operation was successful, otherwise a negative value corresponding to the error.
+ */
+int mbedtls_sha256_restore_state(mbedtls_sha256_context *ctx, const unsigned char *state, size_t state_len);
+
+#endif /* MBEDTLS_SHA256_ALT */
+
+#endif /* MBEDTLS_SHA256_ALT_H */
+
+/** @} */
@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+
+/**@file
+ * @defgroup nrf_security_glue_stats mbedcrypto glue statistics
+ * @ingroup nrf_security
+ * @{
+ * @brief Per backend operation counters of the mbedcrypto glue layer.
+ *
+ * @details When CONFIG_GLUE_STATS is enabled, the glue layer counts each data
+ *          processing call to a backend, the bytes processed and the duration of
+ *          the call in a log2 histogram. The counters show which backend serves an
+ *          operation in the field, e.g. whether the cc310 is actually used.
+ *
+ *          Waits for a contended cc310 mutex are counted separately.
+ *
+ *          The counters are 32-bit and wrap around.
+ */
+#ifndef MBEDCRYPTO_GLUE_STATS_H
+#define MBEDCRYPTO_GLUE_STATS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**@brief Number of latency histogram buckets. */
+#define MBEDCRYPTO_GLUE_STATS_HIST_BUCKETS      (16)
+
+/**@brief log2 of the upper bound in clock cycles of the first histogram bucket.
+ *
+ * @details Bucket 0 counts calls shorter than 2^6 cycles. Bucket n counts calls
+ *          of at least 2^(n + 5) and less than 2^(n + 6) cycles. The last bucket
+ *          also counts all longer calls.
+ */
+#define MBEDCRYPTO_GLUE_STATS_HIST_LOG2_MIN     (6)
+
+/**@brief Latency histogram in hardware clock cycles. */
+typedef struct
+{
+    uint32_t    count;                                      //!< Number of calls.
+    uint32_t    hist[MBEDCRYPTO_GLUE_STATS_HIST_BUCKETS];   //!< Calls per duration bucket.
+} mbedcrypto_glue_stats_hist_t;
+
+/**@brief Counters of one operation on one backend. */
+typedef struct
+{
+    const char *                    op;         //!< Operation name, e.g. "aes_ctr".
+    const char *                    backend;    //!< Backend name: "cc310", "vanilla", "oberon" or "unknown".
+    uint32_t                        bytes;      //!< Bytes processed, 0 for public key operations.
+    mbedcrypto_glue_stats_hist_t    latency;    //!< Number of calls and their duration.
+} mbedcrypto_glue_stats_entry_t;
+
+/**@brief Function called for each operation and backend that has been used.
+ *
+ * @param[in]   p_entry     Snapshot of the counters.
+ * @param[in]   p_ctx       Context given to @ref mbedcrypto_glue_stats_foreach.
+ */
+typedef void (*mbedcrypto_glue_stats_cb_t)(const mbedcrypto_glue_stats_entry_t *p_entry, void *p_ctx);
+
+/**@brief Report the counters of each operation and backend that has been used.
+ *
+ * @param[in]   cb          Function called with each entry.
+ * @param[in]   p_ctx       Context passed to @p cb.
+ */
+void mbedcrypto_glue_stats_foreach(mbedcrypto_glue_stats_cb_t cb, void *p_ctx);
+
+/**@brief Read the number of contended cc310 mutex locks and their wait time.
+ *
+ * @details Only available with the cc310 backend. Otherwise all counters are 0.
+ *
+ * @param[out]  p_wait      Pointer to the structure to fill.
+ */
+void mbedcrypto_glue_stats_mutex_wait_get(mbedcrypto_glue_stats_hist_t *p_wait);
+
+/**@brief Reset all counters. */
+void mbedcrypto_glue_stats_reset(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MBEDCRYPTO_GLUE_STATS_H */
+
+/** @} */
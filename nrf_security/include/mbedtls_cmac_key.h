@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+
+/**@file
+ * @defgroup nrf_security_cmac_key AES-CMAC with a reusable key
+ * @ingroup nrf_security
+ * @{
+ * @brief AES-CMAC with the subkeys derived once per key.
+ *
+ * @details mbedtls_cipher_cmac() and mbedtls_aes_cmac_prf_128() set up the
+ *          AES key and derive the CMAC subkeys K1 and K2 for every message.
+ *          These APIs keep the AES key and the subkeys in a context, so
+ *          messages authenticated with the same key only cost their CBC-MAC.
+ *
+ *          The CBC-MAC is computed with mbedtls_aes_crypt_cbc() when CBC is
+ *          enabled, so a message takes one AES operation per
+ *          @ref MBEDTLS_CMAC_KEY_CHUNK_SIZE bytes instead of one per block.
+ *          With the cc310 backend, this is one hardware operation per chunk.
+ *
+ *          The output is identical to mbedtls_cipher_cmac() with an AES
+ *          cipher of the same key.
+ */
+#ifndef MBEDTLS_CMAC_KEY_H
+#define MBEDTLS_CMAC_KEY_H
+
+#include <stddef.h>
+
+#include "mbedtls/aes.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**@brief Bytes of a message processed by one AES operation, a multiple of 16. */
+#define MBEDTLS_CMAC_KEY_CHUNK_SIZE 128
+
+/**@brief AES-CMAC key context. */
+typedef struct
+{
+    mbedtls_aes_context aes;    //!< AES encryption key.
+    unsigned char k1[16];       //!< CMAC subkey for a complete last block.
+    unsigned char k2[16];       //!< CMAC subkey for a padded last block.
+} mbedtls_cmac_key_context;
+
+/**@brief Initialize an AES-CMAC key context.
+ *
+ * @param[out]  ctx     Context to initialize.
+ */
+void mbedtls_cmac_key_init(mbedtls_cmac_key_context *ctx);
+
+/**@brief Free an AES-CMAC key context and clear the key.
+ *
+ * @param[in,out]   ctx     Context to free.
+ */
+void mbedtls_cmac_key_free(mbedtls_cmac_key_context *ctx);
+
+/**@brief Set the AES key and derive the CMAC subkeys.
+ *
+ * @param[in,out]   ctx         Initialized context.
+ * @param[in]       key         AES key.
+ * @param[in]       keybits     Key size in bits, 128, 192 or 256.
+ *
+ * @return 0 on success, otherwise an AES error code.
+ */
+int mbedtls_cmac_key_setkey(mbedtls_cmac_key_context *ctx,
+                            const unsigned char *key, unsigned int keybits);
+
+/**@brief Set the key of AES-CMAC-PRF-128 (RFC 4615).
+ *
+ * @details Keys that are not 16 bytes are first reduced with AES-CMAC under a
+ *          zero key. @ref mbedtls_cmac_key_compute with this context then
+ *          gives the same output as mbedtls_aes_cmac_prf_128().
+ *
+ * @param[in,out]   ctx         Initialized context.
+ * @param[in]       key         Key of any length.
+ * @param[in]       key_len     Length of @p key in bytes.
+ *
+ * @return 0 on success, otherwise an AES error code.
+ */
+int mbedtls_cmac_key_setkey_prf_128(mbedtls_cmac_key_context *ctx,
+                                    const unsigned char *key, size_t key_len);
+
+/**@brief Compute the AES-CMAC of a message.
+ *
+ * @param[in]   ctx         Context with a key set.
+ * @param[in]   input       Message.
+ * @param[in]   ilen        Length of @p input.
+ * @param[out]  output      MAC.
+ *
+ * @return 0 on success, otherwise an AES error code.
+ */
+int mbedtls_cmac_key_compute(mbedtls_cmac_key_context *ctx,
+                             const unsigned char *input, size_t ilen,
+                             unsigned char output[16]);
+
+/**@brief Compute the AES-CMAC of several messages.
+ *
+ * @details The messages are processed back to back under the key and subkeys
+ *          of @p ctx.
+ *
+ * @param[in]   ctx         Context with a key set.
+ * @param[in]   inputs      Messages.
+ * @param[in]   ilens       Lengths of the messages.
+ * @param[out]  outputs     MACs, one per message.
+ * @param[in]   count       Number of messages.
+ *
+ * @return 0 on success, otherwise an AES error code.
+ */
+int mbedtls_cmac_key_compute_batch(mbedtls_cmac_key_context *ctx,
+                                   const unsigned char *const inputs[],
+                                   const size_t ilens[],
+                                   unsigned char outputs[][16], size_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MBEDTLS_CMAC_KEY_H */
+
+/** @} */
@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+
+/**@file
+ * @defgroup nrf_security_ctr_drbg_batched Batched CTR_DRBG generation
+ * @ingroup nrf_security
+ * @{
+ * @brief CTR_DRBG generate function using a single AES-CTR operation.
+ *
+ * @details mbedtls_ctr_drbg_random() encrypts the DRBG counter one 16 byte
+ *          block at a time. When AES is provided by the CC310 backend, every
+ *          block is a separate hardware operation. The CTR_DRBG generate
+ *          function is the AES-CTR keystream of the incremented counter, and
+ *          the following update with no additional input is the continuation
+ *          of that keystream. These APIs compute both with mbedtls_aes_crypt_ctr()
+ *          so the request is done as two hardware operations.
+ *
+ *          The output is identical to mbedtls_ctr_drbg_random() on the same
+ *          context, and the functions can be freely mixed with the mbed TLS
+ *          CTR_DRBG APIs.
+ */
+#ifndef MBEDTLS_CTR_DRBG_BATCHED_H
+#define MBEDTLS_CTR_DRBG_BATCHED_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**@brief Generate random data with a CTR_DRBG context.
+ *
+ * @details Drop-in replacement for mbedtls_ctr_drbg_random().
+ *
+ * @param[in,out]   p_rng       Pointer to a seeded mbedtls_ctr_drbg_context.
+ * @param[out]      output      Buffer to fill.
+ * @param[in]       output_len  Length of the buffer, at most MBEDTLS_CTR_DRBG_MAX_REQUEST.
+ *
+ * @return 0 on success, otherwise a MBEDTLS_ERR_CTR_DRBG_* or AES error code.
+ */
+int mbedtls_ctr_drbg_batched_random(void *p_rng, unsigned char *output,
+                                    size_t output_len);
+
+/**@brief Generate any amount of random data with a CTR_DRBG context.
+ *
+ * @details The request is split in generate calls of at most
+ *          MBEDTLS_CTR_DRBG_MAX_REQUEST bytes. Reseeding is done as needed
+ *          between the calls.
+ *
+ * @param[in,out]   p_rng       Pointer to a seeded mbedtls_ctr_drbg_context.
+ * @param[out]      output      Buffer to fill.
+ * @param[in]       output_len  Length of the buffer.
+ *
+ * @return 0 on success, otherwise a MBEDTLS_ERR_CTR_DRBG_* or AES error code.
+ */
+int mbedtls_ctr_drbg_batched_random_large(void *p_rng, unsigned char *output,
+                                          size_t output_len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MBEDTLS_CTR_DRBG_BATCHED_H */
+
+/** @} */
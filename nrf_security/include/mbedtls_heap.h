@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+
+/**@file
+ * @defgroup nrf_security_mbedtls_heap mbed TLS heap statistics
+ * @ingroup nrf_security
+ * @{
+ * @brief Usage statistics for the mbed TLS heap.
+ *
+ * @details When CONFIG_MBEDTLS_HEAP_STATS is enabled, every mbed TLS allocation
+ *          is accounted on top of the selected heap allocator. The statistics
+ *          are intended for sizing the heap and for spotting memory footprint
+ *          regressions.
+ */
+#ifndef MBEDTLS_HEAP_H
+#define MBEDTLS_HEAP_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**@brief mbed TLS heap statistics. */
+typedef struct
+{
+    size_t      cur_used;       //!< Bytes currently allocated, as requested by the callers.
+    size_t      max_used;       //!< Highest value of cur_used since boot or the last reset.
+    size_t      cur_blocks;     //!< Number of allocations currently not freed.
+    size_t      max_blocks;     //!< Highest value of cur_blocks since boot or the last reset.
+    uint32_t    alloc_count;    //!< Total number of successful allocations.
+    uint32_t    fail_count;     //!< Total number of failed allocations.
+    size_t      total_free;     //!< Bytes left in the heap.
+    size_t      largest_free;   //!< Largest allocation that can currently succeed, 0 if unknown.
+    uint8_t     fragmentation;  //!< Fragmentation index in percent, 0 when largest_free is unknown.
+} mbedtls_heap_stats_t;
+
+/**@brief Read the mbed TLS heap statistics.
+ *
+ * @details The fragmentation index is computed as
+ *          100 * (1 - largest_free / total_free).
+ *
+ * @param[out]  p_stats     Pointer to the structure to fill.
+ */
+void mbedtls_heap_stats_get(mbedtls_heap_stats_t *p_stats);
+
+/**@brief Reset the max_used and max_blocks peaks to the current values. */
+void mbedtls_heap_stats_reset_max(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MBEDTLS_HEAP_H */
+
+/** @} */
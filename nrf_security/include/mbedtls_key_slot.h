@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+
+/**@file
+ * @defgroup nrf_security_key_slot Key slots
+ * @ingroup nrf_security
+ * @{
+ * @brief Long-lived AES and AES-CCM keys referenced by an identifier.
+ *
+ * @details A key is imported once into one of CONFIG_MBEDTLS_KEY_SLOT_COUNT
+ *          slots, which keeps it set up for the selected backend: the
+ *          expanded key schedule for mbed TLS vanilla, or the key prepared
+ *          for cc310. Operations then reference the slot by its
+ *          identifier, so no key setup is done per message and the raw key
+ *          does not have to be kept by the caller.
+ *
+ *          An identifier is no longer valid once its slot is destroyed, also
+ *          if the slot is reused for another key.
+ *
+ *          A slot can be used from several threads. Operations on one slot
+ *          are serialized, operations on different slots are not.
+ */
+#ifndef MBEDTLS_KEY_SLOT_H
+#define MBEDTLS_KEY_SLOT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "mbedtls/aes.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**@brief Identifier that never refers to a key slot. */
+#define MBEDTLS_KEY_SLOT_ID_INVALID 0
+
+/**@brief Key slot identifier. */
+typedef uint32_t mbedtls_key_slot_id;
+
+/**@brief Import an AES key for ECB operations in one direction.
+ *
+ * @param[out]  id          Identifier of the slot holding the key.
+ * @param[in]   mode        MBEDTLS_AES_ENCRYPT or MBEDTLS_AES_DECRYPT.
+ * @param[in]   key         AES key.
+ * @param[in]   keybits     Key size in bits, 128, 192 or 256.
+ *
+ * @return 0 on success, MBEDTLS_ERR_CIPHER_ALLOC_FAILED if all slots are in
+ *         use, otherwise an AES error code.
+ */
+int mbedtls_key_slot_aes_import(mbedtls_key_slot_id *id, int mode,
+                                const unsigned char *key,
+                                unsigned int keybits);
+
+/**@brief AES-ECB operation with the key of a slot.
+ *
+ * @details The operation is the one given to @ref mbedtls_key_slot_aes_import.
+ *
+ * @param[in]   id          Identifier of an AES slot.
+ * @param[in]   input       Input block.
+ * @param[out]  output      Output block.
+ *
+ * @return 0 on success, MBEDTLS_ERR_AES_BAD_INPUT_DATA if @p id does not
+ *         refer to an AES slot, otherwise an AES error code.
+ */
+int mbedtls_key_slot_aes_crypt_ecb(mbedtls_key_slot_id id,
+                                   const unsigned char input[16],
+                                   unsigned char output[16]);
+
+#if defined(MBEDTLS_CCM_C)
+/**@brief Import an AES-CCM key.
+ *
+ * @param[out]  id          Identifier of the slot holding the key.
+ * @param[in]   key         AES key.
+ * @param[in]   keybits     Key size in bits, 128, 192 or 256.
+ *
+ * @return 0 on success, MBEDTLS_ERR_CIPHER_ALLOC_FAILED if all slots are in
+ *         use, otherwise a CCM error code.
+ */
+int mbedtls_key_slot_ccm_import(mbedtls_key_slot_id *id,
+                                const unsigned char *key,
+                                unsigned int keybits);
+
+/**@brief AES-CCM encryption with the key of a slot.
+ *
+ * @details The parameters after @p id are those of
+ *          mbedtls_ccm_encrypt_and_tag().
+ *
+ * @return 0 on success, MBEDTLS_ERR_CCM_BAD_INPUT if @p id does not refer to
+ *         a CCM slot, otherwise a CCM error code.
+ */
+int mbedtls_key_slot_ccm_encrypt_and_tag(mbedtls_key_slot_id id,
+                                         size_t length,
+                                         const unsigned char *iv, size_t iv_len,
+                                         const unsigned char *add, size_t add_len,
+                                         const unsigned char *input,
+                                         unsigned char *output,
+                                         unsigned char *tag, size_t tag_len);
+
+/**@brief AES-CCM decryption and tag check with the key of a slot.
+ *
+ * @details The parameters after @p id are those of
+ *          mbedtls_ccm_auth_decrypt().
+ *
+ * @return 0 on success, MBEDTLS_ERR_CCM_BAD_INPUT if @p id does not refer to
+ *         a CCM slot, MBEDTLS_ERR_CCM_AUTH_FAILED if the tag does not match,
+ *         otherwise a CCM error code.
+ */
+int mbedtls_key_slot_ccm_auth_decrypt(mbedtls_key_slot_id id,
+                                      size_t length,
+                                      const unsigned char *iv, size_t iv_len,
+                                      const unsigned char *add, size_t add_len,
+                                      const unsigned char *input,
+                                      unsigned char *output,
+                                      const unsigned char *tag, size_t tag_len);
+#endif /* MBEDTLS_CCM_C */
+
+/**@brief Destroy a key slot and clear its key.
+ *
+ * @details Waits for an ongoing operation on the slot to complete. Does
+ *          nothing if @p id does not refer to a slot.
+ *
+ * @param[in]   id          Identifier of the slot.
+ */
+void mbedtls_key_slot_destroy(mbedtls_key_slot_id id);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MBEDTLS_KEY_SLOT_H */
+
+/** @} */
@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+
+/**@file
+ * @defgroup nrf_security_pem_decode PEM decoding without a heap copy
+ * @ingroup nrf_security
+ * @{
+ * @brief PEM decoding in place or one object at a time.
+ *
+ * @details @c mbedtls_pem_read_buffer decodes a PEM object into a buffer
+ *          allocated from the mbed TLS heap, so loading certificates needs the
+ *          PEM text and the DER data in RAM at the same time. These APIs decode
+ *          into caller provided memory instead:
+ *
+ *          - @ref mbedtls_pem_decode_in_place overwrites the PEM text of an
+ *            object in RAM with its DER data.
+ *          - @ref mbedtls_pem_decode_each decodes the objects of a bundle, e.g.
+ *            a CA list in memory-mapped flash, one at a time into a buffer large
+ *            enough for the largest object, and passes each one to a callback.
+ *
+ *          Encrypted PEM objects are not supported.
+ */
+#ifndef MBEDTLS_PEM_DECODE_H
+#define MBEDTLS_PEM_DECODE_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**@brief Function called with each decoded object of @ref mbedtls_pem_decode_each.
+ *
+ * @details For certificates, this can call mbedtls_x509_crt_parse_der().
+ *
+ * @param[in]   p_ctx       Context given to @ref mbedtls_pem_decode_each.
+ * @param[in]   der         DER data of the object.
+ * @param[in]   der_len     Length of @p der.
+ *
+ * @return 0 to continue with the next object, otherwise an error that stops
+ *         the decoding and is returned by @ref mbedtls_pem_decode_each.
+ */
+typedef int (*mbedtls_pem_decode_cb_t)(void *p_ctx, const unsigned char *der,
+                                       size_t der_len);
+
+/**@brief Decode the first PEM object of a buffer in place.
+ *
+ * @details The DER data is written to the start of @p buf. The PEM text up to
+ *          the end of the footer is overwritten, data after it is left as it is.
+ *
+ * @param[in,out]   buf         PEM text, not necessarily NUL terminated.
+ * @param[in]       buflen      Length of @p buf.
+ * @param[in]       header      Header line, e.g. "-----BEGIN CERTIFICATE-----".
+ * @param[in]       footer      Footer line, e.g. "-----END CERTIFICATE-----".
+ * @param[out]      der_len     Length of the DER data at the start of @p buf.
+ * @param[out]      use_len     Bytes of @p buf used by the PEM object, including
+ *                              the line break after the footer.
+ *
+ * @return 0 on success, MBEDTLS_ERR_PEM_NO_HEADER_FOOTER_PRESENT if @p buf holds
+ *         no object, MBEDTLS_ERR_PEM_FEATURE_UNAVAILABLE for an encrypted object,
+ *         or MBEDTLS_ERR_PEM_INVALID_DATA for invalid base64 data.
+ */
+int mbedtls_pem_decode_in_place(unsigned char *buf, size_t buflen,
+                                const char *header, const char *footer,
+                                size_t *der_len, size_t *use_len);
+
+/**@brief Decode each PEM object of a bundle.
+ *
+ * @details Text between the objects is ignored. The source is only read.
+ *
+ * @param[in]   pem         PEM text, not necessarily NUL terminated.
+ * @param[in]   pem_len     Length of @p pem.
+ * @param[in]   header      Header line of the objects.
+ * @param[in]   footer      Footer line of the objects.
+ * @param[out]  der_buf     Buffer for the DER data of one object.
+ * @param[in]   der_buf_len Length of @p der_buf.
+ * @param[in]   cb          Function called with each object.
+ * @param[in]   p_ctx       Context passed to @p cb.
+ *
+ * @return 0 when all objects have been decoded, the error of @p cb, or the
+ *         errors of @ref mbedtls_pem_decode_in_place. MBEDTLS_ERR_PEM_BAD_INPUT_DATA
+ *         if an object does not fit in @p der_buf.
+ */
+int mbedtls_pem_decode_each(const unsigned char *pem, size_t pem_len,
+                            const char *header, const char *footer,
+                            unsigned char *der_buf, size_t der_buf_len,
+                            mbedtls_pem_decode_cb_t cb, void *p_ctx);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MBEDTLS_PEM_DECODE_H */
+
+/** @} */
@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+
+/**@file
+ * @defgroup nrf_security_thread_drbg Per-thread CTR_DRBG
+ * @ingroup nrf_security
+ * @{
+ * @brief Random number generation with one CTR_DRBG instance per thread.
+ *
+ * @details A CTR_DRBG context shared by all threads serializes every random
+ *          request on the context mutex. These APIs give each calling thread
+ *          its own CTR_DRBG instance with an independent reseed counter. All
+ *          instances are seeded from one shared entropy context, and the
+ *          thread identity is used as personalization string.
+ *
+ *          An instance is taken from a fixed pool of
+ *          CONFIG_MBEDTLS_THREAD_DRBG_COUNT entries on the first request of a
+ *          thread and is kept until @ref mbedtls_thread_drbg_release is called.
+ *          The instance is found through the k_thread custom data. A new
+ *          thread created in the k_thread object of a thread that did not
+ *          release its instance gets that instance seeded again, it does not
+ *          continue the old state. When the pool is exhausted, the remaining
+ *          threads share one more instance under a lock.
+ */
+#ifndef MBEDTLS_THREAD_DRBG_H
+#define MBEDTLS_THREAD_DRBG_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**@brief Generate random data using the CTR_DRBG of the calling thread.
+ *
+ * @details The signature matches the mbed TLS f_rng callback, so this function
+ *          can be given directly to e.g. mbedtls_ssl_conf_rng().
+ *
+ * @param[in]   p_rng       Unused, may be NULL.
+ * @param[out]  output      Buffer to fill.
+ * @param[in]   output_len  Length of the buffer, at most MBEDTLS_CTR_DRBG_MAX_REQUEST.
+ *
+ * @return 0 on success, MBEDTLS_ERR_CTR_DRBG_* or MBEDTLS_ERR_ENTROPY_* on
+ *         failure.
+ */
+int mbedtls_thread_drbg_random(void *p_rng, unsigned char *output,
+                               size_t output_len);
+
+/**@brief Release the CTR_DRBG instance of the calling thread.
+ *
+ * @details Should be called by a thread before it terminates to return its
+ *          instance to the pool. Does nothing if the thread has no instance
+ *          or uses the shared instance.
+ */
+void mbedtls_thread_drbg_release(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MBEDTLS_THREAD_DRBG_H */
+
+/** @} */
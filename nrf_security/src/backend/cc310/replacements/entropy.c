@@ -62,6 +62,23 @@
 
 #define ENTROPY_MAX_LOOP    256     /**< Maximum amount to loop before error */
 
+#if defined(MBEDTLS_ENTROPY_HARDWARE_ALT) && \
+    defined(CONFIG_NRF_CC310_PLATFORM_ENTROPY_POOL)
+#include "nrf_cc310_platform_entropy_pool.h"
+
+/* CC310: Serve the hardware entropy source from the pre-fetched pool */
+static int entropy_pool_poll( void *data, unsigned char *output,
+                              size_t len, size_t *olen )
+{
+    ((void) data);
+
+    if( nrf_cc310_platform_entropy_pool_get( output, len, olen ) != 0 )
+        return( MBEDTLS_ERR_ENTROPY_SOURCE_FAILED );
+
+    return( 0 );
+}
+#endif
+
 void mbedtls_entropy_init( mbedtls_entropy_context *ctx )
 {
     ctx->source_count = 0;
@@ -106,11 +123,17 @@ void mbedtls_entropy_init( mbedtls_entropy_context *ctx )
                                 MBEDTLS_ENTROPY_SOURCE_STRONG );
 #endif
 #if defined(MBEDTLS_ENTROPY_HARDWARE_ALT)
+#if defined(CONFIG_NRF_CC310_PLATFORM_ENTROPY_POOL)
+    mbedtls_entropy_add_source( ctx, entropy_pool_poll, ctx,
+                                MBEDTLS_ENTROPY_MIN_HARDWARE,
+                                MBEDTLS_ENTROPY_SOURCE_STRONG );
+#else
     /* CC310: Adding ctx as third argument instead of NULL */
     mbedtls_entropy_add_source( ctx, mbedtls_hardware_poll, ctx,
                                 MBEDTLS_ENTROPY_MIN_HARDWARE,
                                 MBEDTLS_ENTROPY_SOURCE_STRONG );
 #endif
+#endif
 #if defined(MBEDTLS_ENTROPY_NV_SEED)
     mbedtls_entropy_add_source( ctx, mbedtls_nv_seed_poll, NULL,
                                 MBEDTLS_ENTROPY_BLOCK_SIZE,
@@ -261,7 +284,7 @@ static int entropy_gather_internal( mbedtls_entropy_context *ctx )
 {
     int ret, i, have_one_strong = 0;
     unsigned char buf[MBEDTLS_ENTROPY_MAX_GATHER];
-    size_t olen;
+    size_t olen, want = MBEDTLS_ENTROPY_MAX_GATHER;
 
     if( ctx->source_count == 0 )
         return( MBEDTLS_ERR_ENTROPY_NO_SOURCES_DEFINED );
@@ -274,9 +297,25 @@ static int entropy_gather_internal( mbedtls_entropy_context *ctx )
         if( ctx->source[i].strong == MBEDTLS_ENTROPY_SOURCE_STRONG )
             have_one_strong = 1;
 
+#if defined(CONFIG_MBEDTLS_ENTROPY_GATHER_THRESHOLD)
+        /*
+         * CC310: Only ask for what the source needs to reach its threshold,
+         * but at least one accumulator block. Requesting
+         * MBEDTLS_ENTROPY_MAX_GATHER bytes drains the TRNG (or the entropy
+         * pool) far beyond MBEDTLS_ENTROPY_MIN_HARDWARE, and anything longer
+         * than a block is hashed once more before it is accumulated.
+         */
+        want = MBEDTLS_ENTROPY_BLOCK_SIZE;
+        if( ctx->source[i].threshold > ctx->source[i].size &&
+            ctx->source[i].threshold - ctx->source[i].size > want )
+            want = ctx->source[i].threshold - ctx->source[i].size;
+        if( want > MBEDTLS_ENTROPY_MAX_GATHER )
+            want = MBEDTLS_ENTROPY_MAX_GATHER;
+#endif /* CONFIG_MBEDTLS_ENTROPY_GATHER_THRESHOLD */
+
         olen = 0;
         if( ( ret = ctx->source[i].f_source( ctx->source[i].p_source,
-                        buf, MBEDTLS_ENTROPY_MAX_GATHER, &olen ) ) != 0 )
+                        buf, want, &olen ) ) != 0 )
         {
             goto cleanup;
         }
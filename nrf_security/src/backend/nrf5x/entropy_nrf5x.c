@@ -3,23 +3,31 @@
  *
  * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
  */
-#include <assert.h>
 #include <zephyr.h>
 #include <entropy.h>
 #include <mbedtls/entropy.h>
 
-static_assert(defined(CONFIG_ENTROPY_GENERATOR), "CONFIG_ENTROPY_GENERATOR is not enabled.");
-static_assert(defined(CONFIG_ENTROPY_HAS_DRIVER), "CONFIG_ENTROPY_HAS_DRIVER is not set.");
+#if !defined(CONFIG_ENTROPY_GENERATOR)
+#error "CONFIG_ENTROPY_GENERATOR is not enabled."
+#endif
+#if !defined(CONFIG_ENTROPY_HAS_DRIVER)
+#error "CONFIG_ENTROPY_HAS_DRIVER is not set."
+#endif
+
+/* Largest request the entropy driver API accepts in one call */
+#define ENTROPY_CHUNK_MAX UINT16_MAX
+
+static struct device *entropy_dev;
 
 int mbedtls_hardware_poll(void *data,
                           unsigned char *output,
                           size_t len,
                           size_t *olen )
 {
-    struct device *dev;
-    u8_t buffer[MBEDTLS_ENTROPY_MAX_GATHER] = { 0 };
+    size_t offset = 0;
+    u16_t chunk;
     int ret;
-    
+
     (void)data;
 
     if (output == NULL)
@@ -32,27 +40,49 @@ int mbedtls_hardware_poll(void *data,
         return -1;
     }
 
+    *olen = 0;
+
     if (len == 0)
     {
         return -1;
     }
 
-    if (len != MBEDTLS_ENTROPY_MAX_GATHER)
+    if (entropy_dev == NULL)
     {
-        return -1;
+        entropy_dev = device_get_binding(CONFIG_ENTROPY_NAME);
+        if (entropy_dev == NULL)
+        {
+            return MBEDTLS_ERR_ENTROPY_NO_SOURCES_DEFINED;
+        }
     }
 
-    dev = device_get_binding(CONFIG_ENTROPY_NAME);
-    if (!dev)
+    while (offset < len)
     {
-        return MBEDTLS_ERR_ENTROPY_NO_SOURCES_DEFINED;
-    }
+        chunk = (u16_t)MIN(len - offset, ENTROPY_CHUNK_MAX);
 
-    ret = entropy_get_entropy(dev, buffer, MBEDTLS_ENTROPY_MAX_GATHER);
-    if (ret)
-    {
-        return MBEDTLS_ERR_ENTROPY_SOURCE_FAILED;
+        if (k_is_in_isr())
+        {
+            /* Busy-waits for the missing bytes instead of sleeping */
+            ret = entropy_get_entropy_isr(entropy_dev, &output[offset],
+                                          chunk, ENTROPY_BUSYWAIT);
+            if (ret <= 0)
+            {
+                return MBEDTLS_ERR_ENTROPY_SOURCE_FAILED;
+            }
+            chunk = (u16_t)ret;
+        }
+        else
+        {
+            ret = entropy_get_entropy(entropy_dev, &output[offset], chunk);
+            if (ret != 0)
+            {
+                return MBEDTLS_ERR_ENTROPY_SOURCE_FAILED;
+            }
+        }
+
+        offset += chunk;
+        *olen = offset;
     }
 
     return 0;
-}
\ No newline at end of file
+}
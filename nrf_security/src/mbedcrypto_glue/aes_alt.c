@@ -23,6 +23,12 @@
 
 #include "mbedtls/aes.h"
 #include "backend_aes.h"
+#include "backend_trace.h"
+#include "backend_cache.h"
+
+#if defined(CONFIG_GLUE_MBEDTLS_AES_SECONDARY)
+#include "nrf_cc310_platform_mutex.h"
+#endif
 
 
 #define AES_CONTEXT_INIT(ctx) do { ctx->handle = NULL; } while (0)
@@ -30,6 +36,25 @@
 #define AES_CONTEXT_UNPACK(ctx, funcs, backend_context) do { funcs = ctx->handle; backend_context = &ctx->buffer; } while (0)
 #define AES_CONTEXT_FREE(ctx) do { ctx->handle = NULL; } while (0)
 
+#if defined(CONFIG_GLUE_MBEDTLS_AES_SECONDARY)
+#define AES_CONTEXT_SECONDARY_ALLOC(ctx, funcs, backend_context, new_funcs) do { ctx->handle_secondary = (void*)new_funcs; funcs = new_funcs; backend_context = &ctx->buffer_secondary; } while (0)
+#define AES_CONTEXT_SECONDARY_UNPACK(ctx, funcs, backend_context) do { funcs = ctx->handle_secondary; backend_context = &ctx->buffer_secondary; } while (0)
+#define AES_CONTEXT_SECONDARY_FREE(ctx) do { ctx->handle_secondary = NULL; } while (0)
+
+/* Use the software backend if the CC310 is busy with another symmetric operation. */
+#define AES_CONTEXT_UNPACK_FOR_OPERATION(ctx, funcs, backend_context) do { \
+        AES_CONTEXT_UNPACK(ctx, funcs, backend_context); \
+        if (ctx->handle_secondary != NULL && \
+            nrf_cc310_platform_mutex_is_busy(platform_mutexes.sym_mutex)) \
+        { \
+            AES_CONTEXT_SECONDARY_UNPACK(ctx, funcs, backend_context); \
+        } \
+    } while (0)
+#else
+#define AES_CONTEXT_UNPACK_FOR_OPERATION(ctx, funcs, backend_context) \
+        AES_CONTEXT_UNPACK(ctx, funcs, backend_context)
+#endif /* CONFIG_GLUE_MBEDTLS_AES_SECONDARY */
+
 #define AES_XTS_CONTEXT_INIT(ctx) do { ctx->handle = NULL; } while (0)
 #define AES_XTS_CONTEXT_ALLOC(ctx, funcs, backend_context, new_funcs) do { ctx->handle = (void*)new_funcs; funcs = new_funcs; backend_context = &ctx->buffer; } while (0)
 #define AES_XTS_CONTEXT_UNPACK(ctx, funcs, backend_context) do { funcs = ctx->handle; backend_context = &ctx->buffer; } while (0)
@@ -39,6 +64,9 @@
 #if defined(CONFIG_CC310_MBEDTLS_AES_C)
 extern mbedtls_aes_funcs mbedtls_aes_cc310_backend_funcs;
 #endif
+#if defined(CONFIG_GLUE_MBEDTLS_AES_OBERON)
+extern mbedtls_aes_funcs mbedtls_aes_oberon_backend_funcs;
+#endif
 #if defined(CONFIG_VANILLA_MBEDTLS_AES_C)
 extern mbedtls_aes_funcs mbedtls_aes_vanilla_mbedtls_backend_funcs;
 #endif
@@ -48,6 +76,9 @@ static mbedtls_aes_funcs* aes_backends[] = {
 #if defined(CONFIG_CC310_MBEDTLS_AES_C)
     &mbedtls_aes_cc310_backend_funcs,
 #endif
+#if defined(CONFIG_GLUE_MBEDTLS_AES_OBERON)
+    &mbedtls_aes_oberon_backend_funcs,
+#endif
 #if defined(CONFIG_VANILLA_MBEDTLS_AES_C)
     &mbedtls_aes_vanilla_mbedtls_backend_funcs,
 #endif
@@ -71,9 +102,113 @@ static const mbedtls_aes_funcs* find_backend(unsigned int keybits, int mode, int
     return funcs;
 }
 
+#define AES_BACKEND_CACHE_SIZE (2 * BACKEND_CACHE_KEYBITS_COUNT * 2)
+
+static const mbedtls_aes_funcs* aes_backend_cache[AES_BACKEND_CACHE_SIZE];
+
+static int aes_backend_cache_index(unsigned int keybits, int mode, int xts)
+{
+    int keybits_index;
+
+    /* XTS keys are two AES keys of equal size. */
+    keybits_index = backend_cache_keybits_index(xts ? (keybits / 2) : keybits);
+    if (keybits_index == BACKEND_CACHE_NO_INDEX)
+    {
+        return BACKEND_CACHE_NO_INDEX;
+    }
+
+    return (((xts ? 1 : 0) * BACKEND_CACHE_KEYBITS_COUNT + keybits_index) * 2) +
+           ((mode == MBEDTLS_AES_ENCRYPT) ? 1 : 0);
+}
+
+static const mbedtls_aes_funcs* get_backend(unsigned int keybits, int mode, int xts)
+{
+    const mbedtls_aes_funcs* funcs;
+    BACKEND_CACHE_GET(aes_backend_cache, aes_backend_cache_index(keybits, mode, xts),
+                      funcs, find_backend(keybits, mode, xts));
+    return funcs;
+}
+
+#if defined(CONFIG_GLUE_MBEDTLS_AES_SECONDARY)
+/* Software backend for a key on cc310, nrf_oberon first as it is faster. */
+static const mbedtls_aes_funcs* find_secondary_backend(unsigned int keybits, int mode)
+{
+#if defined(CONFIG_GLUE_MBEDTLS_AES_OBERON)
+    if (mbedtls_aes_oberon_backend_funcs.check(keybits, mode, 0) > 0)
+    {
+        return &mbedtls_aes_oberon_backend_funcs;
+    }
+#endif
+#if defined(CONFIG_VANILLA_MBEDTLS_AES_C)
+    if (mbedtls_aes_vanilla_mbedtls_backend_funcs.check(keybits, mode, 0) > 0)
+    {
+        return &mbedtls_aes_vanilla_mbedtls_backend_funcs;
+    }
+#endif
+    return NULL;
+}
+
+static void aes_secondary_free(mbedtls_aes_context *ctx)
+{
+    const mbedtls_aes_funcs* funcs;
+    void* backend_context;
+    AES_CONTEXT_SECONDARY_UNPACK(ctx, funcs, backend_context);
+    if (funcs != NULL)
+    {
+        funcs->free(backend_context);
+        AES_CONTEXT_SECONDARY_FREE(ctx);
+    }
+}
+
+/*
+ * Key a software backend as well when the key is on cc310, so that each
+ * operation started while cc310 is busy can be processed in software.
+ */
+static void aes_secondary_setkey(mbedtls_aes_context *ctx, const mbedtls_aes_funcs* primary, const unsigned char *key, unsigned int keybits, int mode)
+{
+    const mbedtls_aes_funcs* new_funcs;
+    const mbedtls_aes_funcs* funcs;
+    void* backend_context;
+    int ret;
+
+    aes_secondary_free(ctx);
+
+    if (primary != &mbedtls_aes_cc310_backend_funcs)
+    {
+        return;
+    }
+
+    new_funcs = find_secondary_backend(keybits, mode);
+    if (new_funcs == NULL)
+    {
+        return;
+    }
+
+    AES_CONTEXT_SECONDARY_ALLOC(ctx, funcs, backend_context, new_funcs);
+    funcs->init(backend_context);
+
+    if (mode == MBEDTLS_AES_ENCRYPT)
+    {
+        ret = funcs->setkey_enc(backend_context, key, keybits);
+    }
+    else
+    {
+        ret = funcs->setkey_dec(backend_context, key, keybits);
+    }
+
+    if (ret != 0)
+    {
+        aes_secondary_free(ctx);
+    }
+}
+#endif /* CONFIG_GLUE_MBEDTLS_AES_SECONDARY */
+
 void mbedtls_aes_init(mbedtls_aes_context *ctx)
 {
     AES_CONTEXT_INIT(ctx);
+#if defined(CONFIG_GLUE_MBEDTLS_AES_SECONDARY)
+    AES_CONTEXT_SECONDARY_FREE(ctx);
+#endif
 }
 
 void mbedtls_aes_free(mbedtls_aes_context *ctx)
@@ -86,6 +221,9 @@ void mbedtls_aes_free(mbedtls_aes_context *ctx)
         funcs->free(backend_context);
         AES_CONTEXT_FREE(ctx);
     }
+#if defined(CONFIG_GLUE_MBEDTLS_AES_SECONDARY)
+    aes_secondary_free(ctx);
+#endif
 }
 
 #if defined(CONFIG_GLUE_MBEDTLS_CIPHER_MODE_XTS)
@@ -115,50 +253,55 @@ static int mbedtls_aes_setkey( mbedtls_aes_context *ctx, const unsigned char *ke
     const mbedtls_aes_funcs* new_funcs;
     const mbedtls_aes_funcs* funcs;
     void* backend_context;
+    int ret;
     AES_CONTEXT_UNPACK(ctx, funcs, backend_context);
 
-    new_funcs = find_backend(keybits, mode, 0);
+    new_funcs = get_backend(keybits, mode, 0);
 
     if (new_funcs == NULL)
     {
         return MBEDTLS_ERR_AES_FEATURE_UNAVAILABLE;
     }
 
-    if (funcs == new_funcs)
+    if (funcs != new_funcs)
     {
-        if (mode == MBEDTLS_AES_ENCRYPT)
+        if (funcs != NULL)
         {
-            return funcs->setkey_enc(backend_context, key, keybits);
+            funcs->free(backend_context);
+            AES_CONTEXT_FREE(ctx);
         }
-        else
+
+        AES_CONTEXT_ALLOC(ctx, funcs, backend_context, new_funcs);
+
+        if (funcs == NULL)
         {
-            return funcs->setkey_dec(backend_context, key, keybits);
+            return MBEDTLS_ERR_AES_HW_ACCEL_FAILED;
         }
+
+        funcs->init(backend_context);
     }
 
-    if (funcs != NULL)
+    if (mode == MBEDTLS_AES_ENCRYPT)
     {
-        funcs->free(backend_context);
-        AES_CONTEXT_FREE(ctx);
+        ret = funcs->setkey_enc(backend_context, key, keybits);
     }
-
-    AES_CONTEXT_ALLOC(ctx, funcs, backend_context, new_funcs);
-
-    if (funcs == NULL)
+    else
     {
-        return MBEDTLS_ERR_AES_HW_ACCEL_FAILED;
+        ret = funcs->setkey_dec(backend_context, key, keybits);
     }
 
-    funcs->init(backend_context);
-
-    if (mode == MBEDTLS_AES_ENCRYPT)
+#if defined(CONFIG_GLUE_MBEDTLS_AES_SECONDARY)
+    if (ret == 0)
     {
-        return funcs->setkey_enc(backend_context, key, keybits);
+        aes_secondary_setkey(ctx, funcs, key, keybits, mode);
     }
     else
     {
-        return funcs->setkey_dec(backend_context, key, keybits);
+        aes_secondary_free(ctx);
     }
+#endif
+
+    return ret;
 }
 
 int mbedtls_aes_setkey_enc(mbedtls_aes_context *ctx, const unsigned char *key, unsigned int keybits)
@@ -181,7 +324,7 @@ static int mbedtls_aes_xts_setkey_internal(mbedtls_aes_xts_context *ctx, const u
     void* backend_context;
     AES_XTS_CONTEXT_UNPACK(ctx, funcs, backend_context);
 
-    new_funcs = find_backend(keybits, mode, 1);
+    new_funcs = get_backend(keybits, mode, 1);
 
     if (new_funcs == NULL)
     {
@@ -241,7 +384,7 @@ int mbedtls_internal_aes_encrypt(mbedtls_aes_context *ctx, const unsigned char i
 {
     mbedtls_aes_funcs* funcs;
     void* backend_context;
-    AES_CONTEXT_UNPACK(ctx, funcs, backend_context);
+    AES_CONTEXT_UNPACK_FOR_OPERATION(ctx, funcs, backend_context);
     if (funcs == NULL)
     {
         return MBEDTLS_ERR_AES_FEATURE_UNAVAILABLE;
@@ -253,7 +396,7 @@ int mbedtls_internal_aes_decrypt(mbedtls_aes_context *ctx, const unsigned char i
 {
     mbedtls_aes_funcs* funcs;
     void* backend_context;
-    AES_CONTEXT_UNPACK(ctx, funcs, backend_context);
+    AES_CONTEXT_UNPACK_FOR_OPERATION(ctx, funcs, backend_context);
     if (funcs == NULL)
     {
         return MBEDTLS_ERR_AES_FEATURE_UNAVAILABLE;
@@ -293,6 +436,50 @@ int mbedtls_aes_crypt_ecb( mbedtls_aes_context *ctx,
         return( mbedtls_internal_aes_decrypt( ctx, input, output ) );
 }
 
+/*
+ * AES-ECB encryption/decryption of multiple independent blocks
+ */
+int mbedtls_aes_crypt_ecb_blocks(mbedtls_aes_context *ctx, int mode, size_t length, const unsigned char *input, unsigned char *output)
+{
+    mbedtls_aes_funcs* funcs;
+    void* backend_context;
+    mbedtls_internal_aes_encrypt_fn crypt_block;
+    int ret;
+    AES_CONTEXT_UNPACK_FOR_OPERATION(ctx, funcs, backend_context);
+    if (funcs == NULL)
+    {
+        return MBEDTLS_ERR_AES_FEATURE_UNAVAILABLE;
+    }
+
+    if ((length % 16) != 0)
+    {
+        return MBEDTLS_ERR_AES_INVALID_INPUT_LENGTH;
+    }
+
+    if (funcs->crypt_ecb_blocks != NULL)
+    {
+        return BACKEND_TRACE(BACKEND_TRACE_AES_ECB, funcs, length, funcs->crypt_ecb_blocks(backend_context, mode, length, input, output));
+    }
+
+    /* The encrypt and decrypt function pointers share the same signature. */
+    crypt_block = (mode == MBEDTLS_AES_ENCRYPT) ? funcs->internal_encrypt : funcs->internal_decrypt;
+
+    while (length > 0)
+    {
+        ret = crypt_block(backend_context, input, output);
+        if (ret != 0)
+        {
+            return ret;
+        }
+
+        input += 16;
+        output += 16;
+        length -= 16;
+    }
+
+    return 0;
+}
+
 #if defined(CONFIG_GLUE_MBEDTLS_CIPHER_MODE_CBC)
 /*
  * AES-CBC buffer encryption/decryption
@@ -306,12 +493,12 @@ int mbedtls_aes_crypt_cbc( mbedtls_aes_context *ctx,
 {
     mbedtls_aes_funcs* funcs;
     void* backend_context;
-    AES_CONTEXT_UNPACK(ctx, funcs, backend_context); // TODO: replate UNPACK by static inline
+    AES_CONTEXT_UNPACK_FOR_OPERATION(ctx, funcs, backend_context); // TODO: replate UNPACK by static inline
     if (funcs == NULL)
     {
         return MBEDTLS_ERR_AES_FEATURE_UNAVAILABLE;
     }
-    return funcs->crypt_cbc(backend_context, mode, length, iv, input, output);
+    return BACKEND_TRACE(BACKEND_TRACE_AES_CBC, funcs, length, funcs->crypt_cbc(backend_context, mode, length, iv, input, output));
 }
 
 #endif
@@ -327,7 +514,7 @@ int mbedtls_aes_crypt_xts(mbedtls_aes_xts_context *ctx, int mode, size_t length,
     {
         return MBEDTLS_ERR_AES_FEATURE_UNAVAILABLE;
     }
-    return funcs->crypt_xts(backend_context, mode, length, data_unit, input, output);
+    return BACKEND_TRACE(BACKEND_TRACE_AES_XTS, funcs, length, funcs->crypt_xts(backend_context, mode, length, data_unit, input, output));
 }
 
 #endif
@@ -338,24 +525,24 @@ int mbedtls_aes_crypt_cfb128(mbedtls_aes_context *ctx, int mode, size_t length,
 {
     mbedtls_aes_funcs* funcs;
     void* backend_context;
-    AES_CONTEXT_UNPACK(ctx, funcs, backend_context);
+    AES_CONTEXT_UNPACK_FOR_OPERATION(ctx, funcs, backend_context);
     if (funcs == NULL)
     {
         return MBEDTLS_ERR_AES_FEATURE_UNAVAILABLE;
     }
-    return funcs->crypt_cfb128(backend_context, mode, length, iv_off, iv, input, output);
+    return BACKEND_TRACE(BACKEND_TRACE_AES_CFB, funcs, length, funcs->crypt_cfb128(backend_context, mode, length, iv_off, iv, input, output));
 }
 
 int mbedtls_aes_crypt_cfb8(mbedtls_aes_context *ctx, int mode, size_t length, unsigned char iv[16], const unsigned char *input, unsigned char *output)
 {
     mbedtls_aes_funcs* funcs;
     void* backend_context;
-    AES_CONTEXT_UNPACK(ctx, funcs, backend_context);
+    AES_CONTEXT_UNPACK_FOR_OPERATION(ctx, funcs, backend_context);
     if (funcs == NULL)
     {
         return MBEDTLS_ERR_AES_FEATURE_UNAVAILABLE;
     }
-    return funcs->crypt_cfb8(backend_context, mode, length, iv, input, output);
+    return BACKEND_TRACE(BACKEND_TRACE_AES_CFB, funcs, length, funcs->crypt_cfb8(backend_context, mode, length, iv, input, output));
 }
 
 #endif
@@ -366,12 +553,12 @@ int mbedtls_aes_crypt_ofb(mbedtls_aes_context *ctx, size_t length, size_t *iv_of
 {
     mbedtls_aes_funcs* funcs;
     void* backend_context;
-    AES_CONTEXT_UNPACK(ctx, funcs, backend_context);
+    AES_CONTEXT_UNPACK_FOR_OPERATION(ctx, funcs, backend_context);
     if (funcs == NULL)
     {
         return MBEDTLS_ERR_AES_FEATURE_UNAVAILABLE;
     }
-    return funcs->crypt_ofb(backend_context, length, iv_off, iv, input, output);
+    return BACKEND_TRACE(BACKEND_TRACE_AES_OFB, funcs, length, funcs->crypt_ofb(backend_context, length, iv_off, iv, input, output));
 }
 
 #endif
@@ -382,12 +569,12 @@ int mbedtls_aes_crypt_ctr(mbedtls_aes_context *ctx, size_t length, size_t *nc_of
 {
     mbedtls_aes_funcs* funcs;
     void* backend_context;
-    AES_CONTEXT_UNPACK(ctx, funcs, backend_context);
+    AES_CONTEXT_UNPACK_FOR_OPERATION(ctx, funcs, backend_context);
     if (funcs == NULL)
     {
         return MBEDTLS_ERR_AES_FEATURE_UNAVAILABLE;
     }
-    return funcs->crypt_ctr(backend_context, length, nc_off, nonce_counter, stream_block, input, output);
+    return BACKEND_TRACE(BACKEND_TRACE_AES_CTR, funcs, length, funcs->crypt_ctr(backend_context, length, nc_off, nonce_counter, stream_block, input, output));
 }
 
 #endif
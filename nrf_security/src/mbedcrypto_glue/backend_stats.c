@@ -0,0 +1,387 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <zephyr.h>
+#include <kernel.h>
+
+#include "backend_trace.h"
+#include "mbedcrypto_glue_stats.h"
+
+#if defined(CONFIG_GLUE_MBEDTLS_AES_C)
+#include "backend_aes.h"
+#endif
+#if defined(CONFIG_GLUE_MBEDTLS_CCM_C)
+#include "backend_ccm.h"
+#endif
+#if defined(CONFIG_GLUE_MBEDTLS_CHACHAPOLY_C)
+#include "backend_chachapoly.h"
+#endif
+#if defined(CONFIG_GLUE_MBEDTLS_DHM_C)
+#include "backend_dhm.h"
+#endif
+#if defined(CONFIG_GLUE_MBEDTLS_ECDH_C)
+#include "backend_ecdh.h"
+#endif
+#if defined(CONFIG_GLUE_MBEDTLS_SHA1_C)
+#include "backend_sha1.h"
+#endif
+#if defined(CONFIG_GLUE_MBEDTLS_SHA256_C)
+#include "backend_sha256.h"
+#endif
+
+/*
+ * AES and AES CCM have up to three backends (cc310, nrf_oberon and mbed TLS),
+ * which can all be used in one run. Calls on a further backend are not counted.
+ */
+#define BACKEND_STATS_SLOTS     (3)
+
+/**@brief Counters of one operation on one backend. */
+typedef struct
+{
+    atomic_t    backend;                                    //!< Function table of the backend, 0 if the slot is free.
+    atomic_t    bytes;                                      //!< Bytes processed.
+    atomic_t    count;                                      //!< Number of calls.
+    atomic_t    hist[MBEDCRYPTO_GLUE_STATS_HIST_BUCKETS];   //!< Calls per duration bucket.
+} backend_stats_slot_t;
+
+static backend_stats_slot_t backend_stats[BACKEND_TRACE_COUNT][BACKEND_STATS_SLOTS];
+
+static atomic_t backend_stats_wait_count;
+static atomic_t backend_stats_wait_hist[MBEDCRYPTO_GLUE_STATS_HIST_BUCKETS];
+
+static const char * const backend_stats_op_names[] = {
+    [BACKEND_TRACE_AES_ECB]             = "aes_ecb",
+    [BACKEND_TRACE_AES_CBC]             = "aes_cbc",
+    [BACKEND_TRACE_AES_XTS]             = "aes_xts",
+    [BACKEND_TRACE_AES_CFB]             = "aes_cfb",
+    [BACKEND_TRACE_AES_OFB]             = "aes_ofb",
+    [BACKEND_TRACE_AES_CTR]             = "aes_ctr",
+    [BACKEND_TRACE_CCM_ENCRYPT]         = "ccm_encrypt",
+    [BACKEND_TRACE_CCM_DECRYPT]         = "ccm_decrypt",
+    [BACKEND_TRACE_CHACHAPOLY_UPDATE]   = "chachapoly_update",
+    [BACKEND_TRACE_CHACHAPOLY_ENCRYPT]  = "chachapoly_encrypt",
+    [BACKEND_TRACE_CHACHAPOLY_DECRYPT]  = "chachapoly_decrypt",
+    [BACKEND_TRACE_CMAC_UPDATE]         = "cmac_update",
+    [BACKEND_TRACE_CMAC]                = "cmac",
+    [BACKEND_TRACE_SHA1_UPDATE]         = "sha1_update",
+    [BACKEND_TRACE_SHA256_UPDATE]       = "sha256_update",
+    [BACKEND_TRACE_DHM_MAKE_PUBLIC]     = "dhm_make_public",
+    [BACKEND_TRACE_DHM_CALC_SECRET]     = "dhm_calc_secret",
+    [BACKEND_TRACE_ECDH_GEN_PUBLIC]     = "ecdh_gen_public",
+    [BACKEND_TRACE_ECDH_COMPUTE_SHARED] = "ecdh_compute_shared",
+    [BACKEND_TRACE_ECDSA_SIGN]          = "ecdsa_sign",
+    [BACKEND_TRACE_ECDSA_VERIFY]        = "ecdsa_verify",
+    [BACKEND_TRACE_ECDSA_GENKEY]        = "ecdsa_genkey",
+};
+
+#if defined(CONFIG_GLUE_MBEDTLS_AES_C) && defined(CONFIG_CC310_MBEDTLS_AES_C)
+extern const mbedtls_aes_funcs mbedtls_aes_cc310_backend_funcs;
+#endif
+#if defined(CONFIG_GLUE_MBEDTLS_AES_OBERON)
+extern const mbedtls_aes_funcs mbedtls_aes_oberon_backend_funcs;
+#endif
+#if defined(CONFIG_GLUE_MBEDTLS_AES_C) && defined(CONFIG_VANILLA_MBEDTLS_AES_C)
+extern const mbedtls_aes_funcs mbedtls_aes_vanilla_mbedtls_backend_funcs;
+#endif
+#if defined(CONFIG_GLUE_MBEDTLS_CCM_C) && defined(CONFIG_CC310_MBEDTLS_CCM_C)
+extern const mbedtls_ccm_funcs mbedtls_ccm_cc310_backend_funcs;
+#endif
+#if defined(CONFIG_GLUE_MBEDTLS_CCM_C) && defined(CONFIG_VANILLA_MBEDTLS_CCM_C)
+extern const mbedtls_ccm_funcs mbedtls_ccm_vanilla_mbedtls_backend_funcs;
+#endif
+#if defined(CONFIG_GLUE_MBEDTLS_CCM_OBERON)
+extern const mbedtls_ccm_funcs mbedtls_ccm_oberon_backend_funcs;
+#endif
+#if defined(CONFIG_GLUE_MBEDTLS_CHACHAPOLY_C)
+extern const mbedtls_chachapoly_funcs mbedtls_chachapoly_cc310_backend_funcs;
+extern const mbedtls_chachapoly_funcs mbedtls_chachapoly_oberon_backend_funcs;
+#endif
+#if defined(CONFIG_GLUE_MBEDTLS_DHM_C) && defined(CONFIG_CC310_MBEDTLS_DHM_C)
+extern const mbedtls_dhm_funcs mbedtls_dhm_cc310_backend_funcs;
+#endif
+#if defined(CONFIG_GLUE_MBEDTLS_DHM_C) && defined(CONFIG_VANILLA_MBEDTLS_DHM_C)
+extern const mbedtls_dhm_funcs mbedtls_dhm_vanilla_mbedtls_backend_funcs;
+#endif
+#if defined(CONFIG_GLUE_MBEDTLS_ECDH_C)
+extern const mbedtls_ecdh_funcs mbedtls_ecdh_oberon_backend_funcs;
+extern const mbedtls_ecdh_funcs mbedtls_ecdh_vanilla_mbedtls_backend_funcs;
+#endif
+#if defined(CONFIG_GLUE_MBEDTLS_SHA1_C)
+extern const mbedtls_sha1_funcs mbedtls_sha1_cc310_backend_funcs;
+extern const mbedtls_sha1_funcs mbedtls_sha1_oberon_backend_funcs;
+#endif
+#if defined(CONFIG_GLUE_MBEDTLS_SHA256_C)
+extern const mbedtls_sha256_funcs mbedtls_sha256_cc310_backend_funcs;
+extern const mbedtls_sha256_funcs mbedtls_sha256_oberon_backend_funcs;
+#endif
+
+/**@brief Backend name of a function table. */
+typedef struct
+{
+    const void *    funcs;
+    const char *    name;
+} backend_stats_name_t;
+
+static const backend_stats_name_t backend_stats_backend_names[] = {
+#if defined(CONFIG_GLUE_MBEDTLS_AES_C) && defined(CONFIG_CC310_MBEDTLS_AES_C)
+    { &mbedtls_aes_cc310_backend_funcs, "cc310" },
+#endif
+#if defined(CONFIG_GLUE_MBEDTLS_AES_OBERON)
+    { &mbedtls_aes_oberon_backend_funcs, "oberon" },
+#endif
+#if defined(CONFIG_GLUE_MBEDTLS_AES_C) && defined(CONFIG_VANILLA_MBEDTLS_AES_C)
+    { &mbedtls_aes_vanilla_mbedtls_backend_funcs, "vanilla" },
+#endif
+#if defined(CONFIG_GLUE_MBEDTLS_CCM_C) && defined(CONFIG_CC310_MBEDTLS_CCM_C)
+    { &mbedtls_ccm_cc310_backend_funcs, "cc310" },
+#endif
+#if defined(CONFIG_GLUE_MBEDTLS_CCM_C) && defined(CONFIG_VANILLA_MBEDTLS_CCM_C)
+    { &mbedtls_ccm_vanilla_mbedtls_backend_funcs, "vanilla" },
+#endif
+#if defined(CONFIG_GLUE_MBEDTLS_CCM_OBERON)
+    { &mbedtls_ccm_oberon_backend_funcs, "oberon" },
+#endif
+#if defined(CONFIG_GLUE_MBEDTLS_CHACHAPOLY_C)
+    { &mbedtls_chachapoly_cc310_backend_funcs, "cc310" },
+    { &mbedtls_chachapoly_oberon_backend_funcs, "oberon" },
+#endif
+#if defined(CONFIG_GLUE_MBEDTLS_DHM_C) && defined(CONFIG_CC310_MBEDTLS_DHM_C)
+    { &mbedtls_dhm_cc310_backend_funcs, "cc310" },
+#endif
+#if defined(CONFIG_GLUE_MBEDTLS_DHM_C) && defined(CONFIG_VANILLA_MBEDTLS_DHM_C)
+    { &mbedtls_dhm_vanilla_mbedtls_backend_funcs, "vanilla" },
+#endif
+#if defined(CONFIG_GLUE_MBEDTLS_ECDH_C)
+    { &mbedtls_ecdh_oberon_backend_funcs, "oberon" },
+    { &mbedtls_ecdh_vanilla_mbedtls_backend_funcs, "vanilla" },
+#endif
+#if defined(CONFIG_GLUE_MBEDTLS_SHA1_C)
+    { &mbedtls_sha1_cc310_backend_funcs, "cc310" },
+    { &mbedtls_sha1_oberon_backend_funcs, "oberon" },
+#endif
+#if defined(CONFIG_GLUE_MBEDTLS_SHA256_C)
+    { &mbedtls_sha256_cc310_backend_funcs, "cc310" },
+    { &mbedtls_sha256_oberon_backend_funcs, "oberon" },
+#endif
+    { NULL, "unknown" },
+};
+
+static const char * backend_stats_backend_name(const void *funcs)
+{
+    size_t i;
+
+    for (i = 0; backend_stats_backend_names[i].funcs != NULL; i++)
+    {
+        if (backend_stats_backend_names[i].funcs == funcs)
+        {
+            break;
+        }
+    }
+
+    return backend_stats_backend_names[i].name;
+}
+
+static size_t backend_stats_bucket(uint32_t cycles)
+{
+    size_t bucket;
+
+    if (cycles < (1u << MBEDCRYPTO_GLUE_STATS_HIST_LOG2_MIN))
+    {
+        return 0;
+    }
+
+    bucket = 31 - __builtin_clz(cycles) - (MBEDCRYPTO_GLUE_STATS_HIST_LOG2_MIN - 1);
+
+    return bucket < MBEDCRYPTO_GLUE_STATS_HIST_BUCKETS ? bucket : MBEDCRYPTO_GLUE_STATS_HIST_BUCKETS - 1;
+}
+
+uint32_t backend_stats_start(void)
+{
+    return k_cycle_get_32();
+}
+
+void backend_stats_record(uint32_t op, const void *backend, size_t bytes, uint32_t start)
+{
+    uint32_t cycles = k_cycle_get_32() - start;
+    backend_stats_slot_t *slot;
+    size_t i;
+
+    if (op >= BACKEND_TRACE_COUNT)
+    {
+        return;
+    }
+
+    /* Slots are claimed in the order the backends are first used and never released. */
+    for (i = 0; i < BACKEND_STATS_SLOTS; i++)
+    {
+        slot = &backend_stats[op][i];
+        if (atomic_get(&slot->backend) == (atomic_val_t)backend ||
+            atomic_cas(&slot->backend, 0, (atomic_val_t)backend) ||
+            atomic_get(&slot->backend) == (atomic_val_t)backend)
+        {
+            atomic_inc(&slot->count);
+            atomic_add(&slot->bytes, (atomic_val_t)bytes);
+            atomic_inc(&slot->hist[backend_stats_bucket(cycles)]);
+            return;
+        }
+    }
+}
+
+void backend_stats_mutex_wait(uint32_t cycles)
+{
+    atomic_inc(&backend_stats_wait_count);
+    atomic_inc(&backend_stats_wait_hist[backend_stats_bucket(cycles)]);
+}
+
+void mbedcrypto_glue_stats_foreach(mbedcrypto_glue_stats_cb_t cb, void *p_ctx)
+{
+    mbedcrypto_glue_stats_entry_t entry;
+    backend_stats_slot_t *slot;
+    const void *backend;
+    size_t op;
+    size_t i;
+    size_t j;
+
+    BUILD_ASSERT_MSG(ARRAY_SIZE(backend_stats_op_names) == BACKEND_TRACE_COUNT,
+                     "Missing glue operation name");
+
+    for (op = 0; op < BACKEND_TRACE_COUNT; op++)
+    {
+        for (i = 0; i < BACKEND_STATS_SLOTS; i++)
+        {
+            slot = &backend_stats[op][i];
+            backend = (const void *)atomic_get(&slot->backend);
+            if (backend == NULL)
+            {
+                break;
+            }
+
+            entry.op = backend_stats_op_names[op];
+            entry.backend = backend_stats_backend_name(backend);
+            entry.bytes = (uint32_t)atomic_get(&slot->bytes);
+            entry.latency.count = (uint32_t)atomic_get(&slot->count);
+            for (j = 0; j < MBEDCRYPTO_GLUE_STATS_HIST_BUCKETS; j++)
+            {
+                entry.latency.hist[j] = (uint32_t)atomic_get(&slot->hist[j]);
+            }
+
+            cb(&entry, p_ctx);
+        }
+    }
+}
+
+void mbedcrypto_glue_stats_mutex_wait_get(mbedcrypto_glue_stats_hist_t *p_wait)
+{
+    size_t j;
+
+    if (p_wait == NULL)
+    {
+        return;
+    }
+
+    p_wait->count = (uint32_t)atomic_get(&backend_stats_wait_count);
+    for (j = 0; j < MBEDCRYPTO_GLUE_STATS_HIST_BUCKETS; j++)
+    {
+        p_wait->hist[j] = (uint32_t)atomic_get(&backend_stats_wait_hist[j]);
+    }
+}
+
+void mbedcrypto_glue_stats_reset(void)
+{
+    size_t op;
+    size_t i;
+    size_t j;
+
+    /* The backend of a slot is kept, so that concurrent calls keep their slot. */
+    for (op = 0; op < BACKEND_TRACE_COUNT; op++)
+    {
+        for (i = 0; i < BACKEND_STATS_SLOTS; i++)
+        {
+            atomic_clear(&backend_stats[op][i].bytes);
+            atomic_clear(&backend_stats[op][i].count);
+            for (j = 0; j < MBEDCRYPTO_GLUE_STATS_HIST_BUCKETS; j++)
+            {
+                atomic_clear(&backend_stats[op][i].hist[j]);
+            }
+        }
+    }
+
+    atomic_clear(&backend_stats_wait_count);
+    for (j = 0; j < MBEDCRYPTO_GLUE_STATS_HIST_BUCKETS; j++)
+    {
+        atomic_clear(&backend_stats_wait_hist[j]);
+    }
+}
+
+#if defined(CONFIG_GLUE_STATS_SHELL)
+#include <shell/shell.h>
+
+static void glue_stats_print_hist(const struct shell *shell, const mbedcrypto_glue_stats_hist_t *p_hist)
+{
+    size_t j;
+
+    /* Only the buckets that have been hit, as "log2 of the bucket upper bound: calls" */
+    for (j = 0; j < MBEDCRYPTO_GLUE_STATS_HIST_BUCKETS; j++)
+    {
+        if (p_hist->hist[j] != 0)
+        {
+            shell_fprintf(shell, SHELL_NORMAL, " %u:%u",
+                          (unsigned int)(j + MBEDCRYPTO_GLUE_STATS_HIST_LOG2_MIN),
+                          (unsigned int)p_hist->hist[j]);
+        }
+    }
+    shell_fprintf(shell, SHELL_NORMAL, "\n");
+}
+
+static void glue_stats_print_entry(const mbedcrypto_glue_stats_entry_t *p_entry, void *p_ctx)
+{
+    const struct shell *shell = p_ctx;
+
+    shell_fprintf(shell, SHELL_NORMAL, "%-20s %-8s calls %u bytes %u cycles(log2)",
+                  p_entry->op, p_entry->backend,
+                  (unsigned int)p_entry->latency.count, (unsigned int)p_entry->bytes);
+    glue_stats_print_hist(shell, &p_entry->latency);
+}
+
+static int cmd_glue_stats_show(const struct shell *shell, size_t argc, char **argv)
+{
+    mbedcrypto_glue_stats_hist_t wait;
+
+    ARG_UNUSED(argc);
+    ARG_UNUSED(argv);
+
+    mbedcrypto_glue_stats_foreach(glue_stats_print_entry, (void *)shell);
+
+    mbedcrypto_glue_stats_mutex_wait_get(&wait);
+    shell_fprintf(shell, SHELL_NORMAL, "%-20s %-8s waits %u cycles(log2)",
+                  "mutex_contention", "cc310", (unsigned int)wait.count);
+    glue_stats_print_hist(shell, &wait);
+
+    return 0;
+}
+
+static int cmd_glue_stats_reset(const struct shell *shell, size_t argc, char **argv)
+{
+    ARG_UNUSED(shell);
+    ARG_UNUSED(argc);
+    ARG_UNUSED(argv);
+
+    mbedcrypto_glue_stats_reset();
+
+    return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_glue_stats,
+    SHELL_CMD(show, NULL, "Print glue backend statistics", cmd_glue_stats_show),
+    SHELL_CMD(reset, NULL, "Reset glue backend statistics", cmd_glue_stats_reset),
+    SHELL_SUBCMD_SET_END
+);
+
+SHELL_CMD_REGISTER(glue_stats, &sub_glue_stats, "mbedcrypto glue statistics commands", NULL);
+#endif /* CONFIG_GLUE_STATS_SHELL */
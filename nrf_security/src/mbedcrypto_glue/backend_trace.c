@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <zephyr.h>
+#include <init.h>
+
+#include "backend_trace.h"
+
+#if defined(CONFIG_NRF_CC310_PLATFORM_MUTEX_TRACE)
+#include "nrf_cc310_platform_mutex.h"
+#endif
+
+#if defined(CONFIG_GLUE_STATS)
+/* Implemented in backend_stats.c */
+void backend_stats_mutex_wait(uint32_t cycles);
+#endif
+
+#if defined(CONFIG_GLUE_TRACE) && defined(CONFIG_SEGGER_SYSTEMVIEW)
+
+#include <SEGGER_SYSVIEW.h>
+
+/* Event BACKEND_TRACE_COUNT reports the wait time of a contended cc310 mutex. */
+#define BACKEND_TRACE_EVENT_COUNT   (BACKEND_TRACE_COUNT + 1)
+
+static SEGGER_SYSVIEW_MODULE backend_trace_module =
+{
+    .sModule = "M=nrf_security",
+    .NumEvents = BACKEND_TRACE_EVENT_COUNT,
+};
+
+static int backend_trace_init(struct device *dev)
+{
+    ARG_UNUSED(dev);
+
+    SEGGER_SYSVIEW_RegisterModule(&backend_trace_module);
+
+    return 0;
+}
+
+SYS_INIT(backend_trace_init, APPLICATION, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
+
+__weak void backend_trace_begin(uint32_t op, const void *backend, size_t bytes)
+{
+    SEGGER_SYSVIEW_RecordU32x2(backend_trace_module.EventOffset + op,
+                               (uint32_t)backend, (uint32_t)bytes);
+}
+
+__weak void backend_trace_end(uint32_t op, int ret)
+{
+    SEGGER_SYSVIEW_RecordEndCallU32(backend_trace_module.EventOffset + op, (uint32_t)ret);
+}
+
+#elif defined(CONFIG_GLUE_TRACE)
+
+__weak void backend_trace_begin(uint32_t op, const void *backend, size_t bytes)
+{
+    ARG_UNUSED(op);
+    ARG_UNUSED(backend);
+    ARG_UNUSED(bytes);
+}
+
+__weak void backend_trace_end(uint32_t op, int ret)
+{
+    ARG_UNUSED(op);
+    ARG_UNUSED(ret);
+}
+
+#endif /* CONFIG_GLUE_TRACE && CONFIG_SEGGER_SYSTEMVIEW */
+
+#if defined(CONFIG_NRF_CC310_PLATFORM_MUTEX_TRACE)
+__weak void nrf_cc310_platform_mutex_trace_wait(void const * mutex, uint32_t cycles)
+{
+    ARG_UNUSED(mutex);
+
+#if defined(CONFIG_GLUE_TRACE) && defined(CONFIG_SEGGER_SYSTEMVIEW)
+    SEGGER_SYSVIEW_RecordU32x2(backend_trace_module.EventOffset + BACKEND_TRACE_COUNT,
+                               (uint32_t)mutex, cycles);
+#endif
+#if defined(CONFIG_GLUE_STATS)
+    backend_stats_mutex_wait(cycles);
+#endif
+}
+#endif /* CONFIG_NRF_CC310_PLATFORM_MUTEX_TRACE */
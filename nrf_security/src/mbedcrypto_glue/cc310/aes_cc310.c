@@ -16,7 +16,7 @@
 
 static int mbedtls_aes_check(unsigned int keybits, int mode, int xts)
 {
-    return (keybits == 128 && xts == 0) ? 2 : 0;
+    return (keybits == 128 && xts == 0) ? 3 : 0;
 }
 
 const mbedtls_aes_funcs mbedtls_aes_cc310_backend_funcs = {
@@ -39,6 +39,8 @@ const mbedtls_aes_funcs mbedtls_aes_cc310_backend_funcs = {
 #endif
     .internal_encrypt = mbedtls_internal_aes_encrypt,
     .internal_decrypt = mbedtls_internal_aes_decrypt,
+    // nrf_cc310_mbedcrypto has no multi-block ECB and takes the sym mutex in each call, the glue calls internal_encrypt/decrypt per block.
+    .crypt_ecb_blocks = NULL,
 #if defined(CONFIG_CC310_MBEDTLS_CIPHER_MODE_CBC) && defined(CONFIG_GLUE_MBEDTLS_CIPHER_MODE_CBC)
     .crypt_cbc = mbedtls_aes_crypt_cbc,
 #endif
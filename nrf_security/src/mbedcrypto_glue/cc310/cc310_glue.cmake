@@ -15,11 +15,26 @@ if (CONFIG_GLUE_MBEDTLS_CCM_C AND CC310_MBEDTLS_CCM_C)
   nrf_security_debug("cc310 backend glue: CCM")
 endif()
 
+if (CONFIG_GLUE_MBEDTLS_CHACHAPOLY_C AND CC310_MBEDTLS_CHACHAPOLY_C)
+  set(GLUE_CC310_MBEDTLS_CHACHAPOLY_C TRUE)
+  nrf_security_debug("cc310 backend glue: CHACHAPOLY")
+endif()
+
 if (CONFIG_GLUE_MBEDTLS_DHM_C AND CC310_MBEDTLS_DHM_C)
   set(GLUE_CC310_MBEDTLS_DHM_C TRUE)
   nrf_security_debug("cc310 backend glue: DHM")
 endif()
 
+if (CONFIG_GLUE_MBEDTLS_SHA1_C AND CC310_MBEDTLS_SHA1_C)
+  set(GLUE_CC310_MBEDTLS_SHA1_C TRUE)
+  nrf_security_debug("cc310 backend glue: SHA1")
+endif()
+
+if (CONFIG_GLUE_MBEDTLS_SHA256_C AND CC310_MBEDTLS_SHA256_C)
+  set(GLUE_CC310_MBEDTLS_SHA256_C TRUE)
+  nrf_security_debug("cc310 backend glue: SHA256")
+endif()
+
 
 zephyr_library_named(mbedcrypto_glue_cc310)
 
@@ -32,9 +47,18 @@ zephyr_library_sources_ifdef(GLUE_CC310_MBEDTLS_AES_C
 zephyr_library_sources_ifdef(GLUE_CC310_MBEDTLS_CCM_C
   ${CMAKE_CURRENT_LIST_DIR}/ccm_cc310.c
 )
+zephyr_library_sources_ifdef(GLUE_CC310_MBEDTLS_CHACHAPOLY_C
+  ${CMAKE_CURRENT_LIST_DIR}/chachapoly_cc310.c
+)
 zephyr_library_sources_ifdef(GLUE_CC310_MBEDTLS_DHM_C
   ${CMAKE_CURRENT_LIST_DIR}/dhm_cc310.c
 )
+zephyr_library_sources_ifdef(GLUE_CC310_MBEDTLS_SHA1_C
+  ${CMAKE_CURRENT_LIST_DIR}/sha1_cc310.c
+)
+zephyr_library_sources_ifdef(GLUE_CC310_MBEDTLS_SHA256_C
+  ${CMAKE_CURRENT_LIST_DIR}/sha256_cc310.c
+)
 
 zephyr_library_sources(${ZEPHYR_BASE}/misc/empty_file.c)
 
@@ -20,6 +20,14 @@ static int mbedtls_ccm_check(mbedtls_cipher_id_t cipher, unsigned int keybits)
     return (keybits == 128) ? 2 : 0;
 }
 
+#if defined(CONFIG_GLUE_SIZE_AWARE_DISPATCH)
+/* Hardware setup and locking dominate for short inputs. */
+static int mbedtls_ccm_check_length(size_t length)
+{
+    return (length >= CONFIG_GLUE_SIZE_AWARE_DISPATCH_THRESHOLD) ? 2 : 0;
+}
+#endif
+
 const mbedtls_ccm_funcs mbedtls_ccm_cc310_backend_funcs = {
     .backend_context_size = (4 * CC310_MBEDTLS_CCM_CONTEXT_WORDS),
     .check = mbedtls_ccm_check,
@@ -30,6 +38,9 @@ const mbedtls_ccm_funcs mbedtls_ccm_cc310_backend_funcs = {
     .star_encrypt_and_tag = mbedtls_ccm_star_encrypt_and_tag,
     .auth_decrypt = mbedtls_ccm_auth_decrypt,
     .star_auth_decrypt = mbedtls_ccm_star_auth_decrypt,
+#if defined(CONFIG_GLUE_SIZE_AWARE_DISPATCH)
+    .check_length = mbedtls_ccm_check_length,
+#endif
 };
 
 #endif
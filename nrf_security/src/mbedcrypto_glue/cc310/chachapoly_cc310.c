@@ -0,0 +1,35 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+
+#if !defined(MBEDTLS_CONFIG_FILE)
+#include "mbedtls/config.h"
+#else
+#include MBEDTLS_CONFIG_FILE
+#endif
+
+#if defined(CONFIG_GLUE_MBEDTLS_CHACHAPOLY_C)
+
+#include "mbedtls/chachapoly.h"
+#include "backend_chachapoly.h"
+
+/* Hardware setup and locking dominate for short inputs. */
+static int mbedtls_chachapoly_check(size_t length)
+{
+    return (length >= CONFIG_GLUE_MBEDTLS_CHACHAPOLY_CC310_MIN_LENGTH) ? 2 : 0;
+}
+
+/* The nrf_cc310_mbedcrypto library only supports one-shot operations. */
+const mbedtls_chachapoly_funcs mbedtls_chachapoly_cc310_backend_funcs = {
+    .backend_context_size = (4 * CC310_MBEDTLS_CHACHAPOLY_CONTEXT_WORDS),
+    .check = mbedtls_chachapoly_check,
+    .init = mbedtls_chachapoly_init,
+    .free = mbedtls_chachapoly_free,
+    .setkey = mbedtls_chachapoly_setkey,
+    .encrypt_and_tag = mbedtls_chachapoly_encrypt_and_tag,
+    .auth_decrypt = mbedtls_chachapoly_auth_decrypt,
+};
+
+#endif /* CONFIG_GLUE_MBEDTLS_CHACHAPOLY_C */
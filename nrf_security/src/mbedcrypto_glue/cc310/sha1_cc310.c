@@ -0,0 +1,34 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+
+#if !defined(MBEDTLS_CONFIG_FILE)
+#include "mbedtls/config.h"
+#else
+#include MBEDTLS_CONFIG_FILE
+#endif
+
+#if defined(CONFIG_GLUE_MBEDTLS_SHA1_C)
+
+#include "mbedtls/sha1.h"
+#include "backend_sha1.h"
+
+static int mbedtls_sha1_check(void)
+{
+    return 2;
+}
+
+const mbedtls_sha1_funcs mbedtls_sha1_cc310_backend_funcs = {
+    .backend_context_size = (4 * CC310_MBEDTLS_SHA1_CONTEXT_WORDS),
+    .check = mbedtls_sha1_check,
+    .init = mbedtls_sha1_init,
+    .free = mbedtls_sha1_free,
+    .starts = mbedtls_sha1_starts_ret,
+    .update = mbedtls_sha1_update_ret,
+    .finish = mbedtls_sha1_finish_ret,
+    .process = mbedtls_internal_sha1_process,
+};
+
+#endif /* CONFIG_GLUE_MBEDTLS_SHA1_C */
@@ -0,0 +1,34 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+
+#if !defined(MBEDTLS_CONFIG_FILE)
+#include "mbedtls/config.h"
+#else
+#include MBEDTLS_CONFIG_FILE
+#endif
+
+#if defined(CONFIG_GLUE_MBEDTLS_SHA256_C)
+
+#include "mbedtls/sha256.h"
+#include "backend_sha256.h"
+
+static int mbedtls_sha256_check(int is224)
+{
+    return 2;
+}
+
+const mbedtls_sha256_funcs mbedtls_sha256_cc310_backend_funcs = {
+    .backend_context_size = (4 * CC310_MBEDTLS_SHA256_CONTEXT_WORDS),
+    .check = mbedtls_sha256_check,
+    .init = mbedtls_sha256_init,
+    .free = mbedtls_sha256_free,
+    .starts = mbedtls_sha256_starts_ret,
+    .update = mbedtls_sha256_update_ret,
+    .finish = mbedtls_sha256_finish_ret,
+    .process = mbedtls_internal_sha256_process,
+};
+
+#endif /* CONFIG_GLUE_MBEDTLS_SHA256_C */
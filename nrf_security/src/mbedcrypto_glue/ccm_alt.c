@@ -15,7 +15,15 @@
 #include <stddef.h>
 
 #include "mbedtls/ccm.h"
+#include "mbedtls/platform.h"
+#include "mbedtls/platform_util.h"
 #include "backend_ccm.h"
+#include "backend_trace.h"
+#include "backend_cache.h"
+
+#if defined(CONFIG_GLUE_MBEDTLS_CCM_SECONDARY) && defined(CONFIG_GLUE_LOAD_AWARE_DISPATCH)
+#include "nrf_cc310_platform_mutex.h"
+#endif
 
 
 #define CCM_CONTEXT_INIT(ctx) do { ctx->handle = NULL; } while (0)
@@ -32,12 +40,35 @@
     } while (0)
 
 
+#if defined(CONFIG_GLUE_MBEDTLS_CCM_SECONDARY)
+#define CCM_CONTEXT_SECONDARY_ALLOC(ctx, funcs, backend_context, new_funcs) do { ctx->handle_secondary = (void*)new_funcs; funcs = new_funcs; backend_context = &ctx->buffer_secondary; } while (0)
+#define CCM_CONTEXT_SECONDARY_UNPACK(ctx, funcs, backend_context) do { funcs = ctx->handle_secondary; backend_context = &ctx->buffer_secondary; } while (0)
+#define CCM_CONTEXT_SECONDARY_FREE(ctx) do { ctx->handle_secondary = NULL; } while (0)
+
+/* Select the secondary backend if cc310 is busy or it is better suited for the input length. */
+#define CCM_CONTEXT_UNPACK_FOR_LENGTH(ctx, funcs, backend_context, length) do { \
+        CCM_CONTEXT_UNPACK_NOT_NULL(ctx, funcs, backend_context); \
+        if (ctx->handle_secondary != NULL && \
+            ccm_use_secondary(ctx->handle_secondary, funcs, length)) \
+        { \
+            CCM_CONTEXT_SECONDARY_UNPACK(ctx, funcs, backend_context); \
+        } \
+    } while (0)
+#else
+#define CCM_CONTEXT_UNPACK_FOR_LENGTH(ctx, funcs, backend_context, length) \
+        CCM_CONTEXT_UNPACK_NOT_NULL(ctx, funcs, backend_context)
+#endif /* CONFIG_GLUE_MBEDTLS_CCM_SECONDARY */
+
+
 #if defined(CONFIG_CC310_MBEDTLS_CCM_C)
 extern mbedtls_ccm_funcs mbedtls_ccm_cc310_backend_funcs;
 #endif
 #if defined(CONFIG_VANILLA_MBEDTLS_CCM_C)
 extern mbedtls_ccm_funcs mbedtls_ccm_vanilla_mbedtls_backend_funcs;
 #endif
+#if defined(CONFIG_GLUE_MBEDTLS_CCM_OBERON)
+extern mbedtls_ccm_funcs mbedtls_ccm_oberon_backend_funcs;
+#endif
 
 
 static mbedtls_ccm_funcs* ccm_backends[] = {
@@ -47,6 +78,9 @@ static mbedtls_ccm_funcs* ccm_backends[] = {
 #if defined(CONFIG_VANILLA_MBEDTLS_CCM_C)
     &mbedtls_ccm_vanilla_mbedtls_backend_funcs,
 #endif
+#if defined(CONFIG_GLUE_MBEDTLS_CCM_OBERON)
+    &mbedtls_ccm_oberon_backend_funcs,
+#endif
 };
 
 static const mbedtls_ccm_funcs* find_backend(mbedtls_cipher_id_t cipher, unsigned int keybits)
@@ -67,9 +101,131 @@ static const mbedtls_ccm_funcs* find_backend(mbedtls_cipher_id_t cipher, unsigne
     return funcs;
 }
 
+/* Cipher IDs up to and including MBEDTLS_CIPHER_ID_CAMELLIA are cached. */
+#define CCM_BACKEND_CACHE_CIPHERS (MBEDTLS_CIPHER_ID_CAMELLIA + 1)
+#define CCM_BACKEND_CACHE_SIZE (CCM_BACKEND_CACHE_CIPHERS * BACKEND_CACHE_KEYBITS_COUNT)
+
+static const mbedtls_ccm_funcs* ccm_backend_cache[CCM_BACKEND_CACHE_SIZE];
+
+static int ccm_backend_cache_index(mbedtls_cipher_id_t cipher, unsigned int keybits)
+{
+    int keybits_index = backend_cache_keybits_index(keybits);
+
+    if (keybits_index == BACKEND_CACHE_NO_INDEX ||
+        (unsigned int)cipher >= CCM_BACKEND_CACHE_CIPHERS)
+    {
+        return BACKEND_CACHE_NO_INDEX;
+    }
+
+    return (cipher * BACKEND_CACHE_KEYBITS_COUNT) + keybits_index;
+}
+
+static const mbedtls_ccm_funcs* get_backend(mbedtls_cipher_id_t cipher, unsigned int keybits)
+{
+    const mbedtls_ccm_funcs* funcs;
+    BACKEND_CACHE_GET(ccm_backend_cache, ccm_backend_cache_index(cipher, keybits),
+                      funcs, find_backend(cipher, keybits));
+    return funcs;
+}
+
+#if defined(CONFIG_GLUE_MBEDTLS_CCM_SECONDARY)
+#if defined(CONFIG_GLUE_SIZE_AWARE_DISPATCH)
+static int ccm_length_priority(const mbedtls_ccm_funcs* funcs, size_t length)
+{
+    return (funcs->check_length != NULL) ? funcs->check_length(length) : 1;
+}
+#endif
+
+static int ccm_use_secondary(const mbedtls_ccm_funcs* secondary, const mbedtls_ccm_funcs* primary, size_t length)
+{
+#if defined(CONFIG_GLUE_LOAD_AWARE_DISPATCH)
+    if (nrf_cc310_platform_mutex_is_busy(platform_mutexes.sym_mutex))
+    {
+        return 1;
+    }
+#endif
+#if defined(CONFIG_GLUE_SIZE_AWARE_DISPATCH)
+    return ccm_length_priority(secondary, length) > ccm_length_priority(primary, length);
+#else
+    return 0;
+#endif
+}
+
+/*
+ * Find the software backend keyed next to cc310. nrf_oberon is preferred as
+ * it never uses cc310. mbed TLS CCM encrypts each block through the AES glue,
+ * which moves each block off a busy cc310 by itself, so it is only used for
+ * GLUE_LOAD_AWARE_DISPATCH and never selected by length.
+ */
+static const mbedtls_ccm_funcs* find_secondary_backend(mbedtls_cipher_id_t cipher, unsigned int keybits)
+{
+#if defined(CONFIG_GLUE_MBEDTLS_CCM_OBERON)
+    if (mbedtls_ccm_oberon_backend_funcs.check(cipher, keybits) > 0)
+    {
+        return &mbedtls_ccm_oberon_backend_funcs;
+    }
+#endif
+#if defined(CONFIG_GLUE_LOAD_AWARE_DISPATCH) && defined(CONFIG_VANILLA_MBEDTLS_CCM_C)
+    if (mbedtls_ccm_vanilla_mbedtls_backend_funcs.check(cipher, keybits) > 0)
+    {
+        return &mbedtls_ccm_vanilla_mbedtls_backend_funcs;
+    }
+#endif
+    return NULL;
+}
+
+static void ccm_secondary_free(mbedtls_ccm_context *ctx)
+{
+    const mbedtls_ccm_funcs* funcs;
+    void* backend_context;
+    CCM_CONTEXT_SECONDARY_UNPACK(ctx, funcs, backend_context);
+    if (funcs != NULL)
+    {
+        funcs->free(backend_context);
+        CCM_CONTEXT_SECONDARY_FREE(ctx);
+    }
+}
+
+/*
+ * Key the secondary backend as well when the key is on cc310, so that each
+ * operation can be handed to software when cc310 is busy or the input is too
+ * short to be worth the cc310 setup.
+ */
+static void ccm_secondary_setkey(mbedtls_ccm_context *ctx, const mbedtls_ccm_funcs* primary, mbedtls_cipher_id_t cipher, const unsigned char *key, unsigned int keybits)
+{
+    const mbedtls_ccm_funcs* new_funcs;
+    const mbedtls_ccm_funcs* funcs;
+    void* backend_context;
+
+    ccm_secondary_free(ctx);
+
+    if (primary != &mbedtls_ccm_cc310_backend_funcs)
+    {
+        return;
+    }
+
+    new_funcs = find_secondary_backend(cipher, keybits);
+    if (new_funcs == NULL)
+    {
+        return;
+    }
+
+    CCM_CONTEXT_SECONDARY_ALLOC(ctx, funcs, backend_context, new_funcs);
+    funcs->init(backend_context);
+
+    if (funcs->setkey(backend_context, cipher, key, keybits) != 0)
+    {
+        ccm_secondary_free(ctx);
+    }
+}
+#endif /* CONFIG_GLUE_MBEDTLS_CCM_SECONDARY */
+
 void mbedtls_ccm_init(mbedtls_ccm_context *ctx)
 {
     CCM_CONTEXT_INIT(ctx);
+#if defined(CONFIG_GLUE_MBEDTLS_CCM_SECONDARY)
+    CCM_CONTEXT_SECONDARY_FREE(ctx);
+#endif
 }
 
 int mbedtls_ccm_setkey(mbedtls_ccm_context *ctx, mbedtls_cipher_id_t cipher, const unsigned char *key, unsigned int keybits)
@@ -77,36 +233,48 @@ int mbedtls_ccm_setkey(mbedtls_ccm_context *ctx, mbedtls_cipher_id_t cipher, con
     const mbedtls_ccm_funcs* new_funcs;
     const mbedtls_ccm_funcs* funcs;
     void* backend_context;
+    int ret;
     CCM_CONTEXT_UNPACK(ctx, funcs, backend_context);
 
-    new_funcs = find_backend(cipher, keybits);
+    new_funcs = get_backend(cipher, keybits);
 
     if (new_funcs == NULL)
     {
         return MBEDTLS_ERR_CIPHER_FEATURE_UNAVAILABLE;
     }
 
-    if (funcs == new_funcs)
+    if (funcs != new_funcs)
     {
-        return funcs->setkey(backend_context, cipher, key, keybits);
-    }
+        if (funcs != NULL)
+        {
+            funcs->free(backend_context);
+            CCM_CONTEXT_FREE(ctx);
+        }
 
-    if (funcs != NULL)
-    {
-        funcs->free(backend_context);
-        CCM_CONTEXT_FREE(ctx);
+        CCM_CONTEXT_ALLOC(ctx, funcs, backend_context, new_funcs);
+
+        if (funcs == NULL)
+        {
+            return MBEDTLS_ERR_CIPHER_ALLOC_FAILED;
+        }
+
+        funcs->init(backend_context);
     }
 
-    CCM_CONTEXT_ALLOC(ctx, funcs, backend_context, new_funcs);
+    ret = funcs->setkey(backend_context, cipher, key, keybits);
 
-    if (funcs == NULL)
+#if defined(CONFIG_GLUE_MBEDTLS_CCM_SECONDARY)
+    if (ret == 0)
+    {
+        ccm_secondary_setkey(ctx, funcs, cipher, key, keybits);
+    }
+    else
     {
-        return MBEDTLS_ERR_CIPHER_ALLOC_FAILED;
+        ccm_secondary_free(ctx);
     }
+#endif
 
-    funcs->init(backend_context);
-    
-    return funcs->setkey(backend_context, cipher, key, keybits);
+    return ret;
 }
 
 void mbedtls_ccm_free(mbedtls_ccm_context *ctx)
@@ -119,6 +287,9 @@ void mbedtls_ccm_free(mbedtls_ccm_context *ctx)
         funcs->free(backend_context);
         CCM_CONTEXT_FREE(ctx);
     }
+#if defined(CONFIG_GLUE_MBEDTLS_CCM_SECONDARY)
+    ccm_secondary_free(ctx);
+#endif
     memset(ctx, 0, sizeof(mbedtls_ccm_context));
 }
 
@@ -126,32 +297,624 @@ int mbedtls_ccm_encrypt_and_tag(mbedtls_ccm_context *ctx, size_t length, const u
 {
     mbedtls_ccm_funcs* funcs;
     void* backend_context;
-    CCM_CONTEXT_UNPACK_NOT_NULL(ctx, funcs, backend_context);
-    return funcs->encrypt_and_tag(backend_context, length, iv, iv_len, add, add_len, input, output, tag, tag_len);
+    CCM_CONTEXT_UNPACK_FOR_LENGTH(ctx, funcs, backend_context, length);
+    return BACKEND_TRACE(BACKEND_TRACE_CCM_ENCRYPT, funcs, length, funcs->encrypt_and_tag(backend_context, length, iv, iv_len, add, add_len, input, output, tag, tag_len));
 }
 
 int mbedtls_ccm_star_encrypt_and_tag(mbedtls_ccm_context *ctx, size_t length, const unsigned char *iv, size_t iv_len, const unsigned char *add, size_t add_len, const unsigned char *input, unsigned char *output, unsigned char *tag, size_t tag_len)
 {
     mbedtls_ccm_funcs* funcs;
     void* backend_context;
-    CCM_CONTEXT_UNPACK_NOT_NULL(ctx, funcs, backend_context);
-    return funcs->star_encrypt_and_tag(backend_context, length, iv, iv_len, add, add_len, input, output, tag, tag_len);
+    CCM_CONTEXT_UNPACK_FOR_LENGTH(ctx, funcs, backend_context, length);
+    return BACKEND_TRACE(BACKEND_TRACE_CCM_ENCRYPT, funcs, length, funcs->star_encrypt_and_tag(backend_context, length, iv, iv_len, add, add_len, input, output, tag, tag_len));
 }
 
 int mbedtls_ccm_auth_decrypt(mbedtls_ccm_context *ctx, size_t length, const unsigned char *iv, size_t iv_len, const unsigned char *add, size_t add_len, const unsigned char *input, unsigned char *output, const unsigned char *tag, size_t tag_len)
 {
     mbedtls_ccm_funcs* funcs;
     void* backend_context;
-    CCM_CONTEXT_UNPACK_NOT_NULL(ctx, funcs, backend_context);
-    return funcs->auth_decrypt(backend_context, length, iv, iv_len, add, add_len, input, output, tag, tag_len);
+    CCM_CONTEXT_UNPACK_FOR_LENGTH(ctx, funcs, backend_context, length);
+    return BACKEND_TRACE(BACKEND_TRACE_CCM_DECRYPT, funcs, length, funcs->auth_decrypt(backend_context, length, iv, iv_len, add, add_len, input, output, tag, tag_len));
 }
 
 int mbedtls_ccm_star_auth_decrypt(mbedtls_ccm_context *ctx, size_t length, const unsigned char *iv, size_t iv_len, const unsigned char *add, size_t add_len, const unsigned char *input, unsigned char *output, const unsigned char *tag, size_t tag_len)
 {
     mbedtls_ccm_funcs* funcs;
     void* backend_context;
-    CCM_CONTEXT_UNPACK_NOT_NULL(ctx, funcs, backend_context);
-    return funcs->star_auth_decrypt(backend_context, length, iv, iv_len, add, add_len, input, output, tag, tag_len);
+    CCM_CONTEXT_UNPACK_FOR_LENGTH(ctx, funcs, backend_context, length);
+    return BACKEND_TRACE(BACKEND_TRACE_CCM_DECRYPT, funcs, length, funcs->star_auth_decrypt(backend_context, length, iv, iv_len, add, add_len, input, output, tag, tag_len));
+}
+
+static size_t iov_total_len(const mbedtls_ccm_iovec *iov, size_t count)
+{
+    size_t total = 0;
+    size_t i;
+    for (i = 0; i < count; i++)
+    {
+        total += iov[i].len;
+    }
+    return total;
+}
+
+static void iov_gather(unsigned char *dst, const mbedtls_ccm_iovec *iov, size_t count)
+{
+    size_t i;
+    for (i = 0; i < count; i++)
+    {
+        memcpy(dst, iov[i].base, iov[i].len);
+        dst += iov[i].len;
+    }
+}
+
+static void iov_scatter(const mbedtls_ccm_iovec *iov, size_t count, const unsigned char *src)
+{
+    size_t i;
+    for (i = 0; i < count; i++)
+    {
+        memcpy(iov[i].base, src, iov[i].len);
+        src += iov[i].len;
+    }
+}
+
+static void iov_zeroize(const mbedtls_ccm_iovec *iov, size_t count)
+{
+    size_t i;
+    for (i = 0; i < count; i++)
+    {
+        mbedtls_platform_zeroize(iov[i].base, iov[i].len);
+    }
+}
+
+/*
+ * Fallback for backends without native scatter-gather support. Contiguous
+ * buffers are passed through as is, fragmented buffers are gathered into a
+ * temporary buffer, on the stack if they fit.
+ */
+static int ccm_crypt_iov_linear(const mbedtls_ccm_funcs* funcs, void* backend_context, int decrypt, int star,
+                                const unsigned char *iv, size_t iv_len,
+                                const mbedtls_ccm_iovec *add, size_t add_count,
+                                const mbedtls_ccm_iovec *input, size_t input_count,
+                                const mbedtls_ccm_iovec *output, size_t output_count,
+                                unsigned char *tag, size_t tag_len)
+{
+    size_t add_len = iov_total_len(add, add_count);
+    size_t length = iov_total_len(input, input_count);
+    const unsigned char *add_buf = (add_count > 0) ? add[0].base : NULL;
+    const unsigned char *in_buf = (input_count > 0) ? input[0].base : NULL;
+    unsigned char *out_buf = (output_count > 0) ? output[0].base : NULL;
+    unsigned char stack_buf[CONFIG_GLUE_MBEDTLS_CCM_IOV_BUFFER_SIZE];
+    unsigned char *tmp = NULL;
+    int ret;
+
+    if (length != iov_total_len(output, output_count))
+    {
+        return MBEDTLS_ERR_CCM_BAD_INPUT;
+    }
+
+    if (add_count > 1 || input_count > 1 || output_count > 1)
+    {
+        if (add_len + length <= sizeof(stack_buf))
+        {
+            tmp = stack_buf;
+        }
+        else
+        {
+#if defined(CONFIG_GLUE_MBEDTLS_CCM_IOV_HEAP)
+            tmp = mbedtls_calloc(1, add_len + length);
+            if (tmp == NULL)
+            {
+                return MBEDTLS_ERR_CIPHER_ALLOC_FAILED;
+            }
+#else
+            return MBEDTLS_ERR_CCM_BAD_INPUT;
+#endif
+        }
+        iov_gather(tmp, add, add_count);
+        iov_gather(tmp + add_len, input, input_count);
+        add_buf = tmp;
+        in_buf = tmp + add_len;
+        out_buf = tmp + add_len;
+    }
+
+    if (decrypt)
+    {
+        ret = star ? funcs->star_auth_decrypt(backend_context, length, iv, iv_len, add_buf, add_len, in_buf, out_buf, tag, tag_len)
+                   : funcs->auth_decrypt(backend_context, length, iv, iv_len, add_buf, add_len, in_buf, out_buf, tag, tag_len);
+    }
+    else
+    {
+        ret = star ? funcs->star_encrypt_and_tag(backend_context, length, iv, iv_len, add_buf, add_len, in_buf, out_buf, tag, tag_len)
+                   : funcs->encrypt_and_tag(backend_context, length, iv, iv_len, add_buf, add_len, in_buf, out_buf, tag, tag_len);
+    }
+
+    if (tmp != NULL)
+    {
+        if (ret == 0)
+        {
+            iov_scatter(output, output_count, tmp + add_len);
+        }
+        else
+        {
+            /* As the backend does for contiguous buffers, clear the output. */
+            iov_zeroize(output, output_count);
+        }
+        mbedtls_platform_zeroize(tmp, add_len + length);
+        if (tmp != stack_buf)
+        {
+            mbedtls_free(tmp);
+        }
+    }
+
+    return ret;
+}
+
+int mbedtls_ccm_encrypt_and_tag_iov(mbedtls_ccm_context *ctx, const unsigned char *iv, size_t iv_len, const mbedtls_ccm_iovec *add, size_t add_count, const mbedtls_ccm_iovec *input, size_t input_count, const mbedtls_ccm_iovec *output, size_t output_count, unsigned char *tag, size_t tag_len)
+{
+    mbedtls_ccm_funcs* funcs;
+    void* backend_context;
+    CCM_CONTEXT_UNPACK_FOR_LENGTH(ctx, funcs, backend_context, iov_total_len(input, input_count));
+    if (funcs->encrypt_and_tag_iov != NULL)
+    {
+        return BACKEND_TRACE(BACKEND_TRACE_CCM_ENCRYPT, funcs, iov_total_len(input, input_count), funcs->encrypt_and_tag_iov(backend_context, 0, iv, iv_len, add, add_count, input, input_count, output, output_count, tag, tag_len));
+    }
+    return BACKEND_TRACE(BACKEND_TRACE_CCM_ENCRYPT, funcs, iov_total_len(input, input_count), ccm_crypt_iov_linear(funcs, backend_context, 0, 0, iv, iv_len, add, add_count, input, input_count, output, output_count, tag, tag_len));
+}
+
+int mbedtls_ccm_star_encrypt_and_tag_iov(mbedtls_ccm_context *ctx, const unsigned char *iv, size_t iv_len, const mbedtls_ccm_iovec *add, size_t add_count, const mbedtls_ccm_iovec *input, size_t input_count, const mbedtls_ccm_iovec *output, size_t output_count, unsigned char *tag, size_t tag_len)
+{
+    mbedtls_ccm_funcs* funcs;
+    void* backend_context;
+    CCM_CONTEXT_UNPACK_FOR_LENGTH(ctx, funcs, backend_context, iov_total_len(input, input_count));
+    if (funcs->encrypt_and_tag_iov != NULL)
+    {
+        return BACKEND_TRACE(BACKEND_TRACE_CCM_ENCRYPT, funcs, iov_total_len(input, input_count), funcs->encrypt_and_tag_iov(backend_context, 1, iv, iv_len, add, add_count, input, input_count, output, output_count, tag, tag_len));
+    }
+    return BACKEND_TRACE(BACKEND_TRACE_CCM_ENCRYPT, funcs, iov_total_len(input, input_count), ccm_crypt_iov_linear(funcs, backend_context, 0, 1, iv, iv_len, add, add_count, input, input_count, output, output_count, tag, tag_len));
+}
+
+int mbedtls_ccm_auth_decrypt_iov(mbedtls_ccm_context *ctx, const unsigned char *iv, size_t iv_len, const mbedtls_ccm_iovec *add, size_t add_count, const mbedtls_ccm_iovec *input, size_t input_count, const mbedtls_ccm_iovec *output, size_t output_count, const unsigned char *tag, size_t tag_len)
+{
+    mbedtls_ccm_funcs* funcs;
+    void* backend_context;
+    CCM_CONTEXT_UNPACK_FOR_LENGTH(ctx, funcs, backend_context, iov_total_len(input, input_count));
+    if (funcs->auth_decrypt_iov != NULL)
+    {
+        return BACKEND_TRACE(BACKEND_TRACE_CCM_DECRYPT, funcs, iov_total_len(input, input_count), funcs->auth_decrypt_iov(backend_context, 0, iv, iv_len, add, add_count, input, input_count, output, output_count, tag, tag_len));
+    }
+    return BACKEND_TRACE(BACKEND_TRACE_CCM_DECRYPT, funcs, iov_total_len(input, input_count), ccm_crypt_iov_linear(funcs, backend_context, 1, 0, iv, iv_len, add, add_count, input, input_count, output, output_count, (unsigned char *)tag, tag_len));
+}
+
+int mbedtls_ccm_star_auth_decrypt_iov(mbedtls_ccm_context *ctx, const unsigned char *iv, size_t iv_len, const mbedtls_ccm_iovec *add, size_t add_count, const mbedtls_ccm_iovec *input, size_t input_count, const mbedtls_ccm_iovec *output, size_t output_count, const unsigned char *tag, size_t tag_len)
+{
+    mbedtls_ccm_funcs* funcs;
+    void* backend_context;
+    CCM_CONTEXT_UNPACK_FOR_LENGTH(ctx, funcs, backend_context, iov_total_len(input, input_count));
+    if (funcs->auth_decrypt_iov != NULL)
+    {
+        return BACKEND_TRACE(BACKEND_TRACE_CCM_DECRYPT, funcs, iov_total_len(input, input_count), funcs->auth_decrypt_iov(backend_context, 1, iv, iv_len, add, add_count, input, input_count, output, output_count, tag, tag_len));
+    }
+    return BACKEND_TRACE(BACKEND_TRACE_CCM_DECRYPT, funcs, iov_total_len(input, input_count), ccm_crypt_iov_linear(funcs, backend_context, 1, 1, iv, iv_len, add, add_count, input, input_count, output, output_count, (unsigned char *)tag, tag_len));
+}
+
+
+/*
+ * Streaming AES CCM.
+ *
+ * The backends only offer one-shot operations, so the streaming operations
+ * are built from the AES block cipher. The CBC-MAC is kept in y and the
+ * payload is encrypted with the counter blocks following the one used for
+ * the tag. Only the counters and one partial block are stored, so any
+ * message length is handled in constant memory.
+ */
+
+#define CCM_STREAM_STATE_IDLE       0
+#define CCM_STREAM_STATE_AD         1
+#define CCM_STREAM_STATE_PAYLOAD    2
+
+/* Number of counter blocks encrypted in one call to the AES backend. */
+#define CCM_STREAM_CTR_BLOCKS       4
+
+static int ccm_stream_encrypt_block(mbedtls_ccm_stream_context *ctx, const unsigned char input[16], unsigned char output[16])
+{
+    return mbedtls_aes_crypt_ecb(&ctx->aes, MBEDTLS_AES_ENCRYPT, input, output);
+}
+
+static void ccm_stream_ctr_increment(unsigned char ctr[16])
+{
+    size_t i;
+
+    /* The counter is the lower q bytes, q being encoded in the flags byte. */
+    for (i = 15; i > 15 - ((ctr[0] & 0x07) + 1); i--)
+    {
+        if (++ctr[i] != 0)
+        {
+            break;
+        }
+    }
+}
+
+static int ccm_stream_mac_block(mbedtls_ccm_stream_context *ctx, const unsigned char block[16])
+{
+    size_t i;
+
+    for (i = 0; i < 16; i++)
+    {
+        ctx->y[i] ^= block[i];
+    }
+    return ccm_stream_encrypt_block(ctx, ctx->y, ctx->y);
+}
+
+static int ccm_stream_mac(mbedtls_ccm_stream_context *ctx, const unsigned char *data, size_t len)
+{
+    size_t use;
+    int ret;
+
+    while (len > 0)
+    {
+        if (ctx->mac_len == 0 && len >= 16)
+        {
+            ret = ccm_stream_mac_block(ctx, data);
+            if (ret != 0)
+            {
+                return ret;
+            }
+            data += 16;
+            len -= 16;
+            continue;
+        }
+
+        use = 16 - ctx->mac_len;
+        if (use > len)
+        {
+            use = len;
+        }
+        memcpy(ctx->mac_buf + ctx->mac_len, data, use);
+        ctx->mac_len += use;
+        data += use;
+        len -= use;
+
+        if (ctx->mac_len == 16)
+        {
+            ret = ccm_stream_mac_block(ctx, ctx->mac_buf);
+            ctx->mac_len = 0;
+            if (ret != 0)
+            {
+                return ret;
+            }
+        }
+    }
+
+    return 0;
+}
+
+/* Zero-pad and authenticate the partial block, if any. */
+static int ccm_stream_mac_pad(mbedtls_ccm_stream_context *ctx)
+{
+    int ret;
+
+    if (ctx->mac_len == 0)
+    {
+        return 0;
+    }
+
+    memset(ctx->mac_buf + ctx->mac_len, 0, 16 - ctx->mac_len);
+    ret = ccm_stream_mac_block(ctx, ctx->mac_buf);
+    ctx->mac_len = 0;
+    return ret;
+}
+
+static int ccm_stream_ctr(mbedtls_ccm_stream_context *ctx, const unsigned char *input, size_t len, unsigned char *output)
+{
+#if defined(CONFIG_GLUE_MBEDTLS_AES_C)
+    unsigned char blocks[16 * CCM_STREAM_CTR_BLOCKS];
+    size_t count;
+    size_t i;
+#endif /* CONFIG_GLUE_MBEDTLS_AES_C */
+    int ret;
+
+    while (len > 0)
+    {
+        if (ctx->ks_off < 16)
+        {
+            *output++ = *input++ ^ ctx->ks[ctx->ks_off++];
+            len--;
+            continue;
+        }
+
+#if defined(CONFIG_GLUE_MBEDTLS_AES_C)
+        /* Encrypt several whole counter blocks in one backend call. */
+        count = len / 16;
+        if (count > CCM_STREAM_CTR_BLOCKS)
+        {
+            count = CCM_STREAM_CTR_BLOCKS;
+        }
+        if (count > 1)
+        {
+            for (i = 0; i < count; i++)
+            {
+                memcpy(blocks + 16 * i, ctx->ctr, 16);
+                ccm_stream_ctr_increment(ctx->ctr);
+            }
+            ret = mbedtls_aes_crypt_ecb_blocks(&ctx->aes, MBEDTLS_AES_ENCRYPT, 16 * count, blocks, blocks);
+            if (ret != 0)
+            {
+                mbedtls_platform_zeroize(blocks, sizeof(blocks));
+                return ret;
+            }
+            for (i = 0; i < 16 * count; i++)
+            {
+                output[i] = input[i] ^ blocks[i];
+            }
+            mbedtls_platform_zeroize(blocks, sizeof(blocks));
+            input += 16 * count;
+            output += 16 * count;
+            len -= 16 * count;
+            continue;
+        }
+#endif /* CONFIG_GLUE_MBEDTLS_AES_C */
+
+        ret = ccm_stream_encrypt_block(ctx, ctx->ctr, ctx->ks);
+        if (ret != 0)
+        {
+            return ret;
+        }
+        ccm_stream_ctr_increment(ctx->ctr);
+        ctx->ks_off = 0;
+    }
+
+    return 0;
+}
+
+void mbedtls_ccm_stream_init(mbedtls_ccm_stream_context *ctx)
+{
+    memset(ctx, 0, sizeof(*ctx));
+    mbedtls_aes_init(&ctx->aes);
+}
+
+int mbedtls_ccm_stream_setkey(mbedtls_ccm_stream_context *ctx, const unsigned char *key, unsigned int keybits)
+{
+    ctx->state = CCM_STREAM_STATE_IDLE;
+    return mbedtls_aes_setkey_enc(&ctx->aes, key, keybits);
+}
+
+void mbedtls_ccm_stream_free(mbedtls_ccm_stream_context *ctx)
+{
+    if (ctx == NULL)
+    {
+        return;
+    }
+
+    mbedtls_aes_free(&ctx->aes);
+    mbedtls_platform_zeroize(ctx, sizeof(*ctx));
+}
+
+int mbedtls_ccm_stream_starts(mbedtls_ccm_stream_context *ctx, int mode,
+                              const unsigned char *iv, size_t iv_len,
+                              size_t ad_len, size_t length, size_t tag_len)
+{
+    unsigned char b[16];
+    unsigned char q;
+    size_t i;
+    size_t len_left;
+    int star;
+    int ret;
+
+    if (mode < MBEDTLS_CCM_ENCRYPT || mode > MBEDTLS_CCM_STAR_DECRYPT)
+    {
+        return MBEDTLS_ERR_CCM_BAD_INPUT;
+    }
+    star = (mode == MBEDTLS_CCM_STAR_ENCRYPT || mode == MBEDTLS_CCM_STAR_DECRYPT);
+
+    /* Same restrictions as the one-shot operations. */
+    if (tag_len == 2 || tag_len > 16 || tag_len % 2 != 0 || (!star && tag_len < 4))
+    {
+        return MBEDTLS_ERR_CCM_BAD_INPUT;
+    }
+
+    if (iv_len < 7 || iv_len > 13)
+    {
+        return MBEDTLS_ERR_CCM_BAD_INPUT;
+    }
+
+    if (ad_len >= 0xFF00)
+    {
+        return MBEDTLS_ERR_CCM_BAD_INPUT;
+    }
+
+    q = 16 - 1 - (unsigned char)iv_len;
+    if (q < sizeof(length) && length >= ((size_t)1 << (q * 8)))
+    {
+        return MBEDTLS_ERR_CCM_BAD_INPUT;
+    }
+
+    /* First block B_0: flags, nonce and payload length. */
+    b[0] = 0;
+    b[0] |= (ad_len > 0) << 6;
+    b[0] |= ((tag_len > 0 ? tag_len : 2) - 2) / 2 << 3;
+    b[0] |= q - 1;
+    memcpy(b + 1, iv, iv_len);
+    for (i = 0, len_left = length; i < q; i++, len_left >>= 8)
+    {
+        b[15 - i] = (unsigned char)(len_left & 0xFF);
+    }
+
+    memset(ctx->y, 0, 16);
+    ctx->mac_len = 0;
+    ret = ccm_stream_mac_block(ctx, b);
+    if (ret != 0)
+    {
+        goto exit;
+    }
+
+    /* Counter block A_0 encrypts the tag, the payload starts at A_1. */
+    ctx->ctr[0] = q - 1;
+    memcpy(ctx->ctr + 1, iv, iv_len);
+    memset(ctx->ctr + 1 + iv_len, 0, q);
+    ret = ccm_stream_encrypt_block(ctx, ctx->ctr, ctx->s0);
+    if (ret != 0)
+    {
+        goto exit;
+    }
+    ctx->ctr[15] = 1;
+    ctx->ks_off = 16;
+
+    /* The associated data is prefixed with its 2-byte length. */
+    if (ad_len > 0)
+    {
+        b[0] = (unsigned char)((ad_len >> 8) & 0xFF);
+        b[1] = (unsigned char)(ad_len & 0xFF);
+        ret = ccm_stream_mac(ctx, b, 2);
+        if (ret != 0)
+        {
+            goto exit;
+        }
+    }
+
+    ctx->ad_left = ad_len;
+    ctx->length_left = length;
+    ctx->tag_len = tag_len;
+    ctx->mode = mode;
+    ctx->state = CCM_STREAM_STATE_AD;
+
+exit:
+    mbedtls_platform_zeroize(b, sizeof(b));
+    return ret;
+}
+
+int mbedtls_ccm_stream_update_ad(mbedtls_ccm_stream_context *ctx, const unsigned char *add, size_t add_len)
+{
+    if (ctx->state != CCM_STREAM_STATE_AD || add_len > ctx->ad_left)
+    {
+        return MBEDTLS_ERR_CCM_BAD_INPUT;
+    }
+
+    ctx->ad_left -= add_len;
+    return ccm_stream_mac(ctx, add, add_len);
+}
+
+int mbedtls_ccm_stream_update(mbedtls_ccm_stream_context *ctx, const unsigned char *input, size_t length, unsigned char *output)
+{
+    unsigned char chunk[16 * CCM_STREAM_CTR_BLOCKS];
+    size_t use;
+    int decrypt;
+    int ret;
+
+    if (ctx->state == CCM_STREAM_STATE_AD && ctx->ad_left == 0)
+    {
+        ret = ccm_stream_mac_pad(ctx);
+        if (ret != 0)
+        {
+            return ret;
+        }
+        ctx->state = CCM_STREAM_STATE_PAYLOAD;
+    }
+
+    if (ctx->state != CCM_STREAM_STATE_PAYLOAD || length > ctx->length_left)
+    {
+        return MBEDTLS_ERR_CCM_BAD_INPUT;
+    }
+
+    ctx->length_left -= length;
+    decrypt = (ctx->mode == MBEDTLS_CCM_DECRYPT || ctx->mode == MBEDTLS_CCM_STAR_DECRYPT);
+
+    /*
+     * The CBC-MAC is computed over the plaintext. The input is processed in
+     * small chunks, so that in-place operation works without a copy of the
+     * whole input.
+     */
+    while (length > 0)
+    {
+        use = (length > sizeof(chunk)) ? sizeof(chunk) : length;
+
+        if (decrypt)
+        {
+            ret = ccm_stream_ctr(ctx, input, use, output);
+            if (ret == 0)
+            {
+                ret = ccm_stream_mac(ctx, output, use);
+            }
+        }
+        else
+        {
+            memcpy(chunk, input, use);
+            ret = ccm_stream_ctr(ctx, input, use, output);
+            if (ret == 0)
+            {
+                ret = ccm_stream_mac(ctx, chunk, use);
+            }
+        }
+
+        if (ret != 0)
+        {
+            mbedtls_platform_zeroize(chunk, sizeof(chunk));
+            return ret;
+        }
+
+        input += use;
+        output += use;
+        length -= use;
+    }
+
+    mbedtls_platform_zeroize(chunk, sizeof(chunk));
+    return 0;
+}
+
+int mbedtls_ccm_stream_finish(mbedtls_ccm_stream_context *ctx, unsigned char *tag, size_t tag_len)
+{
+    unsigned char computed[16];
+    unsigned char diff;
+    size_t i;
+    int ret;
+
+    if (ctx->state == CCM_STREAM_STATE_AD && ctx->ad_left == 0)
+    {
+        ret = ccm_stream_mac_pad(ctx);
+        if (ret != 0)
+        {
+            return ret;
+        }
+        ctx->state = CCM_STREAM_STATE_PAYLOAD;
+    }
+
+    if (ctx->state != CCM_STREAM_STATE_PAYLOAD || ctx->length_left != 0 || tag_len != ctx->tag_len)
+    {
+        return MBEDTLS_ERR_CCM_BAD_INPUT;
+    }
+
+    ret = ccm_stream_mac_pad(ctx);
+    ctx->state = CCM_STREAM_STATE_IDLE;
+    if (ret != 0)
+    {
+        return ret;
+    }
+
+    for (i = 0; i < tag_len; i++)
+    {
+        computed[i] = ctx->y[i] ^ ctx->s0[i];
+    }
+
+    if (ctx->mode == MBEDTLS_CCM_ENCRYPT || ctx->mode == MBEDTLS_CCM_STAR_ENCRYPT)
+    {
+        memcpy(tag, computed, tag_len);
+    }
+    else
+    {
+        for (diff = 0, i = 0; i < tag_len; i++)
+        {
+            diff |= tag[i] ^ computed[i];
+        }
+        if (diff != 0)
+        {
+            ret = MBEDTLS_ERR_CCM_AUTH_FAILED;
+        }
+    }
+
+    mbedtls_platform_zeroize(computed, sizeof(computed));
+    mbedtls_platform_zeroize(ctx->y, sizeof(ctx->y));
+    mbedtls_platform_zeroize(ctx->s0, sizeof(ctx->s0));
+    mbedtls_platform_zeroize(ctx->ks, sizeof(ctx->ks));
+    mbedtls_platform_zeroize(ctx->mac_buf, sizeof(ctx->mac_buf));
+    return ret;
 }
 
 #endif /* CONFIG_GLUE_MBEDTLS_CCM_C */
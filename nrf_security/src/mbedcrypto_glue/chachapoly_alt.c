@@ -0,0 +1,248 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+#if !defined(MBEDTLS_CONFIG_FILE)
+#include "mbedtls/config.h"
+#else
+#include MBEDTLS_CONFIG_FILE
+#endif
+
+#if defined(MBEDTLS_CHACHAPOLY_C) && defined(CONFIG_GLUE_MBEDTLS_CHACHAPOLY_C)
+
+#include <string.h>
+#include <stddef.h>
+
+#include "mbedtls/chachapoly.h"
+#include "mbedtls/platform.h"
+#include "mbedtls/platform_util.h"
+#include "backend_chachapoly.h"
+#include "backend_trace.h"
+
+
+#define CHACHAPOLY_CONTEXT_INIT(ctx) do { ctx->handle = NULL; } while (0)
+#define CHACHAPOLY_CONTEXT_ALLOC(ctx, funcs, backend_context, new_funcs) do { ctx->handle = (void*)new_funcs; funcs = new_funcs; backend_context = &ctx->buffer; } while (0)
+#define CHACHAPOLY_CONTEXT_UNPACK(ctx, funcs, backend_context) do { funcs = ctx->handle; backend_context = &ctx->buffer; } while (0)
+#define CHACHAPOLY_CONTEXT_FREE(ctx) do { ctx->handle = NULL; } while (0)
+
+#define CHACHAPOLY_CONTEXT_UNPACK_NOT_NULL(ctx, funcs, backend_context) do { \
+        CHACHAPOLY_CONTEXT_UNPACK(ctx, funcs, backend_context); \
+        if (funcs == NULL) \
+        { \
+            return MBEDTLS_ERR_CHACHAPOLY_BAD_STATE; \
+        } \
+    } while (0)
+
+
+extern const mbedtls_chachapoly_funcs mbedtls_chachapoly_cc310_backend_funcs;
+extern const mbedtls_chachapoly_funcs mbedtls_chachapoly_oberon_backend_funcs;
+
+
+static const mbedtls_chachapoly_funcs* chachapoly_backends[] = {
+    &mbedtls_chachapoly_cc310_backend_funcs,
+    &mbedtls_chachapoly_oberon_backend_funcs,
+};
+
+/*
+ * Find the backend with the highest priority for an operation. Only backends
+ * supporting streaming are considered when streaming is set.
+ */
+static const mbedtls_chachapoly_funcs* find_backend(size_t length, int streaming)
+{
+    int max_priority = 0;
+    const mbedtls_chachapoly_funcs* funcs = NULL;
+    int priority;
+    int i;
+    for (i = 0; i < sizeof(chachapoly_backends) / sizeof(chachapoly_backends[0]); i++)
+    {
+        if (streaming && chachapoly_backends[i]->starts == NULL)
+        {
+            continue;
+        }
+        priority = chachapoly_backends[i]->check(length);
+        if (priority > max_priority)
+        {
+            max_priority = priority;
+            funcs = chachapoly_backends[i];
+        }
+    }
+    return funcs;
+}
+
+/*
+ * Make the backend for an operation the active one, keying it with the key
+ * held by the glue context. Switching is cheap, as none of the backends
+ * derive anything from the key in setkey.
+ */
+static int chachapoly_select(mbedtls_chachapoly_context *ctx, size_t length, int streaming, const mbedtls_chachapoly_funcs** p_funcs, void** p_backend_context)
+{
+    const mbedtls_chachapoly_funcs* new_funcs;
+    const mbedtls_chachapoly_funcs* funcs;
+    void* backend_context;
+    int ret;
+
+    if (!ctx->key_set)
+    {
+        return MBEDTLS_ERR_CHACHAPOLY_BAD_STATE;
+    }
+
+    new_funcs = find_backend(length, streaming);
+    if (new_funcs == NULL)
+    {
+        return MBEDTLS_ERR_PLATFORM_FEATURE_UNSUPPORTED;
+    }
+
+    CHACHAPOLY_CONTEXT_UNPACK(ctx, funcs, backend_context);
+
+    if (funcs != new_funcs)
+    {
+        if (funcs != NULL)
+        {
+            funcs->free(backend_context);
+            CHACHAPOLY_CONTEXT_FREE(ctx);
+        }
+
+        CHACHAPOLY_CONTEXT_ALLOC(ctx, funcs, backend_context, new_funcs);
+        funcs->init(backend_context);
+
+        ret = funcs->setkey(backend_context, ctx->key);
+        if (ret != 0)
+        {
+            funcs->free(backend_context);
+            CHACHAPOLY_CONTEXT_FREE(ctx);
+            return ret;
+        }
+    }
+
+    *p_funcs = funcs;
+    *p_backend_context = backend_context;
+    return 0;
+}
+
+void mbedtls_chachapoly_init(mbedtls_chachapoly_context *ctx)
+{
+    memset(ctx, 0, sizeof(mbedtls_chachapoly_context));
+    CHACHAPOLY_CONTEXT_INIT(ctx);
+}
+
+void mbedtls_chachapoly_free(mbedtls_chachapoly_context *ctx)
+{
+    const mbedtls_chachapoly_funcs* funcs;
+    void* backend_context;
+
+    if (ctx == NULL)
+    {
+        return;
+    }
+
+    CHACHAPOLY_CONTEXT_UNPACK(ctx, funcs, backend_context);
+    if (funcs != NULL)
+    {
+        funcs->free(backend_context);
+        CHACHAPOLY_CONTEXT_FREE(ctx);
+    }
+    mbedtls_platform_zeroize(ctx, sizeof(mbedtls_chachapoly_context));
+}
+
+int mbedtls_chachapoly_setkey(mbedtls_chachapoly_context *ctx, const unsigned char key[32])
+{
+    const mbedtls_chachapoly_funcs* funcs;
+    void* backend_context;
+
+    /* The backend is keyed when the first operation selects it. */
+    CHACHAPOLY_CONTEXT_UNPACK(ctx, funcs, backend_context);
+    if (funcs != NULL)
+    {
+        funcs->free(backend_context);
+        CHACHAPOLY_CONTEXT_FREE(ctx);
+    }
+
+    memcpy(ctx->key, key, sizeof(ctx->key));
+    ctx->key_set = 1;
+
+    return 0;
+}
+
+int mbedtls_chachapoly_starts(mbedtls_chachapoly_context *ctx, const unsigned char nonce[12], mbedtls_chachapoly_mode_t mode)
+{
+    const mbedtls_chachapoly_funcs* funcs;
+    void* backend_context;
+    int ret;
+
+    ret = chachapoly_select(ctx, 0, 1, &funcs, &backend_context);
+    if (ret != 0)
+    {
+        return ret;
+    }
+
+    return funcs->starts(backend_context, nonce, mode);
+}
+
+int mbedtls_chachapoly_update_aad(mbedtls_chachapoly_context *ctx, const unsigned char *aad, size_t aad_len)
+{
+    const mbedtls_chachapoly_funcs* funcs;
+    void* backend_context;
+    CHACHAPOLY_CONTEXT_UNPACK_NOT_NULL(ctx, funcs, backend_context);
+    if (funcs->update_aad == NULL)
+    {
+        return MBEDTLS_ERR_CHACHAPOLY_BAD_STATE;
+    }
+    return funcs->update_aad(backend_context, aad, aad_len);
+}
+
+int mbedtls_chachapoly_update(mbedtls_chachapoly_context *ctx, size_t len, const unsigned char *input, unsigned char *output)
+{
+    const mbedtls_chachapoly_funcs* funcs;
+    void* backend_context;
+    CHACHAPOLY_CONTEXT_UNPACK_NOT_NULL(ctx, funcs, backend_context);
+    if (funcs->update == NULL)
+    {
+        return MBEDTLS_ERR_CHACHAPOLY_BAD_STATE;
+    }
+    return BACKEND_TRACE(BACKEND_TRACE_CHACHAPOLY_UPDATE, funcs, len, funcs->update(backend_context, len, input, output));
+}
+
+int mbedtls_chachapoly_finish(mbedtls_chachapoly_context *ctx, unsigned char mac[16])
+{
+    const mbedtls_chachapoly_funcs* funcs;
+    void* backend_context;
+    CHACHAPOLY_CONTEXT_UNPACK_NOT_NULL(ctx, funcs, backend_context);
+    if (funcs->finish == NULL)
+    {
+        return MBEDTLS_ERR_CHACHAPOLY_BAD_STATE;
+    }
+    return funcs->finish(backend_context, mac);
+}
+
+int mbedtls_chachapoly_encrypt_and_tag(mbedtls_chachapoly_context *ctx, size_t length, const unsigned char nonce[12], const unsigned char *aad, size_t aad_len, const unsigned char *input, unsigned char *output, unsigned char tag[16])
+{
+    const mbedtls_chachapoly_funcs* funcs;
+    void* backend_context;
+    int ret;
+
+    ret = chachapoly_select(ctx, length, 0, &funcs, &backend_context);
+    if (ret != 0)
+    {
+        return ret;
+    }
+
+    return BACKEND_TRACE(BACKEND_TRACE_CHACHAPOLY_ENCRYPT, funcs, length, funcs->encrypt_and_tag(backend_context, length, nonce, aad, aad_len, input, output, tag));
+}
+
+int mbedtls_chachapoly_auth_decrypt(mbedtls_chachapoly_context *ctx, size_t length, const unsigned char nonce[12], const unsigned char *aad, size_t aad_len, const unsigned char tag[16], const unsigned char *input, unsigned char *output)
+{
+    const mbedtls_chachapoly_funcs* funcs;
+    void* backend_context;
+    int ret;
+
+    ret = chachapoly_select(ctx, length, 0, &funcs, &backend_context);
+    if (ret != 0)
+    {
+        return ret;
+    }
+
+    return BACKEND_TRACE(BACKEND_TRACE_CHACHAPOLY_DECRYPT, funcs, length, funcs->auth_decrypt(backend_context, length, nonce, aad, aad_len, tag, input, output));
+}
+
+#endif /* MBEDTLS_CHACHAPOLY_C && CONFIG_GLUE_MBEDTLS_CHACHAPOLY_C */
@@ -16,6 +16,8 @@
 
 #include "mbedtls/cmac.h"
 #include "backend_cmac.h"
+#include "backend_trace.h"
+#include "backend_cache.h"
 
 
 #if defined(CONFIG_CC310_MBEDTLS_CMAC_C)
@@ -53,11 +55,21 @@ static const mbedtls_cmac_funcs* find_backend(const mbedtls_cipher_info_t *ciphe
     return funcs;
 }
 
+static const mbedtls_cmac_funcs* cmac_backend_cache[BACKEND_CACHE_KEYBITS_COUNT];
+
+static const mbedtls_cmac_funcs* get_backend(const mbedtls_cipher_info_t *cipher_info , const unsigned char *key, size_t keybits)
+{
+    const mbedtls_cmac_funcs* funcs;
+    BACKEND_CACHE_GET(cmac_backend_cache, backend_cache_keybits_index(keybits),
+                      funcs, find_backend(cipher_info, key, keybits));
+    return funcs;
+}
+
 int mbedtls_cipher_cmac_starts(mbedtls_cipher_context_t *ctx , const unsigned char *key, size_t keybits)
 {
     const mbedtls_cmac_funcs* funcs;
 
-    funcs = find_backend(ctx->cipher_info, key, keybits);
+    funcs = get_backend(ctx->cipher_info, key, keybits);
 
     if (funcs == NULL)
     {
@@ -77,7 +89,7 @@ int mbedtls_cipher_cmac_update(mbedtls_cipher_context_t *ctx , const unsigned ch
         return MBEDTLS_ERR_CIPHER_INVALID_CONTEXT;
     }
 
-    return funcs->update(ctx, input, ilen);
+    return BACKEND_TRACE(BACKEND_TRACE_CMAC_UPDATE, funcs, ilen, funcs->update(ctx, input, ilen));
 }
 
 int mbedtls_cipher_cmac_finish(mbedtls_cipher_context_t *ctx , unsigned char *output)
@@ -118,14 +130,14 @@ int mbedtls_cipher_cmac(const mbedtls_cipher_info_t *cipher_info , const unsigne
 {
     const mbedtls_cmac_funcs* funcs;
 
-    funcs = find_backend(cipher_info, key, keylen);
+    funcs = get_backend(cipher_info, key, keylen);
 
     if (funcs == NULL)
     {
         return MBEDTLS_ERR_CIPHER_FEATURE_UNAVAILABLE;
     }
 
-    return funcs->cmac(cipher_info, key, keylen, input, ilen, output);
+    return BACKEND_TRACE(BACKEND_TRACE_CMAC, funcs, ilen, funcs->cmac(cipher_info, key, keylen, input, ilen, output));
 }
 
 #if defined(MBEDTLS_AES_C)
@@ -134,7 +146,7 @@ int mbedtls_aes_cmac_prf_128(const unsigned char *key, size_t key_len , const un
 {
     const mbedtls_cmac_funcs* funcs;
 
-    funcs = find_backend(NULL, key, key_len);
+    funcs = get_backend(NULL, key, key_len);
 
     if (funcs == NULL)
     {
@@ -25,6 +25,8 @@
 
 #include "mbedtls/dhm.h"
 #include "backend_dhm.h"
+#include "backend_trace.h"
+#include "backend_cache.h"
 
 
 #define DHM_CONTEXT_INIT(ctx) do { ctx->handle = NULL; } while (0)
@@ -75,13 +77,38 @@ static const mbedtls_dhm_funcs* find_backend(unsigned int pbits)
     return funcs;
 }
 
+/* Prime sizes that are multiples of 512 bits, up to 8192 bits, are cached. */
+#define DHM_BACKEND_CACHE_STEP (512)
+#define DHM_BACKEND_CACHE_SIZE (8192 / DHM_BACKEND_CACHE_STEP)
+
+static const mbedtls_dhm_funcs* dhm_backend_cache[DHM_BACKEND_CACHE_SIZE];
+
+static int dhm_backend_cache_index(unsigned int pbits)
+{
+    if (pbits == 0 || (pbits % DHM_BACKEND_CACHE_STEP) != 0 ||
+        pbits > (DHM_BACKEND_CACHE_SIZE * DHM_BACKEND_CACHE_STEP))
+    {
+        return BACKEND_CACHE_NO_INDEX;
+    }
+
+    return (pbits / DHM_BACKEND_CACHE_STEP) - 1;
+}
+
+static const mbedtls_dhm_funcs* get_backend(unsigned int pbits)
+{
+    const mbedtls_dhm_funcs* funcs;
+    BACKEND_CACHE_GET(dhm_backend_cache, dhm_backend_cache_index(pbits),
+                      funcs, find_backend(pbits));
+    return funcs;
+}
+
 int recheck_context(mbedtls_dhm_context *ctx, unsigned int pbits)
 {
     const mbedtls_dhm_funcs* new_funcs;
     const mbedtls_dhm_funcs* funcs;
     DHM_CONTEXT_UNPACK(ctx, funcs);
 
-    new_funcs = find_backend(pbits);
+    new_funcs = get_backend(pbits);
 
     if (new_funcs == NULL)
     {
@@ -111,6 +138,190 @@ int recheck_context(mbedtls_dhm_context *ctx, unsigned int pbits)
     return 0;
 }
 
+#if defined(CONFIG_GLUE_MBEDTLS_DHM_RFC7919)
+
+/*
+ * R^2 mod P of the RFC 7919 groups, as used by the Montgomery multiplication in
+ * mbedtls_mpi_exp_mod. R is 2^pbits, so the values only hold when P has no
+ * leading zero limbs.
+ */
+static const unsigned char dhm_ffdhe2048_rr[] = {
+    0x35, 0x2B, 0xD3, 0x99, 0xBE, 0x84, 0x05, 0x8E, 0xFA, 0xFF, 0x50, 0xD2,
+    0x9D, 0x57, 0x34, 0x57, 0xA5, 0x7C, 0x73, 0xBD, 0xDC, 0x70, 0xFB, 0x82,
+    0xBA, 0xE7, 0xB0, 0xB3, 0x6E, 0x36, 0x2D, 0xC0, 0x6A, 0x31, 0x56, 0x04,
+    0x18, 0x9C, 0xD7, 0x6B, 0x06, 0xBD, 0xEA, 0xC1, 0xF5, 0x50, 0x0F, 0xA7,
+    0xE8, 0xC2, 0x95, 0x4E, 0x4C, 0x18, 0x04, 0xCA, 0x5C, 0x6D, 0x1A, 0xEB,
+    0xDB, 0x06, 0xF6, 0x5B, 0x6A, 0x12, 0xFB, 0x70, 0x7C, 0x8C, 0x05, 0x10,
+    0xB2, 0x97, 0xA8, 0x23, 0x6F, 0xA9, 0x3D, 0x28, 0x26, 0x74, 0xE1, 0xD6,
+    0x4F, 0xBC, 0xBD, 0xC8, 0xE6, 0x67, 0x8E, 0xEB, 0x37, 0x5D, 0xB1, 0x8E,
+    0xAE, 0x13, 0x02, 0xF2, 0xF6, 0xD4, 0x77, 0x7E, 0x9B, 0x89, 0x4B, 0x24,
+    0x5F, 0x6B, 0x69, 0xA1, 0x44, 0xF0, 0xC6, 0x19, 0xCE, 0x34, 0x84, 0x58,
+    0x85, 0xA9, 0x97, 0xD5, 0x0C, 0xD5, 0x1A, 0xEC, 0xDD, 0x24, 0xA1, 0x27,
+    0x53, 0xC8, 0xF0, 0x9D, 0x62, 0x75, 0x88, 0xC4, 0x98, 0x75, 0xD5, 0xA7,
+    0x74, 0x8D, 0x40, 0x7C, 0x34, 0x37, 0xB7, 0xA8, 0xF8, 0xA9, 0x80, 0x14,
+    0xA1, 0x2B, 0x74, 0xE4, 0xB1, 0x48, 0x84, 0xD8, 0xA1, 0x8A, 0xF8, 0xCE,
+    0xE3, 0xE7, 0x68, 0xC8, 0x60, 0xD1, 0x0B, 0x8A, 0x5F, 0x57, 0xD0, 0x37,
+    0x43, 0x0E, 0xE9, 0x1E, 0x56, 0x1A, 0xB4, 0x26, 0xD0, 0x71, 0x37, 0xFD,
+    0x70, 0xAC, 0xF2, 0xAA, 0x4C, 0xF3, 0x6D, 0xDD, 0xF9, 0x2F, 0x8E, 0x9A,
+    0xB7, 0xE3, 0x3F, 0xB0, 0xF6, 0xAF, 0xEB, 0xB7, 0x6E, 0x58, 0x9D, 0x6C,
+    0xE9, 0xFD, 0xAC, 0x6A, 0xCF, 0xF4, 0xEA, 0xAA, 0x18, 0xAF, 0x74, 0x82,
+    0x91, 0x17, 0x3F, 0x2A, 0x05, 0x70, 0x18, 0x7E, 0xC4, 0x22, 0xEE, 0xB7,
+    0x0A, 0x15, 0x2F, 0x39, 0x64, 0x58, 0xF3, 0xB8, 0x18, 0x7B, 0xE3, 0x6B,
+    0xD3, 0x8A, 0x4F, 0xA1
+};
+
+static const unsigned char dhm_ffdhe3072_rr[] = {
+    0xA1, 0x5C, 0x07, 0x6B, 0x8E, 0xBA, 0x95, 0x2B, 0xF1, 0x28, 0xE8, 0xA3,
+    0xBC, 0x34, 0xB8, 0x5A, 0x6E, 0xD9, 0xEE, 0xAD, 0xF8, 0x0F, 0x1D, 0x3B,
+    0x23, 0x58, 0x44, 0xDC, 0xD8, 0x63, 0x73, 0xC1, 0xCF, 0x12, 0xDF, 0xC2,
+    0xD3, 0xCE, 0x87, 0x37, 0xDC, 0x47, 0xAA, 0x6E, 0xDD, 0x24, 0x10, 0xF7,
+    0x78, 0x29, 0xCC, 0x53, 0x63, 0xF6, 0xC2, 0x87, 0xB9, 0x63, 0x10, 0x02,
+    0xBC, 0xD3, 0xA5, 0x14, 0xB0, 0x18, 0x33, 0xB5, 0x09, 0xE7, 0x82, 0x3D,
+    0x10, 0xCE, 0x03, 0x7C, 0xD0, 0xD9, 0x6E, 0x9F, 0x27, 0xDE, 0xA1, 0x4F,
+    0xE4, 0x18, 0x15, 0x98, 0xBD, 0xE2, 0xB9, 0xC3, 0x92, 0xD1, 0x1C, 0x5F,
+    0x06, 0xA7, 0xF1, 0xF9, 0x79, 0xDD, 0xBC, 0x72, 0x8E, 0x66, 0x98, 0xAC,
+    0x54, 0x50, 0x3D, 0xB2, 0x33, 0x6A, 0xDD, 0x6A, 0x56, 0x81, 0x74, 0xB6,
+    0x7F, 0x3B, 0x09, 0xC2, 0x87, 0x4C, 0x8B, 0xD6, 0xFB, 0xA4, 0x8A, 0x97,
+    0x19, 0x4A, 0xC0, 0xC3, 0x5C, 0xEF, 0x7F, 0xEB, 0x30, 0x65, 0xC0, 0x63,
+    0xB9, 0x57, 0xD0, 0x16, 0x8A, 0xA3, 0x0D, 0xBD, 0xD1, 0x7F, 0x17, 0x64,
+    0x5D, 0x31, 0xB3, 0xE1, 0x05, 0x1B, 0x9E, 0x86, 0xAF, 0x98, 0xB2, 0x40,
+    0x47, 0xC2, 0xF1, 0x20, 0x1F, 0x7E, 0x26, 0xBF, 0x9E, 0x12, 0x42, 0x14,
+    0x47, 0x81, 0x11, 0x7F, 0x73, 0xF3, 0x19, 0x68, 0x78, 0x67, 0x26, 0x89,
+    0xAD, 0xAD, 0x49, 0xE2, 0x1E, 0x8E, 0xA3, 0x5A, 0xB5, 0x93, 0xA5, 0xA3,
+    0x1D, 0xBB, 0x96, 0x9A, 0xB1, 0xB2, 0xA7, 0x65, 0xC8, 0x38, 0x2B, 0x42,
+    0x27, 0x31, 0x39, 0x49, 0xC5, 0xD2, 0xB6, 0xB9, 0xCA, 0x83, 0x0F, 0xC7,
+    0xE9, 0xC9, 0xAA, 0xCD, 0xF8, 0xFA, 0x1E, 0x54, 0x9E, 0xDE, 0x73, 0x4F,
+    0x62, 0x20, 0x11, 0xD2, 0xE7, 0xDE, 0xE0, 0x86, 0xD8, 0xBB, 0xA3, 0x11,
+    0x3B, 0x3C, 0x4F, 0x5D, 0xD4, 0xFA, 0xA7, 0xC3, 0x13, 0xAA, 0xD0, 0xC3,
+    0x76, 0xFF, 0xEA, 0x53, 0xA3, 0xC7, 0x53, 0xB3, 0xE8, 0x28, 0x3C, 0x27,
+    0x31, 0x57, 0xA6, 0xFC, 0x37, 0x36, 0x94, 0xDC, 0xDE, 0x5E, 0x69, 0x92,
+    0x6E, 0x07, 0x82, 0x02, 0xE0, 0x55, 0x02, 0xDB, 0x2E, 0x90, 0xCB, 0x13,
+    0x52, 0xF9, 0x21, 0x70, 0xA7, 0x93, 0x36, 0x7B, 0x56, 0xDA, 0xFD, 0x28,
+    0x81, 0x7A, 0xDC, 0xF8, 0x31, 0x67, 0x68, 0x17, 0x78, 0x3B, 0x26, 0x9A,
+    0x46, 0xA6, 0x89, 0xAE, 0x9B, 0x87, 0xC4, 0x09, 0x3C, 0xF5, 0x5A, 0xFA,
+    0x4A, 0x4D, 0x77, 0x7D, 0x71, 0xFA, 0xD3, 0x2A, 0xD2, 0xEE, 0x92, 0x66,
+    0x73, 0x6D, 0xC4, 0x03, 0x84, 0xE1, 0x9B, 0x8A, 0x4F, 0x2F, 0x19, 0xC7,
+    0x29, 0xB3, 0x8C, 0x9F, 0x17, 0xD3, 0xB9, 0xEE, 0x6D, 0x42, 0xCB, 0x5B,
+    0x17, 0xBC, 0x46, 0xDC, 0xFA, 0x18, 0x61, 0xEC, 0x14, 0xBA, 0x15, 0x60
+};
+
+static const unsigned char dhm_ffdhe4096_rr[] = {
+    0x9C, 0xE5, 0xB1, 0x97, 0x0F, 0xD8, 0xC1, 0x3A, 0x6F, 0xCA, 0xA6, 0x72,
+    0x72, 0x1A, 0xFD, 0x71, 0xCC, 0x49, 0xDD, 0xBC, 0x0A, 0x74, 0xA9, 0x65,
+    0x0E, 0x12, 0xA8, 0xD3, 0x73, 0xDC, 0x21, 0x45, 0x91, 0xB4, 0x75, 0x5B,
+    0x94, 0xDB, 0x49, 0x9F, 0x24, 0xD6, 0xC8, 0xEE, 0xF2, 0xB7, 0x9C, 0x5D,
+    0x73, 0x69, 0xBC, 0x4D, 0xEA, 0x70, 0xD9, 0x99, 0xB5, 0x6E, 0xA5, 0xB6,
+    0xB8, 0x5B, 0xC3, 0xB1, 0xBD, 0xC4, 0xA3, 0x7D, 0x88, 0x7B, 0xEB, 0xF6,
+    0x0F, 0x1A, 0x8D, 0xF6, 0x69, 0xC8, 0x9E, 0x34, 0x4D, 0xA9, 0x76, 0x6C,
+    0x9C, 0xEB, 0x35, 0x48, 0x5F, 0x59, 0xF6, 0xB0, 0xAB, 0x45, 0xF3, 0x0B,
+    0xAD, 0xB0, 0x9E, 0x22, 0xBD, 0x27, 0xEE, 0xA4, 0x12, 0xD2, 0x02, 0x72,
+    0xC6, 0x42, 0x44, 0xCA, 0x22, 0x6A, 0x8A, 0x8E, 0x67, 0x7D, 0x0E, 0xC7,
+    0xC9, 0xEB, 0x89, 0x87, 0x63, 0x43, 0x8A, 0xB1, 0x57, 0x11, 0x54, 0x08,
+    0xC2, 0x9E, 0x4C, 0xF6, 0x6A, 0xEB, 0x2E, 0x33, 0xB0, 0xB7, 0xA1, 0x02,
+    0x09, 0xCE, 0x26, 0xFC, 0x63, 0xDC, 0xB6, 0x28, 0x0B, 0x04, 0x9B, 0xF0,
+    0x47, 0x42, 0x7B, 0x9B, 0x82, 0xB1, 0x2E, 0x47, 0xAB, 0xBC, 0xF4, 0xFC,
+    0x55, 0x1F, 0x30, 0xB2, 0x71, 0x52, 0xFD, 0x09, 0x8C, 0xB8, 0xA1, 0xC2,
+    0x46, 0xC5, 0x3E, 0xCC, 0xC9, 0xB6, 0xFA, 0xBA, 0x81, 0xD4, 0xE2, 0x16,
+    0xDE, 0x7A, 0x06, 0x66, 0x45, 0x6B, 0x50, 0xEE, 0x11, 0x9D, 0x4A, 0x45,
+    0x30, 0x23, 0xA5, 0xBB, 0x71, 0x80, 0x44, 0x2E, 0x3F, 0x18, 0xFF, 0x71,
+    0x40, 0xB6, 0xB5, 0x7E, 0xFA, 0x3A, 0x6F, 0xA3, 0x6B, 0x89, 0xE3, 0xE9,
+    0x18, 0x44, 0xBA, 0x5C, 0xBC, 0x4D, 0xD3, 0x10, 0x2E, 0x6F, 0x5F, 0xBF,
+    0x71, 0x3C, 0xE8, 0xA4, 0x8F, 0xFF, 0xBC, 0x83, 0x24, 0xDE, 0xB0, 0x22,
+    0x7D, 0x48, 0xFF, 0x6A, 0xFF, 0x66, 0x9C, 0xC3, 0x0E, 0x05, 0xC9, 0xC8,
+    0xA2, 0xE0, 0xD2, 0x02, 0x15, 0x0E, 0x35, 0xD7, 0xAC, 0xA0, 0x55, 0x5A,
+    0x19, 0xB5, 0xFA, 0xCD, 0x2E, 0x2E, 0x3A, 0xA9, 0x17, 0xDF, 0x47, 0x70,
+    0x4C, 0x3B, 0x00, 0xD9, 0x8C, 0x45, 0xD7, 0x34, 0x16, 0x2F, 0x97, 0x41,
+    0x11, 0xBF, 0x27, 0x92, 0xA8, 0x78, 0xF4, 0xD4, 0x9B, 0x59, 0x10, 0xF9,
+    0x58, 0xD3, 0xEA, 0xEF, 0x1C, 0x79, 0x4A, 0x4E, 0x83, 0x2C, 0x0E, 0x85,
+    0xF8, 0x35, 0x7C, 0x2F, 0x63, 0x22, 0xEE, 0x9C, 0xC3, 0x96, 0x7E, 0x50,
+    0xC9, 0x4C, 0x31, 0x90, 0xF5, 0x43, 0xC1, 0xC9, 0x11, 0x1D, 0x16, 0xFA,
+    0x00, 0xC9, 0xA4, 0x49, 0x21, 0x43, 0x56, 0x70, 0xB5, 0x91, 0x37, 0x0E,
+    0x60, 0x4F, 0xF3, 0x65, 0x11, 0x5B, 0x49, 0xC1, 0x12, 0x16, 0xD3, 0x8D,
+    0x5A, 0x71, 0x0F, 0xEF, 0xCA, 0xA4, 0x45, 0xEF, 0xE2, 0x22, 0xF8, 0xA0,
+    0x7B, 0x28, 0x9A, 0x4F, 0x4C, 0xC0, 0x83, 0x1B, 0x7E, 0xDA, 0xB7, 0xF6,
+    0x13, 0x50, 0x18, 0x0A, 0x03, 0x9E, 0xA0, 0xB3, 0x41, 0x7F, 0x65, 0x2A,
+    0x60, 0x2E, 0xE0, 0x77, 0x6E, 0xF6, 0xE3, 0x16, 0x34, 0x05, 0x7F, 0x48,
+    0x4C, 0x3D, 0x50, 0x6F, 0x4B, 0x38, 0xDC, 0xE2, 0xD4, 0x58, 0xF6, 0x1C,
+    0xE9, 0xE4, 0x7F, 0xD2, 0xFB, 0x80, 0x3A, 0x65, 0x81, 0x37, 0x0E, 0x54,
+    0x2C, 0x8F, 0x26, 0x9A, 0x7E, 0xC0, 0x21, 0x6E, 0xD3, 0xAE, 0x93, 0x50,
+    0x2B, 0xCD, 0x01, 0x55, 0xDD, 0x2E, 0x3F, 0x31, 0x1F, 0x41, 0xDC, 0x52,
+    0xED, 0x9C, 0x5B, 0x4F, 0x5E, 0x5E, 0x28, 0xFA, 0xAA, 0xB1, 0xDD, 0x5D,
+    0x6E, 0xB2, 0x6D, 0xC7, 0x2A, 0xBF, 0x56, 0x27, 0x12, 0x6A, 0x70, 0xAA,
+    0xF6, 0x2F, 0x75, 0x8E, 0xEC, 0x79, 0x15, 0x85, 0x87, 0xB5, 0x11, 0x00,
+    0xA7, 0xC6, 0x22, 0xB7, 0xCF, 0xB2, 0xCC, 0x2D
+};
+
+static const unsigned char dhm_ffdhe2048_p[] = MBEDTLS_DHM_RFC7919_FFDHE2048_P_BIN;
+static const unsigned char dhm_ffdhe3072_p[] = MBEDTLS_DHM_RFC7919_FFDHE3072_P_BIN;
+static const unsigned char dhm_ffdhe4096_p[] = MBEDTLS_DHM_RFC7919_FFDHE4096_P_BIN;
+
+static const struct
+{
+    const unsigned char* p;
+    const unsigned char* rr;
+    size_t len;
+} dhm_rfc7919_groups[] = {
+    { dhm_ffdhe2048_p, dhm_ffdhe2048_rr, sizeof(dhm_ffdhe2048_rr) },
+    { dhm_ffdhe3072_p, dhm_ffdhe3072_rr, sizeof(dhm_ffdhe3072_rr) },
+    { dhm_ffdhe4096_p, dhm_ffdhe4096_rr, sizeof(dhm_ffdhe4096_rr) },
+};
+
+static void load_rfc7919_rp(mbedtls_dhm_context *ctx)
+{
+    mbedtls_mpi p;
+    size_t pbits;
+    int i;
+
+    pbits = mbedtls_mpi_bitlen(&ctx->P);
+    if (ctx->P.n * 8 * sizeof(mbedtls_mpi_uint) != pbits)
+    {
+        return;
+    }
+
+    for (i = 0; i < sizeof(dhm_rfc7919_groups) / sizeof(dhm_rfc7919_groups[0]); i++)
+    {
+        if (8 * dhm_rfc7919_groups[i].len != pbits)
+        {
+            continue;
+        }
+
+        mbedtls_mpi_init(&p);
+        if (mbedtls_mpi_read_binary(&p, dhm_rfc7919_groups[i].p, dhm_rfc7919_groups[i].len) == 0 &&
+            mbedtls_mpi_cmp_mpi(&p, &ctx->P) == 0)
+        {
+            if (mbedtls_mpi_read_binary(&ctx->RP, dhm_rfc7919_groups[i].rr, dhm_rfc7919_groups[i].len) != 0)
+            {
+                mbedtls_mpi_free(&ctx->RP);
+            }
+        }
+        mbedtls_mpi_free(&p);
+        return;
+    }
+}
+
+#endif /* CONFIG_GLUE_MBEDTLS_DHM_RFC7919 */
+
+/*
+ * A backend context is kept when the new group is handled by the same backend,
+ * so the cached R^2 mod P of a previous group must be dropped when P changes.
+ */
+static void update_rp(mbedtls_dhm_context *ctx)
+{
+    const mbedtls_dhm_funcs* funcs;
+    DHM_CONTEXT_UNPACK(ctx, funcs);
+
+    mbedtls_mpi_free(&ctx->RP);
+
+#if defined(CONFIG_GLUE_MBEDTLS_DHM_RFC7919)
+    if (funcs == &mbedtls_dhm_vanilla_mbedtls_backend_funcs)
+    {
+        load_rfc7919_rp(ctx);
+    }
+#else
+    (void)funcs;
+#endif
+}
+
 static unsigned int read_pbits(unsigned char **p, const unsigned char *end)
 {
     unsigned char *src = *p;
@@ -167,7 +378,13 @@ int mbedtls_dhm_read_params(mbedtls_dhm_context *ctx, unsigned char **p, const u
 
     DHM_CONTEXT_UNPACK(ctx, funcs);
 
-    return funcs->read_params(ctx, p, end);
+    res = funcs->read_params(ctx, p, end);
+    if (res == 0)
+    {
+        update_rp(ctx);
+    }
+
+    return res;
 }
 
 int mbedtls_dhm_make_params(mbedtls_dhm_context *ctx, int x_size, unsigned char *output, size_t *olen, int (*f_rng)(void *, unsigned char *, size_t), void *p_rng)
@@ -192,7 +409,13 @@ int mbedtls_dhm_set_group(mbedtls_dhm_context *ctx, const mbedtls_mpi *P, const
 
     DHM_CONTEXT_UNPACK(ctx, funcs);
 
-    return funcs->set_group(ctx, P, G);
+    res = funcs->set_group(ctx, P, G);
+    if (res == 0)
+    {
+        update_rp(ctx);
+    }
+
+    return res;
 }
 
 int mbedtls_dhm_read_public(mbedtls_dhm_context *ctx, const unsigned char *input, size_t ilen)
@@ -210,7 +433,7 @@ int mbedtls_dhm_make_public(mbedtls_dhm_context *ctx, int x_size, unsigned char
 
     DHM_CONTEXT_UNPACK_NOT_NULL(ctx, funcs);
 
-    return funcs->make_public(ctx, x_size, output, olen, f_rng, p_rng);
+    return BACKEND_TRACE(BACKEND_TRACE_DHM_MAKE_PUBLIC, funcs, 0, funcs->make_public(ctx, x_size, output, olen, f_rng, p_rng));
 }
 
 int mbedtls_dhm_calc_secret(mbedtls_dhm_context *ctx, unsigned char *output, size_t output_size, size_t *olen, int (*f_rng)(void *, unsigned char *, size_t), void *p_rng)
@@ -219,7 +442,7 @@ int mbedtls_dhm_calc_secret(mbedtls_dhm_context *ctx, unsigned char *output, siz
 
     DHM_CONTEXT_UNPACK_NOT_NULL(ctx, funcs);
 
-    return funcs->calc_secret(ctx, output, output_size, olen, f_rng, p_rng);
+    return BACKEND_TRACE(BACKEND_TRACE_DHM_CALC_SECRET, funcs, 0, funcs->calc_secret(ctx, output, output_size, olen, f_rng, p_rng));
 }
 
 void mbedtls_dhm_free(mbedtls_dhm_context *ctx)
@@ -317,6 +540,10 @@ int mbedtls_dhm_parse_dhm(mbedtls_dhm_context *ctx, const unsigned char *dhmin,
     DHM_CONTEXT_UNPACK(ctx, funcs);
 
     ret = funcs->parse_dhm(ctx, dhmin, dhminlen);
+    if (ret == 0)
+    {
+        update_rp(ctx);
+    }
 
 #if defined(MBEDTLS_PEM_PARSE_C)
     mbedtls_pem_free(&pem);
@@ -17,11 +17,13 @@
 
 #include "mbedtls/ecdh.h"
 #include "backend_ecdh.h"
+#include "backend_trace.h"
 
 
 #if defined(CONFIG_CC310_MBEDTLS_ECDH_C)
 extern mbedtls_ecdh_funcs mbedtls_ecdh_cc310_backend_funcs;
 #endif
+extern mbedtls_ecdh_funcs mbedtls_ecdh_oberon_backend_funcs;
 #if defined(CONFIG_VANILLA_MBEDTLS_ECDH_C)
 extern mbedtls_ecdh_funcs mbedtls_ecdh_vanilla_mbedtls_backend_funcs;
 #endif
@@ -31,6 +33,7 @@ static mbedtls_ecdh_funcs* ecdh_backends[] = {
 #if defined(CONFIG_CC310_MBEDTLS_ECDH_C)
     &mbedtls_ecdh_cc310_backend_funcs,
 #endif
+    &mbedtls_ecdh_oberon_backend_funcs,
 #if defined(CONFIG_VANILLA_MBEDTLS_ECDH_C)
     &mbedtls_ecdh_vanilla_mbedtls_backend_funcs,
 #endif
@@ -61,7 +64,7 @@ int mbedtls_ecdh_gen_public(mbedtls_ecp_group *grp, mbedtls_mpi *d, mbedtls_ecp_
     {
         return MBEDTLS_ERR_ECP_FEATURE_UNAVAILABLE;
     }
-    return funcs->gen_public(grp, d, Q, f_rng, p_rng);
+    return BACKEND_TRACE(BACKEND_TRACE_ECDH_GEN_PUBLIC, funcs, 0, funcs->gen_public(grp, d, Q, f_rng, p_rng));
 }
 
 int mbedtls_ecdh_compute_shared(mbedtls_ecp_group *grp, mbedtls_mpi *z, const mbedtls_ecp_point *Q, const mbedtls_mpi *d, int (*f_rng)(void *, unsigned char *, size_t), void *p_rng)
@@ -71,7 +74,7 @@ int mbedtls_ecdh_compute_shared(mbedtls_ecp_group *grp, mbedtls_mpi *z, const mb
     {
         return MBEDTLS_ERR_ECP_FEATURE_UNAVAILABLE;
     }
-    return funcs->compute_shared(grp, z, Q, d, f_rng, p_rng);
+    return BACKEND_TRACE(BACKEND_TRACE_ECDH_COMPUTE_SHARED, funcs, 0, funcs->compute_shared(grp, z, Q, d, f_rng, p_rng));
 }
 
 #endif /* MBEDTLS_ECDH_C && CONFIG_GLUE_MBEDTLS_ECDH_C */
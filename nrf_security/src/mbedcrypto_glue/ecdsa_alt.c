@@ -18,6 +18,7 @@
 
 #include "mbedtls/ecdsa.h"
 #include "backend_ecdsa.h"
+#include "backend_trace.h"
 
 
 #if defined(CONFIG_CC310_MBEDTLS_ECDSA_C)
@@ -62,7 +63,7 @@ int mbedtls_ecdsa_sign(mbedtls_ecp_group *grp, mbedtls_mpi *r, mbedtls_mpi *s, c
     {
         return MBEDTLS_ERR_ECP_FEATURE_UNAVAILABLE;
     }
-    return funcs->sign(grp, r, s, d, buf, blen, f_rng, p_rng);
+    return BACKEND_TRACE(BACKEND_TRACE_ECDSA_SIGN, funcs, 0, funcs->sign(grp, r, s, d, buf, blen, f_rng, p_rng));
 }
 
 int mbedtls_ecdsa_verify(mbedtls_ecp_group *grp, const unsigned char *buf, size_t blen, const mbedtls_ecp_point *Q, const mbedtls_mpi *r, const mbedtls_mpi *s)
@@ -72,7 +73,7 @@ int mbedtls_ecdsa_verify(mbedtls_ecp_group *grp, const unsigned char *buf, size_
     {
         return MBEDTLS_ERR_ECP_FEATURE_UNAVAILABLE;
     }
-    return funcs->verify(grp, buf, blen, Q, r, s);
+    return BACKEND_TRACE(BACKEND_TRACE_ECDSA_VERIFY, funcs, 0, funcs->verify(grp, buf, blen, Q, r, s));
 }
 
 int mbedtls_ecdsa_genkey(mbedtls_ecdsa_context *ctx, mbedtls_ecp_group_id gid, int (*f_rng)(void *, unsigned char *, size_t), void *p_rng)
@@ -82,7 +83,7 @@ int mbedtls_ecdsa_genkey(mbedtls_ecdsa_context *ctx, mbedtls_ecp_group_id gid, i
     {
         return MBEDTLS_ERR_ECP_FEATURE_UNAVAILABLE;
     }
-    return funcs->genkey(ctx, gid, f_rng, p_rng);
+    return BACKEND_TRACE(BACKEND_TRACE_ECDSA_GENKEY, funcs, 0, funcs->genkey(ctx, gid, f_rng, p_rng));
 }
 
 #endif /* MBEDTLS_ECDSA_C && CONFIG_GLUE_MBEDTLS_ECDSA_C*/
@@ -41,7 +41,7 @@ void mbedtls_entropy_add_backend_sources( mbedtls_entropy_context *ctx )
 
     if (context_words > 0)
     {
-        ctx->backend_context_buffer = mbedtls_calloc(4 * context_words);
+        ctx->backend_context_buffer = mbedtls_calloc(context_words, 4);
         if (ctx->backend_context_buffer == NULL)
         {
             // TODO: show error log
@@ -0,0 +1,482 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+#if !defined(MBEDTLS_CONFIG_FILE)
+#include "mbedtls/config.h"
+#else
+#include MBEDTLS_CONFIG_FILE
+#endif
+
+#if defined(MBEDTLS_GCM_C) && defined(CONFIG_GLUE_MBEDTLS_GCM_C)
+
+#include <string.h>
+#include <stddef.h>
+
+#include "mbedtls/gcm.h"
+#include "mbedtls/aes.h"
+#include "mbedtls/platform_util.h"
+
+#if defined(CONFIG_GLUE_MBEDTLS_GCM_OBERON)
+#include "ocrypto_aes_gcm.h"
+#endif
+
+/*
+ * AES GCM on top of the AES API.
+ *
+ * The counter blocks are encrypted with mbedtls_aes_crypt_ctr, or block by
+ * block when the 32-bit counter could wrap, so that the selected AES backend
+ * does the heavy lifting. GHASH is computed in software with 4-bit tables.
+ */
+
+#define GET_UINT32_BE(b, i)                         \
+    (((uint32_t)(b)[(i)] << 24) |                   \
+     ((uint32_t)(b)[(i) + 1] << 16) |               \
+     ((uint32_t)(b)[(i) + 2] << 8) |                \
+     ((uint32_t)(b)[(i) + 3]))
+
+#define PUT_UINT32_BE(n, b, i) do {                 \
+        (b)[(i)] = (unsigned char)((n) >> 24);      \
+        (b)[(i) + 1] = (unsigned char)((n) >> 16);  \
+        (b)[(i) + 2] = (unsigned char)((n) >> 8);   \
+        (b)[(i) + 3] = (unsigned char)(n);          \
+    } while (0)
+
+
+/* Reduction of the 4 bits shifted out of the low end, for GHASH. */
+static const uint16_t gcm_last4[16] =
+{
+    0x0000, 0x1c20, 0x3840, 0x2460, 0x7080, 0x6ca0, 0x48c0, 0x54e0,
+    0xe100, 0xfd20, 0xd940, 0xc560, 0x9180, 0x8da0, 0xa9c0, 0xb5e0
+};
+
+static void gcm_gen_table(mbedtls_gcm_context *ctx, const unsigned char h[16])
+{
+    uint64_t vh;
+    uint64_t vl;
+    uint32_t t;
+    int i;
+    int j;
+
+    vh = ((uint64_t)GET_UINT32_BE(h, 0) << 32) | GET_UINT32_BE(h, 4);
+    vl = ((uint64_t)GET_UINT32_BE(h, 8) << 32) | GET_UINT32_BE(h, 12);
+
+    /* HL/HH[i] hold H * i, using the bit-reflected field representation. */
+    ctx->HL[8] = vl;
+    ctx->HH[8] = vh;
+    ctx->HL[0] = 0;
+    ctx->HH[0] = 0;
+
+    for (i = 4; i > 0; i >>= 1)
+    {
+        t = (uint32_t)(vl & 1) * 0xe1000000U;
+        vl = (vh << 63) | (vl >> 1);
+        vh = (vh >> 1) ^ ((uint64_t)t << 32);
+        ctx->HL[i] = vl;
+        ctx->HH[i] = vh;
+    }
+
+    for (i = 2; i <= 8; i *= 2)
+    {
+        for (j = 1; j < i; j++)
+        {
+            ctx->HH[i + j] = ctx->HH[i] ^ ctx->HH[j];
+            ctx->HL[i + j] = ctx->HL[i] ^ ctx->HL[j];
+        }
+    }
+}
+
+/* buf = buf * H */
+static void gcm_mult(mbedtls_gcm_context *ctx, unsigned char buf[16])
+{
+    uint64_t zh;
+    uint64_t zl;
+    unsigned char lo;
+    unsigned char hi;
+    unsigned char rem;
+    int i;
+
+    lo = buf[15] & 0x0f;
+    zh = ctx->HH[lo];
+    zl = ctx->HL[lo];
+
+    for (i = 15; i >= 0; i--)
+    {
+        lo = buf[i] & 0x0f;
+        hi = (buf[i] >> 4) & 0x0f;
+
+        if (i != 15)
+        {
+            rem = (unsigned char)(zl & 0x0f);
+            zl = (zh << 60) | (zl >> 4);
+            zh = (zh >> 4) ^ ((uint64_t)gcm_last4[rem] << 48);
+            zh ^= ctx->HH[lo];
+            zl ^= ctx->HL[lo];
+        }
+
+        rem = (unsigned char)(zl & 0x0f);
+        zl = (zh << 60) | (zl >> 4);
+        zh = (zh >> 4) ^ ((uint64_t)gcm_last4[rem] << 48);
+        zh ^= ctx->HH[hi];
+        zl ^= ctx->HL[hi];
+    }
+
+    PUT_UINT32_BE(zh >> 32, buf, 0);
+    PUT_UINT32_BE(zh, buf, 4);
+    PUT_UINT32_BE(zl >> 32, buf, 8);
+    PUT_UINT32_BE(zl, buf, 12);
+}
+
+/*
+ * Absorb data into the GHASH state. offset is the number of bytes already
+ * absorbed, so that the data can be given in pieces of any length.
+ */
+static void gcm_ghash(mbedtls_gcm_context *ctx, uint64_t offset, const unsigned char *data, size_t len)
+{
+    size_t pos = (size_t)(offset % 16);
+
+    while (len > 0)
+    {
+        ctx->buf[pos++] ^= *data++;
+        len--;
+        if (pos == 16)
+        {
+            gcm_mult(ctx, ctx->buf);
+            pos = 0;
+        }
+    }
+}
+
+/* Complete a partially absorbed block with zero padding. */
+static void gcm_ghash_pad(mbedtls_gcm_context *ctx, uint64_t offset)
+{
+    if (offset % 16 != 0)
+    {
+        gcm_mult(ctx, ctx->buf);
+    }
+}
+
+/* Increment the lower 32 bits of the counter block. */
+static void gcm_incr(unsigned char y[16])
+{
+    size_t i;
+
+    for (i = 16; i > 12; i--)
+    {
+        if (++y[i - 1] != 0)
+        {
+            break;
+        }
+    }
+}
+
+static int gcm_ctr(mbedtls_gcm_context *ctx, size_t length, const unsigned char *input, unsigned char *output)
+{
+    int ret;
+#if defined(MBEDTLS_CIPHER_MODE_CTR)
+    uint32_t ctr32 = GET_UINT32_BE(ctx->y, 12);
+    size_t used = (ctx->nc_off == 0) ? 0 : 16 - ctx->nc_off;
+    size_t blocks = (length > used) ? (length - used + 15) / 16 : 0;
+
+    /*
+     * The AES CTR mode increments the whole counter block, GCM only the
+     * lower 32 bits. They agree as long as the lower 32 bits do not wrap.
+     */
+    if ((uint64_t)blocks <= (uint64_t)(0xFFFFFFFFU - ctr32))
+    {
+        return mbedtls_aes_crypt_ctr(&ctx->aes, length, &ctx->nc_off, ctx->y, ctx->stream_block, input, output);
+    }
+#endif /* MBEDTLS_CIPHER_MODE_CTR */
+
+    while (length > 0)
+    {
+        if (ctx->nc_off == 0)
+        {
+            ret = mbedtls_aes_crypt_ecb(&ctx->aes, MBEDTLS_AES_ENCRYPT, ctx->y, ctx->stream_block);
+            if (ret != 0)
+            {
+                return ret;
+            }
+            gcm_incr(ctx->y);
+        }
+
+        *output++ = *input++ ^ ctx->stream_block[ctx->nc_off];
+        ctx->nc_off = (ctx->nc_off + 1) & 0x0F;
+        length--;
+    }
+
+    return 0;
+}
+
+void mbedtls_gcm_init(mbedtls_gcm_context *ctx)
+{
+    memset(ctx, 0, sizeof(*ctx));
+    mbedtls_aes_init(&ctx->aes);
+}
+
+int mbedtls_gcm_setkey(mbedtls_gcm_context *ctx, mbedtls_cipher_id_t cipher, const unsigned char *key, unsigned int keybits)
+{
+    unsigned char h[16];
+    int ret;
+
+    if (cipher != MBEDTLS_CIPHER_ID_AES)
+    {
+        return MBEDTLS_ERR_GCM_BAD_INPUT;
+    }
+
+    ret = mbedtls_aes_setkey_enc(&ctx->aes, key, keybits);
+    if (ret != 0)
+    {
+        return ret;
+    }
+
+    /* H = E(K, 0^128) */
+    memset(h, 0, sizeof(h));
+    ret = mbedtls_aes_crypt_ecb(&ctx->aes, MBEDTLS_AES_ENCRYPT, h, h);
+    if (ret != 0)
+    {
+        return ret;
+    }
+
+    gcm_gen_table(ctx, h);
+    mbedtls_platform_zeroize(h, sizeof(h));
+
+#if defined(CONFIG_GLUE_MBEDTLS_GCM_OBERON)
+    memcpy(ctx->key, key, keybits / 8);
+    ctx->key_len = keybits / 8;
+#endif /* CONFIG_GLUE_MBEDTLS_GCM_OBERON */
+
+    return 0;
+}
+
+int mbedtls_gcm_starts(mbedtls_gcm_context *ctx, int mode, const unsigned char *iv, size_t iv_len, const unsigned char *add, size_t add_len)
+{
+    unsigned char work_buf[16];
+    uint64_t iv_bits;
+    int ret;
+
+    /* IV and AD are limited to 2^64 bits, so 2^61 bytes */
+    if (iv_len == 0 || ((uint64_t)iv_len) >> 61 != 0 || ((uint64_t)add_len) >> 61 != 0)
+    {
+        return MBEDTLS_ERR_GCM_BAD_INPUT;
+    }
+
+    memset(ctx->y, 0, sizeof(ctx->y));
+    memset(ctx->buf, 0, sizeof(ctx->buf));
+
+    ctx->mode = mode;
+    ctx->len = 0;
+    ctx->add_len = 0;
+    ctx->nc_off = 0;
+
+    /* J0 is IV || 0^31 || 1 for 96-bit IVs, otherwise GHASH(IV) */
+    if (iv_len == 12)
+    {
+        memcpy(ctx->y, iv, iv_len);
+        ctx->y[15] = 1;
+    }
+    else
+    {
+        gcm_ghash(ctx, 0, iv, iv_len);
+        gcm_ghash_pad(ctx, iv_len);
+
+        memset(work_buf, 0, sizeof(work_buf));
+        iv_bits = (uint64_t)iv_len * 8;
+        PUT_UINT32_BE(iv_bits >> 32, work_buf, 8);
+        PUT_UINT32_BE(iv_bits, work_buf, 12);
+        gcm_ghash(ctx, 0, work_buf, sizeof(work_buf));
+
+        memcpy(ctx->y, ctx->buf, sizeof(ctx->y));
+        memset(ctx->buf, 0, sizeof(ctx->buf));
+    }
+
+    ret = mbedtls_aes_crypt_ecb(&ctx->aes, MBEDTLS_AES_ENCRYPT, ctx->y, ctx->base_ectr);
+    if (ret != 0)
+    {
+        return ret;
+    }
+    gcm_incr(ctx->y);
+
+    ctx->add_len = add_len;
+    gcm_ghash(ctx, 0, add, add_len);
+    gcm_ghash_pad(ctx, add_len);
+
+    return 0;
+}
+
+int mbedtls_gcm_update(mbedtls_gcm_context *ctx, size_t length, const unsigned char *input, unsigned char *output)
+{
+    int ret;
+
+    if (output > input && (size_t)(output - input) < length)
+    {
+        return MBEDTLS_ERR_GCM_BAD_INPUT;
+    }
+
+    /* Total length is restricted to 2^39 - 256 bits, ie 2^36 - 2^5 bytes */
+    if (ctx->len + length < ctx->len || (uint64_t)ctx->len + length > 0xFFFFFFFE0ull)
+    {
+        return MBEDTLS_ERR_GCM_BAD_INPUT;
+    }
+
+    /* GHASH always covers the ciphertext */
+    if (ctx->mode == MBEDTLS_GCM_DECRYPT)
+    {
+        gcm_ghash(ctx, ctx->len, input, length);
+    }
+
+    ret = gcm_ctr(ctx, length, input, output);
+    if (ret != 0)
+    {
+        return ret;
+    }
+
+    if (ctx->mode == MBEDTLS_GCM_ENCRYPT)
+    {
+        gcm_ghash(ctx, ctx->len, output, length);
+    }
+
+    ctx->len += length;
+
+    return 0;
+}
+
+int mbedtls_gcm_finish(mbedtls_gcm_context *ctx, unsigned char *tag, size_t tag_len)
+{
+    unsigned char work_buf[16];
+    uint64_t orig_len = ctx->len * 8;
+    uint64_t orig_add_len = ctx->add_len * 8;
+    size_t i;
+
+    if (tag_len > 16 || tag_len < 4)
+    {
+        return MBEDTLS_ERR_GCM_BAD_INPUT;
+    }
+
+    gcm_ghash_pad(ctx, ctx->len);
+
+    PUT_UINT32_BE(orig_add_len >> 32, work_buf, 0);
+    PUT_UINT32_BE(orig_add_len, work_buf, 4);
+    PUT_UINT32_BE(orig_len >> 32, work_buf, 8);
+    PUT_UINT32_BE(orig_len, work_buf, 12);
+    gcm_ghash(ctx, 0, work_buf, sizeof(work_buf));
+
+    for (i = 0; i < tag_len; i++)
+    {
+        tag[i] = ctx->buf[i] ^ ctx->base_ectr[i];
+    }
+
+    mbedtls_platform_zeroize(work_buf, sizeof(work_buf));
+
+    return 0;
+}
+
+#if defined(CONFIG_GLUE_MBEDTLS_GCM_OBERON)
+/* nrf_oberon only takes 96-bit IVs and always produces a 16 byte tag. */
+static int gcm_use_oberon(size_t length, size_t iv_len)
+{
+    if (iv_len != 12)
+    {
+        return 0;
+    }
+
+#if CONFIG_GLUE_MBEDTLS_GCM_OBERON_MAX_LENGTH > 0
+    if (length > CONFIG_GLUE_MBEDTLS_GCM_OBERON_MAX_LENGTH)
+    {
+        return 0;
+    }
+#else
+    (void)length;
+#endif
+
+    return 1;
+}
+#endif /* CONFIG_GLUE_MBEDTLS_GCM_OBERON */
+
+int mbedtls_gcm_crypt_and_tag(mbedtls_gcm_context *ctx, int mode, size_t length, const unsigned char *iv, size_t iv_len, const unsigned char *add, size_t add_len, const unsigned char *input, unsigned char *output, size_t tag_len, unsigned char *tag)
+{
+    int ret;
+
+#if defined(CONFIG_GLUE_MBEDTLS_GCM_OBERON)
+    if (mode == MBEDTLS_GCM_ENCRYPT && gcm_use_oberon(length, iv_len) && tag_len >= 4 && tag_len <= 16)
+    {
+        unsigned char full_tag[16];
+
+        ocrypto_aes_gcm_encrypt(output, full_tag, input, length, ctx->key, ctx->key_len, iv, add, add_len);
+        memcpy(tag, full_tag, tag_len);
+        mbedtls_platform_zeroize(full_tag, sizeof(full_tag));
+        return 0;
+    }
+#endif /* CONFIG_GLUE_MBEDTLS_GCM_OBERON */
+
+    ret = mbedtls_gcm_starts(ctx, mode, iv, iv_len, add, add_len);
+    if (ret != 0)
+    {
+        return ret;
+    }
+
+    ret = mbedtls_gcm_update(ctx, length, input, output);
+    if (ret != 0)
+    {
+        return ret;
+    }
+
+    return mbedtls_gcm_finish(ctx, tag, tag_len);
+}
+
+int mbedtls_gcm_auth_decrypt(mbedtls_gcm_context *ctx, size_t length, const unsigned char *iv, size_t iv_len, const unsigned char *add, size_t add_len, const unsigned char *tag, size_t tag_len, const unsigned char *input, unsigned char *output)
+{
+    unsigned char check_tag[16];
+    unsigned char diff;
+    size_t i;
+    int ret;
+
+#if defined(CONFIG_GLUE_MBEDTLS_GCM_OBERON)
+    /* A truncated tag can not be checked by nrf_oberon */
+    if (gcm_use_oberon(length, iv_len) && tag_len == 16)
+    {
+        if (ocrypto_aes_gcm_decrypt(output, tag, input, length, ctx->key, ctx->key_len, iv, add, add_len) != 0)
+        {
+            mbedtls_platform_zeroize(output, length);
+            return MBEDTLS_ERR_GCM_AUTH_FAILED;
+        }
+        return 0;
+    }
+#endif /* CONFIG_GLUE_MBEDTLS_GCM_OBERON */
+
+    ret = mbedtls_gcm_crypt_and_tag(ctx, MBEDTLS_GCM_DECRYPT, length, iv, iv_len, add, add_len, input, output, tag_len, check_tag);
+    if (ret != 0)
+    {
+        return ret;
+    }
+
+    /* Check the tag in constant time */
+    for (diff = 0, i = 0; i < tag_len; i++)
+    {
+        diff |= tag[i] ^ check_tag[i];
+    }
+
+    mbedtls_platform_zeroize(check_tag, sizeof(check_tag));
+
+    if (diff != 0)
+    {
+        mbedtls_platform_zeroize(output, length);
+        return MBEDTLS_ERR_GCM_AUTH_FAILED;
+    }
+
+    return 0;
+}
+
+void mbedtls_gcm_free(mbedtls_gcm_context *ctx)
+{
+    if (ctx == NULL)
+    {
+        return;
+    }
+
+    mbedtls_aes_free(&ctx->aes);
+    mbedtls_platform_zeroize(ctx, sizeof(*ctx));
+}
+
+#endif /* MBEDTLS_GCM_C && CONFIG_GLUE_MBEDTLS_GCM_C */
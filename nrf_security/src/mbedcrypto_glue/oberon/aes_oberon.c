@@ -0,0 +1,313 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+
+#if !defined(MBEDTLS_CONFIG_FILE)
+#include "mbedtls/config.h"
+#else
+#include MBEDTLS_CONFIG_FILE
+#endif
+
+#if defined(CONFIG_GLUE_MBEDTLS_AES_OBERON)
+
+#include <string.h>
+#include <toolchain.h>
+
+#include "mbedtls/aes.h"
+#include "mbedtls/platform_util.h"
+#include "backend_aes.h"
+#include "ocrypto_aes_ctr.h"
+#include "ocrypto_aes_ctr_reset.h"
+
+BUILD_ASSERT_MSG(sizeof(ocrypto_aes_ctr_ctx) <= 4 * OBERON_MBEDTLS_AES_CONTEXT_WORDS, "Invalid OBERON_MBEDTLS_AES_CONTEXT_WORDS value");
+
+/*
+ * nrf_oberon only exposes AES through AES-CTR. A block is encrypted as the
+ * keystream of a counter equal to the block, reusing the expanded key of the
+ * context. There is no inverse cipher, so only encryption keys are supported.
+ */
+static int mbedtls_aes_check(unsigned int keybits, int mode, int xts)
+{
+    if (mode != MBEDTLS_AES_ENCRYPT || xts != 0)
+    {
+        return 0;
+    }
+
+    return (keybits == 128 || keybits == 192 || keybits == 256) ? 2 : 0;
+}
+
+static void oberon_aes_init(mbedtls_aes_context *ctx)
+{
+    memset(ctx, 0, sizeof(ocrypto_aes_ctr_ctx));
+}
+
+static void oberon_aes_free(mbedtls_aes_context *ctx)
+{
+    mbedtls_platform_zeroize(ctx, sizeof(ocrypto_aes_ctr_ctx));
+}
+
+static int oberon_aes_setkey_enc(mbedtls_aes_context *ctx, const unsigned char *key, unsigned int keybits)
+{
+    static const uint8_t zero_iv[16];
+
+    if (keybits != 128 && keybits != 192 && keybits != 256)
+    {
+        return MBEDTLS_ERR_AES_INVALID_KEY_LENGTH;
+    }
+
+    ocrypto_aes_ctr_init((ocrypto_aes_ctr_ctx *)ctx, key, keybits / 8, zero_iv);
+    return 0;
+}
+
+static int oberon_aes_setkey_dec(mbedtls_aes_context *ctx, const unsigned char *key, unsigned int keybits)
+{
+    return MBEDTLS_ERR_AES_FEATURE_UNAVAILABLE;
+}
+
+static int oberon_internal_aes_encrypt(mbedtls_aes_context *ctx, const unsigned char input[16], unsigned char output[16])
+{
+    ocrypto_aes_ctr_block((ocrypto_aes_ctr_ctx *)ctx, input, output);
+    return 0;
+}
+
+static int oberon_internal_aes_decrypt(mbedtls_aes_context *ctx, const unsigned char input[16], unsigned char output[16])
+{
+    return MBEDTLS_ERR_AES_FEATURE_UNAVAILABLE;
+}
+
+#if defined(CONFIG_GLUE_MBEDTLS_CIPHER_MODE_CBC)
+/* Only encryption, CBC decryption needs the inverse cipher. */
+static int oberon_aes_crypt_cbc(mbedtls_aes_context *ctx, int mode, size_t length, unsigned char iv[16], const unsigned char *input, unsigned char *output)
+{
+    int i;
+
+    if (mode != MBEDTLS_AES_ENCRYPT)
+    {
+        return MBEDTLS_ERR_AES_FEATURE_UNAVAILABLE;
+    }
+
+    if (length % 16)
+    {
+        return MBEDTLS_ERR_AES_INVALID_INPUT_LENGTH;
+    }
+
+    while (length > 0)
+    {
+        for (i = 0; i < 16; i++)
+        {
+            output[i] = (unsigned char)(input[i] ^ iv[i]);
+        }
+
+        ocrypto_aes_ctr_block((ocrypto_aes_ctr_ctx *)ctx, output, output);
+        memcpy(iv, output, 16);
+
+        input += 16;
+        output += 16;
+        length -= 16;
+    }
+
+    return 0;
+}
+#endif /* CONFIG_GLUE_MBEDTLS_CIPHER_MODE_CBC */
+
+#if defined(CONFIG_GLUE_MBEDTLS_CIPHER_MODE_CFB)
+static int oberon_aes_crypt_cfb128(mbedtls_aes_context *ctx, int mode, size_t length, size_t *iv_off, unsigned char iv[16], const unsigned char *input, unsigned char *output)
+{
+    size_t n = *iv_off;
+    unsigned char c;
+
+    if (n > 15)
+    {
+        return MBEDTLS_ERR_AES_BAD_INPUT_DATA;
+    }
+
+    while (length--)
+    {
+        if (n == 0)
+        {
+            ocrypto_aes_ctr_block((ocrypto_aes_ctr_ctx *)ctx, iv, iv);
+        }
+
+        if (mode == MBEDTLS_AES_DECRYPT)
+        {
+            c = *input++;
+            *output++ = (unsigned char)(c ^ iv[n]);
+            iv[n] = c;
+        }
+        else
+        {
+            iv[n] = *output++ = (unsigned char)(iv[n] ^ *input++);
+        }
+
+        n = (n + 1) & 0x0F;
+    }
+
+    *iv_off = n;
+    return 0;
+}
+
+static int oberon_aes_crypt_cfb8(mbedtls_aes_context *ctx, int mode, size_t length, unsigned char iv[16], const unsigned char *input, unsigned char *output)
+{
+    unsigned char ov[17];
+    unsigned char c;
+
+    while (length--)
+    {
+        memcpy(ov, iv, 16);
+        ocrypto_aes_ctr_block((ocrypto_aes_ctr_ctx *)ctx, iv, iv);
+
+        if (mode == MBEDTLS_AES_DECRYPT)
+        {
+            ov[16] = *input;
+        }
+
+        c = *output++ = (unsigned char)(iv[0] ^ *input++);
+
+        if (mode == MBEDTLS_AES_ENCRYPT)
+        {
+            ov[16] = c;
+        }
+
+        memcpy(iv, ov + 1, 16);
+    }
+
+    return 0;
+}
+#endif /* CONFIG_GLUE_MBEDTLS_CIPHER_MODE_CFB */
+
+#if defined(CONFIG_GLUE_MBEDTLS_CIPHER_MODE_OFB)
+static int oberon_aes_crypt_ofb(mbedtls_aes_context *ctx, size_t length, size_t *iv_off, unsigned char iv[16], const unsigned char *input, unsigned char *output)
+{
+    size_t n = *iv_off;
+
+    if (n > 15)
+    {
+        return MBEDTLS_ERR_AES_BAD_INPUT_DATA;
+    }
+
+    while (length--)
+    {
+        if (n == 0)
+        {
+            ocrypto_aes_ctr_block((ocrypto_aes_ctr_ctx *)ctx, iv, iv);
+        }
+
+        *output++ = (unsigned char)(*input++ ^ iv[n]);
+        n = (n + 1) & 0x0F;
+    }
+
+    *iv_off = n;
+    return 0;
+}
+#endif /* CONFIG_GLUE_MBEDTLS_CIPHER_MODE_OFB */
+
+#if defined(CONFIG_GLUE_MBEDTLS_CIPHER_MODE_CTR)
+/* Add to a 128-bit big endian counter. */
+static void oberon_aes_ctr_add(unsigned char counter[16], size_t blocks)
+{
+    int i;
+
+    for (i = 15; i >= 0 && blocks != 0; i--)
+    {
+        blocks += counter[i];
+        counter[i] = (unsigned char)blocks;
+        blocks >>= 8;
+    }
+}
+
+static int oberon_aes_crypt_ctr(mbedtls_aes_context *ctx, size_t length, size_t *nc_off, unsigned char nonce_counter[16], unsigned char stream_block[16], const unsigned char *input, unsigned char *output)
+{
+    ocrypto_aes_ctr_ctx *oberon_ctx = (ocrypto_aes_ctr_ctx *)ctx;
+    size_t n = *nc_off;
+    size_t blocks;
+    size_t chunk;
+    uint32_t low;
+    size_t i;
+
+    if (n > 15)
+    {
+        return MBEDTLS_ERR_AES_BAD_INPUT_DATA;
+    }
+
+    /* Use up the keystream left from the previous call. */
+    while (n != 0 && length > 0)
+    {
+        *output++ = (unsigned char)(*input++ ^ stream_block[n]);
+        n = (n + 1) & 0x0F;
+        length--;
+    }
+
+    /*
+     * Whole blocks are processed by nrf_oberon in one call. The chunks end
+     * where the low counter word wraps, so the result does not depend on how
+     * far nrf_oberon propagates the carry.
+     */
+    blocks = length / 16;
+    while (blocks > 0)
+    {
+        low = ((uint32_t)nonce_counter[12] << 24) | ((uint32_t)nonce_counter[13] << 16) |
+              ((uint32_t)nonce_counter[14] << 8) | (uint32_t)nonce_counter[15];
+
+        chunk = blocks;
+        if (low != 0 && chunk > (uint32_t)(0 - low))
+        {
+            chunk = (uint32_t)(0 - low);
+        }
+
+        ocrypto_aes_ctr_reset(oberon_ctx, nonce_counter);
+        ocrypto_aes_ctr_encrypt(oberon_ctx, output, input, chunk * 16);
+        oberon_aes_ctr_add(nonce_counter, chunk);
+
+        input += chunk * 16;
+        output += chunk * 16;
+        length -= chunk * 16;
+        blocks -= chunk;
+    }
+
+    if (length > 0)
+    {
+        ocrypto_aes_ctr_block(oberon_ctx, nonce_counter, stream_block);
+        oberon_aes_ctr_add(nonce_counter, 1);
+
+        for (i = 0; i < length; i++)
+        {
+            output[i] = (unsigned char)(input[i] ^ stream_block[i]);
+        }
+
+        n = length;
+    }
+
+    *nc_off = n;
+    return 0;
+}
+#endif /* CONFIG_GLUE_MBEDTLS_CIPHER_MODE_CTR */
+
+/* XTS is not supported, the check function never selects nrf_oberon for it. */
+const mbedtls_aes_funcs mbedtls_aes_oberon_backend_funcs = {
+    .backend_context_size = (4 * OBERON_MBEDTLS_AES_CONTEXT_WORDS),
+    .check = mbedtls_aes_check,
+    .init = oberon_aes_init,
+    .free = oberon_aes_free,
+    .setkey_enc = oberon_aes_setkey_enc,
+    .setkey_dec = oberon_aes_setkey_dec,
+    .internal_encrypt = oberon_internal_aes_encrypt,
+    .internal_decrypt = oberon_internal_aes_decrypt,
+    .crypt_ecb_blocks = NULL,
+#if defined(CONFIG_GLUE_MBEDTLS_CIPHER_MODE_CBC)
+    .crypt_cbc = oberon_aes_crypt_cbc,
+#endif
+#if defined(CONFIG_GLUE_MBEDTLS_CIPHER_MODE_CFB)
+    .crypt_cfb128 = oberon_aes_crypt_cfb128,
+    .crypt_cfb8 = oberon_aes_crypt_cfb8,
+#endif
+#if defined(CONFIG_GLUE_MBEDTLS_CIPHER_MODE_OFB)
+    .crypt_ofb = oberon_aes_crypt_ofb,
+#endif
+#if defined(CONFIG_GLUE_MBEDTLS_CIPHER_MODE_CTR)
+    .crypt_ctr = oberon_aes_crypt_ctr,
+#endif
+};
+
+#endif /* CONFIG_GLUE_MBEDTLS_AES_OBERON */
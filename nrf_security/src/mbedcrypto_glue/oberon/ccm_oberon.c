@@ -0,0 +1,257 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+
+#if !defined(MBEDTLS_CONFIG_FILE)
+#include "mbedtls/config.h"
+#else
+#include MBEDTLS_CONFIG_FILE
+#endif
+
+#if defined(CONFIG_GLUE_MBEDTLS_CCM_OBERON)
+
+#include <string.h>
+#include <toolchain.h>
+
+#include "mbedtls/ccm.h"
+#include "mbedtls/platform_util.h"
+#include "backend_ccm.h"
+#include "ocrypto_aes_ctr.h"
+#include "ocrypto_aes_ctr_reset.h"
+
+BUILD_ASSERT_MSG(sizeof(ocrypto_aes_ctr_ctx) <= 4 * OBERON_MBEDTLS_CCM_CONTEXT_WORDS, "Invalid OBERON_MBEDTLS_CCM_CONTEXT_WORDS value");
+
+/*
+ * AES CCM/CCM* on the nrf_oberon AES-CTR. Unlike the mbed TLS backend, which
+ * reaches the AES glue through the cipher layer, this never uses cc310, so
+ * it is a real software alternative for short messages.
+ *
+ * The priority is 1, the same as mbed TLS. find_backend() keeps the first
+ * backend with the highest priority, and ccm_backends lists mbed TLS before
+ * this backend, so it is only selected first if mbed TLS CCM is not
+ * available.
+ */
+static int mbedtls_ccm_check(mbedtls_cipher_id_t cipher, unsigned int keybits)
+{
+    if (cipher != MBEDTLS_CIPHER_ID_AES)
+    {
+        return 0;
+    }
+
+    return (keybits == 128 || keybits == 192 || keybits == 256) ? 1 : 0;
+}
+
+#if defined(CONFIG_GLUE_SIZE_AWARE_DISPATCH)
+static int mbedtls_ccm_check_length(size_t length)
+{
+    return 1;
+}
+#endif
+
+static void oberon_ccm_init(mbedtls_ccm_context *ctx)
+{
+    memset(ctx, 0, sizeof(ocrypto_aes_ctr_ctx));
+}
+
+static void oberon_ccm_free(mbedtls_ccm_context *ctx)
+{
+    mbedtls_platform_zeroize(ctx, sizeof(ocrypto_aes_ctr_ctx));
+}
+
+static int oberon_ccm_setkey(mbedtls_ccm_context *ctx, mbedtls_cipher_id_t cipher, const unsigned char *key, unsigned int keybits)
+{
+    static const uint8_t zero_iv[16];
+
+    if (mbedtls_ccm_check(cipher, keybits) == 0)
+    {
+        return MBEDTLS_ERR_CCM_BAD_INPUT;
+    }
+
+    ocrypto_aes_ctr_init((ocrypto_aes_ctr_ctx *)ctx, key, keybits / 8, zero_iv);
+    return 0;
+}
+
+/* CBC-MAC of data into y, the last block padded with zeros. */
+static void oberon_ccm_mac(ocrypto_aes_ctr_ctx *ctx, unsigned char y[16], const unsigned char *data, size_t len)
+{
+    size_t use_len;
+    size_t i;
+
+    while (len > 0)
+    {
+        use_len = (len > 16) ? 16 : len;
+
+        for (i = 0; i < use_len; i++)
+        {
+            y[i] ^= data[i];
+        }
+        ocrypto_aes_ctr_block(ctx, y, y);
+
+        data += use_len;
+        len -= use_len;
+    }
+}
+
+/* Same steps and checks as ccm_auth_crypt() in standard mbed TLS. */
+static int oberon_ccm_auth_crypt(ocrypto_aes_ctr_ctx *ctx, int decrypt, int star, size_t length,
+                                 const unsigned char *iv, size_t iv_len,
+                                 const unsigned char *add, size_t add_len,
+                                 const unsigned char *input, unsigned char *output,
+                                 unsigned char *tag, size_t tag_len)
+{
+    unsigned char b[16];
+    unsigned char y[16];
+    unsigned char ctr[16];
+    unsigned char diff;
+    unsigned char q;
+    size_t len_left;
+    size_t use_len;
+    size_t i;
+    int ret = 0;
+
+    if ((star && tag_len == 2) || (!star && tag_len < 4) || tag_len > 16 || tag_len % 2 != 0)
+    {
+        return MBEDTLS_ERR_CCM_BAD_INPUT;
+    }
+
+    if (iv_len < 7 || iv_len > 13 || add_len > 0xFF00)
+    {
+        return MBEDTLS_ERR_CCM_BAD_INPUT;
+    }
+
+    q = 16 - 1 - (unsigned char)iv_len;
+
+    /* First block B_0: flags, nonce and message length. */
+    b[0] = 0;
+    b[0] |= (add_len > 0) << 6;
+    if (tag_len > 0)
+    {
+        b[0] |= ((tag_len - 2) / 2) << 3;
+    }
+    b[0] |= q - 1;
+
+    memcpy(b + 1, iv, iv_len);
+
+    for (i = 0, len_left = length; i < q; i++, len_left >>= 8)
+    {
+        b[15 - i] = (unsigned char)(len_left & 0xFF);
+    }
+
+    if (len_left > 0)
+    {
+        return MBEDTLS_ERR_CCM_BAD_INPUT;
+    }
+
+    ocrypto_aes_ctr_block(ctx, b, y);
+
+    /* Associated data, prefixed with its 2-byte length. */
+    if (add_len > 0)
+    {
+        use_len = (add_len > 14) ? 14 : add_len;
+
+        memset(b, 0, 16);
+        b[0] = (unsigned char)((add_len >> 8) & 0xFF);
+        b[1] = (unsigned char)(add_len & 0xFF);
+        memcpy(b + 2, add, use_len);
+
+        oberon_ccm_mac(ctx, y, b, 16);
+        oberon_ccm_mac(ctx, y, add + use_len, add_len - use_len);
+    }
+
+    /* Counter block: flags, nonce and a counter starting at 1 for the payload. */
+    ctr[0] = q - 1;
+    memcpy(ctr + 1, iv, iv_len);
+    memset(ctr + 1 + iv_len, 0, q);
+    ctr[15] = 1;
+
+    /*
+     * The MAC is over the plaintext. The whole payload is one CTR call, the
+     * counter never carries out of its q bytes as the length fits in them.
+     */
+    if (!decrypt)
+    {
+        oberon_ccm_mac(ctx, y, input, length);
+    }
+
+    if (length > 0)
+    {
+        ocrypto_aes_ctr_reset(ctx, ctr);
+        ocrypto_aes_ctr_encrypt(ctx, output, input, length);
+    }
+
+    if (decrypt)
+    {
+        oberon_ccm_mac(ctx, y, output, length);
+    }
+
+    /* Authentication tag: T XOR S_0, with the counter reset to 0. */
+    ctr[15] = 0;
+    ocrypto_aes_ctr_block(ctx, ctr, b);
+
+    for (i = 0; i < tag_len; i++)
+    {
+        y[i] ^= b[i];
+    }
+
+    if (decrypt)
+    {
+        diff = 0;
+        for (i = 0; i < tag_len; i++)
+        {
+            diff |= tag[i] ^ y[i];
+        }
+
+        if (diff != 0)
+        {
+            mbedtls_platform_zeroize(output, length);
+            ret = MBEDTLS_ERR_CCM_AUTH_FAILED;
+        }
+    }
+    else
+    {
+        memcpy(tag, y, tag_len);
+    }
+
+    mbedtls_platform_zeroize(b, sizeof(b));
+    mbedtls_platform_zeroize(y, sizeof(y));
+    return ret;
+}
+
+static int oberon_ccm_encrypt_and_tag(mbedtls_ccm_context *ctx, size_t length, const unsigned char *iv, size_t iv_len, const unsigned char *add, size_t add_len, const unsigned char *input, unsigned char *output, unsigned char *tag, size_t tag_len)
+{
+    return oberon_ccm_auth_crypt((ocrypto_aes_ctr_ctx *)ctx, 0, 0, length, iv, iv_len, add, add_len, input, output, tag, tag_len);
+}
+
+static int oberon_ccm_star_encrypt_and_tag(mbedtls_ccm_context *ctx, size_t length, const unsigned char *iv, size_t iv_len, const unsigned char *add, size_t add_len, const unsigned char *input, unsigned char *output, unsigned char *tag, size_t tag_len)
+{
+    return oberon_ccm_auth_crypt((ocrypto_aes_ctr_ctx *)ctx, 0, 1, length, iv, iv_len, add, add_len, input, output, tag, tag_len);
+}
+
+static int oberon_ccm_auth_decrypt(mbedtls_ccm_context *ctx, size_t length, const unsigned char *iv, size_t iv_len, const unsigned char *add, size_t add_len, const unsigned char *input, unsigned char *output, const unsigned char *tag, size_t tag_len)
+{
+    return oberon_ccm_auth_crypt((ocrypto_aes_ctr_ctx *)ctx, 1, 0, length, iv, iv_len, add, add_len, input, output, (unsigned char *)tag, tag_len);
+}
+
+static int oberon_ccm_star_auth_decrypt(mbedtls_ccm_context *ctx, size_t length, const unsigned char *iv, size_t iv_len, const unsigned char *add, size_t add_len, const unsigned char *input, unsigned char *output, const unsigned char *tag, size_t tag_len)
+{
+    return oberon_ccm_auth_crypt((ocrypto_aes_ctr_ctx *)ctx, 1, 1, length, iv, iv_len, add, add_len, input, output, (unsigned char *)tag, tag_len);
+}
+
+const mbedtls_ccm_funcs mbedtls_ccm_oberon_backend_funcs = {
+    .backend_context_size = (4 * OBERON_MBEDTLS_CCM_CONTEXT_WORDS),
+    .check = mbedtls_ccm_check,
+    .init = oberon_ccm_init,
+    .setkey = oberon_ccm_setkey,
+    .free = oberon_ccm_free,
+    .encrypt_and_tag = oberon_ccm_encrypt_and_tag,
+    .star_encrypt_and_tag = oberon_ccm_star_encrypt_and_tag,
+    .auth_decrypt = oberon_ccm_auth_decrypt,
+    .star_auth_decrypt = oberon_ccm_star_auth_decrypt,
+#if defined(CONFIG_GLUE_SIZE_AWARE_DISPATCH)
+    .check_length = mbedtls_ccm_check_length,
+#endif
+};
+
+#endif /* CONFIG_GLUE_MBEDTLS_CCM_OBERON */
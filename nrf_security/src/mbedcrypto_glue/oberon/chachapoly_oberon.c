@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+
+#if !defined(MBEDTLS_CONFIG_FILE)
+#include "mbedtls/config.h"
+#else
+#include MBEDTLS_CONFIG_FILE
+#endif
+
+#if defined(CONFIG_GLUE_MBEDTLS_CHACHAPOLY_C)
+
+#include <string.h>
+#include <toolchain.h>
+
+#include "mbedtls/chachapoly.h"
+#include "mbedtls/platform_util.h"
+#include "backend_chachapoly.h"
+#include "ocrypto_chacha20_poly1305.h"
+#include "ocrypto_chacha20_poly1305_inc.h"
+
+#define OBERON_CHACHAPOLY_STATE_INIT        0
+#define OBERON_CHACHAPOLY_STATE_AAD         1
+#define OBERON_CHACHAPOLY_STATE_CIPHERTEXT  2
+#define OBERON_CHACHAPOLY_STATE_FINISHED    3
+
+/*
+ * nrf_oberon takes the key and the nonce with every incremental call, so
+ * they are kept next to the incremental state.
+ */
+typedef struct
+{
+    ocrypto_chacha20_poly1305_ctx inc;
+    unsigned char key[ocrypto_chacha20_poly1305_KEY_BYTES];
+    unsigned char nonce[ocrypto_chacha20_poly1305_NONCE_BYTES_MAX];
+    int mode;
+    int state;
+} oberon_chachapoly_context;
+
+BUILD_ASSERT_MSG(sizeof(oberon_chachapoly_context) <= 4 * OBERON_MBEDTLS_CHACHAPOLY_CONTEXT_WORDS, "Invalid OBERON_MBEDTLS_CHACHAPOLY_CONTEXT_WORDS value");
+
+static int mbedtls_chachapoly_check(size_t length)
+{
+    return 1;
+}
+
+static void oberon_chachapoly_init(mbedtls_chachapoly_context *ctx)
+{
+    memset(ctx, 0, sizeof(oberon_chachapoly_context));
+}
+
+static void oberon_chachapoly_free(mbedtls_chachapoly_context *ctx)
+{
+    mbedtls_platform_zeroize(ctx, sizeof(oberon_chachapoly_context));
+}
+
+static int oberon_chachapoly_setkey(mbedtls_chachapoly_context *ctx, const unsigned char key[32])
+{
+    oberon_chachapoly_context *p_ctx = (oberon_chachapoly_context *)ctx;
+
+    memcpy(p_ctx->key, key, sizeof(p_ctx->key));
+    p_ctx->state = OBERON_CHACHAPOLY_STATE_INIT;
+    return 0;
+}
+
+static int oberon_chachapoly_starts(mbedtls_chachapoly_context *ctx, const unsigned char nonce[12], mbedtls_chachapoly_mode_t mode)
+{
+    oberon_chachapoly_context *p_ctx = (oberon_chachapoly_context *)ctx;
+
+    memcpy(p_ctx->nonce, nonce, sizeof(p_ctx->nonce));
+    p_ctx->mode = mode;
+    p_ctx->state = OBERON_CHACHAPOLY_STATE_AAD;
+
+    ocrypto_chacha20_poly1305_init(&p_ctx->inc, p_ctx->nonce, sizeof(p_ctx->nonce), p_ctx->key);
+    return 0;
+}
+
+static int oberon_chachapoly_update_aad(mbedtls_chachapoly_context *ctx, const unsigned char *aad, size_t aad_len)
+{
+    oberon_chachapoly_context *p_ctx = (oberon_chachapoly_context *)ctx;
+
+    if (p_ctx->state != OBERON_CHACHAPOLY_STATE_AAD)
+    {
+        return MBEDTLS_ERR_CHACHAPOLY_BAD_STATE;
+    }
+
+    ocrypto_chacha20_poly1305_update_aad(&p_ctx->inc, aad, aad_len);
+    return 0;
+}
+
+static int oberon_chachapoly_update(mbedtls_chachapoly_context *ctx, size_t len, const unsigned char *input, unsigned char *output)
+{
+    oberon_chachapoly_context *p_ctx = (oberon_chachapoly_context *)ctx;
+
+    if (p_ctx->state != OBERON_CHACHAPOLY_STATE_AAD &&
+        p_ctx->state != OBERON_CHACHAPOLY_STATE_CIPHERTEXT)
+    {
+        return MBEDTLS_ERR_CHACHAPOLY_BAD_STATE;
+    }
+
+    p_ctx->state = OBERON_CHACHAPOLY_STATE_CIPHERTEXT;
+
+    if (p_ctx->mode == MBEDTLS_CHACHAPOLY_ENCRYPT)
+    {
+        ocrypto_chacha20_poly1305_update_enc(&p_ctx->inc, output, input, len, p_ctx->nonce, sizeof(p_ctx->nonce), p_ctx->key);
+    }
+    else
+    {
+        ocrypto_chacha20_poly1305_update_dec(&p_ctx->inc, output, input, len, p_ctx->nonce, sizeof(p_ctx->nonce), p_ctx->key);
+    }
+    return 0;
+}
+
+/*
+ * The tag is computed the same way for both directions. As with mbed TLS,
+ * the caller compares it to the received tag after decryption.
+ */
+static int oberon_chachapoly_finish(mbedtls_chachapoly_context *ctx, unsigned char mac[16])
+{
+    oberon_chachapoly_context *p_ctx = (oberon_chachapoly_context *)ctx;
+
+    if (p_ctx->state != OBERON_CHACHAPOLY_STATE_AAD &&
+        p_ctx->state != OBERON_CHACHAPOLY_STATE_CIPHERTEXT)
+    {
+        return MBEDTLS_ERR_CHACHAPOLY_BAD_STATE;
+    }
+
+    ocrypto_chacha20_poly1305_final_enc(&p_ctx->inc, mac);
+    p_ctx->state = OBERON_CHACHAPOLY_STATE_FINISHED;
+    return 0;
+}
+
+static int oberon_chachapoly_encrypt_and_tag(mbedtls_chachapoly_context *ctx, size_t length, const unsigned char nonce[12], const unsigned char *aad, size_t aad_len, const unsigned char *input, unsigned char *output, unsigned char tag[16])
+{
+    oberon_chachapoly_context *p_ctx = (oberon_chachapoly_context *)ctx;
+
+    ocrypto_chacha20_poly1305_encrypt_aad(tag, output, input, length, aad, aad_len, nonce, 12, p_ctx->key);
+    return 0;
+}
+
+static int oberon_chachapoly_auth_decrypt(mbedtls_chachapoly_context *ctx, size_t length, const unsigned char nonce[12], const unsigned char *aad, size_t aad_len, const unsigned char tag[16], const unsigned char *input, unsigned char *output)
+{
+    oberon_chachapoly_context *p_ctx = (oberon_chachapoly_context *)ctx;
+
+    if (ocrypto_chacha20_poly1305_decrypt_aad(tag, output, input, length, aad, aad_len, nonce, 12, p_ctx->key) != 0)
+    {
+        mbedtls_platform_zeroize(output, length);
+        return MBEDTLS_ERR_CHACHAPOLY_AUTH_FAILED;
+    }
+    return 0;
+}
+
+const mbedtls_chachapoly_funcs mbedtls_chachapoly_oberon_backend_funcs = {
+    .backend_context_size = (4 * OBERON_MBEDTLS_CHACHAPOLY_CONTEXT_WORDS),
+    .check = mbedtls_chachapoly_check,
+    .init = oberon_chachapoly_init,
+    .free = oberon_chachapoly_free,
+    .setkey = oberon_chachapoly_setkey,
+    .starts = oberon_chachapoly_starts,
+    .update_aad = oberon_chachapoly_update_aad,
+    .update = oberon_chachapoly_update,
+    .finish = oberon_chachapoly_finish,
+    .encrypt_and_tag = oberon_chachapoly_encrypt_and_tag,
+    .auth_decrypt = oberon_chachapoly_auth_decrypt,
+};
+
+#endif /* CONFIG_GLUE_MBEDTLS_CHACHAPOLY_C */
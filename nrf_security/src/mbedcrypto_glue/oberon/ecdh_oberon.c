@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+
+#if !defined(MBEDTLS_CONFIG_FILE)
+#include "mbedtls/config.h"
+#else
+#include MBEDTLS_CONFIG_FILE
+#endif
+
+#if defined(CONFIG_GLUE_MBEDTLS_ECDH_C)
+
+#include <stdint.h>
+
+#include "mbedtls/ecdh.h"
+#include "mbedtls/platform_util.h"
+#include "backend_ecdh.h"
+#include "ocrypto_curve25519.h"
+
+/* nrf_oberon only implements X25519. */
+static int mbedtls_ecdh_check(mbedtls_ecp_group *grp, int function)
+{
+    return (grp->id == MBEDTLS_ECP_DP_CURVE25519) ? 2 : 0;
+}
+
+/*
+ * mbed TLS keeps Curve25519 scalars and u-coordinates as integers, while
+ * nrf_oberon takes them as little endian byte strings.
+ */
+static int oberon_mpi_write_le(const mbedtls_mpi *X, uint8_t buf[32])
+{
+    uint8_t tmp;
+    int ret;
+    int i;
+
+    ret = mbedtls_mpi_write_binary(X, buf, 32);
+    if (ret != 0)
+    {
+        return ret;
+    }
+
+    for (i = 0; i < 16; i++)
+    {
+        tmp = buf[i];
+        buf[i] = buf[31 - i];
+        buf[31 - i] = tmp;
+    }
+
+    return 0;
+}
+
+static int oberon_mpi_read_le(mbedtls_mpi *X, const uint8_t buf[32])
+{
+    uint8_t be[32];
+    int ret;
+    int i;
+
+    for (i = 0; i < 32; i++)
+    {
+        be[i] = buf[31 - i];
+    }
+
+    ret = mbedtls_mpi_read_binary(X, be, 32);
+    mbedtls_platform_zeroize(be, sizeof(be));
+    return ret;
+}
+
+/* Write an affine Montgomery point, as done by mbedtls_ecp_mul(). */
+static int oberon_point_read_le(mbedtls_ecp_point *Q, const uint8_t u[32])
+{
+    int ret;
+
+    ret = oberon_mpi_read_le(&Q->X, u);
+    if (ret != 0)
+    {
+        return ret;
+    }
+
+    mbedtls_mpi_free(&Q->Y);
+    return mbedtls_mpi_lset(&Q->Z, 1);
+}
+
+static int oberon_ecdh_gen_public(mbedtls_ecp_group *grp, mbedtls_mpi *d, mbedtls_ecp_point *Q, int (*f_rng)(void *, unsigned char *, size_t), void *p_rng)
+{
+    uint8_t n[ocrypto_curve25519_SCALAR_BYTES];
+    uint8_t r[ocrypto_curve25519_BYTES];
+    int ret;
+
+    if (grp->id != MBEDTLS_ECP_DP_CURVE25519)
+    {
+        return MBEDTLS_ERR_ECP_FEATURE_UNAVAILABLE;
+    }
+
+    /* The private key is generated as by mbed TLS, so it is already clamped. */
+    ret = mbedtls_ecp_gen_privkey(grp, d, f_rng, p_rng);
+    if (ret == 0)
+    {
+        ret = oberon_mpi_write_le(d, n);
+    }
+    if (ret == 0)
+    {
+        ocrypto_curve25519_scalarmult_base(r, n);
+        ret = oberon_point_read_le(Q, r);
+    }
+
+    mbedtls_platform_zeroize(n, sizeof(n));
+    return ret;
+}
+
+static int oberon_ecdh_compute_shared(mbedtls_ecp_group *grp, mbedtls_mpi *z, const mbedtls_ecp_point *Q, const mbedtls_mpi *d, int (*f_rng)(void *, unsigned char *, size_t), void *p_rng)
+{
+    uint8_t n[ocrypto_curve25519_SCALAR_BYTES];
+    uint8_t p[ocrypto_curve25519_BYTES];
+    uint8_t r[ocrypto_curve25519_BYTES];
+    mbedtls_mpi u;
+    uint8_t acc;
+    int ret;
+    int i;
+
+    if (grp->id != MBEDTLS_ECP_DP_CURVE25519)
+    {
+        return MBEDTLS_ERR_ECP_FEATURE_UNAVAILABLE;
+    }
+
+    /* The same checks as mbedtls_ecp_mul(). f_rng is not needed, as the
+     * nrf_oberon implementation is constant time without blinding. */
+    ret = mbedtls_ecp_check_privkey(grp, d);
+    if (ret != 0)
+    {
+        return ret;
+    }
+
+    ret = mbedtls_ecp_check_pubkey(grp, Q);
+    if (ret != 0)
+    {
+        return ret;
+    }
+
+    /* mbed TLS computes with u mod p, where X25519 would ignore the top bit. */
+    mbedtls_mpi_init(&u);
+    ret = mbedtls_mpi_mod_mpi(&u, &Q->X, &grp->P);
+    if (ret == 0)
+    {
+        ret = oberon_mpi_write_le(&u, p);
+    }
+    if (ret == 0)
+    {
+        ret = oberon_mpi_write_le(d, n);
+    }
+    if (ret != 0)
+    {
+        goto exit;
+    }
+
+    ocrypto_curve25519_scalarmult(r, n, p);
+
+    /* A point of small order gives zero, which mbed TLS rejects. */
+    acc = 0;
+    for (i = 0; i < ocrypto_curve25519_BYTES; i++)
+    {
+        acc |= r[i];
+    }
+
+    if (acc == 0)
+    {
+        ret = MBEDTLS_ERR_ECP_BAD_INPUT_DATA;
+        goto exit;
+    }
+
+    ret = oberon_mpi_read_le(z, r);
+
+exit:
+    mbedtls_mpi_free(&u);
+    mbedtls_platform_zeroize(n, sizeof(n));
+    mbedtls_platform_zeroize(r, sizeof(r));
+    return ret;
+}
+
+const mbedtls_ecdh_funcs mbedtls_ecdh_oberon_backend_funcs = {
+    .check = mbedtls_ecdh_check,
+    .gen_public = oberon_ecdh_gen_public,
+    .compute_shared = oberon_ecdh_compute_shared,
+};
+
+#endif /* CONFIG_GLUE_MBEDTLS_ECDH_C */
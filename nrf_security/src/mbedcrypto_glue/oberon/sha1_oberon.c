@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+
+#if !defined(MBEDTLS_CONFIG_FILE)
+#include "mbedtls/config.h"
+#else
+#include MBEDTLS_CONFIG_FILE
+#endif
+
+#if defined(CONFIG_GLUE_MBEDTLS_SHA1_C)
+
+#include <string.h>
+#include <toolchain.h>
+
+#include "mbedtls/sha1.h"
+#include "mbedtls/platform_util.h"
+#include "backend_sha1.h"
+#include "ocrypto_sha1.h"
+
+BUILD_ASSERT_MSG(sizeof(ocrypto_sha1_ctx) <= 4 * OBERON_MBEDTLS_SHA1_CONTEXT_WORDS, "Invalid OBERON_MBEDTLS_SHA1_CONTEXT_WORDS value");
+
+static int mbedtls_sha1_check(void)
+{
+    return 1;
+}
+
+static void oberon_sha1_init(mbedtls_sha1_context *ctx)
+{
+    memset(ctx, 0, sizeof(ocrypto_sha1_ctx));
+}
+
+static void oberon_sha1_free(mbedtls_sha1_context *ctx)
+{
+    mbedtls_platform_zeroize(ctx, sizeof(ocrypto_sha1_ctx));
+}
+
+static int oberon_sha1_starts(mbedtls_sha1_context *ctx)
+{
+    ocrypto_sha1_init((ocrypto_sha1_ctx *)ctx);
+    return 0;
+}
+
+static int oberon_sha1_update(mbedtls_sha1_context *ctx, const unsigned char *input, size_t ilen)
+{
+    ocrypto_sha1_update((ocrypto_sha1_ctx *)ctx, input, ilen);
+    return 0;
+}
+
+static int oberon_sha1_finish(mbedtls_sha1_context *ctx, unsigned char output[20])
+{
+    ocrypto_sha1_final((ocrypto_sha1_ctx *)ctx, output);
+    return 0;
+}
+
+/* The compression function is not exposed by nrf_oberon. */
+const mbedtls_sha1_funcs mbedtls_sha1_oberon_backend_funcs = {
+    .backend_context_size = (4 * OBERON_MBEDTLS_SHA1_CONTEXT_WORDS),
+    .check = mbedtls_sha1_check,
+    .init = oberon_sha1_init,
+    .free = oberon_sha1_free,
+    .starts = oberon_sha1_starts,
+    .update = oberon_sha1_update,
+    .finish = oberon_sha1_finish,
+    .process = NULL,
+};
+
+#endif /* CONFIG_GLUE_MBEDTLS_SHA1_C */
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+
+#if !defined(MBEDTLS_CONFIG_FILE)
+#include "mbedtls/config.h"
+#else
+#include MBEDTLS_CONFIG_FILE
+#endif
+
+#if defined(CONFIG_GLUE_MBEDTLS_SHA256_C)
+
+#include <string.h>
+#include <toolchain.h>
+
+#include "mbedtls/sha256.h"
+#include "mbedtls/platform_util.h"
+#include "backend_sha256.h"
+#include "ocrypto_sha256.h"
+
+BUILD_ASSERT_MSG(sizeof(ocrypto_sha256_ctx) <= 4 * OBERON_MBEDTLS_SHA256_CONTEXT_WORDS, "Invalid OBERON_MBEDTLS_SHA256_CONTEXT_WORDS value");
+
+/* nrf_oberon does not implement SHA-224. */
+static int mbedtls_sha256_check(int is224)
+{
+    return is224 ? 0 : 1;
+}
+
+static void oberon_sha256_init(mbedtls_sha256_context *ctx)
+{
+    memset(ctx, 0, sizeof(ocrypto_sha256_ctx));
+}
+
+static void oberon_sha256_free(mbedtls_sha256_context *ctx)
+{
+    mbedtls_platform_zeroize(ctx, sizeof(ocrypto_sha256_ctx));
+}
+
+static int oberon_sha256_starts(mbedtls_sha256_context *ctx, int is224)
+{
+    if (is224)
+    {
+        return MBEDTLS_ERR_SHA256_HW_ACCEL_FAILED;
+    }
+
+    ocrypto_sha256_init((ocrypto_sha256_ctx *)ctx);
+    return 0;
+}
+
+static int oberon_sha256_update(mbedtls_sha256_context *ctx, const unsigned char *input, size_t ilen)
+{
+    ocrypto_sha256_update((ocrypto_sha256_ctx *)ctx, input, ilen);
+    return 0;
+}
+
+static int oberon_sha256_finish(mbedtls_sha256_context *ctx, unsigned char output[32])
+{
+    ocrypto_sha256_final((ocrypto_sha256_ctx *)ctx, output);
+    return 0;
+}
+
+/* The compression function is not exposed by nrf_oberon. */
+const mbedtls_sha256_funcs mbedtls_sha256_oberon_backend_funcs = {
+    .backend_context_size = (4 * OBERON_MBEDTLS_SHA256_CONTEXT_WORDS),
+    .check = mbedtls_sha256_check,
+    .init = oberon_sha256_init,
+    .free = oberon_sha256_free,
+    .starts = oberon_sha256_starts,
+    .update = oberon_sha256_update,
+    .finish = oberon_sha256_finish,
+    .process = NULL,
+};
+
+#endif /* CONFIG_GLUE_MBEDTLS_SHA256_C */
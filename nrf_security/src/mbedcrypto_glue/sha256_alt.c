@@ -0,0 +1,287 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+#if !defined(MBEDTLS_CONFIG_FILE)
+#include "mbedtls/config.h"
+#else
+#include MBEDTLS_CONFIG_FILE
+#endif
+
+#if defined(MBEDTLS_SHA256_C) && defined(CONFIG_GLUE_MBEDTLS_SHA256_C)
+
+#include <string.h>
+#include <stddef.h>
+
+#include "mbedtls/sha256.h"
+#include "mbedtls/platform_util.h"
+#include "backend_sha256.h"
+#include "backend_trace.h"
+
+#if defined(CONFIG_GLUE_LOAD_AWARE_DISPATCH)
+#include "nrf_cc310_platform_mutex.h"
+#endif
+
+
+#define SHA256_CONTEXT_INIT(ctx) do { ctx->handle = NULL; } while (0)
+#define SHA256_CONTEXT_ALLOC(ctx, funcs, backend_context, new_funcs) do { ctx->handle = (void*)new_funcs; funcs = new_funcs; backend_context = &ctx->buffer; } while (0)
+#define SHA256_CONTEXT_UNPACK(ctx, funcs, backend_context) do { funcs = ctx->handle; backend_context = &ctx->buffer; } while (0)
+#define SHA256_CONTEXT_FREE(ctx) do { ctx->handle = NULL; } while (0)
+
+#define SHA256_CONTEXT_UNPACK_NOT_NULL(ctx, funcs, backend_context) do { \
+        SHA256_CONTEXT_UNPACK(ctx, funcs, backend_context); \
+        if (funcs == NULL) \
+        { \
+            return MBEDTLS_ERR_SHA256_HW_ACCEL_FAILED; \
+        } \
+    } while (0)
+
+
+extern const mbedtls_sha256_funcs mbedtls_sha256_cc310_backend_funcs;
+extern const mbedtls_sha256_funcs mbedtls_sha256_oberon_backend_funcs;
+
+
+static const mbedtls_sha256_funcs* sha256_backends[] = {
+    &mbedtls_sha256_cc310_backend_funcs,
+    &mbedtls_sha256_oberon_backend_funcs,
+};
+
+static const mbedtls_sha256_funcs* find_backend(int is224)
+{
+    int max_priority = 0;
+    const mbedtls_sha256_funcs* funcs = NULL;
+    int priority;
+    int i;
+    for (i = 0; i < sizeof(sha256_backends) / sizeof(sha256_backends[0]); i++)
+    {
+        priority = sha256_backends[i]->check(is224);
+        if (priority > max_priority)
+        {
+            max_priority = priority;
+            funcs = sha256_backends[i];
+        }
+    }
+    return funcs;
+}
+
+static const mbedtls_sha256_funcs* get_backend(int is224)
+{
+    const mbedtls_sha256_funcs* funcs = find_backend(is224);
+
+#if defined(CONFIG_GLUE_LOAD_AWARE_DISPATCH)
+    /* Use software if the CC310 is busy with another symmetric operation. */
+    if (funcs == &mbedtls_sha256_cc310_backend_funcs &&
+        nrf_cc310_platform_mutex_is_busy(platform_mutexes.sym_mutex) &&
+        mbedtls_sha256_oberon_backend_funcs.check(is224) > 0)
+    {
+        funcs = &mbedtls_sha256_oberon_backend_funcs;
+    }
+#endif
+
+    return funcs;
+}
+
+static int backend_index(const mbedtls_sha256_funcs* funcs)
+{
+    int i;
+    for (i = 0; i < sizeof(sha256_backends) / sizeof(sha256_backends[0]); i++)
+    {
+        if (sha256_backends[i] == funcs)
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+void mbedtls_sha256_init(mbedtls_sha256_context *ctx)
+{
+    SHA256_CONTEXT_INIT(ctx);
+}
+
+void mbedtls_sha256_free(mbedtls_sha256_context *ctx)
+{
+    const mbedtls_sha256_funcs* funcs;
+    void* backend_context;
+
+    if (ctx == NULL)
+    {
+        return;
+    }
+
+    SHA256_CONTEXT_UNPACK(ctx, funcs, backend_context);
+    if (funcs != NULL)
+    {
+        funcs->free(backend_context);
+        SHA256_CONTEXT_FREE(ctx);
+    }
+    mbedtls_platform_zeroize(ctx, sizeof(mbedtls_sha256_context));
+}
+
+/* Backend contexts hold no pointers, so a copy is a valid clone. */
+void mbedtls_sha256_clone(mbedtls_sha256_context *dst, const mbedtls_sha256_context *src)
+{
+    *dst = *src;
+}
+
+int mbedtls_sha256_starts_ret(mbedtls_sha256_context *ctx, int is224)
+{
+    const mbedtls_sha256_funcs* new_funcs;
+    const mbedtls_sha256_funcs* funcs;
+    void* backend_context;
+
+    new_funcs = get_backend(is224);
+    if (new_funcs == NULL)
+    {
+        return MBEDTLS_ERR_SHA256_HW_ACCEL_FAILED;
+    }
+
+    SHA256_CONTEXT_UNPACK(ctx, funcs, backend_context);
+    if (funcs != new_funcs)
+    {
+        if (funcs != NULL)
+        {
+            funcs->free(backend_context);
+            SHA256_CONTEXT_FREE(ctx);
+        }
+
+        SHA256_CONTEXT_ALLOC(ctx, funcs, backend_context, new_funcs);
+        funcs->init(backend_context);
+    }
+
+    return funcs->starts(backend_context, is224);
+}
+
+int mbedtls_sha256_update_ret(mbedtls_sha256_context *ctx, const unsigned char *input, size_t ilen)
+{
+    const mbedtls_sha256_funcs* funcs;
+    void* backend_context;
+    SHA256_CONTEXT_UNPACK_NOT_NULL(ctx, funcs, backend_context);
+    return BACKEND_TRACE(BACKEND_TRACE_SHA256_UPDATE, funcs, ilen, funcs->update(backend_context, input, ilen));
+}
+
+int mbedtls_sha256_finish_ret(mbedtls_sha256_context *ctx, unsigned char output[32])
+{
+    const mbedtls_sha256_funcs* funcs;
+    void* backend_context;
+    SHA256_CONTEXT_UNPACK_NOT_NULL(ctx, funcs, backend_context);
+    return funcs->finish(backend_context, output);
+}
+
+int mbedtls_internal_sha256_process(mbedtls_sha256_context *ctx, const unsigned char data[64])
+{
+    const mbedtls_sha256_funcs* funcs;
+    void* backend_context;
+    SHA256_CONTEXT_UNPACK_NOT_NULL(ctx, funcs, backend_context);
+    if (funcs->process == NULL)
+    {
+        return MBEDTLS_ERR_SHA256_HW_ACCEL_FAILED;
+    }
+    return funcs->process(backend_context, data);
+}
+
+int mbedtls_sha256_ret(const unsigned char *input, size_t ilen, unsigned char output[32], int is224)
+{
+    int ret;
+    mbedtls_sha256_context ctx;
+
+    mbedtls_sha256_init(&ctx);
+
+    ret = mbedtls_sha256_starts_ret(&ctx, is224);
+    if (ret == 0)
+    {
+        ret = mbedtls_sha256_update_ret(&ctx, input, ilen);
+    }
+    if (ret == 0)
+    {
+        ret = mbedtls_sha256_finish_ret(&ctx, output);
+    }
+
+    mbedtls_sha256_free(&ctx);
+    return ret;
+}
+
+/*
+ * The saved state is the index of the backend followed by its context.
+ */
+int mbedtls_sha256_save_state(const mbedtls_sha256_context *ctx, unsigned char *state, size_t state_size, size_t *olen)
+{
+    const mbedtls_sha256_funcs* funcs = ctx->handle;
+    int index = backend_index(funcs);
+
+    if (index < 0)
+    {
+        return MBEDTLS_ERR_SHA256_HW_ACCEL_FAILED;
+    }
+
+    if (state_size < 4 + funcs->backend_context_size)
+    {
+        return MBEDTLS_ERR_SHA256_HW_ACCEL_FAILED;
+    }
+
+    memset(state, 0, 4);
+    state[0] = (unsigned char)index;
+    memcpy(state + 4, &ctx->buffer, funcs->backend_context_size);
+    *olen = 4 + funcs->backend_context_size;
+    return 0;
+}
+
+int mbedtls_sha256_restore_state(mbedtls_sha256_context *ctx, const unsigned char *state, size_t state_len)
+{
+    const mbedtls_sha256_funcs* new_funcs;
+    const mbedtls_sha256_funcs* funcs;
+    void* backend_context;
+
+    if (state_len < 4 ||
+        state[0] >= sizeof(sha256_backends) / sizeof(sha256_backends[0]))
+    {
+        return MBEDTLS_ERR_SHA256_HW_ACCEL_FAILED;
+    }
+
+    new_funcs = sha256_backends[state[0]];
+    if (state_len != 4 + new_funcs->backend_context_size)
+    {
+        return MBEDTLS_ERR_SHA256_HW_ACCEL_FAILED;
+    }
+
+    SHA256_CONTEXT_UNPACK(ctx, funcs, backend_context);
+    if (funcs != NULL)
+    {
+        funcs->free(backend_context);
+        SHA256_CONTEXT_FREE(ctx);
+    }
+
+    SHA256_CONTEXT_ALLOC(ctx, funcs, backend_context, new_funcs);
+    memcpy(backend_context, state + 4, funcs->backend_context_size);
+    return 0;
+}
+
+#if !defined(MBEDTLS_DEPRECATED_REMOVED)
+void mbedtls_sha256_starts(mbedtls_sha256_context *ctx, int is224)
+{
+    mbedtls_sha256_starts_ret(ctx, is224);
+}
+
+void mbedtls_sha256_update(mbedtls_sha256_context *ctx, const unsigned char *input, size_t ilen)
+{
+    mbedtls_sha256_update_ret(ctx, input, ilen);
+}
+
+void mbedtls_sha256_finish(mbedtls_sha256_context *ctx, unsigned char output[32])
+{
+    mbedtls_sha256_finish_ret(ctx, output);
+}
+
+void mbedtls_sha256_process(mbedtls_sha256_context *ctx, const unsigned char data[64])
+{
+    mbedtls_internal_sha256_process(ctx, data);
+}
+
+void mbedtls_sha256(const unsigned char *input, size_t ilen, unsigned char output[32], int is224)
+{
+    mbedtls_sha256_ret(input, ilen, output, is224);
+}
+#endif /* MBEDTLS_DEPRECATED_REMOVED */
+
+#endif /* MBEDTLS_SHA256_C && CONFIG_GLUE_MBEDTLS_SHA256_C */
@@ -12,9 +12,11 @@
 #if defined(CONFIG_VANILLA_MBEDTLS_CCM_C) && defined(CONFIG_GLUE_MBEDTLS_CCM_C)
 
 #include <toolchain.h>
+#include <string.h>
 
 #include "mbedtls/ccm.h"
 #include "mbedtls/cipher.h"
+#include "mbedtls/platform_util.h"
 #include "backend_ccm.h"
 
 
@@ -26,6 +28,307 @@ static int mbedtls_ccm_check(mbedtls_cipher_id_t cipher, unsigned int keybits)
     return 1;
 }
 
+/*
+ * Scatter-gather CCM/CCM*, following the same steps as ccm_auth_crypt() in
+ * standard mbed TLS. The standard mbed TLS CCM context only holds the cipher
+ * context set up for ECB by mbedtls_ccm_setkey(), which is used directly here.
+ */
+typedef struct
+{
+    const mbedtls_ccm_iovec *iov;
+    size_t count;
+    size_t index;
+    size_t offset;
+} iov_cursor;
+
+static void iov_cursor_init(iov_cursor *cursor, const mbedtls_ccm_iovec *iov, size_t count)
+{
+    cursor->iov = iov;
+    cursor->count = count;
+    cursor->index = 0;
+    cursor->offset = 0;
+}
+
+static size_t iov_total_len(const mbedtls_ccm_iovec *iov, size_t count)
+{
+    size_t total = 0;
+    size_t i;
+    for (i = 0; i < count; i++)
+    {
+        total += iov[i].len;
+    }
+    return total;
+}
+
+/* Copy up to len bytes from the cursor position, returning the number copied. */
+static size_t iov_read(iov_cursor *cursor, unsigned char *dst, size_t len)
+{
+    size_t copied = 0;
+    size_t chunk;
+
+    while (copied < len && cursor->index < cursor->count)
+    {
+        chunk = cursor->iov[cursor->index].len - cursor->offset;
+        if (chunk > len - copied)
+        {
+            chunk = len - copied;
+        }
+        memcpy(dst + copied, cursor->iov[cursor->index].base + cursor->offset, chunk);
+        copied += chunk;
+        cursor->offset += chunk;
+        if (cursor->offset == cursor->iov[cursor->index].len)
+        {
+            cursor->index++;
+            cursor->offset = 0;
+        }
+    }
+
+    return copied;
+}
+
+static void iov_write(iov_cursor *cursor, const unsigned char *src, size_t len)
+{
+    size_t written = 0;
+    size_t chunk;
+
+    while (written < len && cursor->index < cursor->count)
+    {
+        chunk = cursor->iov[cursor->index].len - cursor->offset;
+        if (chunk > len - written)
+        {
+            chunk = len - written;
+        }
+        memcpy(cursor->iov[cursor->index].base + cursor->offset, src + written, chunk);
+        written += chunk;
+        cursor->offset += chunk;
+        if (cursor->offset == cursor->iov[cursor->index].len)
+        {
+            cursor->index++;
+            cursor->offset = 0;
+        }
+    }
+}
+
+static int ccm_block_encrypt(mbedtls_cipher_context_t *cipher_ctx, const unsigned char in[16], unsigned char out[16])
+{
+    size_t olen;
+    return mbedtls_cipher_update(cipher_ctx, in, 16, out, &olen);
+}
+
+static int ccm_auth_crypt_iov(mbedtls_cipher_context_t *cipher_ctx, int decrypt, int star,
+                              const unsigned char *iv, size_t iv_len,
+                              const mbedtls_ccm_iovec *add, size_t add_count,
+                              const mbedtls_ccm_iovec *input, size_t input_count,
+                              const mbedtls_ccm_iovec *output, size_t output_count,
+                              unsigned char *tag, size_t tag_len)
+{
+    int ret;
+    unsigned char i;
+    unsigned char q;
+    size_t len_left;
+    size_t use_len;
+    size_t add_len = iov_total_len(add, add_count);
+    size_t length = iov_total_len(input, input_count);
+    unsigned char b[16];
+    unsigned char y[16];
+    unsigned char ctr[16];
+    unsigned char ks[16];
+    iov_cursor in_cursor;
+    iov_cursor out_cursor;
+
+    if ((star && tag_len == 2) || (!star && tag_len < 4) || tag_len > 16 || tag_len % 2 != 0)
+    {
+        return MBEDTLS_ERR_CCM_BAD_INPUT;
+    }
+
+    if (iv_len < 7 || iv_len > 13 || add_len > 0xFF00 ||
+        length != iov_total_len(output, output_count))
+    {
+        return MBEDTLS_ERR_CCM_BAD_INPUT;
+    }
+
+    q = 16 - 1 - (unsigned char)iv_len;
+
+    /* First block B_0: flags, nonce and message length. */
+    b[0] = 0;
+    b[0] |= (add_len > 0) << 6;
+    if (tag_len > 0)
+    {
+        b[0] |= ((tag_len - 2) / 2) << 3;
+    }
+    b[0] |= q - 1;
+
+    memcpy(b + 1, iv, iv_len);
+
+    for (i = 0, len_left = length; i < q; i++, len_left >>= 8)
+    {
+        b[15 - i] = (unsigned char)(len_left & 0xFF);
+    }
+
+    if (len_left > 0)
+    {
+        return MBEDTLS_ERR_CCM_BAD_INPUT;
+    }
+
+    ret = ccm_block_encrypt(cipher_ctx, b, y);
+    if (ret != 0)
+    {
+        goto exit;
+    }
+
+    /* CBC-MAC over the associated data, prefixed with its 2-byte length. */
+    if (add_len > 0)
+    {
+        iov_cursor_init(&in_cursor, add, add_count);
+
+        memset(b, 0, 16);
+        b[0] = (unsigned char)((add_len >> 8) & 0xFF);
+        b[1] = (unsigned char)(add_len & 0xFF);
+        use_len = iov_read(&in_cursor, b + 2, 14);
+        len_left = add_len - use_len;
+
+        for (;;)
+        {
+            for (i = 0; i < 16; i++)
+            {
+                y[i] ^= b[i];
+            }
+
+            ret = ccm_block_encrypt(cipher_ctx, y, y);
+            if (ret != 0)
+            {
+                goto exit;
+            }
+
+            if (len_left == 0)
+            {
+                break;
+            }
+
+            memset(b, 0, 16);
+            len_left -= iov_read(&in_cursor, b, 16);
+        }
+    }
+
+    /* Counter block: flags, nonce and a counter starting at 0. */
+    ctr[0] = q - 1;
+    memcpy(ctr + 1, iv, iv_len);
+    memset(ctr + 1 + iv_len, 0, q);
+    ctr[15] = 1;
+
+    iov_cursor_init(&in_cursor, input, input_count);
+    iov_cursor_init(&out_cursor, output, output_count);
+    len_left = length;
+
+    while (len_left > 0)
+    {
+        use_len = (len_left > 16) ? 16 : len_left;
+
+        memset(b, 0, 16);
+        iov_read(&in_cursor, b, use_len);
+
+        ret = ccm_block_encrypt(cipher_ctx, ctr, ks);
+        if (ret != 0)
+        {
+            goto exit;
+        }
+
+        if (!decrypt)
+        {
+            for (i = 0; i < 16; i++)
+            {
+                y[i] ^= b[i];
+            }
+        }
+
+        for (i = 0; i < use_len; i++)
+        {
+            b[i] ^= ks[i];
+        }
+
+        if (decrypt)
+        {
+            /* Authenticate the plaintext, padded with zeros. */
+            memset(b + use_len, 0, 16 - use_len);
+            for (i = 0; i < 16; i++)
+            {
+                y[i] ^= b[i];
+            }
+        }
+
+        ret = ccm_block_encrypt(cipher_ctx, y, y);
+        if (ret != 0)
+        {
+            goto exit;
+        }
+
+        iov_write(&out_cursor, b, use_len);
+        len_left -= use_len;
+
+        /* Increment the counter, which is at most q bytes wide. */
+        for (i = 0; i < q; i++)
+        {
+            if (++ctr[15 - i] != 0)
+            {
+                break;
+            }
+        }
+    }
+
+    /* Authentication tag: T XOR S_0, with the counter reset to 0. */
+    memset(ctr + 1 + iv_len, 0, q);
+    ret = ccm_block_encrypt(cipher_ctx, ctr, ks);
+    if (ret != 0)
+    {
+        goto exit;
+    }
+
+    for (i = 0; i < tag_len; i++)
+    {
+        y[i] ^= ks[i];
+    }
+
+    if (decrypt)
+    {
+        unsigned char diff = 0;
+
+        for (i = 0; i < tag_len; i++)
+        {
+            diff |= tag[i] ^ y[i];
+        }
+
+        if (diff != 0)
+        {
+            size_t j;
+            for (j = 0; j < output_count; j++)
+            {
+                mbedtls_platform_zeroize(output[j].base, output[j].len);
+            }
+            ret = MBEDTLS_ERR_CCM_AUTH_FAILED;
+        }
+    }
+    else
+    {
+        memcpy(tag, y, tag_len);
+    }
+
+exit:
+    mbedtls_platform_zeroize(b, sizeof(b));
+    mbedtls_platform_zeroize(y, sizeof(y));
+    mbedtls_platform_zeroize(ks, sizeof(ks));
+    return ret;
+}
+
+static int ccm_vanilla_encrypt_and_tag_iov(mbedtls_ccm_context *ctx, int star, const unsigned char *iv, size_t iv_len, const mbedtls_ccm_iovec *add, size_t add_count, const mbedtls_ccm_iovec *input, size_t input_count, const mbedtls_ccm_iovec *output, size_t output_count, unsigned char *tag, size_t tag_len)
+{
+    return ccm_auth_crypt_iov((mbedtls_cipher_context_t *)ctx, 0, star, iv, iv_len, add, add_count, input, input_count, output, output_count, tag, tag_len);
+}
+
+static int ccm_vanilla_auth_decrypt_iov(mbedtls_ccm_context *ctx, int star, const unsigned char *iv, size_t iv_len, const mbedtls_ccm_iovec *add, size_t add_count, const mbedtls_ccm_iovec *input, size_t input_count, const mbedtls_ccm_iovec *output, size_t output_count, const unsigned char *tag, size_t tag_len)
+{
+    return ccm_auth_crypt_iov((mbedtls_cipher_context_t *)ctx, 1, star, iv, iv_len, add, add_count, input, input_count, output, output_count, (unsigned char *)tag, tag_len);
+}
+
 const mbedtls_ccm_funcs mbedtls_ccm_vanilla_mbedtls_backend_funcs = {
     .backend_context_size = (4 * VANILLA_MBEDTLS_CCM_CONTEXT_WORDS),
     .check = mbedtls_ccm_check,
@@ -36,6 +339,8 @@ const mbedtls_ccm_funcs mbedtls_ccm_vanilla_mbedtls_backend_funcs = {
     .star_encrypt_and_tag = mbedtls_ccm_star_encrypt_and_tag,
     .auth_decrypt = mbedtls_ccm_auth_decrypt,
     .star_auth_decrypt = mbedtls_ccm_star_auth_decrypt,
+    .encrypt_and_tag_iov = ccm_vanilla_encrypt_and_tag_iov,
+    .auth_decrypt_iov = ccm_vanilla_auth_decrypt_iov,
 };
 
 #endif
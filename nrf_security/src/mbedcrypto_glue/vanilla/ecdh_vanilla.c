@@ -17,10 +17,48 @@ static int mbedtls_ecdh_check(mbedtls_ecp_group *grp, int function)
     return 1;
 }
 
+/*
+ * The glue replaces mbedtls_ecdh_gen_public() and mbedtls_ecdh_compute_shared()
+ * in ecdh.c, so these are the mbed TLS implementations on top of ECP.
+ */
+static int vanilla_ecdh_gen_public(mbedtls_ecp_group *grp, mbedtls_mpi *d, mbedtls_ecp_point *Q, int (*f_rng)(void *, unsigned char *, size_t), void *p_rng)
+{
+    int ret;
+
+    ret = mbedtls_ecp_gen_privkey(grp, d, f_rng, p_rng);
+    if (ret != 0)
+    {
+        return ret;
+    }
+
+    return mbedtls_ecp_mul(grp, Q, d, &grp->G, f_rng, p_rng);
+}
+
+static int vanilla_ecdh_compute_shared(mbedtls_ecp_group *grp, mbedtls_mpi *z, const mbedtls_ecp_point *Q, const mbedtls_mpi *d, int (*f_rng)(void *, unsigned char *, size_t), void *p_rng)
+{
+    mbedtls_ecp_point P;
+    int ret;
+
+    mbedtls_ecp_point_init(&P);
+
+    ret = mbedtls_ecp_mul(grp, &P, d, Q, f_rng, p_rng);
+    if (ret == 0 && mbedtls_ecp_is_zero(&P))
+    {
+        ret = MBEDTLS_ERR_ECP_BAD_INPUT_DATA;
+    }
+    if (ret == 0)
+    {
+        ret = mbedtls_mpi_copy(z, &P.X);
+    }
+
+    mbedtls_ecp_point_free(&P);
+    return ret;
+}
+
 const mbedtls_ecdh_funcs mbedtls_ecdh_vanilla_mbedtls_backend_funcs = {
     .check = mbedtls_ecdh_check,
-    .gen_public = mbedtls_ecdh_gen_public,
-    .compute_shared = mbedtls_ecdh_compute_shared,
+    .gen_public = vanilla_ecdh_gen_public,
+    .compute_shared = vanilla_ecdh_compute_shared,
 };
 
 #endif
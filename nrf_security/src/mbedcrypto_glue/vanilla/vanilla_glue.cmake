@@ -18,6 +18,11 @@ if (CONFIG_GLUE_MBEDTLS_DHM_C AND CONFIG_VANILLA_MBEDTLS_DHM_C)
   nrf_security_debug("Vanilla backend glue: DHM")
 endif()
 
+if (CONFIG_GLUE_MBEDTLS_ECDH_C AND CONFIG_VANILLA_MBEDTLS_ECDH_C)
+  set(GLUE_VANILLA_MBEDTLS_ECDH_C TRUE)
+  nrf_security_debug("Vanilla backend glue: ECDH")
+endif()
+
 nrf_security_debug("######### Creating vanilla noglue library #########")
 
 #
@@ -87,6 +92,11 @@ zephyr_library_sources_ifdef(GLUE_VANILLA_MBEDTLS_DHM_C
   ${CMAKE_CURRENT_LIST_DIR}/dhm_vanilla.c
 )
 
+# ECDH is implemented on ECP in the glue file, ecdh.c stays in the base library
+zephyr_library_sources_ifdef(GLUE_VANILLA_MBEDTLS_ECDH_C
+  ${CMAKE_CURRENT_LIST_DIR}/ecdh_vanilla.c
+)
+
 zephyr_library_sources(${ZEPHYR_BASE}/misc/empty_file.c)
 zephyr_library_compile_definitions(MBEDTLS_BACKEND_PREFIX=vanilla)
 zephyr_library_link_libraries(mbedtls_common_glue)
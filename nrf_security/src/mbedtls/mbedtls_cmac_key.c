@@ -0,0 +1,215 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+
+#include <string.h>
+
+#include "mbedtls/aes.h"
+#include "mbedtls/platform_util.h"
+#include "mbedtls_cmac_key.h"
+
+#define CMAC_BLOCK_SIZE 16
+
+#if (MBEDTLS_CMAC_KEY_CHUNK_SIZE % CMAC_BLOCK_SIZE) != 0
+#error "MBEDTLS_CMAC_KEY_CHUNK_SIZE must be a multiple of the AES block size"
+#endif
+
+/* Multiply by x in GF(2^128), as done for the subkeys in RFC 4493. */
+static void cmac_key_double(unsigned char out[CMAC_BLOCK_SIZE],
+			    const unsigned char in[CMAC_BLOCK_SIZE])
+{
+	unsigned char msb = in[0] >> 7;
+
+	for (int i = 0; i < CMAC_BLOCK_SIZE - 1; i++) {
+		out[i] = (unsigned char)((in[i] << 1) | (in[i + 1] >> 7));
+	}
+
+	out[CMAC_BLOCK_SIZE - 1] = (unsigned char)(in[CMAC_BLOCK_SIZE - 1] << 1);
+	if (msb) {
+		out[CMAC_BLOCK_SIZE - 1] ^= 0x87;
+	}
+}
+
+static int cmac_key_subkeys(mbedtls_cmac_key_context *ctx)
+{
+	unsigned char l[CMAC_BLOCK_SIZE] = { 0 };
+	int ret;
+
+	ret = mbedtls_aes_crypt_ecb(&ctx->aes, MBEDTLS_AES_ENCRYPT, l, l);
+	if (ret == 0) {
+		cmac_key_double(ctx->k1, l);
+		cmac_key_double(ctx->k2, ctx->k1);
+	}
+
+	mbedtls_platform_zeroize(l, sizeof(l));
+	return ret;
+}
+
+/* CBC-MAC of whole blocks into state. mbedtls_aes_crypt_cbc() leaves the
+ * last ciphertext block in its IV, which is the CBC-MAC state.
+ */
+static int cmac_key_cbc_mac(mbedtls_cmac_key_context *ctx,
+			    unsigned char state[CMAC_BLOCK_SIZE],
+			    const unsigned char *input, size_t len)
+{
+#if defined(MBEDTLS_CIPHER_MODE_CBC)
+	unsigned char scratch[MBEDTLS_CMAC_KEY_CHUNK_SIZE];
+	size_t chunk;
+	int ret = 0;
+
+	while (len > 0) {
+		chunk = len < sizeof(scratch) ? len : sizeof(scratch);
+
+		ret = mbedtls_aes_crypt_cbc(&ctx->aes, MBEDTLS_AES_ENCRYPT,
+					    chunk, state, input, scratch);
+		if (ret != 0) {
+			break;
+		}
+
+		input += chunk;
+		len -= chunk;
+	}
+
+	mbedtls_platform_zeroize(scratch, sizeof(scratch));
+	return ret;
+#else
+	int ret;
+
+	while (len > 0) {
+		for (int i = 0; i < CMAC_BLOCK_SIZE; i++) {
+			state[i] ^= input[i];
+		}
+
+		ret = mbedtls_aes_crypt_ecb(&ctx->aes, MBEDTLS_AES_ENCRYPT,
+					    state, state);
+		if (ret != 0) {
+			return ret;
+		}
+
+		input += CMAC_BLOCK_SIZE;
+		len -= CMAC_BLOCK_SIZE;
+	}
+
+	return 0;
+#endif /* MBEDTLS_CIPHER_MODE_CBC */
+}
+
+void mbedtls_cmac_key_init(mbedtls_cmac_key_context *ctx)
+{
+	memset(ctx, 0, sizeof(*ctx));
+	mbedtls_aes_init(&ctx->aes);
+}
+
+void mbedtls_cmac_key_free(mbedtls_cmac_key_context *ctx)
+{
+	if (ctx == NULL) {
+		return;
+	}
+
+	mbedtls_aes_free(&ctx->aes);
+	mbedtls_platform_zeroize(ctx, sizeof(*ctx));
+}
+
+int mbedtls_cmac_key_setkey(mbedtls_cmac_key_context *ctx,
+			    const unsigned char *key, unsigned int keybits)
+{
+	int ret;
+
+	ret = mbedtls_aes_setkey_enc(&ctx->aes, key, keybits);
+	if (ret != 0) {
+		return ret;
+	}
+
+	return cmac_key_subkeys(ctx);
+}
+
+int mbedtls_cmac_key_setkey_prf_128(mbedtls_cmac_key_context *ctx,
+				    const unsigned char *key, size_t key_len)
+{
+	static const unsigned char zero_key[CMAC_BLOCK_SIZE];
+	unsigned char derived[CMAC_BLOCK_SIZE];
+	int ret;
+
+	if (key_len == CMAC_BLOCK_SIZE) {
+		return mbedtls_cmac_key_setkey(ctx, key, 128);
+	}
+
+	/* RFC 4615: other key lengths are reduced to AES-CMAC(0, key). */
+	ret = mbedtls_cmac_key_setkey(ctx, zero_key, 128);
+	if (ret == 0) {
+		ret = mbedtls_cmac_key_compute(ctx, key, key_len, derived);
+	}
+	if (ret == 0) {
+		ret = mbedtls_cmac_key_setkey(ctx, derived, 128);
+	}
+
+	mbedtls_platform_zeroize(derived, sizeof(derived));
+	return ret;
+}
+
+int mbedtls_cmac_key_compute(mbedtls_cmac_key_context *ctx,
+			     const unsigned char *input, size_t ilen,
+			     unsigned char output[16])
+{
+	unsigned char state[CMAC_BLOCK_SIZE] = { 0 };
+	unsigned char last[CMAC_BLOCK_SIZE];
+	const unsigned char *subkey;
+	size_t last_len;
+	int ret;
+
+	/* The last block, complete or not, is handled with a subkey. An empty
+	 * message is a single padded block.
+	 */
+	last_len = ilen % CMAC_BLOCK_SIZE;
+	if (ilen > 0 && last_len == 0) {
+		last_len = CMAC_BLOCK_SIZE;
+	}
+
+	ret = cmac_key_cbc_mac(ctx, state, input, ilen - last_len);
+	if (ret != 0) {
+		goto exit;
+	}
+
+	if (last_len > 0) {
+		memcpy(last, input + ilen - last_len, last_len);
+	}
+	if (last_len == CMAC_BLOCK_SIZE) {
+		subkey = ctx->k1;
+	} else {
+		last[last_len] = 0x80;
+		memset(last + last_len + 1, 0, CMAC_BLOCK_SIZE - last_len - 1);
+		subkey = ctx->k2;
+	}
+
+	for (int i = 0; i < CMAC_BLOCK_SIZE; i++) {
+		state[i] ^= last[i] ^ subkey[i];
+	}
+
+	ret = mbedtls_aes_crypt_ecb(&ctx->aes, MBEDTLS_AES_ENCRYPT, state,
+				    output);
+
+exit:
+	mbedtls_platform_zeroize(state, sizeof(state));
+	mbedtls_platform_zeroize(last, sizeof(last));
+	return ret;
+}
+
+int mbedtls_cmac_key_compute_batch(mbedtls_cmac_key_context *ctx,
+				   const unsigned char *const inputs[],
+				   const size_t ilens[],
+				   unsigned char outputs[][16], size_t count)
+{
+	int ret;
+
+	for (size_t i = 0; i < count; i++) {
+		ret = mbedtls_cmac_key_compute(ctx, inputs[i], ilens[i],
+					       outputs[i]);
+		if (ret != 0) {
+			return ret;
+		}
+	}
+
+	return 0;
+}
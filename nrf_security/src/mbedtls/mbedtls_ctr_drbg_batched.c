@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+
+#include <string.h>
+
+#include "mbedtls/ctr_drbg.h"
+#include "mbedtls/aes.h"
+#include "mbedtls/platform_util.h"
+#if defined(MBEDTLS_THREADING_C)
+#include "mbedtls/threading.h"
+#endif
+#include "mbedtls_ctr_drbg_batched.h"
+
+#if !defined(MBEDTLS_CIPHER_MODE_CTR)
+#error "MBEDTLS_CIPHER_MODE_CTR is required for the batched CTR_DRBG"
+#endif
+
+static void ctr_drbg_counter_increment(unsigned char *counter)
+{
+	for (int i = MBEDTLS_CTR_DRBG_BLOCKSIZE; i > 0; i--) {
+		if (++counter[i - 1] != 0) {
+			break;
+		}
+	}
+}
+
+/* Generate and update without additional input, as done by
+ * mbedtls_ctr_drbg_random_with_add().
+ *
+ * The generate step encrypts V + 1 ... V + n, and the update step encrypts
+ * V + n + 1 ... and XORs with zero. Both are AES-CTR keystreams. The update
+ * restarts at a block boundary, as mbedtls_aes_crypt_ctr() has already
+ * stepped past a partially used last block.
+ */
+static int ctr_drbg_generate(mbedtls_ctr_drbg_context *ctx,
+			     unsigned char *output, size_t output_len)
+{
+	unsigned char tmp[MBEDTLS_CTR_DRBG_SEEDLEN];
+	unsigned char stream_block[MBEDTLS_CTR_DRBG_BLOCKSIZE];
+	size_t nc_off;
+	int ret;
+
+	if (ctx->reseed_counter > ctx->reseed_interval ||
+	    ctx->prediction_resistance) {
+		ret = mbedtls_ctr_drbg_reseed(ctx, NULL, 0);
+		if (ret != 0) {
+			return ret;
+		}
+	}
+
+	ctr_drbg_counter_increment(ctx->counter);
+
+	if (output_len > 0) {
+		memset(output, 0, output_len);
+		nc_off = 0;
+		ret = mbedtls_aes_crypt_ctr(&ctx->aes_ctx, output_len, &nc_off,
+					    ctx->counter, stream_block,
+					    output, output);
+		if (ret != 0) {
+			goto exit;
+		}
+	}
+
+	memset(tmp, 0, sizeof(tmp));
+	nc_off = 0;
+	ret = mbedtls_aes_crypt_ctr(&ctx->aes_ctx, sizeof(tmp), &nc_off,
+				    ctx->counter, stream_block, tmp, tmp);
+	if (ret != 0) {
+		goto exit;
+	}
+
+	ret = mbedtls_aes_setkey_enc(&ctx->aes_ctx, tmp,
+				     MBEDTLS_CTR_DRBG_KEYBITS);
+	if (ret != 0) {
+		goto exit;
+	}
+
+	memcpy(ctx->counter, tmp + MBEDTLS_CTR_DRBG_KEYSIZE,
+	       MBEDTLS_CTR_DRBG_BLOCKSIZE);
+
+	ctx->reseed_counter++;
+
+exit:
+	mbedtls_platform_zeroize(tmp, sizeof(tmp));
+	mbedtls_platform_zeroize(stream_block, sizeof(stream_block));
+
+	return ret;
+}
+
+int mbedtls_ctr_drbg_batched_random(void *p_rng, unsigned char *output,
+				    size_t output_len)
+{
+	mbedtls_ctr_drbg_context *ctx = (mbedtls_ctr_drbg_context *)p_rng;
+	int ret;
+
+	if (output_len > MBEDTLS_CTR_DRBG_MAX_REQUEST) {
+		return MBEDTLS_ERR_CTR_DRBG_REQUEST_TOO_BIG;
+	}
+
+#if defined(MBEDTLS_THREADING_C)
+	ret = mbedtls_mutex_lock(&ctx->mutex);
+	if (ret != 0) {
+		return ret;
+	}
+#endif
+
+	ret = ctr_drbg_generate(ctx, output, output_len);
+
+#if defined(MBEDTLS_THREADING_C)
+	if (mbedtls_mutex_unlock(&ctx->mutex) != 0) {
+		return MBEDTLS_ERR_THREADING_MUTEX_ERROR;
+	}
+#endif
+
+	return ret;
+}
+
+int mbedtls_ctr_drbg_batched_random_large(void *p_rng, unsigned char *output,
+					  size_t output_len)
+{
+	size_t chunk;
+	int ret;
+
+	do {
+		chunk = (output_len > MBEDTLS_CTR_DRBG_MAX_REQUEST) ?
+			MBEDTLS_CTR_DRBG_MAX_REQUEST : output_len;
+
+		ret = mbedtls_ctr_drbg_batched_random(p_rng, output, chunk);
+		if (ret != 0) {
+			return ret;
+		}
+
+		output += chunk;
+		output_len -= chunk;
+	} while (output_len > 0);
+
+	return 0;
+}
@@ -9,18 +9,39 @@
 
 #include "mbedtls/memory_buffer_alloc.h"
 
+#if defined(CONFIG_MBEDTLS_HEAP_STATS)
+#include "mbedtls_heap_stats.h"
+#endif
+
 #if !defined(CONFIG_MBEDTLS_HEAP_SIZE) || CONFIG_MBEDTLS_HEAP_SIZE == 0
 #error "CONFIG_MBEDTLS_HEAP_SIZE must be specified and greater than 0"
 #endif
 
 static unsigned char mbedtls_heap[CONFIG_MBEDTLS_HEAP_SIZE];
 
+#if defined(CONFIG_MBEDTLS_HEAP_STATS)
+void mbedtls_heap_free_get(size_t used, size_t *p_total_free,
+			   size_t *p_largest_free)
+{
+	/* The buffer allocator does not expose its free list. The free size
+	 * is an upper bound as its block headers are not accounted for.
+	 */
+	*p_total_free = (used < sizeof(mbedtls_heap)) ?
+			(sizeof(mbedtls_heap) - used) : 0;
+	*p_largest_free = 0;
+}
+#endif
+
 static int mbedtls_heap_init(struct device *dev)
 {
 	ARG_UNUSED(dev);
 
 	mbedtls_memory_buffer_alloc_init(mbedtls_heap, sizeof(mbedtls_heap));
 
+#if defined(CONFIG_MBEDTLS_HEAP_STATS)
+	mbedtls_heap_stats_install();
+#endif
+
 	return 0;
 }
 
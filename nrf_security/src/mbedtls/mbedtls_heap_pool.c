@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+
+/*
+ * Size-class pool allocator for mbed TLS.
+ *
+ * Every size class is a k_mem_slab of fixed size blocks. An allocation is
+ * served from the smallest class that fits and has a free block, falling
+ * back to the next larger classes. Both calloc and free are O(1) in the
+ * number of allocations, and memory does not fragment across handshakes.
+ */
+
+#include <init.h>
+#include <kernel.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "mbedtls/platform.h"
+
+#if defined(CONFIG_MBEDTLS_HEAP_STATS)
+#include "mbedtls_heap_stats.h"
+#endif
+
+#define HEAP_POOL_ALIGN 4
+
+#if CONFIG_MBEDTLS_HEAP_POOL_32_COUNT > 0
+K_MEM_SLAB_DEFINE(heap_pool_32, 32,
+		  CONFIG_MBEDTLS_HEAP_POOL_32_COUNT, HEAP_POOL_ALIGN);
+#endif
+#if CONFIG_MBEDTLS_HEAP_POOL_128_COUNT > 0
+K_MEM_SLAB_DEFINE(heap_pool_128, 128,
+		  CONFIG_MBEDTLS_HEAP_POOL_128_COUNT, HEAP_POOL_ALIGN);
+#endif
+#if CONFIG_MBEDTLS_HEAP_POOL_512_COUNT > 0
+K_MEM_SLAB_DEFINE(heap_pool_512, 512,
+		  CONFIG_MBEDTLS_HEAP_POOL_512_COUNT, HEAP_POOL_ALIGN);
+#endif
+#if CONFIG_MBEDTLS_HEAP_POOL_2048_COUNT > 0
+K_MEM_SLAB_DEFINE(heap_pool_2048, 2048,
+		  CONFIG_MBEDTLS_HEAP_POOL_2048_COUNT, HEAP_POOL_ALIGN);
+#endif
+#if CONFIG_MBEDTLS_HEAP_POOL_LARGE_COUNT > 0
+K_MEM_SLAB_DEFINE(heap_pool_large,
+		  ROUND_UP(CONFIG_MBEDTLS_HEAP_POOL_LARGE_SIZE, HEAP_POOL_ALIGN),
+		  CONFIG_MBEDTLS_HEAP_POOL_LARGE_COUNT, HEAP_POOL_ALIGN);
+#endif
+
+#if CONFIG_MBEDTLS_HEAP_POOL_32_COUNT == 0 && \
+	CONFIG_MBEDTLS_HEAP_POOL_128_COUNT == 0 && \
+	CONFIG_MBEDTLS_HEAP_POOL_512_COUNT == 0 && \
+	CONFIG_MBEDTLS_HEAP_POOL_2048_COUNT == 0 && \
+	CONFIG_MBEDTLS_HEAP_POOL_LARGE_COUNT == 0
+#error "At least one mbed TLS heap pool must be enabled"
+#endif
+
+/* Size classes, ordered by increasing block size. */
+static struct k_mem_slab *const heap_pools[] = {
+#if CONFIG_MBEDTLS_HEAP_POOL_32_COUNT > 0
+	&heap_pool_32,
+#endif
+#if CONFIG_MBEDTLS_HEAP_POOL_128_COUNT > 0
+	&heap_pool_128,
+#endif
+#if CONFIG_MBEDTLS_HEAP_POOL_512_COUNT > 0
+	&heap_pool_512,
+#endif
+#if CONFIG_MBEDTLS_HEAP_POOL_2048_COUNT > 0
+	&heap_pool_2048,
+#endif
+#if CONFIG_MBEDTLS_HEAP_POOL_LARGE_COUNT > 0
+	&heap_pool_large,
+#endif
+};
+
+#if CONFIG_MBEDTLS_HEAP_POOL_LARGE_COUNT > 0 && \
+	CONFIG_MBEDTLS_HEAP_POOL_LARGE_SIZE <= 2048
+#error "CONFIG_MBEDTLS_HEAP_POOL_LARGE_SIZE must be larger than 2048"
+#endif
+
+static bool heap_pool_owns(struct k_mem_slab *pool, void *ptr)
+{
+	char *start = pool->buffer;
+	char *end = start + pool->num_blocks * pool->block_size;
+
+	return ((char *)ptr >= start) && ((char *)ptr < end);
+}
+
+static void *heap_pool_calloc(size_t n, size_t size)
+{
+	size_t total;
+	void *ptr;
+
+	if (n == 0 || size == 0) {
+		return NULL;
+	}
+
+	if (n > SIZE_MAX / size) {
+		return NULL;
+	}
+
+	total = n * size;
+
+	for (size_t i = 0; i < ARRAY_SIZE(heap_pools); i++) {
+		if (heap_pools[i]->block_size < total) {
+			continue;
+		}
+
+		if (k_mem_slab_alloc(heap_pools[i], &ptr, K_NO_WAIT) == 0) {
+			memset(ptr, 0, total);
+			return ptr;
+		}
+	}
+
+	return NULL;
+}
+
+static void heap_pool_free(void *ptr)
+{
+	if (ptr == NULL) {
+		return;
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(heap_pools); i++) {
+		if (heap_pool_owns(heap_pools[i], ptr)) {
+			k_mem_slab_free(heap_pools[i], &ptr);
+			return;
+		}
+	}
+
+	__ASSERT(false, "Freeing pointer not owned by the mbed TLS heap");
+}
+
+#if defined(CONFIG_MBEDTLS_HEAP_STATS)
+void mbedtls_heap_free_get(size_t used, size_t *p_total_free,
+			   size_t *p_largest_free)
+{
+	ARG_UNUSED(used);
+
+	*p_total_free = 0;
+	*p_largest_free = 0;
+
+	for (size_t i = 0; i < ARRAY_SIZE(heap_pools); i++) {
+		u32_t num_free = heap_pools[i]->num_blocks -
+				 k_mem_slab_num_used_get(heap_pools[i]);
+
+		*p_total_free += num_free * heap_pools[i]->block_size;
+		if (num_free > 0) {
+			*p_largest_free = heap_pools[i]->block_size;
+		}
+	}
+}
+#endif
+
+static int mbedtls_heap_init(struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	mbedtls_platform_set_calloc_free(heap_pool_calloc, heap_pool_free);
+
+#if defined(CONFIG_MBEDTLS_HEAP_STATS)
+	mbedtls_heap_stats_install();
+#endif
+
+	return 0;
+}
+
+/* Hw cc310 is initialized with CONFIG_KERNEL_INIT_PRIORITY_DEFAULT and the
+ * heap must be initialized afterwards.
+ */
+SYS_INIT(mbedtls_heap_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEVICE);
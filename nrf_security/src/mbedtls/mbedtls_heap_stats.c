@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+
+#include <kernel.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "mbedtls/platform.h"
+#include "mbedtls_heap.h"
+#include "mbedtls_heap_stats.h"
+
+/* Every allocation is prefixed with its requested size. The header is kept
+ * at 8 bytes so that the returned pointer keeps the alignment of the
+ * allocator.
+ */
+#define HEAP_STATS_HDR_SIZE 8
+
+static void *(*heap_calloc)(size_t n, size_t size);
+static void (*heap_free)(void *ptr);
+
+static mbedtls_heap_stats_t heap_stats;
+
+static void *heap_stats_calloc(size_t n, size_t size)
+{
+	unsigned int key;
+	size_t total = 0;
+	char *ptr;
+
+	if (n == 0 || size == 0 || n > (SIZE_MAX - HEAP_STATS_HDR_SIZE) / size) {
+		ptr = NULL;
+	} else {
+		total = n * size;
+		ptr = heap_calloc(1, total + HEAP_STATS_HDR_SIZE);
+	}
+
+	key = irq_lock();
+
+	if (ptr == NULL) {
+		heap_stats.fail_count++;
+		irq_unlock(key);
+		return NULL;
+	}
+
+	heap_stats.alloc_count++;
+	heap_stats.cur_used += total;
+	heap_stats.cur_blocks++;
+
+	if (heap_stats.cur_used > heap_stats.max_used) {
+		heap_stats.max_used = heap_stats.cur_used;
+	}
+
+	if (heap_stats.cur_blocks > heap_stats.max_blocks) {
+		heap_stats.max_blocks = heap_stats.cur_blocks;
+	}
+
+	irq_unlock(key);
+
+	memcpy(ptr, &total, sizeof(total));
+
+	return ptr + HEAP_STATS_HDR_SIZE;
+}
+
+static void heap_stats_free(void *ptr)
+{
+	unsigned int key;
+	char *block;
+	size_t total;
+
+	if (ptr == NULL) {
+		return;
+	}
+
+	block = (char *)ptr - HEAP_STATS_HDR_SIZE;
+	memcpy(&total, block, sizeof(total));
+
+	key = irq_lock();
+	heap_stats.cur_used -= total;
+	heap_stats.cur_blocks--;
+	irq_unlock(key);
+
+	heap_free(block);
+}
+
+void mbedtls_heap_stats_install(void)
+{
+	BUILD_ASSERT_MSG(sizeof(size_t) <= HEAP_STATS_HDR_SIZE,
+			 "Heap statistics header too small");
+
+	heap_calloc = mbedtls_calloc;
+	heap_free = mbedtls_free;
+
+	mbedtls_platform_set_calloc_free(heap_stats_calloc, heap_stats_free);
+}
+
+void mbedtls_heap_stats_get(mbedtls_heap_stats_t *p_stats)
+{
+	unsigned int key;
+
+	if (p_stats == NULL) {
+		return;
+	}
+
+	key = irq_lock();
+	*p_stats = heap_stats;
+	irq_unlock(key);
+
+	mbedtls_heap_free_get(p_stats->cur_used +
+			      p_stats->cur_blocks * HEAP_STATS_HDR_SIZE,
+			      &p_stats->total_free, &p_stats->largest_free);
+
+	if (p_stats->largest_free != 0 &&
+	    p_stats->largest_free < p_stats->total_free) {
+		p_stats->fragmentation = (uint8_t)(100 -
+			(p_stats->largest_free * 100) / p_stats->total_free);
+	} else {
+		p_stats->fragmentation = 0;
+	}
+
+	/* Report the usable size, not including the header */
+	if (p_stats->largest_free > HEAP_STATS_HDR_SIZE) {
+		p_stats->largest_free -= HEAP_STATS_HDR_SIZE;
+	} else {
+		p_stats->largest_free = 0;
+	}
+}
+
+void mbedtls_heap_stats_reset_max(void)
+{
+	unsigned int key;
+
+	key = irq_lock();
+	heap_stats.max_used = heap_stats.cur_used;
+	heap_stats.max_blocks = heap_stats.cur_blocks;
+	irq_unlock(key);
+}
+
+#if defined(CONFIG_MBEDTLS_HEAP_STATS_SHELL)
+#include <shell/shell.h>
+
+static int cmd_mbedtls_heap_stats(const struct shell *shell, size_t argc,
+				  char **argv)
+{
+	mbedtls_heap_stats_t stats;
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	mbedtls_heap_stats_get(&stats);
+
+	shell_print(shell, "used:          %u (max %u)",
+		    (unsigned int)stats.cur_used, (unsigned int)stats.max_used);
+	shell_print(shell, "blocks:        %u (max %u)",
+		    (unsigned int)stats.cur_blocks,
+		    (unsigned int)stats.max_blocks);
+	shell_print(shell, "allocations:   %u (failed %u)",
+		    stats.alloc_count, stats.fail_count);
+	shell_print(shell, "free:          %u (largest %u)",
+		    (unsigned int)stats.total_free,
+		    (unsigned int)stats.largest_free);
+	shell_print(shell, "fragmentation: %u%%", stats.fragmentation);
+
+	return 0;
+}
+
+static int cmd_mbedtls_heap_reset(const struct shell *shell, size_t argc,
+				  char **argv)
+{
+	ARG_UNUSED(shell);
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	mbedtls_heap_stats_reset_max();
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_mbedtls_heap,
+	SHELL_CMD(stats, NULL, "Print mbed TLS heap statistics",
+		  cmd_mbedtls_heap_stats),
+	SHELL_CMD(reset, NULL, "Reset mbed TLS heap peak values",
+		  cmd_mbedtls_heap_reset),
+	SHELL_SUBCMD_SET_END
+);
+
+SHELL_CMD_REGISTER(mbedtls_heap, &sub_mbedtls_heap, "mbed TLS heap commands",
+		   NULL);
+#endif /* CONFIG_MBEDTLS_HEAP_STATS_SHELL */
@@ -0,0 +1,26 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+
+#ifndef MBEDTLS_HEAP_STATS_H
+#define MBEDTLS_HEAP_STATS_H
+
+#include <stddef.h>
+
+/* Install the accounting wrapper on top of the currently set mbed TLS
+ * calloc and free. Called by the heap implementation after it has set
+ * its allocator.
+ */
+void mbedtls_heap_stats_install(void);
+
+/* Implemented by the heap allocator. Reports the bytes left in the heap
+ * and the largest allocation that can currently succeed, 0 if unknown.
+ * used is the number of bytes currently allocated through the wrapper,
+ * including its per-allocation header.
+ */
+void mbedtls_heap_free_get(size_t used, size_t *p_total_free,
+			   size_t *p_largest_free);
+
+#endif /* MBEDTLS_HEAP_STATS_H */
@@ -0,0 +1,303 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+
+#include <kernel.h>
+
+#include "mbedtls/aes.h"
+#include "mbedtls/cipher.h"
+#if defined(MBEDTLS_CCM_C)
+#include "mbedtls/ccm.h"
+#endif
+#include "mbedtls_key_slot.h"
+
+#if CONFIG_MBEDTLS_KEY_SLOT_COUNT > 256
+#error "CONFIG_MBEDTLS_KEY_SLOT_COUNT must fit in the slot index of an id"
+#endif
+
+/* The low byte of an id is the slot index, the rest is a generation count
+ * that makes the ids of a reused slot differ from the ones it had before.
+ */
+#define KEY_SLOT_INDEX(id) ((id) & 0xff)
+
+enum key_slot_type {
+	KEY_SLOT_AES,
+#if defined(MBEDTLS_CCM_C)
+	KEY_SLOT_CCM,
+#endif
+};
+
+struct key_slot {
+	/* Set with the lock held, MBEDTLS_KEY_SLOT_ID_INVALID when empty */
+	mbedtls_key_slot_id id;
+	enum key_slot_type type;
+	/* AES slots: the direction of the key schedule */
+	int mode;
+	struct k_mutex lock;
+	union {
+		mbedtls_aes_context aes;
+#if defined(MBEDTLS_CCM_C)
+		mbedtls_ccm_context ccm;
+#endif
+	} ctx;
+};
+
+static struct key_slot key_slots[CONFIG_MBEDTLS_KEY_SLOT_COUNT];
+
+/* Slots given out by key_slot_alloc(), and whether their lock is set up */
+static bool key_slot_in_use[CONFIG_MBEDTLS_KEY_SLOT_COUNT];
+static bool key_slot_lock_init[CONFIG_MBEDTLS_KEY_SLOT_COUNT];
+static uint32_t key_slot_generation;
+
+/* Protects the three arrays above and the generation count */
+K_MUTEX_DEFINE(key_slot_mutex);
+
+static struct key_slot *key_slot_alloc(mbedtls_key_slot_id *id)
+{
+	struct key_slot *slot = NULL;
+
+	k_mutex_lock(&key_slot_mutex, K_FOREVER);
+
+	for (size_t i = 0; i < ARRAY_SIZE(key_slots); i++) {
+		if (key_slot_in_use[i]) {
+			continue;
+		}
+
+		if (!key_slot_lock_init[i]) {
+			k_mutex_init(&key_slots[i].lock);
+			key_slot_lock_init[i] = true;
+		}
+
+		key_slot_generation = (key_slot_generation + 1) & 0xffffff;
+		if (key_slot_generation == 0) {
+			key_slot_generation = 1;
+		}
+
+		key_slot_in_use[i] = true;
+		*id = (key_slot_generation << 8) | i;
+		slot = &key_slots[i];
+		break;
+	}
+
+	k_mutex_unlock(&key_slot_mutex);
+
+	return slot;
+}
+
+static void key_slot_release(struct key_slot *slot)
+{
+	k_mutex_lock(&key_slot_mutex, K_FOREVER);
+	key_slot_in_use[slot - key_slots] = false;
+	k_mutex_unlock(&key_slot_mutex);
+}
+
+/* Lock the slot of id, if id is still valid and of the given type */
+static struct key_slot *key_slot_lock(mbedtls_key_slot_id id,
+				      enum key_slot_type type)
+{
+	struct key_slot *slot;
+	size_t i = KEY_SLOT_INDEX(id);
+
+	if (id == MBEDTLS_KEY_SLOT_ID_INVALID || i >= ARRAY_SIZE(key_slots)) {
+		return NULL;
+	}
+
+	slot = &key_slots[i];
+
+	/* A slot with a matching id has its lock set up. The id is checked
+	 * again under the lock, as the slot may be destroyed meanwhile.
+	 */
+	if (slot->id != id) {
+		return NULL;
+	}
+
+	k_mutex_lock(&slot->lock, K_FOREVER);
+
+	if (slot->id != id || slot->type != type) {
+		k_mutex_unlock(&slot->lock);
+		return NULL;
+	}
+
+	return slot;
+}
+
+int mbedtls_key_slot_aes_import(mbedtls_key_slot_id *id, int mode,
+				const unsigned char *key,
+				unsigned int keybits)
+{
+	struct key_slot *slot;
+	mbedtls_key_slot_id new_id;
+	int ret;
+
+	if (id == NULL || (mode != MBEDTLS_AES_ENCRYPT &&
+			   mode != MBEDTLS_AES_DECRYPT)) {
+		return MBEDTLS_ERR_AES_BAD_INPUT_DATA;
+	}
+
+	slot = key_slot_alloc(&new_id);
+	if (slot == NULL) {
+		return MBEDTLS_ERR_CIPHER_ALLOC_FAILED;
+	}
+
+	mbedtls_aes_init(&slot->ctx.aes);
+	if (mode == MBEDTLS_AES_ENCRYPT) {
+		ret = mbedtls_aes_setkey_enc(&slot->ctx.aes, key, keybits);
+	} else {
+		ret = mbedtls_aes_setkey_dec(&slot->ctx.aes, key, keybits);
+	}
+
+	if (ret != 0) {
+		mbedtls_aes_free(&slot->ctx.aes);
+		key_slot_release(slot);
+		return ret;
+	}
+
+	k_mutex_lock(&slot->lock, K_FOREVER);
+	slot->type = KEY_SLOT_AES;
+	slot->mode = mode;
+	slot->id = new_id;
+	k_mutex_unlock(&slot->lock);
+
+	*id = new_id;
+	return 0;
+}
+
+int mbedtls_key_slot_aes_crypt_ecb(mbedtls_key_slot_id id,
+				   const unsigned char input[16],
+				   unsigned char output[16])
+{
+	struct key_slot *slot;
+	int ret;
+
+	slot = key_slot_lock(id, KEY_SLOT_AES);
+	if (slot == NULL) {
+		return MBEDTLS_ERR_AES_BAD_INPUT_DATA;
+	}
+
+	ret = mbedtls_aes_crypt_ecb(&slot->ctx.aes, slot->mode, input, output);
+
+	k_mutex_unlock(&slot->lock);
+
+	return ret;
+}
+
+#if defined(MBEDTLS_CCM_C)
+int mbedtls_key_slot_ccm_import(mbedtls_key_slot_id *id,
+				const unsigned char *key,
+				unsigned int keybits)
+{
+	struct key_slot *slot;
+	mbedtls_key_slot_id new_id;
+	int ret;
+
+	if (id == NULL) {
+		return MBEDTLS_ERR_CCM_BAD_INPUT;
+	}
+
+	slot = key_slot_alloc(&new_id);
+	if (slot == NULL) {
+		return MBEDTLS_ERR_CIPHER_ALLOC_FAILED;
+	}
+
+	mbedtls_ccm_init(&slot->ctx.ccm);
+	ret = mbedtls_ccm_setkey(&slot->ctx.ccm, MBEDTLS_CIPHER_ID_AES,
+				 key, keybits);
+	if (ret != 0) {
+		mbedtls_ccm_free(&slot->ctx.ccm);
+		key_slot_release(slot);
+		return ret;
+	}
+
+	k_mutex_lock(&slot->lock, K_FOREVER);
+	slot->type = KEY_SLOT_CCM;
+	slot->id = new_id;
+	k_mutex_unlock(&slot->lock);
+
+	*id = new_id;
+	return 0;
+}
+
+int mbedtls_key_slot_ccm_encrypt_and_tag(mbedtls_key_slot_id id,
+					 size_t length,
+					 const unsigned char *iv, size_t iv_len,
+					 const unsigned char *add, size_t add_len,
+					 const unsigned char *input,
+					 unsigned char *output,
+					 unsigned char *tag, size_t tag_len)
+{
+	struct key_slot *slot;
+	int ret;
+
+	slot = key_slot_lock(id, KEY_SLOT_CCM);
+	if (slot == NULL) {
+		return MBEDTLS_ERR_CCM_BAD_INPUT;
+	}
+
+	ret = mbedtls_ccm_encrypt_and_tag(&slot->ctx.ccm, length, iv, iv_len,
+					  add, add_len, input, output,
+					  tag, tag_len);
+
+	k_mutex_unlock(&slot->lock);
+
+	return ret;
+}
+
+int mbedtls_key_slot_ccm_auth_decrypt(mbedtls_key_slot_id id,
+				      size_t length,
+				      const unsigned char *iv, size_t iv_len,
+				      const unsigned char *add, size_t add_len,
+				      const unsigned char *input,
+				      unsigned char *output,
+				      const unsigned char *tag, size_t tag_len)
+{
+	struct key_slot *slot;
+	int ret;
+
+	slot = key_slot_lock(id, KEY_SLOT_CCM);
+	if (slot == NULL) {
+		return MBEDTLS_ERR_CCM_BAD_INPUT;
+	}
+
+	ret = mbedtls_ccm_auth_decrypt(&slot->ctx.ccm, length, iv, iv_len,
+				       add, add_len, input, output,
+				       tag, tag_len);
+
+	k_mutex_unlock(&slot->lock);
+
+	return ret;
+}
+#endif /* MBEDTLS_CCM_C */
+
+void mbedtls_key_slot_destroy(mbedtls_key_slot_id id)
+{
+	struct key_slot *slot;
+
+	slot = key_slot_lock(id, KEY_SLOT_AES);
+#if defined(MBEDTLS_CCM_C)
+	if (slot == NULL) {
+		slot = key_slot_lock(id, KEY_SLOT_CCM);
+	}
+#endif
+	if (slot == NULL) {
+		return;
+	}
+
+	/* The free functions clear the key material */
+	switch (slot->type) {
+	case KEY_SLOT_AES:
+		mbedtls_aes_free(&slot->ctx.aes);
+		break;
+#if defined(MBEDTLS_CCM_C)
+	case KEY_SLOT_CCM:
+		mbedtls_ccm_free(&slot->ctx.ccm);
+		break;
+#endif
+	}
+
+	slot->id = MBEDTLS_KEY_SLOT_ID_INVALID;
+	k_mutex_unlock(&slot->lock);
+
+	key_slot_release(slot);
+}
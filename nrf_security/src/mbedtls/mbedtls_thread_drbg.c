@@ -0,0 +1,189 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+
+#include <kernel.h>
+
+#include "mbedtls/entropy.h"
+#include "mbedtls/ctr_drbg.h"
+#include "mbedtls_thread_drbg.h"
+
+struct thread_drbg {
+	k_tid_t owner;
+	mbedtls_ctr_drbg_context ctx;
+};
+
+static struct thread_drbg thread_drbgs[CONFIG_MBEDTLS_THREAD_DRBG_COUNT];
+
+/* Used by the threads that do not get an instance of their own. */
+static mbedtls_ctr_drbg_context shared_drbg;
+static bool shared_drbg_seeded;
+
+/* Shared by all instances, only used when seeding and reseeding. */
+static mbedtls_entropy_context entropy;
+static bool entropy_initialized;
+
+/* Protects the owner fields, the entropy context initialization and the
+ * seeding of the shared instance.
+ */
+K_MUTEX_DEFINE(thread_drbg_mutex);
+
+/* Serializes the use of the shared instance. */
+K_MUTEX_DEFINE(thread_drbg_shared_mutex);
+
+/* Serializes the use of the entropy context. It only has a mutex of its own
+ * with MBEDTLS_THREADING_C, which is not set in every configuration.
+ */
+K_MUTEX_DEFINE(thread_drbg_entropy_mutex);
+
+static int thread_drbg_entropy_func(void *data, unsigned char *output,
+				    size_t len)
+{
+	int ret;
+
+	k_mutex_lock(&thread_drbg_entropy_mutex, K_FOREVER);
+	ret = mbedtls_entropy_func(data, output, len);
+	k_mutex_unlock(&thread_drbg_entropy_mutex);
+
+	return ret;
+}
+
+static int thread_drbg_seed(mbedtls_ctr_drbg_context *ctx, k_tid_t thread)
+{
+	int ret;
+
+	mbedtls_ctr_drbg_init(ctx);
+	ret = mbedtls_ctr_drbg_seed(ctx, thread_drbg_entropy_func, &entropy,
+				    (const unsigned char *)&thread,
+				    sizeof(thread));
+	if (ret != 0) {
+		mbedtls_ctr_drbg_free(ctx);
+	}
+
+	return ret;
+}
+
+/* Must be called with thread_drbg_mutex held. */
+static struct thread_drbg *thread_drbg_claim(k_tid_t self)
+{
+	struct thread_drbg *stale = NULL;
+	struct thread_drbg *unused = NULL;
+	struct thread_drbg *drbg;
+
+	for (size_t i = 0; i < ARRAY_SIZE(thread_drbgs); i++) {
+		if (thread_drbgs[i].owner == self) {
+			stale = &thread_drbgs[i];
+		} else if (thread_drbgs[i].owner == NULL && unused == NULL) {
+			unused = &thread_drbgs[i];
+		}
+	}
+
+	/* An instance owned by this thread ID without the custom data
+	 * pointing at it was left by an earlier thread in the same k_thread
+	 * object. Its state is discarded, the instance is seeded again for
+	 * the new thread.
+	 */
+	drbg = (stale != NULL) ? stale : unused;
+	if (drbg == NULL) {
+		return NULL;
+	}
+
+	if (drbg->owner != NULL) {
+		mbedtls_ctr_drbg_free(&drbg->ctx);
+		drbg->owner = NULL;
+	}
+
+	if (thread_drbg_seed(&drbg->ctx, self) != 0) {
+		return NULL;
+	}
+
+	drbg->owner = self;
+	k_thread_custom_data_set(drbg);
+
+	return drbg;
+}
+
+static struct thread_drbg *thread_drbg_get(void)
+{
+	k_tid_t self = k_current_get();
+	struct thread_drbg *drbg;
+
+	/* The custom data is cleared when a thread is created, so it only
+	 * points at an instance claimed by the calling thread itself. The owner
+	 * field of that instance can not change under it, so the fast path does
+	 * not need the lock.
+	 */
+	drbg = k_thread_custom_data_get();
+	if (drbg != NULL && drbg->owner == self) {
+		return drbg;
+	}
+
+	k_mutex_lock(&thread_drbg_mutex, K_FOREVER);
+
+	if (!entropy_initialized) {
+		mbedtls_entropy_init(&entropy);
+		entropy_initialized = true;
+	}
+
+	drbg = thread_drbg_claim(self);
+
+	k_mutex_unlock(&thread_drbg_mutex);
+
+	return drbg;
+}
+
+static int thread_drbg_shared_random(unsigned char *output, size_t output_len)
+{
+	int ret = 0;
+
+	k_mutex_lock(&thread_drbg_mutex, K_FOREVER);
+	if (!shared_drbg_seeded) {
+		ret = thread_drbg_seed(&shared_drbg, NULL);
+		shared_drbg_seeded = (ret == 0);
+	}
+	k_mutex_unlock(&thread_drbg_mutex);
+
+	if (ret != 0) {
+		return ret;
+	}
+
+	k_mutex_lock(&thread_drbg_shared_mutex, K_FOREVER);
+	ret = mbedtls_ctr_drbg_random(&shared_drbg, output, output_len);
+	k_mutex_unlock(&thread_drbg_shared_mutex);
+
+	return ret;
+}
+
+int mbedtls_thread_drbg_random(void *p_rng, unsigned char *output,
+			       size_t output_len)
+{
+	struct thread_drbg *drbg;
+
+	ARG_UNUSED(p_rng);
+
+	drbg = thread_drbg_get();
+	if (drbg == NULL) {
+		return thread_drbg_shared_random(output, output_len);
+	}
+
+	return mbedtls_ctr_drbg_random(&drbg->ctx, output, output_len);
+}
+
+void mbedtls_thread_drbg_release(void)
+{
+	struct thread_drbg *drbg;
+
+	drbg = k_thread_custom_data_get();
+	if (drbg == NULL || drbg->owner != k_current_get()) {
+		return;
+	}
+
+	mbedtls_ctr_drbg_free(&drbg->ctx);
+	k_thread_custom_data_set(NULL);
+
+	k_mutex_lock(&thread_drbg_mutex, K_FOREVER);
+	drbg->owner = NULL;
+	k_mutex_unlock(&thread_drbg_mutex);
+}
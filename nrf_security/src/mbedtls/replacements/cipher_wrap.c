@@ -85,11 +85,69 @@
 #define mbedtls_free       free
 #endif
 
+#if defined(CONFIG_MBEDTLS_CIPHER_CTX_POOL)
+#include <kernel.h>
+
+/*
+ * Preallocated contexts for the AES, XTS, GCM and CCM ciphers, so that the
+ * cipher setup of a TLS transform does not use the heap. When the pool is
+ * exhausted, the context is allocated from the heap as before.
+ */
+typedef union
+{
+#if defined(MBEDTLS_AES_C)
+    mbedtls_aes_context aes;
+#endif
+#if defined(MBEDTLS_AES_C) && defined(MBEDTLS_CIPHER_MODE_XTS)
+    mbedtls_aes_xts_context xts;
+#endif
+#if defined(MBEDTLS_GCM_C)
+    mbedtls_gcm_context gcm;
+#endif
+#if defined(MBEDTLS_CCM_C)
+    mbedtls_ccm_context ccm;
+#endif
+    void *align;
+} cipher_ctx_pool_block;
+
+K_MEM_SLAB_DEFINE( cipher_ctx_pool,
+                   ROUND_UP( sizeof( cipher_ctx_pool_block ), sizeof( void * ) ),
+                   CONFIG_MBEDTLS_CIPHER_CTX_POOL_COUNT, sizeof( void * ) );
+
+static void *cipher_ctx_calloc( size_t size )
+{
+    void *ctx;
+
+    if( size <= cipher_ctx_pool.block_size &&
+        k_mem_slab_alloc( &cipher_ctx_pool, &ctx, K_NO_WAIT ) == 0 )
+    {
+        memset( ctx, 0, size );
+        return( ctx );
+    }
+
+    return( mbedtls_calloc( 1, size ) );
+}
+
+static void cipher_ctx_release( void *ctx )
+{
+    char *start = cipher_ctx_pool.buffer;
+    char *end = start + cipher_ctx_pool.num_blocks * cipher_ctx_pool.block_size;
+
+    if( (char *) ctx >= start && (char *) ctx < end )
+        k_mem_slab_free( &cipher_ctx_pool, &ctx );
+    else
+        mbedtls_free( ctx );
+}
+#else
+#define cipher_ctx_calloc( size )   mbedtls_calloc( 1, ( size ) )
+#define cipher_ctx_release( ctx )   mbedtls_free( ctx )
+#endif /* CONFIG_MBEDTLS_CIPHER_CTX_POOL */
+
 #if defined(MBEDTLS_GCM_C)
 /* shared by all GCM ciphers */
 static void *gcm_ctx_alloc( void )
 {
-    void *ctx = mbedtls_calloc( 1, sizeof( mbedtls_gcm_context ) );
+    void *ctx = cipher_ctx_calloc( sizeof( mbedtls_gcm_context ) );
 
     if( ctx != NULL )
         mbedtls_gcm_init( (mbedtls_gcm_context *) ctx );
@@ -100,7 +158,7 @@ static void *gcm_ctx_alloc( void )
 static void gcm_ctx_free( void *ctx )
 {
     mbedtls_gcm_free( ctx );
-    mbedtls_free( ctx );
+    cipher_ctx_release( ctx );
 }
 #endif /* MBEDTLS_GCM_C */
 
@@ -108,7 +166,7 @@ static void gcm_ctx_free( void *ctx )
 /* shared by all CCM ciphers */
 static void *ccm_ctx_alloc( void )
 {
-    void *ctx = mbedtls_calloc( 1, sizeof( mbedtls_ccm_context ) );
+    void *ctx = cipher_ctx_calloc( sizeof( mbedtls_ccm_context ) );
 
     if( ctx != NULL )
         mbedtls_ccm_init( (mbedtls_ccm_context *) ctx );
@@ -119,7 +177,7 @@ static void *ccm_ctx_alloc( void )
 static void ccm_ctx_free( void *ctx )
 {
     mbedtls_ccm_free( ctx );
-    mbedtls_free( ctx );
+    cipher_ctx_release( ctx );
 }
 #endif /* MBEDTLS_CCM_C */
 
@@ -210,7 +268,7 @@ static int aes_setkey_enc_wrap( void *ctx, const unsigned char *key,
 
 static void * aes_ctx_alloc( void )
 {
-    mbedtls_aes_context *aes = mbedtls_calloc( 1, sizeof( mbedtls_aes_context ) );
+    mbedtls_aes_context *aes = cipher_ctx_calloc( sizeof( mbedtls_aes_context ) );
 
     if( aes == NULL )
         return( NULL );
@@ -223,7 +281,7 @@ static void * aes_ctx_alloc( void )
 static void aes_ctx_free( void *ctx )
 {
     mbedtls_aes_free( (mbedtls_aes_context *) ctx );
-    mbedtls_free( ctx );
+    cipher_ctx_release( ctx );
 }
 
 static const mbedtls_cipher_base_t aes_info = {
@@ -449,7 +507,7 @@ static int xts_aes_setkey_dec_wrap( void *ctx, const unsigned char *key,
 
 static void *xts_aes_ctx_alloc( void )
 {
-    mbedtls_aes_xts_context *xts_ctx = mbedtls_calloc( 1, sizeof( *xts_ctx ) );
+    mbedtls_aes_xts_context *xts_ctx = cipher_ctx_calloc( sizeof( *xts_ctx ) );
 
     if( xts_ctx != NULL )
         mbedtls_aes_xts_init( xts_ctx );
@@ -465,7 +523,7 @@ static void xts_aes_ctx_free( void *ctx )
         return;
 
     mbedtls_aes_xts_free( xts_ctx );
-    mbedtls_free( xts_ctx );
+    cipher_ctx_release( xts_ctx );
 }
 
 static const mbedtls_cipher_base_t xts_aes_info = {
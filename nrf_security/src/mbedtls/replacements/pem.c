@@ -37,6 +37,12 @@
 
 #include <string.h>
 
+#if defined(CONFIG_MBEDTLS_PEM_DECODE)
+#include <stdint.h>
+
+#include "mbedtls_pem_decode.h"
+#endif
+
 #if defined(MBEDTLS_PLATFORM_C)
 #include "mbedtls/platform.h"
 #else
@@ -438,6 +444,175 @@ void mbedtls_pem_free( mbedtls_pem_context *ctx )
 
     mbedtls_platform_zeroize( ctx, sizeof( mbedtls_pem_context ) );
 }
+
+#if defined(CONFIG_MBEDTLS_PEM_DECODE)
+/*
+ * Find str in [s, end). The PEM text is not necessarily NUL terminated.
+ */
+static const unsigned char *pem_find( const unsigned char *s,
+                                      const unsigned char *end,
+                                      const char *str )
+{
+    size_t n = strlen( str );
+
+    while( (size_t)( end - s ) >= n )
+    {
+        if( memcmp( s, str, n ) == 0 )
+            return( s );
+        s++;
+    }
+
+    return( NULL );
+}
+
+static int pem_base64_value( unsigned char c )
+{
+    if( c >= 'A' && c <= 'Z' ) return( c - 'A' );
+    if( c >= 'a' && c <= 'z' ) return( c - 'a' + 26 );
+    if( c >= '0' && c <= '9' ) return( c - '0' + 52 );
+    if( c == '+' ) return( 62 );
+    if( c == '/' ) return( 63 );
+
+    return( -1 );
+}
+
+/*
+ * Decode the first PEM object of src into dst. dst may be the start of src:
+ * every 4 base64 characters produce at most 3 bytes and are read before
+ * the bytes are written, so the output never overtakes the input.
+ */
+static int pem_decode_object( const unsigned char *src, size_t src_len,
+                              const char *header, const char *footer,
+                              unsigned char *dst, size_t dst_len,
+                              size_t *der_len, size_t *use_len )
+{
+    const unsigned char *end = src + src_len;
+    const unsigned char *s1, *s2, *p;
+    uint32_t acc = 0;
+    size_t n = 0, pad = 0, len = 0;
+    int v;
+
+    s1 = pem_find( src, end, header );
+    if( s1 == NULL )
+        return( MBEDTLS_ERR_PEM_NO_HEADER_FOOTER_PRESENT );
+
+    s1 += strlen( header );
+    s2 = pem_find( s1, end, footer );
+    if( s2 == NULL )
+        return( MBEDTLS_ERR_PEM_NO_HEADER_FOOTER_PRESENT );
+
+    if( s1 < s2 && *s1 == ' '  ) s1++;
+    if( s1 < s2 && *s1 == '\r' ) s1++;
+    if( s1 < s2 && *s1 == '\n' ) s1++;
+    else return( MBEDTLS_ERR_PEM_NO_HEADER_FOOTER_PRESENT );
+
+    p = s2 + strlen( footer );
+    if( p < end && *p == ' '  ) p++;
+    if( p < end && *p == '\r' ) p++;
+    if( p < end && *p == '\n' ) p++;
+    *use_len = p - src;
+
+    if( s2 - s1 >= 22 && memcmp( s1, "Proc-Type: 4,ENCRYPTED", 22 ) == 0 )
+        return( MBEDTLS_ERR_PEM_FEATURE_UNAVAILABLE );
+
+    if( s1 >= s2 )
+        return( MBEDTLS_ERR_PEM_INVALID_DATA );
+
+    for( p = s1; p < s2; p++ )
+    {
+        if( *p == ' ' || *p == '\t' || *p == '\r' || *p == '\n' )
+            continue;
+
+        /* Nothing but padding may follow the first padding character. */
+        if( *p == '=' )
+        {
+            v = 0;
+            pad++;
+        }
+        else if( pad != 0 || ( v = pem_base64_value( *p ) ) < 0 )
+        {
+            return( MBEDTLS_ERR_PEM_INVALID_DATA + MBEDTLS_ERR_BASE64_INVALID_CHARACTER );
+        }
+
+        acc = ( acc << 6 ) | (uint32_t) v;
+
+        if( ++n < 4 )
+            continue;
+
+        if( pad > 2 || len + 3 - pad > dst_len )
+            return( pad > 2 ? MBEDTLS_ERR_PEM_INVALID_DATA + MBEDTLS_ERR_BASE64_INVALID_CHARACTER :
+                              MBEDTLS_ERR_PEM_BAD_INPUT_DATA );
+
+        dst[len++] = (unsigned char)( acc >> 16 );
+        if( pad < 2 ) dst[len++] = (unsigned char)( acc >> 8 );
+        if( pad < 1 ) dst[len++] = (unsigned char)( acc );
+
+        acc = 0;
+        n = 0;
+    }
+
+    if( n != 0 || len == 0 )
+        return( MBEDTLS_ERR_PEM_INVALID_DATA + MBEDTLS_ERR_BASE64_INVALID_CHARACTER );
+
+    *der_len = len;
+
+    return( 0 );
+}
+
+int mbedtls_pem_decode_in_place( unsigned char *buf, size_t buflen,
+                                 const char *header, const char *footer,
+                                 size_t *der_len, size_t *use_len )
+{
+    if( buf == NULL || header == NULL || footer == NULL ||
+        der_len == NULL || use_len == NULL )
+        return( MBEDTLS_ERR_PEM_BAD_INPUT_DATA );
+
+    return( pem_decode_object( buf, buflen, header, footer, buf, buflen,
+                               der_len, use_len ) );
+}
+
+int mbedtls_pem_decode_each( const unsigned char *pem, size_t pem_len,
+                             const char *header, const char *footer,
+                             unsigned char *der_buf, size_t der_buf_len,
+                             mbedtls_pem_decode_cb_t cb, void *p_ctx )
+{
+    size_t der_len, use_len;
+    size_t count = 0;
+    int ret;
+
+    if( pem == NULL || header == NULL || footer == NULL ||
+        der_buf == NULL || cb == NULL )
+        return( MBEDTLS_ERR_PEM_BAD_INPUT_DATA );
+
+    while( pem_len > 0 )
+    {
+        der_len = 0;
+        ret = pem_decode_object( pem, pem_len, header, footer,
+                                 der_buf, der_buf_len, &der_len, &use_len );
+        if( ret == MBEDTLS_ERR_PEM_NO_HEADER_FOOTER_PRESENT && count > 0 )
+            break;
+
+        /* A failed decode leaves a prefix in der_buf without setting der_len */
+        if( ret != 0 )
+        {
+            mbedtls_platform_zeroize( der_buf, der_buf_len );
+            return( ret );
+        }
+
+        ret = cb( p_ctx, der_buf, der_len );
+
+        mbedtls_platform_zeroize( der_buf, der_len );
+        if( ret != 0 )
+            return( ret );
+
+        count++;
+        pem += use_len;
+        pem_len -= use_len;
+    }
+
+    return( count > 0 ? 0 : MBEDTLS_ERR_PEM_NO_HEADER_FOOTER_PRESENT );
+}
+#endif /* CONFIG_MBEDTLS_PEM_DECODE */
 #endif /* MBEDTLS_PEM_PARSE_C */
 
 #if defined(MBEDTLS_PEM_WRITE_C)
@@ -2288,16 +2288,96 @@ const mbedtls_ssl_ciphersuite_t *mbedtls_ssl_ciphersuite_from_string(
     return( NULL );
 }
 
+/*
+ * Number of ciphersuites in ciphersuite_definitions, without the terminator.
+ */
+#define CIPHERSUITE_COUNT   ( sizeof( ciphersuite_definitions     ) /         \
+                              sizeof( ciphersuite_definitions[0]  ) - 1 )
+
+/* All ciphersuites fit in the unsigned char indexes below. */
+typedef char ciphersuite_count_check[ CIPHERSUITE_COUNT <= 256 ? 1 : -1 ];
+
+/*
+ * Indexes of ciphersuite_definitions sorted by ciphersuite ID, for a binary
+ * search in mbedtls_ssl_ciphersuite_from_id(). The definitions only contain
+ * the ciphersuites enabled in the build, so the index is built on first use
+ * instead of being written out by hand.
+ */
+static unsigned char ciphersuite_by_id[CIPHERSUITE_COUNT + 1];
+
+#define CIPHERSUITE_BY_ID_NONE      0
+#define CIPHERSUITE_BY_ID_BUILDING  1
+#define CIPHERSUITE_BY_ID_READY     2
+
+static int ciphersuite_by_id_state = CIPHERSUITE_BY_ID_NONE;
+
+/*
+ * Return 1 if the index can be used. Only the first caller builds it, and
+ * publishes it with a release store that pairs with the acquire load here.
+ * Concurrent callers do not wait for it, they return 0 and search linearly.
+ */
+static int ciphersuite_by_id_ready( void )
+{
+    int expected = CIPHERSUITE_BY_ID_NONE;
+    size_t i, j;
+
+    if( __atomic_load_n( &ciphersuite_by_id_state, __ATOMIC_ACQUIRE ) ==
+        CIPHERSUITE_BY_ID_READY )
+        return( 1 );
+
+    if( !__atomic_compare_exchange_n( &ciphersuite_by_id_state, &expected,
+                                      CIPHERSUITE_BY_ID_BUILDING, 0,
+                                      __ATOMIC_RELAXED, __ATOMIC_RELAXED ) )
+        return( 0 );
+
+    /* Insertion sort */
+    for( i = 0; i < CIPHERSUITE_COUNT; i++ )
+    {
+        for( j = i; j > 0 &&
+             ciphersuite_definitions[ciphersuite_by_id[j - 1]].id > ciphersuite_definitions[i].id;
+             j-- )
+        {
+            ciphersuite_by_id[j] = ciphersuite_by_id[j - 1];
+        }
+        ciphersuite_by_id[j] = (unsigned char) i;
+    }
+
+    __atomic_store_n( &ciphersuite_by_id_state, CIPHERSUITE_BY_ID_READY,
+                      __ATOMIC_RELEASE );
+
+    return( 1 );
+}
+
 const mbedtls_ssl_ciphersuite_t *mbedtls_ssl_ciphersuite_from_id( int ciphersuite )
 {
-    const mbedtls_ssl_ciphersuite_t *cur = ciphersuite_definitions;
+    const mbedtls_ssl_ciphersuite_t *cur;
+    size_t lo = 0;
+    size_t hi = CIPHERSUITE_COUNT;
+    size_t mid;
 
-    while( cur->id != 0 )
+    if( !ciphersuite_by_id_ready() )
     {
+        for( cur = ciphersuite_definitions; cur->id != 0; cur++ )
+        {
+            if( cur->id == ciphersuite )
+                return( cur );
+        }
+
+        return( NULL );
+    }
+
+    while( lo < hi )
+    {
+        mid = lo + ( hi - lo ) / 2;
+        cur = &ciphersuite_definitions[ciphersuite_by_id[mid]];
+
         if( cur->id == ciphersuite )
             return( cur );
 
-        cur++;
+        if( cur->id < ciphersuite )
+            lo = mid + 1;
+        else
+            hi = mid;
     }
 
     return( NULL );